@@ -142,6 +142,18 @@ macro(dune_probe_functions)
     "unistd.h"
     DUNE_SYS_HAS_CLOSE)
 
+  dune_test_function(fdatasync
+    "int"
+    "int"
+    "unistd.h"
+    DUNE_SYS_HAS_FDATASYNC)
+
+  dune_test_function(fsync
+    "int"
+    "int"
+    "unistd.h"
+    DUNE_SYS_HAS_FSYNC)
+
   dune_test_function(closesocket
     "int"
     "SOCKET"
@@ -226,6 +238,18 @@ macro(dune_probe_functions)
     "sys/mman.h;sys/types.h"
     DUNE_SYS_HAS_MMAP64)
 
+  dune_test_function(epoll_create1
+    "int"
+    "int"
+    "sys/epoll.h"
+    DUNE_SYS_HAS_EPOLL_CREATE1)
+
+  dune_test_function(eventfd
+    "int"
+    "unsigned int;int"
+    "sys/eventfd.h"
+    DUNE_SYS_HAS_EVENTFD)
+
   dune_test_function(mlockall
     "int"
     "int"
@@ -478,6 +502,24 @@ macro(dune_probe_functions)
     "sys/types.h;sys/socket.h;winsock2.h"
     DUNE_SYS_HAS_SOCKET)
 
+  dune_test_function(sendmmsg
+    "int"
+    "int;struct mmsghdr*;unsigned int;int"
+    "sys/types.h;sys/socket.h"
+    DUNE_SYS_HAS_SENDMMSG)
+
+  dune_test_function(sendmsg
+    "ssize_t"
+    "int;struct msghdr*;int"
+    "sys/types.h;sys/socket.h"
+    DUNE_SYS_HAS_SENDMSG)
+
+  dune_test_function(recvmmsg
+    "int"
+    "int;struct mmsghdr*;unsigned int;int;struct timespec*"
+    "sys/types.h;sys/socket.h;time.h"
+    DUNE_SYS_HAS_RECVMMSG)
+
   dune_test_function(WSAStartup
     "int"
     "WORD;WSADATA*"
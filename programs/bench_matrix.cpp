@@ -0,0 +1,158 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Benchmark of Math::Matrix products and in-place kernels.                 *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+using DUNE::Math::Matrix;
+using DUNE::Time::Clock;
+
+//! Matrix sizes.
+static const size_t c_sizes[] = {3, 6, 12, 25, 50, 100, 200};
+//! Approximate number of floating point operations per measurement.
+static const double c_work = 2e8;
+
+//! Straightforward product through the element accessors, as written
+//! by most callers that need a product into an existing matrix.
+static Matrix
+referenceProduct(const Matrix& a, const Matrix& b)
+{
+  Matrix s(a.rows(), b.columns(), 0.0);
+  const size_t n = a.rows();
+  const size_t m = a.columns();
+  const size_t r = b.columns();
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    for (size_t k = 0; k < m; ++k)
+    {
+      const double v = a(i, k);
+      for (size_t j = 0; j < r; ++j)
+        s(i, j) += v * b(k, j);
+    }
+  }
+
+  return s;
+}
+
+static Matrix
+sample(size_t n, double seed)
+{
+  Matrix m(n, n);
+  for (size_t i = 0; i < n; ++i)
+    for (size_t j = 0; j < n; ++j)
+      m(i, j) = std::sin(seed + i * 1.3 + j * 0.7);
+  return m;
+}
+
+int
+main(int argc, char** argv)
+{
+  double work = c_work;
+  if (argc > 1)
+    work = std::atof(argv[1]);
+
+  std::printf("%5s %12s | %10s %10s %10s | %10s %10s %10s\n",
+              "size", "iterations",
+              "elem a*b", "a*b", "into",
+              "a*p*a'+q", "gemm", "fused");
+
+  double sink = 0;
+
+  for (size_t s = 0; s < sizeof(c_sizes) / sizeof(c_sizes[0]); ++s)
+  {
+    const size_t n = c_sizes[s];
+    const unsigned iterations = std::max(1.0, work / (2.0 * n * n * n));
+
+    Matrix a = sample(n, 0.1);
+    Matrix p = sample(n, 0.5);
+    Matrix q = sample(n, 0.9);
+    Matrix c(n, n, 0.0);
+    Matrix t(n, n, 0.0);
+    double times[6];
+
+    double start = Clock::get();
+    for (unsigned i = 0; i < iterations; ++i)
+      c = referenceProduct(a, p);
+    times[0] = Clock::get() - start;
+    sink += c(0, 0);
+
+    start = Clock::get();
+    for (unsigned i = 0; i < iterations; ++i)
+      c = a * p;
+    times[1] = Clock::get() - start;
+    sink += c(0, 0);
+
+    start = Clock::get();
+    for (unsigned i = 0; i < iterations; ++i)
+      Matrix::multiplyInto(a, p, c);
+    times[2] = Clock::get() - start;
+    sink += c(0, 0);
+
+    start = Clock::get();
+    for (unsigned i = 0; i < iterations; ++i)
+      c = a * p * transpose(a) + q;
+    times[3] = Clock::get() - start;
+    sink += c(0, 0);
+
+    start = Clock::get();
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+      Matrix::multiplyInto(a, p, t);
+      c = q;
+      Matrix::gemm(1.0, t, false, a, true, 1.0, c);
+    }
+    times[4] = Clock::get() - start;
+    sink += c(0, 0);
+
+    start = Clock::get();
+    for (unsigned i = 0; i < iterations; ++i)
+      Matrix::quadraticInto(a, p, q, c);
+    times[5] = Clock::get() - start;
+    sink += c(0, 0);
+
+    std::printf("%5u %12u |", (unsigned)n, iterations);
+    for (unsigned i = 0; i < 6; ++i)
+    {
+      // Nanoseconds per call.
+      std::printf(" %10.0f", times[i] / iterations * 1e9);
+      if (i == 2)
+        std::printf(" |");
+    }
+    std::printf("\n");
+  }
+
+  std::printf("(checksum %g, times in ns per call)\n", sink);
+  return 0;
+}
@@ -73,153 +73,294 @@ const float c_max_speed = 6.0;
 // Timestep
 const float c_timestep = 0.5;
 
-int
-main(int32_t argc, char** argv)
+// Messages used by this program.
+static const uint16_t c_ids[] = {DUNE_IMC_ANNOUNCE, DUNE_IMC_LOGGINGCONTROL, DUNE_IMC_ESTIMATEDSTATE,
+                                 DUNE_IMC_RPM, DUNE_IMC_SIMULATEDSTATE};
+
+struct Result
 {
-  if (argc <= 1)
-  {
-    std::cerr << "Usage: " << argv[0] << " <path_to_log_1/Data.lsf[.gz]> ... <path_to_log_n/Data.lsf[.gz]>"
-              << std::endl;
-    return 1;
-  }
+  std::string sys_name;
+  std::string log_name;
+  double distance;
+  double duration;
+  bool ignore;
+  std::string message;
 
-  std::map<std::string, Vehicle> vehicles;
+  Result(void):
+    distance(0),
+    duration(0),
+    ignore(false)
+  { }
+};
 
-  for (int32_t i = 1; i < argc; ++i)
-  {
-    std::istream* is = 0;
-    Compression::Methods method = Compression::Factory::detect(argv[i]);
-    if (method == METHOD_UNKNOWN)
-      is = new std::ifstream(argv[i], std::ios::binary);
-    else
-      is = new Compression::FileInput(argv[i], method);
+static void
+processLog(const char* path, Result& result)
+{
+  IMC::Message* msg = NULL;
 
-    IMC::Message* msg = NULL;
+  uint16_t curr_rpm = 0;
 
-    uint16_t curr_rpm = 0;
+  bool got_state = false;
+  IMC::EstimatedState estate;
+  double last_lat;
+  double last_lon;
 
-    bool got_state = false;
-    IMC::EstimatedState estate;
-    double last_lat;
-    double last_lon;
+  // Accumulated travelled distance
+  double distance = 0.0;
+  // Accumulated travelled time
+  double duration = 0.0;
 
-    // Accumulated travelled distance
-    double distance = 0.0;
-    // Accumulated travelled time
-    double duration = 0.0;
+  bool got_name = false;
+  std::string log_name = "unknown";
 
-    bool got_name = false;
-    std::string log_name = "unknown";
+  bool ignore = false;
+  uint16_t sys_id = 0xffff;
+  std::string sys_name;
 
-    bool ignore = false;
-    uint16_t sys_id = 0xffff;
-    std::string sys_name;
+  try
+  {
+    IMC::LogReader reader(path);
+    reader.setFilter(std::vector<uint16_t>(c_ids, c_ids + sizeof(c_ids) / sizeof(c_ids[0])));
 
-    try
+    IMC::LogReader::PacketView packet;
+    size_t offset = 0;
+    while (reader.next(offset, reader.getSize(), packet))
     {
-      while ((msg = IMC::Packet::deserialize(*is)) != 0)
+      msg = reader.decode(packet);
+
+      if (msg->getId() == DUNE_IMC_ANNOUNCE)
       {
-        if (msg->getId() == DUNE_IMC_ANNOUNCE)
+        IMC::Announce* ptr = static_cast<IMC::Announce*>(msg);
+        if (sys_id == ptr->getSource())
         {
-          IMC::Announce* ptr = static_cast<IMC::Announce*>(msg);
-          if (sys_id == ptr->getSource())
+          sys_name = ptr->sys_name;
+        }
+      }
+      else if (msg->getId() == DUNE_IMC_LOGGINGCONTROL)
+      {
+        if (!got_name)
+        {
+          IMC::LoggingControl* ptr = static_cast<IMC::LoggingControl*>(msg);
+
+          if (ptr->op == IMC::LoggingControl::COP_STARTED)
           {
-            sys_name = ptr->sys_name;
+            sys_id = ptr->getSource();
+            log_name = ptr->name;
+            got_name = true;
           }
         }
-        else if (msg->getId() == DUNE_IMC_LOGGINGCONTROL)
+      }
+      else if (msg->getId() == DUNE_IMC_ESTIMATEDSTATE)
+      {
+        if (msg->getTimeStamp() - estate.getTimeStamp() > c_timestep)
         {
-          if (!got_name)
+          IMC::EstimatedState* ptr = static_cast<IMC::EstimatedState*>(msg);
+
+          if (!got_state)
           {
-            IMC::LoggingControl* ptr = static_cast<IMC::LoggingControl*>(msg);
+            estate = *ptr;
+            Coordinates::toWGS84(*ptr, last_lat, last_lon);
 
-            if (ptr->op == IMC::LoggingControl::COP_STARTED)
-            {
-              sys_id = ptr->getSource();
-              log_name = ptr->name;
-              got_name = true;
-            }
+            got_state = true;
           }
-        }
-        else if (msg->getId() == DUNE_IMC_ESTIMATEDSTATE)
-        {
-          if (msg->getTimeStamp() - estate.getTimeStamp() > c_timestep)
+          else if (curr_rpm > c_min_rpm)
           {
-            IMC::EstimatedState* ptr = static_cast<IMC::EstimatedState*>(msg);
+            double lat, lon;
+            Coordinates::toWGS84(*ptr, lat, lon);
 
-            if (!got_state)
-            {
-              estate = *ptr;
-              Coordinates::toWGS84(*ptr, last_lat, last_lon);
+            double dist = Coordinates::WGS84::distance(last_lat, last_lon, 0.0,
+                                                       lat, lon, 0.0);
 
-              got_state = true;
-            }
-            else if (curr_rpm > c_min_rpm)
+            // Not faster than maximum considered speed
+            if (dist / (ptr->getTimeStamp() - estate.getTimeStamp()) < c_max_speed)
             {
-              double lat, lon;
-              Coordinates::toWGS84(*ptr, lat, lon);
-
-              double dist = Coordinates::WGS84::distance(last_lat, last_lon, 0.0,
-                                                         lat, lon, 0.0);
-
-              // Not faster than maximum considered speed
-              if (dist / (ptr->getTimeStamp() - estate.getTimeStamp()) < c_max_speed)
-              {
-                distance += dist;
-                duration += msg->getTimeStamp() - estate.getTimeStamp();
-              }
-
-              estate = *ptr;
-              last_lat = lat;
-              last_lon = lon;
+              distance += dist;
+              duration += msg->getTimeStamp() - estate.getTimeStamp();
             }
+
+            estate = *ptr;
+            last_lat = lat;
+            last_lon = lon;
           }
         }
-        else if (msg->getId() == DUNE_IMC_RPM)
-        {
-          IMC::Rpm* ptr = static_cast<IMC::Rpm*>(msg);
-          curr_rpm = ptr->value;
-        }
-        else if (msg->getId() == DUNE_IMC_SIMULATEDSTATE)
-        {
-          // since it has simulated state let us ignore this log
-          ignore = true;
-          delete msg;
-          std::cerr << "this is a simulated log";
-          break;
-        }
+      }
+      else if (msg->getId() == DUNE_IMC_RPM)
+      {
+        IMC::Rpm* ptr = static_cast<IMC::Rpm*>(msg);
+        curr_rpm = ptr->value;
+      }
+      else if (msg->getId() == DUNE_IMC_SIMULATEDSTATE)
+      {
+        // since it has simulated state let us ignore this log
+        ignore = true;
+        IMC::Factory::recycle(msg);
+        result.message = "this is a simulated log";
+        break;
+      }
 
-        delete msg;
+      IMC::Factory::recycle(msg);
 
-        // ignore idles
-        // either has the string _idle or has only the time.
-        if (log_name.find("_idle") != std::string::npos ||
-            log_name.size() == 15)
-        {
-          ignore = true;
-          std::cerr << "this is an idle log";
-          break;
-        }
+      // ignore idles
+      // either has the string _idle or has only the time.
+      if (log_name.find("_idle") != std::string::npos ||
+          log_name.size() == 15)
+      {
+        ignore = true;
+        result.message = "this is an idle log";
+        break;
       }
     }
-    catch (std::runtime_error& e)
+  }
+  catch (std::runtime_error& e)
+  {
+    result.message = String::str("ERROR: %s", e.what());
+  }
+
+  result.sys_name = sys_name;
+  result.log_name = log_name;
+  result.distance = distance;
+  result.duration = duration;
+  result.ignore = ignore;
+}
+
+//! Bounds the memory held by the logs open at the same time.
+class MemoryBudget
+{
+public:
+  //! Constructor.
+  //! @param[in] size memory available to logs, zero for no limit.
+  MemoryBudget(uint64_t size):
+    m_size(size),
+    m_used(0)
+  { }
+
+  //! Wait until a log fits in the budget. A log larger than the
+  //! budget is admitted when no other log is open.
+  //! @param[in] size memory held by the log.
+  void
+  acquire(uint64_t size)
+  {
+    Concurrency::ScopedCondition l(m_cond);
+    while (m_size > 0 && m_used > 0 && m_used + size > m_size)
+      m_cond.wait();
+    m_used += size;
+  }
+
+  //! Return the memory of a closed log to the budget.
+  //! @param[in] size memory held by the log.
+  void
+  release(uint64_t size)
+  {
+    Concurrency::ScopedCondition l(m_cond);
+    m_used -= size;
+    m_cond.broadcast();
+  }
+
+private:
+  Concurrency::Condition m_cond;
+  uint64_t m_size;
+  uint64_t m_used;
+};
+
+//! Processes logs until there are no more logs to process.
+class Worker: public Concurrency::Thread
+{
+public:
+  Worker(char** paths, std::vector<Result>& results, size_t& next, Concurrency::Mutex& mutex,
+         MemoryBudget& budget):
+    m_paths(paths),
+    m_results(results),
+    m_next(next),
+    m_mutex(mutex),
+    m_budget(budget)
+  { }
+
+private:
+  char** m_paths;
+  std::vector<Result>& m_results;
+  size_t& m_next;
+  Concurrency::Mutex& m_mutex;
+  MemoryBudget& m_budget;
+
+  void
+  run(void)
+  {
+    while (true)
     {
-      std::cerr << "ERROR: " << e.what() << std::endl;
+      size_t index;
+
+      {
+        Concurrency::ScopedMutex l(m_mutex);
+        if (m_next >= m_results.size())
+          return;
+        index = m_next++;
+      }
+
+      // Decompressed logs are held in memory while processed.
+      uint64_t size = IMC::LogReader::getMemoryUsage(m_paths[index]);
+      m_budget.acquire(size);
+      processLog(m_paths[index], m_results[index]);
+      m_budget.release(size);
     }
+  }
+};
+
+int
+main(int32_t argc, char** argv)
+{
+  if (argc <= 1)
+  {
+    std::cerr << "Usage: " << argv[0] << " <path_to_log_1/Data.lsf[.gz]> ... <path_to_log_n/Data.lsf[.gz]>"
+              << std::endl;
+    return 1;
+  }
+
+  std::map<std::string, Vehicle> vehicles;
+
+  // Process logs in parallel.
+  std::vector<Result> results(argc - 1);
+  size_t next = 0;
+  Concurrency::Mutex mutex;
+  std::vector<Worker*> workers;
+
+  // Leave half of the physical memory to the rest of the system.
+  MemoryBudget budget(System::Resources::getMemorySize() / 2);
+
+  unsigned threads = std::min<unsigned>(System::Resources::getProcessorCount(), results.size());
+  for (unsigned i = 0; i < threads; ++i)
+  {
+    workers.push_back(new Worker(argv + 1, results, next, mutex, budget));
+    workers.back()->start();
+  }
 
-    delete is;
+  for (unsigned i = 0; i < threads; ++i)
+  {
+    workers[i]->join();
+    delete workers[i];
+  }
+
+  // Merge results in the order of the command line.
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const Result& r = results[i];
+
+    if (!r.message.empty())
+      std::cerr << r.message;
 
-    if (ignore)
+    if (r.ignore)
     {
       std::cerr << "... ignoring" << std::endl;
       continue;
     }
 
-    if (distance > 0)
+    if (!r.message.empty())
+      std::cerr << std::endl;
+
+    if (r.distance > 0)
     {
-      vehicles[sys_name].duration += duration;
-      vehicles[sys_name].distance += distance;
-      vehicles[sys_name].logs.push_back(Log(log_name, distance, duration));
+      vehicles[r.sys_name].duration += r.duration;
+      vehicles[r.sys_name].distance += r.distance;
+      vehicles[r.sys_name].logs.push_back(Log(r.log_name, r.distance, r.duration));
     }
   }
 
@@ -50,6 +50,9 @@ const unsigned c_samples = 7;
 // Minimum number of samples before starting to count energy
 const unsigned c_min_samples = 20;
 
+// Messages used by this program.
+static const uint16_t c_ids[] = {DUNE_IMC_LOGGINGCONTROL, DUNE_IMC_ENTITYINFO, DUNE_IMC_VOLTAGE, DUNE_IMC_CURRENT, DUNE_IMC_RPM, DUNE_IMC_SIMULATEDSTATE};
+
 int
 main(int32_t argc, char** argv)
 {
@@ -99,13 +102,6 @@ main(int32_t argc, char** argv)
 
   for (int32_t i = start_index; i < argc; ++i)
   {
-    std::istream* is = 0;
-    DUNE::Compression::Methods method = DUNE::Compression::Factory::detect(argv[i]);
-    if (method == DUNE::Compression::METHOD_UNKNOWN)
-      is = new std::ifstream(argv[i], std::ios::binary);
-    else
-      is = new DUNE::Compression::FileInput(argv[i], method);
-
     DUNE::IMC::Message* msg = NULL;
 
     bool got_name = false;
@@ -129,8 +125,14 @@ main(int32_t argc, char** argv)
 
     try
     {
-      while ((msg = DUNE::IMC::Packet::deserialize(*is)) != 0)
+      DUNE::IMC::LogReader reader(argv[i]);
+      reader.setFilter(std::vector<uint16_t>(c_ids, c_ids + sizeof(c_ids) / sizeof(c_ids[0])));
+
+      DUNE::IMC::LogReader::PacketView packet;
+      size_t offset = 0;
+      while (reader.next(offset, reader.getSize(), packet))
       {
+        msg = reader.decode(packet);
 
         if (msg->getId() == DUNE_IMC_LOGGINGCONTROL)
         {
@@ -217,8 +219,6 @@ main(int32_t argc, char** argv)
       std::cerr << "ERROR: " << e.what() << std::endl;
     }
 
-    delete is;
-
     if (ignore)
     {
       std::cerr << "... ignoring" << std::endl;
@@ -41,6 +41,20 @@
 
 using DUNE_NAMESPACES;
 
+//! Collects the selected messages of one log range.
+struct Filter: public IMC::LogReader::Handler
+{
+  IMC::Writer output;
+
+  void
+  onPacket(const IMC::LogReader& reader, const IMC::LogReader::PacketView& packet)
+  {
+    IMC::Message* msg = reader.decode(packet);
+    IMC::Packet::serialize(msg, output);
+    IMC::Factory::recycle(msg);
+  }
+};
+
 int
 main(int32_t argc, char** argv)
 {
@@ -64,53 +78,92 @@ main(int32_t argc, char** argv)
 
   bool done_first = false;
 
-  std::set<uint32_t> ids;
+  std::set<uint16_t> ids;
   std::vector<std::string> msgs;
   Utils::String::split(argv[1], ",", msgs);
 
   for (unsigned k = 0; k < msgs.size(); ++k)
   {
-    uint32_t got = IMC::Factory::getIdFromAbbrev(Utils::String::trim(msgs[k]));
+    uint16_t got = IMC::Factory::getIdFromAbbrev(Utils::String::trim(msgs[k]));
     ids.insert(got);
   }
 
   for (uint32_t j = 2; j < (uint32_t)argc; ++j)
   {
-    std::istream* is = 0;
-    Compression::Methods method = Compression::Factory::detect(argv[j]);
-    if (method == METHOD_UNKNOWN)
-      is = new std::ifstream(argv[j], std::ios::binary);
-    else
-      is = new Compression::FileInput(argv[j], method);
+    // Indexed logs: read only the selected messages.
+    if (IMC::IndexedLogReader::hasIndex(argv[j]))
+    {
+      uint32_t i = 0;
+
+      try
+      {
+        IMC::IndexedLogReader reader(argv[j]);
+        reader.setFilter(std::vector<uint16_t>(ids.begin(), ids.end()));
+
+        if (!done_first && reader.getIndex().getStartTime() >= 0)
+        {
+          // place an empty estimatedstate message in the log
+          IMC::EstimatedState state;
+          state.setTimeStamp(reader.getIndex().getStartTime());
+          IMC::Packet::serialize(&state, buffer);
+          lsf.write(buffer.getBufferSigned(), buffer.getSize());
+          done_first = true;
+        }
+
+        while ((msg = reader.next()) != 0)
+        {
+          IMC::Packet::serialize(msg, buffer);
+          lsf.write(buffer.getBufferSigned(), buffer.getSize());
+          IMC::Factory::recycle(msg);
+          ++i;
+        }
+      }
+      catch (std::runtime_error& e)
+      {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return -1;
+      }
+
+      std::cerr << i << " messages in " << argv[j] << " (indexed)" << std::endl;
+      accum += i;
+      continue;
+    }
 
     uint32_t i = 0;
 
     try
     {
-      while ((msg = IMC::Packet::deserialize(*is)) != 0)
+      IMC::LogReader reader(argv[j]);
+
+      if (!done_first)
       {
-        if (!done_first)
+        IMC::LogReader::PacketView packet;
+        size_t offset = 0;
+        if (reader.next(offset, reader.getSize(), packet))
         {
           // place an empty estimatedstate message in the log
           IMC::EstimatedState state;
-          state.setTimeStamp(msg->getTimeStamp());
+          state.setTimeStamp(packet.header.timestamp);
           IMC::Packet::serialize(&state, buffer);
           lsf.write(buffer.getBufferSigned(), buffer.getSize());
           done_first = true;
         }
+      }
 
-        std::set<uint32_t>::const_iterator it;
-        it = ids.find(msg->getId());
+      // Filter log ranges in parallel and write them in order.
+      reader.setFilter(std::vector<uint16_t>(ids.begin(), ids.end()));
 
-        if (it != ids.end())
-        {
-          IMC::Packet::serialize(msg, buffer);
-          lsf.write(buffer.getBufferSigned(), buffer.getSize());
+      std::vector<Filter> filters(System::Resources::getProcessorCount());
+      std::vector<IMC::LogReader::Handler*> handlers;
+      for (size_t k = 0; k < filters.size(); ++k)
+        handlers.push_back(&filters[k]);
 
-          ++i;
-        }
+      reader.process(handlers);
 
-        delete msg;
+      for (size_t k = 0; k < filters.size(); ++k)
+      {
+        lsf.write((const char*)filters[k].output.getData(), filters[k].output.getSize());
+        i += filters[k].output.getCount();
       }
     }
     catch (std::runtime_error& e)
@@ -121,8 +174,6 @@ main(int32_t argc, char** argv)
 
     std::cerr << i << " messages in " << argv[j] << std::endl;
     accum += i;
-
-    delete is;
   }
 
   lsf.close();
@@ -44,6 +44,9 @@
 
 using DUNE_NAMESPACES;
 
+// Messages used by this program.
+static const uint16_t c_ids[] = {DUNE_IMC_GPSFIX};
+
 int
 main(int32_t argc, char** argv)
 {
@@ -54,13 +57,6 @@ main(int32_t argc, char** argv)
     return 1;
   }
 
-  std::istream* is = 0;
-  Compression::Methods method = Compression::Factory::detect(argv[1]);
-  if (method == METHOD_UNKNOWN)
-    is = new std::ifstream(argv[1], std::ios::binary);
-  else
-    is = new Compression::FileInput(argv[1], method);
-
   ByteBuffer buffer;
   std::ofstream lsf("SurfaceData.lsf", std::ios::binary);
 
@@ -75,8 +71,15 @@ main(int32_t argc, char** argv)
 
   try
   {
-    while ((msg = IMC::Packet::deserialize(*is)) != 0)
+    IMC::LogReader reader(argv[1]);
+    reader.setFilter(std::vector<uint16_t>(c_ids, c_ids + sizeof(c_ids) / sizeof(c_ids[0])));
+
+    IMC::LogReader::PacketView packet;
+    size_t offset = 0;
+    while (reader.next(offset, reader.getSize(), packet))
     {
+      msg = reader.decode(packet);
+
       if (msg->getId() == DUNE_IMC_GPSFIX)
       {
         IMC::GpsFix* fix = static_cast<IMC::GpsFix*>(msg);
@@ -105,8 +108,6 @@ main(int32_t argc, char** argv)
 
   lsf.close();
 
-  delete is;
-
   std::cerr << "Got " << i << " GpsFix messages." << std::endl;
 
   return 0;
@@ -0,0 +1,167 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+#include <DUNE/Simulation/Bathymetry.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using DUNE::Simulation::Bathymetry;
+
+//! Depth of a sloped plane.
+static double
+plane(double x, double y)
+{
+  return 10.0 + 0.05 * x - 0.02 * y;
+}
+
+int
+main(void)
+{
+  Test test("Simulation::Bathymetry");
+
+  std::string path = "test_bathymetry.dbr";
+
+  // Samples of a plane on a 2 m grid that spans several tiles.
+  std::vector<Bathymetry::Sample> samples;
+  for (unsigned i = 0; i <= 100; ++i)
+  {
+    for (unsigned j = 0; j <= 150; ++j)
+    {
+      // Leave a hole in the middle.
+      if (i >= 50 && i <= 52 && j >= 70 && j <= 72)
+        continue;
+
+      Bathymetry::Sample sample;
+      sample.x = -100.0 + 2.0 * i;
+      sample.y = 50.0 + 2.0 * j;
+      sample.depth = plane(sample.x, sample.y);
+      samples.push_back(sample);
+    }
+  }
+
+  Bathymetry::create(path, 41.5, -8.5, samples, 2.0, 5.0);
+
+  {
+    Bathymetry raster(path);
+    test.boolean("reference location", raster.getLatitude() == 41.5 && raster.getLongitude() == -8.5);
+    test.boolean("dimensions", raster.getRows() == 101 && raster.getColumns() == 151);
+    test.boolean("sample", std::fabs(raster.getSample(10, 20) - plane(-80.0, 90.0)) < 1e-4);
+
+    bool ok = true;
+    Random::Generator* prng = Random::Factory::create(Random::Factory::c_default, 1);
+    for (unsigned k = 0; k < 1000; ++k)
+    {
+      double x = -100.0 + 200.0 * prng->uniform();
+      double y = 50.0 + 300.0 * prng->uniform();
+      // Filled samples are not exact.
+      if (x >= -4.0 && x <= 8.0 && y >= 186.0 && y <= 198.0)
+        continue;
+
+      double depth = 0;
+      ok = ok && raster.getDepth(x, y, depth) && std::fabs(depth - plane(x, y)) < 1e-3;
+    }
+    delete prng;
+    test.boolean("bilinear interpolation", ok);
+
+    double depth = 0;
+    test.boolean("boundary", raster.getDepth(100.0, 350.0, depth) && std::fabs(depth - plane(100.0, 350.0)) < 1e-3);
+    test.boolean("out of bounds (north)", !raster.getDepth(100.5, 100.0, depth));
+    test.boolean("out of bounds (west)", !raster.getDepth(0.0, 49.0, depth));
+    test.boolean("hole filled", std::fabs(raster.getSample(50, 70) - plane(0.0, 190.0)) < 0.1);
+  }
+
+  {
+    // Sparse data: holes beyond the fill radius stay empty.
+    std::vector<Bathymetry::Sample> sparse(2);
+    sparse[0].x = 0.0;
+    sparse[0].y = 0.0;
+    sparse[0].depth = 5.0;
+    sparse[1].x = 100.0;
+    sparse[1].y = 0.0;
+    sparse[1].depth = 15.0;
+    Bathymetry::create(path, 0, 0, sparse, 1.0, 3.0);
+
+    Bathymetry raster(path);
+    double depth = 0;
+    test.boolean("filled near data", raster.getDepth(2.0, 0.0, depth) && std::fabs(depth - 5.0) < 1e-6);
+    test.boolean("no data far from samples", !raster.getDepth(50.0, 0.0, depth));
+    test.boolean("no data sample is NaN", std::isnan(raster.getSample(50, 0)));
+  }
+
+  {
+    std::ofstream ofs(path.c_str(), std::ios::binary | std::ios::trunc);
+    ofs << "not a raster, just some text long enough for a header.................";
+    ofs.close();
+
+    bool thrown = false;
+    try
+    {
+      Bathymetry raster(path);
+    }
+    catch (std::runtime_error&)
+    {
+      thrown = true;
+    }
+    test.boolean("invalid file", thrown);
+  }
+
+  {
+    // Header with dimensions whose sizes overflow.
+    Bathymetry::create(path, 41.5, -8.5, samples, 2.0, 0.0);
+    std::fstream fs(path.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+    uint32_t huge[3] = {0xffffffff, 0xffffffff, 0xffffffff};
+    fs.seekp(offsetof(Bathymetry::Header, rows));
+    fs.write((const char*)huge, sizeof(huge));
+    fs.close();
+
+    bool thrown = false;
+    try
+    {
+      Bathymetry raster(path);
+    }
+    catch (std::runtime_error&)
+    {
+      thrown = true;
+    }
+    test.boolean("oversized header", thrown);
+  }
+
+  std::remove(path.c_str());
+
+  return test.getReturnValue();
+}
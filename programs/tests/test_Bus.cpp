@@ -0,0 +1,380 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Number of heap allocations performed by this program.
+static volatile unsigned long g_allocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+  ++g_allocations;
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == NULL)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+//! Minimal task that stores every message it receives.
+class FakeTask: public Tasks::AbstractTask
+{
+public:
+  FakeTask(bool store = true):
+    m_store(store),
+    m_count(0)
+  {
+    if (m_store)
+      m_received.reserve(c_iterations);
+  }
+
+  void
+  receive(const IMC::Message* msg)
+  {
+    ++m_count;
+    if (m_store)
+      m_received.push_back(IMC::SharedMessage(IMC::Factory::clone(msg)));
+  }
+
+  void
+  receive(const IMC::SharedMessage& msg)
+  {
+    ++m_count;
+    if (m_store)
+      m_received.push_back(msg);
+  }
+
+  const char*
+  getName(void) const
+  {
+    return "Fake";
+  }
+
+  void inf(const char*, ...) { }
+  void war(const char*, ...) { }
+  void err(const char*, ...) { }
+  void cri(const char*, ...) { }
+  void debug(const char*, ...) { }
+  void trace(const char*, ...) { }
+  void spew(const char*, ...) { }
+
+  //! True to keep received messages.
+  bool m_store;
+  //! Number of messages received.
+  unsigned long m_count;
+  //! Messages received.
+  std::vector<IMC::SharedMessage> m_received;
+  //! Number of dispatched messages.
+  static const unsigned c_iterations = 1000;
+
+protected:
+  void
+  run(void)
+  { }
+};
+
+//! Task that blocks inside receive() until released.
+class BlockingTask: public FakeTask
+{
+public:
+  BlockingTask(void):
+    FakeTask(false),
+    m_inside(false),
+    m_release(false)
+  { }
+
+  void
+  receive(const IMC::SharedMessage& msg)
+  {
+    (void)msg;
+    m_inside = true;
+    while (!m_release)
+      Time::Delay::wait(0.001);
+  }
+
+  volatile bool m_inside;
+  volatile bool m_release;
+};
+
+//! Thread dispatching a single message.
+class Dispatcher: public Concurrency::Thread
+{
+public:
+  Dispatcher(IMC::Bus& bus):
+    m_bus(bus)
+  { }
+
+private:
+  IMC::Bus& m_bus;
+
+  void
+  run(void)
+  {
+    IMC::Temperature msg;
+    m_bus.dispatch(&msg);
+  }
+};
+
+//! Thread dispatching messages until stopped.
+class Flooder: public Concurrency::Thread
+{
+public:
+  Flooder(IMC::Bus& bus):
+    m_bus(bus)
+  { }
+
+private:
+  IMC::Bus& m_bus;
+
+  void
+  run(void)
+  {
+    IMC::Temperature msg;
+    while (!isStopping())
+      m_bus.dispatch(&msg);
+  }
+};
+
+//! Measure dispatch throughput for a given number of recipients.
+//! @param[in] count number of recipients.
+//! @return true if every recipient got every message.
+static bool
+benchmark(unsigned count)
+{
+  const unsigned c_messages = 100000;
+
+  IMC::Bus bus;
+  std::vector<FakeTask*> tasks;
+  for (unsigned i = 0; i < count; ++i)
+  {
+    tasks.push_back(new FakeTask(false));
+    bus.registerRecipient(tasks.back(), IMC::EstimatedState::getIdStatic());
+    // Unrelated subscriptions to populate the dispatch table.
+    bus.registerRecipient(tasks.back(), IMC::EntityState::getIdStatic());
+    bus.registerRecipient(tasks.back(), IMC::Temperature::getIdStatic());
+  }
+
+  IMC::EstimatedState msg;
+  double start = Time::Clock::get();
+  for (unsigned i = 0; i < c_messages; ++i)
+    bus.dispatch(&msg);
+  double elapsed = Time::Clock::get() - start;
+
+  std::fprintf(stderr, "  %3u tasks: %10.0f dispatch/s %12.0f deliveries/s\n",
+               count, c_messages / elapsed, c_messages * (double)count / elapsed);
+
+  bool ok = true;
+  for (unsigned i = 0; i < count; ++i)
+  {
+    ok = ok && (tasks[i]->m_count == c_messages);
+    bus.unregisterRecipient(tasks[i], IMC::EstimatedState::getIdStatic());
+    bus.unregisterRecipient(tasks[i], IMC::EntityState::getIdStatic());
+    bus.unregisterRecipient(tasks[i], IMC::Temperature::getIdStatic());
+    delete tasks[i];
+  }
+
+  return ok;
+}
+
+int
+main(void)
+{
+  Test test("IMC::Bus");
+
+  const unsigned c_tasks = 60;
+  std::vector<FakeTask*> tasks;
+  IMC::Bus bus;
+
+  for (unsigned i = 0; i < c_tasks; ++i)
+  {
+    tasks.push_back(new FakeTask);
+    bus.registerRecipient(tasks.back(), IMC::EstimatedState::getIdStatic());
+  }
+
+  IMC::EstimatedState msg;
+  msg.x = 1.0;
+
+  // Legacy delivery: one private copy per recipient.
+  unsigned long start = g_allocations;
+  for (unsigned i = 0; i < FakeTask::c_iterations; ++i)
+  {
+    for (unsigned j = 0; j < c_tasks; ++j)
+      tasks[j]->receive(&msg);
+  }
+  unsigned long legacy = g_allocations - start;
+
+  for (unsigned j = 0; j < c_tasks; ++j)
+    tasks[j]->m_received.clear();
+
+  // Shared delivery through the bus.
+  start = g_allocations;
+  for (unsigned i = 0; i < FakeTask::c_iterations; ++i)
+    bus.dispatch(&msg);
+  unsigned long shared = g_allocations - start;
+
+  std::fprintf(stderr, "  %u tasks, %u messages: %lu allocations per-copy, %lu shared\n",
+               c_tasks, FakeTask::c_iterations, legacy, shared);
+
+  test.boolean("fewer allocations", shared * c_tasks / 2 <= legacy);
+
+  bool same = true;
+  for (unsigned j = 1; j < c_tasks; ++j)
+    same = same && tasks[j]->m_received.back().get() == tasks[0]->m_received.back().get();
+  test.boolean("single instance shared", same);
+
+  const IMC::EstimatedState* es = static_cast<const IMC::EstimatedState*>(tasks[0]->m_received.back().get());
+  test.boolean("message contents", es->x == 1.0f);
+
+  // Exclusion of the dispatching task.
+  tasks[0]->m_received.clear();
+  tasks[1]->m_received.clear();
+  bus.dispatch(&msg, tasks[0]);
+  test.boolean("exclude dispatcher", tasks[0]->m_received.empty() && tasks[1]->m_received.size() == 1);
+
+  // Paused bus keeps a single shared copy.
+  tasks[1]->m_received.clear();
+  bus.pause();
+  bus.dispatch(&msg);
+  msg.x = 2.0;
+  bus.resume();
+  es = static_cast<const IMC::EstimatedState*>(tasks[1]->m_received.back().get());
+  test.boolean("back log", tasks[1]->m_received.size() == 1 && es->x == 1.0f);
+
+  // Unregistered tasks stop receiving.
+  tasks[1]->m_received.clear();
+  tasks[2]->m_received.clear();
+  bus.unregisterRecipient(tasks[1], IMC::EstimatedState::getIdStatic());
+  bus.dispatch(&msg);
+  test.boolean("unregister", tasks[1]->m_received.empty() && tasks[2]->m_received.size() == 1);
+
+  // Messages without recipients are not copied.
+  IMC::Temperature temp;
+  start = g_allocations;
+  bus.dispatch(&temp);
+  test.boolean("no recipients, no copy", g_allocations == start);
+
+  for (unsigned j = 0; j < c_tasks; ++j)
+  {
+    bus.unregisterRecipient(tasks[j], IMC::EstimatedState::getIdStatic());
+    delete tasks[j];
+  }
+
+  // A dispatcher blocked inside a recipient does not block changes
+  // to the recipient list or other dispatchers.
+  {
+    IMC::Bus bus;
+    BlockingTask blocker;
+    FakeTask late;
+    bus.registerRecipient(&blocker, IMC::Temperature::getIdStatic());
+
+    Dispatcher dispatcher(bus);
+    dispatcher.start();
+    while (!blocker.m_inside)
+      Time::Delay::wait(0.001);
+
+    bus.registerRecipient(&late, IMC::EstimatedState::getIdStatic());
+    bus.dispatch(&msg);
+    test.boolean("blocked dispatcher: new recipient served", late.m_received.size() == 1);
+
+    bus.unregisterRecipient(&late, IMC::EstimatedState::getIdStatic());
+    blocker.m_release = true;
+    bus.synchronize();
+    dispatcher.stopAndJoin();
+    bus.dispatch(&msg);
+    test.boolean("blocked dispatcher: unregister", late.m_received.size() == 1);
+  }
+
+  // Recipients receive messages dispatched as soon as they are
+  // registered, while other threads keep dispatching.
+  {
+    IMC::Bus bus;
+    FakeTask sink(false);
+    bus.registerRecipient(&sink, IMC::Temperature::getIdStatic());
+
+    Flooder flooder(bus);
+    flooder.start();
+    while (sink.m_count == 0)
+      Time::Delay::wait(0.001);
+
+    const unsigned c_late = 200;
+    std::vector<FakeTask*> late;
+    bool served = true;
+    for (unsigned j = 0; j < c_late; ++j)
+    {
+      late.push_back(new FakeTask(false));
+      bus.registerRecipient(late.back(), IMC::EstimatedState::getIdStatic());
+      bus.dispatch(&msg);
+      served = served && late.back()->m_count == 1;
+    }
+
+    for (unsigned j = 0; j < c_late; ++j)
+    {
+      bus.unregisterRecipient(late[j], IMC::EstimatedState::getIdStatic());
+      bus.dispatch(&msg);
+      served = served && late[j]->m_count == c_late;
+    }
+
+    flooder.stopAndJoin();
+    bus.synchronize();
+    for (unsigned j = 0; j < c_late; ++j)
+      delete late[j];
+
+    test.boolean("concurrent dispatch: changes visible on return", served);
+  }
+
+  const unsigned c_counts[] = {1, 8, 32, 64, 128};
+  bool delivered = true;
+  for (unsigned i = 0; i < sizeof(c_counts) / sizeof(c_counts[0]); ++i)
+    delivered = benchmark(c_counts[i]) && delivered;
+  test.boolean("dispatch throughput", delivered);
+
+  return test.getReturnValue();
+}
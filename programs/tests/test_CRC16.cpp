@@ -0,0 +1,137 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Algorithms/CRC16.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include "Test.hpp"
+
+using namespace DUNE::Algorithms;
+
+typedef uint16_t (*Function)(const uint8_t*, size_t, uint16_t);
+
+static void
+benchmark(const char* name, Function func, const std::vector<uint8_t>& data, unsigned rounds)
+{
+  uint16_t crc = 0;
+  double start = DUNE::Time::Clock::get();
+  for (unsigned i = 0; i < rounds; ++i)
+    crc = func(&data[0], data.size(), crc);
+  double elapsed = DUNE::Time::Clock::get() - start;
+
+  double mib = (double)data.size() * rounds / (1024.0 * 1024.0);
+  std::fprintf(stderr, "  %-14s %10.1f MB/s (crc 0x%04X)\n", name, mib / elapsed, crc);
+}
+
+int
+main(int argc, char** argv)
+{
+  Test test("DUNE::Algorithms::CRC16");
+
+  // CRC-16/ARC check values.
+  const char* input_strings[] =
+  {
+    "123456789",
+    "a",
+    "abc",
+    "message digest",
+    "abcdefghijklmnopqrstuvwxyz",
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+    "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+  };
+
+  int n = sizeof(input_strings) / sizeof(const char*);
+  bool known = true;
+  for (int i = 0; i < n; ++i)
+  {
+    const uint8_t* data = (const uint8_t*)input_strings[i];
+    size_t len = std::strlen(input_strings[i]);
+    uint16_t ref = CRC16::computeBytewise(data, len);
+    known = known && CRC16::compute(data, len) == ref;
+    known = known && CRC16::computeSlicing8(data, len) == ref;
+    known = known && CRC16::computeCLMUL(data, len) == ref;
+  }
+
+  test.boolean("check value", CRC16::compute((const uint8_t*)"123456789", 9) == 0xBB3D);
+  test.boolean("known strings", known);
+
+  // Compare all implementations for every length, alignment and
+  // initial value combination.
+  std::vector<uint8_t> data(4096 + 16);
+  std::srand(1);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = (uint8_t)std::rand();
+
+  bool slicing = true;
+  bool clmul = true;
+  bool dispatch = true;
+  for (size_t len = 0; len <= 1100; ++len)
+  {
+    for (size_t offset = 0; offset < 4; ++offset)
+    {
+      uint16_t init = (uint16_t)std::rand();
+      uint16_t ref = CRC16::computeBytewise(&data[offset], len, init);
+      slicing = slicing && CRC16::computeSlicing8(&data[offset], len, init) == ref;
+      clmul = clmul && CRC16::computeCLMUL(&data[offset], len, init) == ref;
+      dispatch = dispatch && CRC16::compute(&data[offset], len, init) == ref;
+    }
+  }
+
+  test.boolean("slicing-by-8 matches bytewise", slicing);
+  test.boolean("clmul matches bytewise", clmul);
+  test.boolean("dispatch matches bytewise", dispatch);
+
+  // Incremental updates must match a single pass.
+  uint16_t split = CRC16::compute(&data[0], 1000);
+  split = CRC16::compute(&data[1000], 3096, split);
+  test.boolean("incremental update", split == CRC16::computeBytewise(&data[0], 4096));
+
+  // Throughput.
+  std::fprintf(stderr, "  dispatch uses %s\n", CRC16::getImplementation());
+  const size_t sizes[] = {64, 1024, 65535};
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+  {
+    std::vector<uint8_t> bfr(sizes[i]);
+    for (size_t j = 0; j < bfr.size(); ++j)
+      bfr[j] = (uint8_t)std::rand();
+
+    unsigned rounds = (unsigned)((64 * 1024 * 1024) / bfr.size());
+    std::fprintf(stderr, "  %lu bytes:\n", (unsigned long)bfr.size());
+    benchmark("bytewise", CRC16::computeBytewise, bfr, rounds);
+    benchmark("slicing-by-8", CRC16::computeSlicing8, bfr, rounds);
+    benchmark("clmul", CRC16::computeCLMUL, bfr, rounds);
+    benchmark("dispatch", CRC16::compute, bfr, rounds);
+  }
+
+  return 0;
+}
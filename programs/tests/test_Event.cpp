@@ -0,0 +1,104 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 11 headers.
+#include <thread>
+
+// POSIX headers.
+#include <unistd.h>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+int
+main(void)
+{
+  Test test("IO::Event");
+
+  {
+    IO::Event event;
+    test.boolean("starts cleared", !IO::Poll::poll(event, 0.0));
+
+    event.signal();
+    test.boolean("signalled", IO::Poll::poll(event, 0.0));
+    test.boolean("stays signalled", IO::Poll::poll(event, 0.0));
+
+    event.signal();
+    event.clear();
+    test.boolean("cleared", !IO::Poll::poll(event, 0.0));
+
+    event.clear();
+    test.boolean("clearing twice", !IO::Poll::poll(event, 0.0));
+  }
+
+  {
+    IO::Event event;
+    int fds[2];
+    if (pipe(fds) < 0)
+      throw std::runtime_error("pipe");
+
+    IO::Poll poll;
+    poll.add(event);
+    poll.add(fds[0]);
+
+    // Another thread wakes up a long wait.
+    double start = Time::Clock::get();
+    std::thread signaller([&]() { Time::Delay::wait(0.05); event.signal(); });
+    bool triggered = poll.poll(5.0);
+    double elapsed = Time::Clock::get() - start;
+    signaller.join();
+
+    test.boolean("wakes up waiting thread", triggered && elapsed < 1.0);
+    test.boolean("event was triggered", poll.wasTriggered(event));
+    test.boolean("other handle was not triggered", !poll.wasTriggered(fds[0]));
+
+    event.clear();
+    if (write(fds[1], "x", 1) != 1)
+      throw std::runtime_error("write");
+    test.boolean("other handle is triggered", poll.poll(1.0) && poll.wasTriggered(fds[0]));
+    test.boolean("cleared event is not triggered", !poll.wasTriggered(event));
+
+    // Handles polled for writing.
+    char byte;
+    if (read(fds[0], &byte, 1) != 1)
+      throw std::runtime_error("read");
+    poll.addWrite(fds[1]);
+    test.boolean("write handle is writable", poll.poll(1.0) && poll.wasWritable(fds[1]));
+    poll.removeWrite(fds[1]);
+    test.boolean("removed write handle is ignored", !poll.poll(0.0) && !poll.wasWritable(fds[1]));
+
+    close(fds[0]);
+    close(fds[1]);
+  }
+
+  return test.getReturnValue();
+}
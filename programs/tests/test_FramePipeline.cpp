@@ -0,0 +1,246 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <set>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Media;
+
+typedef FramePipeline::Frame Frame;
+
+static const unsigned c_width = 64;
+static const unsigned c_height = 48;
+
+static void
+fill(Frame* frame, unsigned seed)
+{
+  uint8_t* raw = frame->getRaw();
+  for (size_t i = 0; i < frame->getRawSize(); ++i)
+    raw[i] = (uint8_t)((i * 7 + seed * 13) & 0xff);
+}
+
+static bool
+isJPEG(const Frame* frame)
+{
+  const uint8_t* data = frame->getJPEG();
+  size_t size = frame->getJPEGSize();
+  return size > 4
+  && data[0] == 0xff && data[1] == 0xd8
+  && data[size - 2] == 0xff && data[size - 1] == 0xd9;
+}
+
+//! Submit frames and check they are delivered in order.
+static void
+testOrder(Test& test, FramePipeline::PixelFormat format, const char* name)
+{
+  const unsigned count = 50;
+
+  FramePipeline::Settings settings;
+  settings.width = c_width;
+  settings.height = c_height;
+  settings.format = format;
+  settings.workers = 4;
+  settings.buffers = count;
+
+  FramePipeline pipeline(settings);
+  std::set<Frame*> buffers;
+
+  for (unsigned i = 0; i < count; ++i)
+  {
+    Frame* frame = pipeline.acquire();
+    buffers.insert(frame);
+    fill(frame, i);
+    frame->setTimeStamp(i);
+    pipeline.submit(frame);
+  }
+
+  bool order = true;
+  bool valid = true;
+  bool rgb = true;
+  unsigned received = 0;
+
+  while (received < count)
+  {
+    Frame* frame = pipeline.poll(5.0);
+    if (frame == NULL)
+      break;
+
+    order = order && frame->getSequence() == received
+    && frame->getTimeStamp() == received;
+    valid = valid && isJPEG(frame);
+    rgb = rgb && ((frame->getRGB() != NULL) == (format == FramePipeline::PF_BAYER8));
+    ++received;
+    pipeline.release(frame);
+  }
+
+  FramePipeline::Metrics metrics = pipeline.getMetrics();
+
+  test.boolean(DUNE::Utils::String::str("%s: all frames delivered", name).c_str(), received == count);
+  test.boolean(DUNE::Utils::String::str("%s: delivered in order", name).c_str(), order);
+  test.boolean(DUNE::Utils::String::str("%s: valid JPEG", name).c_str(), valid);
+  test.boolean(DUNE::Utils::String::str("%s: decoded image", name).c_str(), rgb);
+  test.boolean(DUNE::Utils::String::str("%s: metrics", name).c_str(),
+               metrics.submitted == count && metrics.encoded == count
+               && metrics.encode.count == count && metrics.total.count == count
+               && metrics.dropped == 0 && pipeline.getPending() == 0);
+}
+
+int
+main(void)
+{
+  Test test("Media::FramePipeline");
+
+  testOrder(test, FramePipeline::PF_RGB24, "rgb24");
+  testOrder(test, FramePipeline::PF_GRAY8, "gray8");
+  testOrder(test, FramePipeline::PF_BAYER8, "bayer8");
+
+  // Buffers held by the consumer are never reused.
+  {
+    FramePipeline::Settings settings;
+    settings.width = c_width;
+    settings.height = c_height;
+    settings.workers = 2;
+    settings.buffers = 3;
+
+    FramePipeline pipeline(settings);
+    std::set<Frame*> buffers;
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+      Frame* frame = pipeline.acquire();
+      buffers.insert(frame);
+      fill(frame, i);
+      pipeline.submit(frame);
+    }
+
+    while (pipeline.getMetrics().encoded < 3)
+      DUNE::Time::Delay::wait(0.001);
+
+    test.boolean("exhausted: acquire fails", pipeline.acquire() == NULL);
+    test.boolean("exhausted: counted as dropped", pipeline.getMetrics().dropped == 1);
+
+    Frame* frame = pipeline.poll();
+    test.boolean("exhausted: oldest delivered", frame != NULL && frame->getSequence() == 0);
+    pipeline.release(frame);
+
+    Frame* recycled = pipeline.acquire();
+    test.boolean("recycled buffer", recycled == frame);
+    pipeline.release(recycled);
+    test.boolean("three distinct buffers", buffers.size() == 3);
+  }
+
+  // Capture faster than compression: old frames are dropped, the
+  // rest stay in order.
+  {
+    const unsigned count = 300;
+
+    FramePipeline::Settings settings;
+    settings.width = 640;
+    settings.height = 480;
+    settings.workers = 1;
+    settings.buffers = 3;
+
+    FramePipeline pipeline(settings);
+
+    unsigned captured = 0;
+    unsigned received = 0;
+    unsigned long last = 0;
+    bool order = true;
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+      Frame* frame = pipeline.acquire();
+      if (frame != NULL)
+      {
+        fill(frame, i);
+        pipeline.submit(frame);
+        ++captured;
+      }
+
+      while ((frame = pipeline.poll()) != NULL)
+      {
+        order = order && (received == 0 || frame->getSequence() > last);
+        last = frame->getSequence();
+        ++received;
+        pipeline.release(frame);
+      }
+    }
+
+    while (pipeline.getPending() > 0)
+    {
+      Frame* frame = pipeline.poll(5.0);
+      if (frame == NULL)
+        break;
+
+      order = order && (received == 0 || frame->getSequence() > last);
+      last = frame->getSequence();
+      ++received;
+      pipeline.release(frame);
+    }
+
+    FramePipeline::Metrics metrics = pipeline.getMetrics();
+
+    test.boolean("overrun: delivered in order", order);
+    test.boolean("overrun: frames dropped", metrics.dropped > 0);
+    test.boolean("overrun: accounting",
+                 received + metrics.dropped == count
+                 && metrics.submitted == captured
+                 && pipeline.getPending() == 0);
+  }
+
+  // The event wakes the consumer once a frame is ready.
+  {
+    FramePipeline::Settings settings;
+    settings.width = c_width;
+    settings.height = c_height;
+    settings.workers = 2;
+
+    FramePipeline pipeline(settings);
+    DUNE::IO::Event event;
+    pipeline.setEvent(&event);
+
+    test.boolean("event: starts cleared", !DUNE::IO::Poll::poll(event, 0.0));
+
+    Frame* frame = pipeline.acquire();
+    fill(frame, 0);
+    pipeline.submit(frame);
+
+    bool signalled = DUNE::IO::Poll::poll(event, 5.0);
+    frame = pipeline.poll();
+    test.boolean("event: signalled when frame is ready", signalled && frame != NULL);
+    pipeline.release(frame);
+    pipeline.setEvent(NULL);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,138 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <atomic>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+typedef Parsers::HDF5BlockCache<double, 3> Cache;
+
+//! Dataset dimensions.
+static const Cache::Index c_dims = {{50, 40, 30}};
+
+//! Value of a point of the synthetic dataset.
+static double
+value(size_t i, size_t j, size_t k)
+{
+  return i * 10000.0 + j * 100.0 + k;
+}
+
+//! Number of blocks read.
+static std::atomic<unsigned> s_reads(0);
+
+//! Synthetic block reader.
+static std::vector<double>
+load(Cache::Index const& offset, Cache::Index const& size)
+{
+  ++s_reads;
+  std::vector<double> data;
+  for (size_t i = 0; i < size[0]; ++i)
+    for (size_t j = 0; j < size[1]; ++j)
+      for (size_t k = 0; k < size[2]; ++k)
+        data.push_back(value(offset[0] + i, offset[1] + j, offset[2] + k));
+  return data;
+}
+
+int
+main(void)
+{
+  Test test("Parsers::HDF5BlockCache");
+
+  {
+    // Room for everything.
+    Cache cache(c_dims, load, {{16, 16, 8}}, 1 << 30);
+
+    bool ok = true;
+    for (size_t i = 0; i < c_dims[0]; ++i)
+      for (size_t j = 0; j < c_dims[1]; ++j)
+        for (size_t k = 0; k < c_dims[2]; ++k)
+          ok = ok && cache.get({{i, j, k}}) == value(i, j, k);
+
+    test.boolean("values (including partial blocks)", ok);
+    // 4 x 3 x 4 blocks.
+    test.boolean("each block read once", s_reads == 48);
+    test.boolean("misses counted", cache.getMisses() == 48);
+    test.boolean("hits counted", cache.getHits() == 50 * 40 * 30 - 48);
+
+    bool thrown = false;
+    try
+    {
+      cache.get({{50, 0, 0}});
+    }
+    catch (std::runtime_error&)
+    {
+      thrown = true;
+    }
+    test.boolean("out of bounds", thrown);
+  }
+
+  {
+    // Room for two full blocks.
+    size_t block = 16 * 16 * 8 * sizeof(double);
+    Cache cache(c_dims, load, {{16, 16, 8}}, 2 * block);
+    s_reads = 0;
+
+    cache.get({{0, 0, 0}});
+    cache.get({{0, 0, 8}});
+    cache.get({{0, 0, 1}});
+    cache.get({{0, 0, 16}});
+    test.boolean("memory budget", cache.getUsage() <= 2 * block);
+
+    // The least recently used block was evicted.
+    cache.get({{0, 0, 2}});
+    test.boolean("recently used block kept", s_reads == 3);
+    cache.get({{0, 0, 9}});
+    test.boolean("least recently used block evicted", s_reads == 4);
+  }
+
+  {
+    Cache cache(c_dims, load, {{16, 16, 8}}, 1 << 30);
+    s_reads = 0;
+
+    cache.prefetch({{20, 20, 20}});
+    cache.prefetch({{20, 20, 20}});
+    cache.prefetch({{60, 0, 0}});
+
+    double deadline = Time::Clock::get() + 2.0;
+    while (cache.getUsage() == 0 && Time::Clock::get() < deadline)
+      Time::Delay::wait(0.01);
+
+    test.boolean("prefetched block read once", s_reads == 1);
+    test.boolean("prefetched value", cache.get({{21, 22, 23}}) == value(21, 22, 23));
+    test.boolean("prefetched block is a hit", cache.getMisses() == 0);
+  }
+
+  return test.getReturnValue();
+}
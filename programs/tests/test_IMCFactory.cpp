@@ -0,0 +1,182 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+static bool
+getStatistics(uint32_t id, IMC::Factory::PoolStatistics& stats)
+{
+  std::vector<IMC::Factory::PoolStatistics> v;
+  IMC::Factory::getPoolStatistics(v);
+
+  for (size_t i = 0; i < v.size(); ++i)
+  {
+    if (v[i].id == id)
+    {
+      stats = v[i];
+      return true;
+    }
+  }
+
+  return false;
+}
+
+class Producer: public Concurrency::Thread
+{
+public:
+  Producer(void):
+    ok(true)
+  { }
+
+  bool ok;
+
+protected:
+  void
+  run(void)
+  {
+    IMC::DevDataBinary src;
+    src.value.resize(256, 7);
+
+    for (unsigned i = 0; i < 20000; ++i)
+    {
+      IMC::Message* msg = IMC::Factory::clone(&src);
+      ok = ok && *msg == src;
+      IMC::Factory::recycle(msg);
+    }
+  }
+};
+
+int
+main(void)
+{
+  Test test("DUNE::IMC::Factory pools");
+
+  // Recycled objects are reused and cleared.
+  IMC::SonarData* sd = static_cast<IMC::SonarData*>(IMC::Factory::produce(DUNE_IMC_SONARDATA));
+  sd->setSource(0x1234);
+  sd->data.resize(10000, 1);
+  sd->max_range = 50;
+  IMC::BeamConfig bc;
+  sd->beam_config.push_back(bc);
+  IMC::Factory::recycle(sd);
+
+  IMC::SonarData* sd2 = static_cast<IMC::SonarData*>(IMC::Factory::produce(DUNE_IMC_SONARDATA));
+  test.boolean("object reused", sd2 == sd);
+  test.boolean("object cleared", *sd2 == IMC::SonarData());
+  test.boolean("capacity kept", sd2->data.capacity() >= 10000);
+
+  // Copies are equal to the original and keep their own nested lists.
+  IMC::SonarData src;
+  src.setSource(0x4321);
+  src.max_range = 25;
+  src.data.resize(1000, 3);
+  src.beam_config.push_back(bc);
+  IMC::Factory::recycle(sd2);
+
+  {
+    IMC::SonarData* copy = static_cast<IMC::SonarData*>(IMC::Factory::clone(&src));
+    test.boolean("pooled copy reused", copy == sd);
+    test.boolean("pooled copy equal", *copy == src);
+    copy->setSource(0x1111);
+    copy->beam_config.push_back(bc);
+    test.boolean("nested header follows copy",
+                 (*copy->beam_config.begin())->getSource() == 0x1111
+                 && (*src.beam_config.begin())->getSource() == 0x4321);
+    delete copy;
+  }
+
+  IMC::Factory::PoolStatistics stats;
+  test.boolean("statistics", getStatistics(DUNE_IMC_SONARDATA, stats)
+               && stats.requests == 3 && stats.hits == 2 && stats.recycled == 2
+               && stats.high_water == 1);
+
+  // Objects with large payloads are not pooled.
+  IMC::SonarData* large = static_cast<IMC::SonarData*>(IMC::Factory::produce(DUNE_IMC_SONARDATA));
+  large->data.resize(DUNE_IMC_CONST_MAX_SIZE + 1);
+  IMC::Factory::recycle(large);
+  test.boolean("large objects are not pooled", getStatistics(DUNE_IMC_SONARDATA, stats)
+               && stats.requests == 4 && stats.recycled == 2);
+
+  // Objects of unknown dynamic type are not pooled.
+  struct Derived: public IMC::EstimatedState
+  {
+    Derived*
+    clone(void) const
+    {
+      return new Derived(*this);
+    }
+  };
+  IMC::Factory::recycle(new Derived);
+  IMC::Message* es = IMC::Factory::produce(DUNE_IMC_ESTIMATEDSTATE);
+  test.boolean("foreign objects are not pooled", typeid(*es) == typeid(IMC::EstimatedState));
+  delete es;
+
+  // Copies of objects of unknown dynamic type are not sliced.
+  Derived derived;
+  derived.x = 1.0;
+  IMC::Message* dcopy = IMC::Factory::clone(&derived);
+  test.boolean("foreign objects are not sliced", typeid(*dcopy) == typeid(Derived)
+               && static_cast<Derived*>(dcopy)->x == 1.0);
+  delete dcopy;
+
+  // Concurrent use.
+  std::vector<Producer*> producers(4);
+  for (size_t i = 0; i < producers.size(); ++i)
+  {
+    producers[i] = new Producer;
+    producers[i]->start();
+  }
+
+  bool ok = true;
+  for (size_t i = 0; i < producers.size(); ++i)
+  {
+    producers[i]->stopAndJoin();
+    ok = ok && producers[i]->ok;
+    delete producers[i];
+  }
+
+  test.boolean("concurrent copies", ok);
+  test.boolean("concurrent hit rate", getStatistics(DUNE_IMC_DEVDATABINARY, stats)
+               && stats.hits + 4 >= stats.requests);
+
+  // Pooling can be disabled.
+  IMC::Factory::setPoolCapacity(0);
+  IMC::Message* a = IMC::Factory::produce(DUNE_IMC_HEARTBEAT);
+  IMC::Factory::recycle(a);
+  IMC::Message* b = IMC::Factory::produce(DUNE_IMC_HEARTBEAT);
+  test.boolean("disabled", getStatistics(DUNE_IMC_HEARTBEAT, stats) && stats.hits == 0);
+  delete b;
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,213 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <fstream>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Number of packets in the test log.
+static const unsigned c_packets = 3000;
+//! Time between packets.
+static const double c_period = 0.1;
+//! Timestamp of the first packet.
+static const double c_start = 1000.0;
+
+//! Write a log and its index the way Transports.Logging does.
+static void
+writeLog(const std::string& path, Compression::Methods method)
+{
+  IMC::Writer packets;
+  for (unsigned i = 0; i < c_packets; ++i)
+  {
+    double time = c_start + i * c_period;
+
+    if (i % 3 == 0)
+    {
+      IMC::EstimatedState msg;
+      msg.x = i;
+      msg.setTimeStamp(time);
+      msg.setSourceEntity(1);
+      IMC::Packet::serialize(&msg, packets);
+    }
+    else if (i % 3 == 1)
+    {
+      IMC::Temperature msg;
+      msg.value = i;
+      msg.setTimeStamp(time);
+      msg.setSourceEntity(2);
+      IMC::Packet::serialize(&msg, packets);
+    }
+    else
+    {
+      IMC::LogBookEntry msg;
+      msg.text = String::str("entry %u", i);
+      msg.setTimeStamp(time);
+      msg.setSourceEntity(3);
+      IMC::Packet::serialize(&msg, packets);
+    }
+  }
+
+  std::ofstream log(path.c_str(), std::ios::binary);
+  std::ofstream idx((path + IMC::LogIndex::c_extension).c_str(), std::ios::binary);
+
+  Utils::ByteBuffer record;
+  IMC::LogIndex::encodeHeader(method, record);
+  idx.write(record.getBufferSigned(), record.getSize());
+
+  Compression::Compressor* com = NULL;
+  if (method != METHOD_UNKNOWN)
+    com = Compression::Factory::compressor(method);
+
+  std::vector<IMC::LogIndex::Entry> entries;
+  Utils::ByteBuffer compressed;
+  uint64_t position = 0;
+  size_t offset = 0;
+  while (offset < packets.getSize())
+  {
+    IMC::LogIndex::Block block;
+    size_t size = IMC::LogIndex::scan(packets.getData() + offset, packets.getSize() - offset, 4096, block, entries);
+    char* raw = (char*)packets.getData() + offset;
+
+    block.position = position;
+    if (com == NULL)
+    {
+      log.write(raw, size);
+      block.stored_size = size;
+    }
+    else
+    {
+      com->compress(compressed, raw, size);
+      log.write(compressed.getBufferSigned(), compressed.getSize());
+      block.stored_size = compressed.getSize();
+    }
+
+    position += block.stored_size;
+    offset += size;
+
+    IMC::LogIndex::encodeBlock(block, entries, record);
+    idx.write(record.getBufferSigned(), record.getSize());
+  }
+
+  // Truncated record, as left by a power failure.
+  idx.write(record.getBufferSigned(), record.getSize() / 2);
+
+  delete com;
+}
+
+static void
+testLog(Test& test, const std::string& path, Compression::Methods method)
+{
+  std::string name = Compression::Factory::method(method);
+  writeLog(path, method);
+
+  IMC::IndexedLogReader reader(path);
+  const IMC::LogIndex& index = reader.getIndex();
+
+  test.boolean((name + ": entries").c_str(), index.getEntryCount() == c_packets);
+  test.boolean((name + ": blocks").c_str(), index.getBlockCount() > 10);
+  test.boolean((name + ": time span").c_str(), index.getStartTime() == c_start
+               && std::fabs(index.getEndTime() - (c_start + (c_packets - 1) * c_period)) < 1e-6);
+
+  // Read everything.
+  unsigned count = 0;
+  bool ordered = true;
+  IMC::Message* msg;
+  while ((msg = reader.next()) != NULL)
+  {
+    ordered = ordered && std::fabs(msg->getTimeStamp() - (c_start + count * c_period)) < 1e-6;
+    ++count;
+    delete msg;
+  }
+
+  test.boolean((name + ": read all").c_str(), count == c_packets && ordered);
+
+  // Filter by message type.
+  reader.rewind();
+  reader.addFilter(IMC::Temperature::getIdStatic());
+  count = 0;
+  bool filtered = true;
+  while ((msg = reader.next()) != NULL)
+  {
+    IMC::Temperature* t = dynamic_cast<IMC::Temperature*>(msg);
+    filtered = filtered && t != NULL && t->getSourceEntity() == 2 && ((unsigned)t->value % 3) == 1;
+    ++count;
+    delete msg;
+  }
+
+  test.boolean((name + ": filter by id").c_str(), filtered && count == c_packets / 3);
+
+  // Time window with filter.
+  reader.setTimeWindow(c_start + 100.0, c_start + 160.0);
+  count = 0;
+  bool in_window = true;
+  while ((msg = reader.next()) != NULL)
+  {
+    in_window = in_window && msg->getId() == IMC::Temperature::getIdStatic()
+      && msg->getTimeStamp() >= c_start + 100.0 && msg->getTimeStamp() <= c_start + 160.0;
+    ++count;
+    delete msg;
+  }
+
+  // Packets 1000 to 1600, one in every three.
+  test.boolean((name + ": time window").c_str(), in_window && count == 201);
+
+  // Seek without filter.
+  reader.clearFilter();
+  reader.setTimeWindow(c_start + 250.0, c_start + 1e6);
+  msg = reader.next();
+  test.boolean((name + ": seek").c_str(), msg != NULL && std::fabs(msg->getTimeStamp() - (c_start + 250.0)) < 1e-6);
+  delete msg;
+
+  Path(path).remove();
+  Path(path + IMC::LogIndex::c_extension).remove();
+}
+
+int
+main(void)
+{
+  Test test("DUNE::IMC::IndexedLogReader");
+
+#if defined(DUNE_OS_POSIX)
+  Path tmp("/tmp");
+#elif defined(DUNE_OS_WINDOWS)
+  Path tmp("c:/");
+#endif
+
+  std::string base = (tmp / String::str("dune_test_log_index_%u", (unsigned)Time::Clock::getSinceEpochNsec() % 100000)).str();
+
+  testLog(test, base + ".lsf", METHOD_UNKNOWN);
+  testLog(test, base + ".lsf.gz", METHOD_GZIP);
+  testLog(test, base + ".lsf.bz2", METHOD_BZIP2);
+
+  return 0;
+}
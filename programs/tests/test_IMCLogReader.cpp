@@ -0,0 +1,193 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <fstream>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Number of packets in the test log.
+static const unsigned c_packets = 20000;
+
+//! Collects timestamps of Temperature messages.
+class Collector: public IMC::LogReader::Handler
+{
+public:
+  std::vector<double> values;
+  unsigned packets;
+
+  Collector(void):
+    packets(0)
+  { }
+
+  void
+  onPacket(const IMC::LogReader& reader, const IMC::LogReader::PacketView& packet)
+  {
+    ++packets;
+    if (packet.header.mgid != IMC::Temperature::getIdStatic())
+      return;
+
+    IMC::Message* msg = reader.decode(packet);
+    values.push_back(static_cast<IMC::Temperature*>(msg)->value);
+    IMC::Factory::recycle(msg);
+  }
+};
+
+static std::string
+createLog(void)
+{
+  std::string data;
+  IMC::Writer writer;
+
+  for (unsigned i = 0; i < c_packets; ++i)
+  {
+    writer.clear();
+    if (i % 2)
+    {
+      IMC::Temperature msg;
+      msg.value = i;
+      IMC::Packet::serialize(&msg, writer);
+    }
+    else
+    {
+      IMC::LogBookEntry msg;
+      msg.text = String::str("entry %u", i);
+      IMC::Packet::serialize(&msg, writer);
+    }
+
+    data.append(reinterpret_cast<const char*>(writer.getData()), writer.getSize());
+
+    // Garbage, as found in logs of interrupted writes.
+    if (i == 5000)
+      data.append("\x54\xfe\x01garbage\x54", 11);
+  }
+
+  return data;
+}
+
+static void
+testReader(Test& test, const std::string& name, const std::string& path)
+{
+  IMC::LogReader reader(path);
+  reader.addFilter(IMC::Temperature::getIdStatic());
+
+  // Sequential.
+  Collector seq;
+  IMC::LogReader::PacketView packet;
+  size_t offset = 0;
+  while (reader.next(offset, reader.getSize(), packet))
+    seq.onPacket(reader, packet);
+
+  bool ordered = seq.values.size() == c_packets / 2;
+  for (size_t i = 0; ordered && i < seq.values.size(); ++i)
+    ordered = seq.values[i] == 2 * i + 1;
+
+  test.boolean((name + ": sequential").c_str(), ordered);
+  test.boolean((name + ": filter").c_str(), seq.packets == c_packets / 2);
+
+  // Parallel.
+  for (unsigned threads = 1; threads <= 8; threads *= 2)
+  {
+    std::vector<Collector> collectors(threads);
+    std::vector<IMC::LogReader::Handler*> handlers;
+    for (unsigned i = 0; i < threads; ++i)
+      handlers.push_back(&collectors[i]);
+
+    reader.process(handlers);
+
+    std::vector<double> merged;
+    for (unsigned i = 0; i < threads; ++i)
+      merged.insert(merged.end(), collectors[i].values.begin(), collectors[i].values.end());
+
+    test.boolean(String::str("%s: parallel (%u threads)", name.c_str(), threads).c_str(),
+                 merged == seq.values);
+  }
+
+  // Ranges start at packet boundaries.
+  std::vector<IMC::LogReader::Range> ranges = reader.split(7);
+  bool aligned = ranges.front().begin == 0 && ranges.back().end == reader.getSize();
+  for (size_t i = 1; i < ranges.size(); ++i)
+  {
+    aligned = aligned && ranges[i].begin == ranges[i - 1].end;
+    offset = ranges[i].begin;
+    reader.clearFilter();
+    aligned = aligned && (!reader.next(offset, ranges[i].end, packet) || packet.offset == ranges[i].begin);
+  }
+
+  test.boolean((name + ": split").c_str(), aligned);
+}
+
+int
+main(void)
+{
+  Test test("DUNE::IMC::LogReader");
+
+#if defined(DUNE_OS_POSIX)
+  Path tmp("/tmp");
+#elif defined(DUNE_OS_WINDOWS)
+  Path tmp("c:/");
+#endif
+
+  std::string base = (tmp / String::str("dune_test_log_reader_%u", (unsigned)Time::Clock::getSinceEpochNsec() % 100000)).str();
+  std::string data = createLog();
+
+  {
+    std::ofstream ofs((base + ".lsf").c_str(), std::ios::binary);
+    ofs.write(data.data(), data.size());
+  }
+
+  {
+    Compression::FileOutput ofs((base + ".lsf.gz").c_str(), METHOD_GZIP);
+    ofs.write(data.data(), data.size());
+  }
+
+  {
+    IMC::LogReader reader(base + ".lsf");
+#if defined(DUNE_SYS_HAS_MMAP)
+    test.boolean("uncompressed: mapped", reader.isMapped());
+#endif
+    test.boolean("uncompressed: size", reader.getSize() == data.size());
+  }
+
+#if defined(DUNE_SYS_HAS_MMAP)
+  test.boolean("uncompressed: memory usage", IMC::LogReader::getMemoryUsage(base + ".lsf") == 0);
+#endif
+  test.boolean("gzip: memory usage", IMC::LogReader::getMemoryUsage(base + ".lsf.gz") >= data.size());
+
+  testReader(test, "uncompressed", base + ".lsf");
+  testReader(test, "gzip", base + ".lsf.gz");
+
+  Path(base + ".lsf").remove();
+  Path(base + ".lsf.gz").remove();
+
+  return 0;
+}
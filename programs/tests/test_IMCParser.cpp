@@ -0,0 +1,166 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Append a serialized message to a stream.
+static void
+append(std::vector<uint8_t>& stream, const IMC::Message& msg)
+{
+  Utils::ByteBuffer bfr;
+  uint16_t n = IMC::Packet::serialize(&msg, bfr);
+  stream.insert(stream.end(), bfr.getBuffer(), bfr.getBuffer() + n);
+}
+
+//! Build a stream with valid frames, noise and a corrupted frame.
+static std::vector<uint8_t>
+makeStream(unsigned& frames)
+{
+  std::vector<uint8_t> stream;
+  frames = 0;
+
+  for (unsigned i = 0; i < 200; ++i)
+  {
+    IMC::EntityState es;
+    es.state = i % 5;
+    es.description.assign(i * 7 % 300, 'x');
+    append(stream, es);
+    ++frames;
+
+    if (i % 10 == 3)
+    {
+      // Noise with stray synchronization bytes.
+      uint8_t noise[] = {0xfe, 0x00, 0x54, 0x54, 0x00, 0xfe, 0xfe, 0x12};
+      stream.insert(stream.end(), noise, noise + sizeof(noise));
+    }
+
+    if (i % 10 == 7)
+    {
+      // Frame with a bad CRC.
+      IMC::Heartbeat hb;
+      size_t start = stream.size();
+      append(stream, hb);
+      stream[start + DUNE_IMC_CONST_HEADER_SIZE - 1] ^= 0xff;
+    }
+  }
+
+  IMC::Abort abort;
+  append(stream, abort);
+  ++frames;
+
+  return stream;
+}
+
+//! Parse a stream byte by byte.
+static std::vector<uint16_t>
+parseBytes(const std::vector<uint8_t>& stream)
+{
+  std::vector<uint16_t> ids;
+  IMC::Parser parser;
+  for (size_t i = 0; i < stream.size(); ++i)
+  {
+    IMC::Message* m = parser.parse(stream[i]);
+    if (m != NULL)
+    {
+      ids.push_back(m->getId());
+      delete m;
+    }
+  }
+  return ids;
+}
+
+//! Parse a stream in chunks.
+static std::vector<uint16_t>
+parseChunks(const std::vector<uint8_t>& stream, size_t chunk, size_t& count)
+{
+  std::vector<uint16_t> ids;
+  IMC::Parser parser;
+  count = 0;
+  for (size_t i = 0; i < stream.size(); i += chunk)
+  {
+    size_t n = std::min(chunk, stream.size() - i);
+    count += parser.parse(&stream[i], n, [&ids](IMC::Message* m)
+    {
+      ids.push_back(m->getId());
+      delete m;
+    });
+  }
+  return ids;
+}
+
+int
+main(void)
+{
+  Test test("IMC::Parser");
+
+  unsigned frames = 0;
+  std::vector<uint8_t> stream = makeStream(frames);
+
+  std::vector<uint16_t> expected = parseBytes(stream);
+  test.boolean("byte parser finds all frames", expected.size() == frames);
+
+  size_t chunks[] = {1, 2, 3, 7, 21, 22, 23, 100, 1000, 65536, stream.size()};
+  for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); ++i)
+  {
+    size_t count = 0;
+    std::vector<uint16_t> ids = parseChunks(stream, chunks[i], count);
+    std::string name = Utils::String::str("chunks of %u bytes", (unsigned)chunks[i]);
+    test.boolean(name.c_str(), ids == expected && count == ids.size());
+  }
+
+  {
+    // Message split across calls keeps its contents.
+    IMC::EntityState es;
+    es.state = 3;
+    es.description = "split";
+    std::vector<uint8_t> data;
+    append(data, es);
+
+    IMC::Parser parser;
+    IMC::EntityState* out = NULL;
+    IMC::Parser::Callback cb = [&out](IMC::Message* m)
+    {
+      out = static_cast<IMC::EntityState*>(m);
+    };
+    size_t first = parser.parse(&data[0], 10, cb);
+    size_t second = parser.parse(&data[10], data.size() - 10, cb);
+    test.boolean("split message", first == 0 && second == 1 && out != NULL
+                 && out->description == "split" && out->state == 3);
+    delete out;
+  }
+
+  return test.getReturnValue();
+}
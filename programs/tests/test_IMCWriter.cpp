@@ -0,0 +1,140 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <sstream>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+static IMC::PlanSpecification
+createPlan(unsigned maneuvers)
+{
+  IMC::PlanSpecification spec;
+  spec.plan_id = "writer";
+  spec.setSource(0x1234);
+  spec.setTimeStamp(1.5);
+
+  for (unsigned i = 0; i < maneuvers; ++i)
+  {
+    IMC::PlanManeuver pm;
+    pm.maneuver_id = String::str("goto%u", i);
+
+    IMC::Goto man;
+    man.lat = 0.1 * i;
+    man.z = i;
+    pm.data.set(man);
+
+    IMC::SetEntityParameters sep;
+    sep.name = "Entity";
+    pm.start_actions.push_back(sep);
+
+    spec.maneuvers.push_back(pm);
+  }
+
+  return spec;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::IMC::Writer");
+
+  IMC::EstimatedState state;
+  state.setSource(0x4321);
+  state.setTimeStamp(2.5);
+  state.x = 10.0;
+
+  IMC::PlanSpecification plan = createPlan(20);
+  IMC::PlanSpecification large = createPlan(600);
+
+  // Reference serialization.
+  Utils::ByteBuffer ref_state;
+  Utils::ByteBuffer ref_plan;
+  IMC::Packet::serialize(&state, ref_state);
+  IMC::Packet::serialize(&plan, ref_plan);
+
+  test.boolean("nested size", ref_plan.getSize() == plan.getSerializationSize());
+
+  IMC::Writer writer(16);
+  uint16_t n0 = IMC::Packet::serialize(&state, writer);
+  uint16_t n1 = IMC::Packet::serialize(&plan, writer);
+  uint16_t n2 = IMC::Packet::serialize(&state, writer);
+
+  test.boolean("packet count", writer.getCount() == 3);
+  test.boolean("packet sizes", writer.getPacketSize(0) == n0
+               && writer.getPacketSize(1) == n1
+               && writer.getPacketSize(2) == n2);
+  test.boolean("total size", writer.getSize() == (size_t)n0 + n1 + n2);
+  test.boolean("same bytes as buffer serialization",
+               n0 == ref_state.getSize()
+               && n1 == ref_plan.getSize()
+               && std::memcmp(writer.getPacketData(0), ref_state.getBuffer(), n0) == 0
+               && std::memcmp(writer.getPacketData(1), ref_plan.getBuffer(), n1) == 0
+               && std::memcmp(writer.getPacketData(2), ref_state.getBuffer(), n2) == 0);
+
+  IMC::Message* msg = IMC::Packet::deserialize(writer.getPacketData(1), writer.getPacketSize(1));
+  test.boolean("deserialize nested", msg != NULL && *msg == plan);
+  delete msg;
+
+  // Memory is reused after clearing.
+  writer.clear();
+  IMC::Packet::serialize(&state, writer);
+  test.boolean("clear", writer.getCount() == 1 && writer.getSize() == n0);
+
+  // Output stream serialization of small and large messages.
+  std::ostringstream os;
+  IMC::Packet::serialize(&state, os);
+  IMC::Packet::serialize(&large, os);
+  std::string data = os.str();
+  std::istringstream is(data);
+  IMC::Message* m0 = IMC::Packet::deserialize(is);
+  IMC::Message* m1 = IMC::Packet::deserialize(is);
+  test.boolean("stream", m0 != NULL && m1 != NULL && *m0 == state && *m1 == large);
+  delete m0;
+  delete m1;
+
+  // Committing more than was reserved is an error.
+  writer.clear();
+  writer.reserve(8);
+  bool thrown = false;
+  try
+  {
+    writer.commit(9);
+  }
+  catch (IMC::InternalBufferTooShort&)
+  {
+    thrown = true;
+  }
+  test.boolean("commit overflow", thrown && writer.getCount() == 0);
+
+  return test.getReturnValue();
+}
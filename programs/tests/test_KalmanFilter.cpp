@@ -0,0 +1,212 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Math::Matrix;
+using DUNE::Navigation::KalmanFilter;
+
+//! Number of states.
+static const short c_states = 9;
+//! Number of outputs.
+static const short c_outputs = 8;
+
+//! Set up a filter with a constant model and pseudo-random observations.
+static void
+setup(KalmanFilter& kal, KalmanFilter::UpdateMode mode)
+{
+  kal.reset(c_states, c_outputs);
+  kal.setUpdateMode(mode);
+
+  Matrix a(c_states, c_states, 0.0);
+  for (short i = 0; i < c_states; ++i)
+  {
+    a(i, i) = 1.0;
+    if (i + 1 < c_states)
+      a(i, i + 1) = 0.1;
+
+    kal.setState(i, std::cos(i * 0.5));
+    kal.setProcessNoise(i, 0.01 * (i + 1));
+    kal.setCovariance(i, 1.0 + 0.1 * i);
+  }
+
+  kal.setTransitions(a);
+
+  for (short o = 0; o < c_outputs; ++o)
+  {
+    kal.setMeasurementNoise(o, 0.05 * (o + 1));
+    for (short j = 0; j < c_states; ++j)
+    {
+      if ((o + j) % 3 == 0)
+        kal.setObservation(o, j, std::sin(o * 1.7 + j * 0.3));
+    }
+  }
+}
+
+static void
+setInnovations(KalmanFilter& kal, unsigned step)
+{
+  for (short o = 0; o < c_outputs; ++o)
+    kal.setInnovation(o, 0.2 * std::sin(step * 0.37 + o));
+}
+
+static bool
+almostEqual(const Matrix& a, const Matrix& b, double tolerance = 1e-9)
+{
+  return (a - b).norm_2() <= tolerance * (1.0 + b.norm_2());
+}
+
+static bool
+isSymmetric(const Matrix& m)
+{
+  for (int i = 0; i < m.rows(); ++i)
+    for (int j = 0; j < m.columns(); ++j)
+      if (m(i, j) != m(j, i))
+        return false;
+  return true;
+}
+
+int
+main(void)
+{
+  Test test("Navigation::KalmanFilter");
+
+  {
+    KalmanFilter batch;
+    KalmanFilter sequential;
+    KalmanFilter ud;
+    setup(batch, KalmanFilter::UPDATE_BATCH);
+    setup(sequential, KalmanFilter::UPDATE_SEQUENTIAL);
+    setup(ud, KalmanFilter::UPDATE_UD);
+
+    bool state = true;
+    bool covariance = true;
+    bool symmetric = true;
+    for (unsigned step = 0; step < 50; ++step)
+    {
+      batch.predict();
+      sequential.predict();
+      ud.predict();
+      setInnovations(batch, step);
+      setInnovations(sequential, step);
+      setInnovations(ud, step);
+      batch.update(0.0);
+      sequential.update(0.0);
+      ud.update(0.0);
+
+      state = state && almostEqual(sequential.getState(), batch.getState())
+      && almostEqual(ud.getState(), batch.getState());
+      covariance = covariance && almostEqual(sequential.getCovariance(), batch.getCovariance())
+      && almostEqual(ud.getCovariance(), batch.getCovariance());
+      symmetric = symmetric && isSymmetric(sequential.getCovariance())
+      && isSymmetric(ud.getCovariance());
+    }
+
+    test.boolean("sequential and U-D state match batch", state);
+    test.boolean("sequential and U-D P match batch", covariance);
+    test.boolean("sequential and U-D P symmetric", symmetric);
+  }
+
+  {
+    // One outlier: batch rejects everything, sequential only the outlier.
+    KalmanFilter batch;
+    KalmanFilter sequential;
+    KalmanFilter reference;
+    setup(batch, KalmanFilter::UPDATE_BATCH);
+    setup(sequential, KalmanFilter::UPDATE_SEQUENTIAL);
+    setup(reference, KalmanFilter::UPDATE_BATCH);
+    setInnovations(batch, 1);
+    setInnovations(sequential, 1);
+    setInnovations(reference, 1);
+    batch.setInnovation(3, 100.0);
+    sequential.setInnovation(3, 100.0);
+
+    // The reference ignores output 3 altogether.
+    for (short j = 0; j < c_states; ++j)
+      reference.setObservation(3, j, 0.0);
+
+    Matrix x0 = batch.getState();
+    test.boolean("batch gating rejects update", batch.update(9.0) == -1);
+    test.boolean("batch gating keeps state", batch.getState() == x0);
+    test.boolean("sequential gating reports rejection", sequential.update(9.0) == -1);
+    test.boolean("sequential gating rejects one output", sequential.getRejectedCount() == 1);
+    reference.update(0.0);
+    test.boolean("sequential gating applies other outputs",
+                 almostEqual(sequential.getState(), reference.getState()));
+  }
+
+  {
+    // Correlated measurement noise falls back to the batch update.
+    KalmanFilter batch;
+    KalmanFilter sequential;
+    setup(batch, KalmanFilter::UPDATE_BATCH);
+    setup(sequential, KalmanFilter::UPDATE_SEQUENTIAL);
+    batch.setMeasurementNoise(0, 1, 0.01);
+    batch.setMeasurementNoise(1, 0, 0.01);
+    sequential.setMeasurementNoise(0, 1, 0.01);
+    sequential.setMeasurementNoise(1, 0, 0.01);
+    setInnovations(batch, 2);
+    setInnovations(sequential, 2);
+    batch.update(0.0);
+    sequential.update(0.0);
+    test.boolean("correlated noise uses batch update",
+                 sequential.getState() == batch.getState());
+  }
+
+  {
+    // Long run with nearly exact measurements: the U-D covariance must
+    // stay symmetric positive semi-definite.
+    KalmanFilter ud;
+    setup(ud, KalmanFilter::UPDATE_UD);
+    for (short o = 0; o < c_outputs; ++o)
+      ud.setMeasurementNoise(o, 1e-12);
+
+    bool psd = true;
+    for (unsigned step = 0; step < 20000; ++step)
+    {
+      ud.predict();
+      setInnovations(ud, step);
+      ud.update(0.0);
+
+      Matrix p = ud.getCovariance();
+      for (short i = 0; i < c_states; ++i)
+        psd = psd && p(i, i) >= 0.0;
+      psd = psd && isSymmetric(p);
+    }
+
+    test.boolean("U-D P stays symmetric and PSD", psd);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,342 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Periodic participant recording the time of each tick.
+class Ticker: public Concurrency::Thread
+{
+public:
+  Ticker(double period, unsigned count):
+    m_period(period),
+    m_count(count)
+  {
+    Time::Lockstep::attach();
+  }
+
+  std::vector<double> ticks;
+
+private:
+  double m_period;
+  unsigned m_count;
+
+  void
+  run(void)
+  {
+    Time::Lockstep::bind();
+    for (unsigned i = 0; i < m_count; ++i)
+    {
+      Time::Delay::wait(m_period);
+      ticks.push_back(Time::Clock::get());
+    }
+    Time::Lockstep::detach();
+  }
+};
+
+//! Participant waiting on a signal.
+class Listener: public Concurrency::Thread
+{
+public:
+  Listener(Time::Lockstep::Signal& signal, double timeout):
+    notified(false),
+    woken(0),
+    m_signal(signal),
+    m_timeout(timeout)
+  {
+    Time::Lockstep::attach();
+  }
+
+  bool notified;
+  double woken;
+
+private:
+  Time::Lockstep::Signal& m_signal;
+  double m_timeout;
+
+  void
+  run(void)
+  {
+    Time::Lockstep::bind();
+    notified = Time::Lockstep::wait(m_signal, m_timeout);
+    woken = Time::Clock::get();
+    Time::Lockstep::detach();
+  }
+};
+
+//! Participant that notifies a signal after a delay.
+class Notifier: public Concurrency::Thread
+{
+public:
+  Notifier(Time::Lockstep::Signal& signal, double delay):
+    m_signal(signal),
+    m_delay(delay)
+  {
+    Time::Lockstep::attach();
+  }
+
+private:
+  Time::Lockstep::Signal& m_signal;
+  double m_delay;
+
+  void
+  run(void)
+  {
+    Time::Lockstep::bind();
+    Time::Delay::wait(m_delay);
+    Time::Lockstep::notify(m_signal);
+    Time::Lockstep::detach();
+  }
+};
+
+//! Participant busy in real time before waiting.
+class Worker: public Concurrency::Thread
+{
+public:
+  Worker(void):
+    started(0),
+    finished(0)
+  {
+    Time::Lockstep::attach();
+  }
+
+  double started;
+  double finished;
+
+private:
+  void
+  run(void)
+  {
+    Time::Lockstep::bind();
+    started = Time::Clock::get();
+    // Busy for a while in real time.
+    double deadline = Time::Clock::getRT() + 0.2;
+    while (Time::Clock::getRT() < deadline)
+    { }
+    finished = Time::Clock::get();
+    Time::Lockstep::detach();
+  }
+};
+
+//! Participant waiting for I/O or a condition variable.
+class Poller: public Concurrency::Thread
+{
+public:
+  Poller(IO::Event* event, Time::Lockstep::Signal* signal, double timeout):
+    readable(false),
+    woken(0),
+    m_event(event),
+    m_signal(signal),
+    m_timeout(timeout)
+  {
+    Time::Lockstep::attach();
+  }
+
+  bool readable;
+  double woken;
+
+private:
+  IO::Event* m_event;
+  Time::Lockstep::Signal* m_signal;
+  double m_timeout;
+
+  void
+  run(void)
+  {
+    Time::Lockstep::bind(m_signal);
+    if (m_event != NULL)
+    {
+      readable = IO::Poll::poll(*m_event, m_timeout);
+    }
+    else
+    {
+      Concurrency::Condition cond;
+      cond.lock();
+      readable = cond.wait(m_timeout);
+      cond.unlock();
+    }
+    woken = Time::Clock::get();
+    Time::Lockstep::detach();
+  }
+};
+
+//! Test if all ticks are multiples of the period.
+static bool
+onSchedule(const std::vector<double>& ticks, double start, double period)
+{
+  for (size_t i = 0; i < ticks.size(); ++i)
+  {
+    if (std::fabs(ticks[i] - start - (i + 1) * period) > 1e-6)
+      return false;
+  }
+  return true;
+}
+
+int
+main(void)
+{
+  Test test("Time::Lockstep");
+
+  Time::Clock::setLockstep();
+  test.boolean("enabled", Time::Lockstep::isEnabled());
+
+  {
+    double start = Time::Clock::get();
+    double rt_start = Time::Clock::getRT();
+
+    Ticker a(0.1, 10000);
+    Ticker b(0.25, 4000);
+    a.start();
+    b.start();
+    a.join();
+    b.join();
+
+    test.boolean("fast ticker on schedule", a.ticks.size() == 10000 && onSchedule(a.ticks, start, 0.1));
+    test.boolean("slow ticker on schedule", b.ticks.size() == 4000 && onSchedule(b.ticks, start, 0.25));
+    test.boolean("virtual time elapsed", std::fabs(Time::Clock::get() - start - 1000.0) < 1e-6);
+    test.boolean("faster than real time", Time::Clock::getRT() - rt_start < 10.0);
+  }
+
+  {
+    Time::Lockstep::Signal signal;
+    double start = Time::Clock::get();
+
+    Listener listener(signal, 10.0);
+    Notifier notifier(signal, 2.0);
+    listener.start();
+    notifier.start();
+    listener.join();
+    notifier.join();
+
+    test.boolean("signal notified", listener.notified);
+    test.boolean("woken at notification time", std::fabs(listener.woken - start - 2.0) < 1e-6);
+  }
+
+  {
+    Time::Lockstep::Signal signal;
+    double start = Time::Clock::get();
+
+    Listener listener(signal, 3.0);
+    listener.start();
+    listener.join();
+
+    test.boolean("timeout", !listener.notified);
+    test.boolean("woken at timeout", std::fabs(listener.woken - start - 3.0) < 1e-6);
+  }
+
+  {
+    Time::Lockstep::Signal signal;
+    Time::Lockstep::notify(signal);
+    test.boolean("pending notification", Time::Lockstep::wait(signal, 1.0));
+  }
+
+  {
+    Worker worker;
+    Ticker ticker(1.0, 1);
+    ticker.start();
+    worker.start();
+    worker.join();
+    ticker.join();
+
+    test.boolean("time frozen while busy", worker.finished == worker.started);
+  }
+
+  {
+    double start = Time::Clock::get();
+    Time::Delay::wait(5.0);
+    test.boolean("passive wait", std::fabs(Time::Clock::get() - start - 5.0) < 1e-6);
+  }
+
+  {
+    IO::Event event;
+    double start = Time::Clock::get();
+    double rt_start = Time::Clock::getRT();
+
+    Poller poller(&event, NULL, 3.0);
+    Ticker ticker(1.0, 5);
+    poller.start();
+    ticker.start();
+    poller.join();
+    ticker.join();
+
+    test.boolean("I/O wait timeout", !poller.readable);
+    test.boolean("I/O wait in virtual time", std::fabs(poller.woken - start - 3.0) < 1e-6);
+    test.boolean("time advances during I/O wait", std::fabs(Time::Clock::get() - start - 5.0) < 1e-6);
+    test.boolean("I/O wait faster than real time", Time::Clock::getRT() - rt_start < 2.0);
+  }
+
+  {
+    IO::Event event;
+    Time::Lockstep::Signal signal;
+    double start = Time::Clock::get();
+
+    Poller poller(&event, &signal, 10.0);
+    Notifier notifier(signal, 2.0);
+    poller.start();
+    notifier.start();
+    poller.join();
+    notifier.join();
+
+    test.boolean("I/O wait ended by signal", std::fabs(poller.woken - start - 2.0) < 1e-6);
+  }
+
+  {
+    IO::Event event;
+    double start = Time::Clock::get();
+
+    Poller poller(&event, NULL, -1.0);
+    poller.start();
+    Time::Delay::waitRT(0.1);
+    event.signal();
+    poller.join();
+
+    test.boolean("I/O readable", poller.readable);
+    test.boolean("time frozen without deadlines", poller.woken == start);
+  }
+
+  {
+    double start = Time::Clock::get();
+
+    Poller poller(NULL, NULL, 4.0);
+    poller.start();
+    poller.join();
+
+    test.boolean("condition timeout", !poller.readable);
+    test.boolean("condition wait in virtual time", std::fabs(poller.woken - start - 4.0) < 1e-6);
+  }
+
+  return test.getReturnValue();
+}
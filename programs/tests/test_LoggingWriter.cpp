@@ -0,0 +1,250 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+#include <Transports/Logging/Writer.hpp>
+#include "Test.hpp"
+
+#if defined(DUNE_OS_LINUX)
+#  include <dirent.h>
+#endif
+
+using DUNE_NAMESPACES;
+
+//! Number of packets in the test log.
+static const unsigned c_packets = 5000;
+//! Size of the writer buffers.
+static const size_t c_buffer_size = 16 * 1024;
+
+//! Serialize the packets of the test log.
+//! @param[out] packets serialized packets.
+static void
+createPackets(std::vector<std::string>& packets)
+{
+  IMC::Writer writer;
+
+  for (unsigned i = 0; i < c_packets; ++i)
+  {
+    IMC::Temperature msg;
+    msg.setTimeStamp(1000.0 + i * 0.1);
+    msg.value = i;
+
+    writer.clear();
+    IMC::Packet::serialize(&msg, writer);
+    packets.push_back(std::string(reinterpret_cast<const char*>(writer.getData()), writer.getSize()));
+  }
+}
+
+//! Read a whole file.
+//! @param[in] path file path.
+//! @return file contents.
+static std::string
+readFile(const std::string& path)
+{
+  std::ifstream ifs(path.c_str(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+
+//! Wait for the writer to write all queued data.
+//! @param[in] writer log writer.
+//! @return true if all data was written.
+static bool
+waitWritten(Transports::Logging::Writer& writer)
+{
+  for (unsigned i = 0; i < 5000; ++i)
+  {
+    if (writer.getStatistics().queued == 0)
+      return true;
+    Time::Delay::wait(0.001);
+  }
+
+  return false;
+}
+
+#if defined(DUNE_OS_LINUX)
+//! Count the open file descriptors of the process.
+//! @return number of file descriptors.
+static unsigned
+countDescriptors(void)
+{
+  unsigned count = 0;
+  DIR* dir = opendir("/proc/self/fd");
+  if (dir == NULL)
+    return 0;
+
+  while (readdir(dir) != NULL)
+    ++count;
+
+  closedir(dir);
+  return count;
+}
+#endif
+
+static void
+testWriter(Test& test, const std::string& name, const std::string& path,
+           Compression::Methods method, const std::vector<std::string>& packets)
+{
+  std::string data;
+
+  {
+    Transports::Logging::Writer writer(path, method, true, c_buffer_size, 4 * c_buffer_size);
+
+    // Half the packets, several buffer swaps, then a sync.
+    for (unsigned i = 0; i < c_packets / 2; ++i)
+    {
+      writer.write(packets[i].data(), packets[i].size());
+      data += packets[i];
+    }
+
+    writer.sync();
+    bool synced = waitWritten(writer);
+    size_t size = readFile(path).size();
+    test.boolean((name + ": sync").c_str(), synced && size > 0
+                 && (method != METHOD_UNKNOWN || size == data.size()));
+
+    for (unsigned i = c_packets / 2; i < c_packets; ++i)
+    {
+      writer.write(packets[i].data(), packets[i].size());
+      data += packets[i];
+    }
+
+    std::string error;
+    test.boolean((name + ": no errors").c_str(), !writer.failed(error));
+  }
+
+  // Log contents.
+  {
+    IMC::LogReader reader(path);
+    test.boolean((name + ": log contents").c_str(),
+                 reader.getSize() == data.size()
+                 && std::memcmp(reader.getData(), data.data(), data.size()) == 0);
+  }
+
+  // Index contents.
+  {
+    IMC::LogIndex index;
+    index.load(path + IMC::LogIndex::c_extension);
+
+    uint64_t raw = 0;
+    uint64_t position = 0;
+    bool contiguous = true;
+    for (size_t i = 0; i < index.getBlockCount(); ++i)
+    {
+      const IMC::LogIndex::Block& block = index.getBlock(i);
+      contiguous = contiguous && block.position == position;
+      position += block.stored_size;
+      raw += block.raw_size;
+    }
+
+    test.boolean((name + ": index method").c_str(), index.getCompression() == method);
+    test.boolean((name + ": index entries").c_str(), index.getEntryCount() == c_packets);
+    test.boolean((name + ": index blocks").c_str(), index.getBlockCount() > 1 && contiguous
+                 && raw == data.size() && position == readFile(path).size());
+    test.boolean((name + ": index times").c_str(), index.getStartTime() == 1000.0
+                 && std::fabs(index.getEndTime() - (1000.0 + (c_packets - 1) * 0.1)) < 1e-6);
+  }
+
+  // Messages read through the index.
+  {
+    IMC::IndexedLogReader reader(path);
+    unsigned count = 0;
+    bool ordered = true;
+    IMC::Message* msg = NULL;
+    while ((msg = reader.next()) != NULL)
+    {
+      ordered = ordered && static_cast<IMC::Temperature*>(msg)->value == count;
+      ++count;
+      IMC::Factory::recycle(msg);
+    }
+
+    test.boolean((name + ": indexed read").c_str(), ordered && count == c_packets);
+  }
+}
+
+int
+main(void)
+{
+  Test test("Transports::Logging::Writer");
+
+#if defined(DUNE_OS_POSIX)
+  Path tmp("/tmp");
+#elif defined(DUNE_OS_WINDOWS)
+  Path tmp("c:/");
+#endif
+
+  std::string base = (tmp / String::str("dune_test_logging_writer_%u", (unsigned)Time::Clock::getSinceEpochNsec() % 100000)).str();
+
+  std::vector<std::string> packets;
+  createPackets(packets);
+
+  testWriter(test, "uncompressed", base + ".lsf", METHOD_UNKNOWN, packets);
+  testWriter(test, "gzip", base + ".lsf.gz", METHOD_GZIP, packets);
+
+  // A failed constructor releases the log file.
+  {
+    Path idx(base + "_fail.lsf" + IMC::LogIndex::c_extension);
+    idx.create();
+
+#if defined(DUNE_OS_LINUX)
+    unsigned fds = countDescriptors();
+#endif
+    bool thrown = false;
+    try
+    {
+      Transports::Logging::Writer writer(base + "_fail.lsf", METHOD_GZIP, true, c_buffer_size, c_buffer_size);
+    }
+    catch (std::runtime_error&)
+    {
+      thrown = true;
+    }
+
+    test.boolean("failed open: throws", thrown);
+#if defined(DUNE_OS_LINUX)
+    test.boolean("failed open: no descriptor leak", countDescriptors() == fds);
+#endif
+
+    idx.remove();
+    Path(base + "_fail.lsf").remove();
+  }
+
+  const char* paths[] = {".lsf", ".lsf.gz"};
+  for (unsigned i = 0; i < 2; ++i)
+  {
+    Path(base + paths[i]).remove();
+    Path(base + paths[i] + IMC::LogIndex::c_extension).remove();
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,151 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Concurrency;
+
+typedef MPSCQueue<unsigned> Queue;
+
+//! Number of producer threads.
+static const unsigned c_producers = 4;
+//! Number of elements pushed by each producer.
+static const unsigned c_count = 100000;
+
+class Producer: public Thread
+{
+public:
+  Producer(Queue& queue, unsigned id):
+    m_queue(queue),
+    m_id(id)
+  { }
+
+  void
+  run(void)
+  {
+    for (unsigned i = 0; i < c_count; ++i)
+      m_queue.push((m_id << 24) | (i + 1));
+  }
+
+private:
+  Queue& m_queue;
+  unsigned m_id;
+};
+
+int
+main(void)
+{
+  Test test("Concurrency::MPSCQueue");
+
+  {
+    Queue queue(5, Queue::OP_DROP_NEWEST);
+    test.boolean("capacity rounded to power of two", queue.capacity() == 8);
+
+    for (unsigned i = 1; i <= 10; ++i)
+      queue.push(i);
+
+    unsigned v = 0;
+    queue.pop(v);
+    test.boolean("drop newest: keeps oldest", v == 1);
+    test.boolean("drop newest: counters", queue.getDropped() == 2 && queue.getPushed() == 8);
+  }
+
+  {
+    Queue queue(8, Queue::OP_DROP_OLDEST);
+    for (unsigned i = 1; i <= 10; ++i)
+      queue.push(i);
+
+    unsigned v[16];
+    size_t n = queue.popBatch(v, 16);
+    test.boolean("drop oldest: keeps newest", n == 8 && v[0] == 3 && v[7] == 10);
+    test.boolean("drop oldest: counters", queue.getDropped() == 2 && queue.getHighWater() == 8);
+    test.boolean("empty after drain", queue.empty());
+  }
+
+  {
+    Queue queue(4, Queue::OP_BLOCK);
+    queue.setBlockTimeout(0.1);
+    for (unsigned i = 1; i <= 5; ++i)
+      queue.push(i);
+
+    test.boolean("block: times out and drops", queue.getDropped() == 1 && queue.size() == 4);
+    test.boolean("wait for items", queue.waitForItems(0.1));
+  }
+
+  {
+    Queue queue(1024, Queue::OP_BLOCK);
+    queue.setBlockTimeout(10.0);
+
+    std::vector<Producer*> producers;
+    for (unsigned i = 0; i < c_producers; ++i)
+    {
+      producers.push_back(new Producer(queue, i));
+      producers.back()->start();
+    }
+
+    std::vector<unsigned> last(c_producers, 0);
+    unsigned received = 0;
+    bool ordered = true;
+    unsigned batch[64];
+
+    while (received < c_producers * c_count)
+    {
+      if (!queue.waitForItems(1.0))
+        break;
+
+      size_t n = queue.popBatch(batch, 64);
+      for (size_t i = 0; i < n; ++i)
+      {
+        unsigned id = batch[i] >> 24;
+        unsigned seq = batch[i] & 0xffffff;
+        ordered = ordered && (seq == last[id] + 1);
+        last[id] = seq;
+      }
+
+      received += n;
+    }
+
+    for (unsigned i = 0; i < c_producers; ++i)
+    {
+      producers[i]->stopAndJoin();
+      delete producers[i];
+    }
+
+    test.boolean("multiple producers: all received", received == c_producers * c_count);
+    test.boolean("multiple producers: per-producer order", ordered);
+    test.boolean("multiple producers: nothing dropped", queue.getDropped() == 0);
+  }
+
+  return test.getReturnValue();
+}
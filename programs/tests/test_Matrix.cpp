@@ -0,0 +1,167 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Math::Matrix;
+
+static Matrix
+sample(size_t r, size_t c, double seed)
+{
+  Matrix m(r, c);
+  for (size_t i = 0; i < r; ++i)
+    for (size_t j = 0; j < c; ++j)
+      m(i, j) = std::sin(seed + i * 1.3 + j * 0.7);
+  return m;
+}
+
+//! Reference product, element by element.
+static Matrix
+naive(const Matrix& a, const Matrix& b)
+{
+  Matrix s(a.rows(), b.columns(), 0.0);
+  for (int i = 0; i < a.rows(); ++i)
+    for (int j = 0; j < b.columns(); ++j)
+      for (int k = 0; k < a.columns(); ++k)
+        s(i, j) += a(i, k) * b(k, j);
+  return s;
+}
+
+static bool
+almostEqual(const Matrix& a, const Matrix& b)
+{
+  if (a.rows() != b.rows() || a.columns() != b.columns())
+    return false;
+
+  return (a - b).norm_2() <= 1e-9 * (1.0 + b.norm_2());
+}
+
+int
+main(void)
+{
+  Test test("Math::Matrix");
+
+  {
+    // Sizes around and across the block size.
+    const size_t sizes[][3] = {{1, 1, 1}, {3, 3, 3}, {5, 7, 2}, {64, 64, 64},
+                               {70, 130, 65}, {129, 3, 200}};
+
+    bool product = true;
+    bool into = true;
+    bool gemm_t = true;
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+    {
+      Matrix a = sample(sizes[s][0], sizes[s][1], 0.1 * s);
+      Matrix b = sample(sizes[s][1], sizes[s][2], 0.3 * s);
+      Matrix expected = naive(a, b);
+
+      product = product && almostEqual(a * b, expected);
+
+      Matrix c;
+      Matrix::multiplyInto(a, b, c);
+      into = into && almostEqual(c, expected);
+
+      // 2 * transpose(transpose(a)) * transpose(transpose(b)) - c
+      Matrix at = transpose(a);
+      Matrix bt = transpose(b);
+      Matrix::gemm(2.0, at, true, bt, true, -1.0, c);
+      gemm_t = gemm_t && almostEqual(c, expected);
+    }
+
+    test.boolean("operator*", product);
+    test.boolean("multiplyInto", into);
+    test.boolean("gemm with transposes", gemm_t);
+  }
+
+  {
+    Matrix c(2, 3, 1.0);
+    bool thrown = false;
+    try
+    {
+      Matrix::gemm(1.0, sample(3, 3, 0.5), false, sample(3, 3, 0.6), false, 1.0, c);
+    }
+    catch (Matrix::Error&)
+    {
+      thrown = true;
+    }
+    test.boolean("gemm accumulate into wrong size throws", thrown);
+  }
+
+  {
+    Matrix a = sample(6, 6, 0.4);
+    Matrix b = sample(6, 6, 0.8);
+    Matrix c = a;
+    Matrix::multiplyInto(c, b, c);
+    test.boolean("multiplyInto aliased", almostEqual(c, naive(a, b)));
+
+    Matrix shared = a;
+    Matrix::multiplyInto(b, b, shared);
+    test.boolean("multiplyInto keeps shared data", a == sample(6, 6, 0.4));
+
+    Matrix t;
+    Matrix::transposeInto(sample(4, 9, 0.2), t);
+    test.boolean("transposeInto", t == transpose(sample(4, 9, 0.2)));
+  }
+
+  {
+    Matrix a = sample(5, 8, 0.6);
+    Matrix p = sample(8, 8, 0.7);
+    Matrix q = sample(5, 5, 0.2);
+    Matrix expected = a * p * transpose(a) + q;
+
+    Matrix c;
+    Matrix::quadraticInto(a, p, q, c);
+    test.boolean("quadraticInto", almostEqual(c, expected));
+
+    Matrix::quadraticInto(a, p, Matrix(), c);
+    test.boolean("quadraticInto without q", almostEqual(c, a * p * transpose(a)));
+
+    c = q;
+    Matrix::quadraticInto(a, p, c, c);
+    test.boolean("quadraticInto accumulate", almostEqual(c, expected));
+
+    bool thrown = false;
+    try
+    {
+      Matrix::quadraticInto(p, p, Matrix(), p);
+    }
+    catch (Matrix::Error& e)
+    {
+      thrown = true;
+    }
+    test.boolean("quadraticInto aliased throws", thrown);
+  }
+
+  return test.getReturnValue();
+}
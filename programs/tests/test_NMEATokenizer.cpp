@@ -0,0 +1,181 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using DUNE::Parsers::NMEATokenizer;
+
+//! Sentence handlers used to test the dispatcher.
+struct Handlers
+{
+  std::string last;
+
+  void
+  onGGA(const NMEATokenizer& stn)
+  {
+    last = "GGA:" + stn.getTalker().str();
+  }
+
+  void
+  onPUBX(const NMEATokenizer& stn)
+  {
+    last = "PUBX:" + stn[1].str();
+  }
+
+  void
+  onOther(const NMEATokenizer& stn)
+  {
+    last = stn.getSentence().str();
+  }
+};
+
+int
+main(void)
+{
+  Test test("Parsers::NMEATokenizer");
+
+  {
+    NMEATokenizer stn;
+    std::string gga = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+    test.boolean("valid sentence", stn.parse(gga) == NMEATokenizer::ST_OK);
+    test.boolean("field count", stn.size() == 15);
+    test.boolean("code", stn.getCode() == "GPGGA");
+    test.boolean("talker", stn.getTalker() == "GP");
+    test.boolean("sentence", stn.getSentence() == "GGA");
+    test.boolean("fields", stn[3] == "N" && stn[13].empty() && stn[14].empty());
+    test.boolean("checksum", stn.hasChecksum() && stn.getReceivedChecksum() == 0x47);
+
+    double lat = 0;
+    unsigned sats = 0;
+    float alt = 0;
+    test.boolean("read real", stn.read(2, lat) && lat == 4807.038);
+    test.boolean("read integer", stn.read(7, sats) && sats == 8);
+    test.boolean("read float", stn.read(9, alt) && alt == 545.4f);
+    test.boolean("read empty field fails", !stn.read(13, lat) && lat == 4807.038);
+    test.boolean("read past last field fails", !stn.read(15, lat));
+  }
+
+  {
+    NMEATokenizer stn;
+    test.boolean("leading noise", stn.parse("xx$GPHDT,274.07,T*03") == NMEATokenizer::ST_OK && stn.size() == 3);
+    test.boolean("checksum mismatch", stn.parse("$GPHDT,274.07,T*04") == NMEATokenizer::ST_CHECKSUM_MISMATCH);
+    test.boolean("computed checksum", stn.getComputedChecksum() == 0x03);
+    test.boolean("malformed checksum", stn.parse("$GPHDT,274.07,T*0") == NMEATokenizer::ST_INVALID_CHECKSUM);
+    test.boolean("data after checksum", stn.parse("$GPHDT,274.07,T*03xx") == NMEATokenizer::ST_INVALID_CHECKSUM);
+    test.boolean("no checksum", stn.parse("$GPHDT,274.07,T \r\n") == NMEATokenizer::ST_OK
+                 && !stn.hasChecksum() && stn[2] == "T");
+    test.boolean("no start", stn.parse("GPHDT,274.07,T*03") == NMEATokenizer::ST_NO_START);
+    test.boolean("no code", stn.parse("$,1,2") == NMEATokenizer::ST_NO_CODE);
+    test.boolean("encapsulated sentence", stn.parse("!AIVDM,1,1,,B,15M67FC000G?ufbE`FepT@3n00Sa,0*5C") == NMEATokenizer::ST_OK
+                 && stn.getTalker() == "AI" && stn.getSentence() == "VDM");
+    test.boolean("proprietary sentence", stn.parse("$PUBX,00,1") == NMEATokenizer::ST_OK
+                 && stn.getTalker().empty() && stn.getSentence() == "PUBX");
+
+    std::string many = "$GPXXX";
+    for (unsigned i = 0; i < NMEATokenizer::c_max_fields; ++i)
+      many += ",1";
+    test.boolean("too many fields", stn.parse(many) == NMEATokenizer::ST_TOO_MANY_FIELDS);
+  }
+
+  {
+    NMEATokenizer::Field f;
+    int i = 0;
+    uint8_t u8 = 0;
+    double d = 0;
+
+    f.data = "-42"; f.size = 3;
+    test.boolean("negative integer", NMEATokenizer::toNumber(f, i) && i == -42);
+    test.boolean("negative to unsigned fails", !NMEATokenizer::toNumber(f, u8));
+    f.data = "256"; f.size = 3;
+    test.boolean("integer out of range fails", !NMEATokenizer::toNumber(f, u8));
+    f.data = "007"; f.size = 3;
+    test.boolean("leading zeros", NMEATokenizer::toNumber(f, u8) && u8 == 7);
+    f.data = "1.5"; f.size = 3;
+    test.boolean("real to integer fails", !NMEATokenizer::toNumber(f, i));
+    f.data = "-0.0005"; f.size = 7;
+    test.boolean("small real", NMEATokenizer::toNumber(f, d) && d == -0.0005);
+    f.data = "12."; f.size = 3;
+    test.boolean("trailing point", NMEATokenizer::toNumber(f, d) && d == 12.0);
+    f.data = "1.2.3"; f.size = 5;
+    test.boolean("two points fail", !NMEATokenizer::toNumber(f, d));
+    f.data = "-"; f.size = 1;
+    test.boolean("sign only fails", !NMEATokenizer::toNumber(f, d));
+
+    // Compare with the C library, up to 15 significant digits.
+    bool ok = true;
+    char bfr[32];
+    for (unsigned k = 0; k < 20000 && ok; ++k)
+    {
+      double v = (k * 7919.0 + 0.123456789) / (k % 7 + 1);
+      int n = std::snprintf(bfr, sizeof(bfr), "%.*f", k % 8, v);
+      f.data = bfr;
+      f.size = n;
+      ok = NMEATokenizer::toNumber(f, d) && d == std::strtod(bfr, NULL);
+    }
+    test.boolean("reals are correctly rounded", ok);
+  }
+
+  {
+    Handlers h;
+    Parsers::NMEADispatcher<Handlers> dispatcher(&h);
+    const char* ids[] = {"GGA", "VTG", "ZDA", "HDT", "HDM", "ROT", "RMC", "GSV", "PSAT", "PUBX"};
+    for (unsigned i = 0; i < sizeof(ids) / sizeof(ids[0]); ++i)
+      dispatcher.add(ids[i], &Handlers::onOther);
+    dispatcher.add("GGA", &Handlers::onGGA);
+    dispatcher.add("PUBX", &Handlers::onPUBX);
+
+    NMEATokenizer stn;
+    bool ok = true;
+    for (unsigned i = 0; i < sizeof(ids) / sizeof(ids[0]); ++i)
+    {
+      std::string line = std::string("$") + (ids[i][0] == 'P' ? "" : "GN") + ids[i] + ",00";
+      ok = ok && stn.parse(line) == NMEATokenizer::ST_OK && dispatcher.dispatch(stn);
+    }
+    test.boolean("all sentences dispatched", ok);
+
+    stn.parse("$GLGGA,1");
+    test.boolean("handler replaced", dispatcher.dispatch(stn) && h.last == "GGA:GL");
+    stn.parse("$PUBX,04");
+    test.boolean("proprietary handler", dispatcher.dispatch(stn) && h.last == "PUBX:04");
+    stn.parse("$GPGLL,1");
+    test.boolean("unknown sentence", !dispatcher.dispatch(stn));
+    stn.parse("$GPGG,1");
+    test.boolean("prefix is not matched", !dispatcher.dispatch(stn));
+  }
+
+  return test.getReturnValue();
+}
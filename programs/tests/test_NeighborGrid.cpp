@@ -0,0 +1,130 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Number of indexed points.
+static const unsigned c_points = 300;
+
+//! Find the points within range by testing all of them.
+static std::vector<unsigned>
+bruteForce(const std::vector<double>& xs, const std::vector<double>& ys,
+           double x, double y, double radius)
+{
+  std::vector<unsigned> ids;
+  for (unsigned i = 0; i < xs.size(); ++i)
+  {
+    double dx = xs[i] - x;
+    double dy = ys[i] - y;
+    if (dx * dx + dy * dy <= radius * radius)
+      ids.push_back(i);
+  }
+  return ids;
+}
+
+//! Compare the grid with the brute force search at every point.
+static bool
+matches(const Math::NeighborGrid& grid, const std::vector<double>& xs,
+        const std::vector<double>& ys, double radius)
+{
+  std::vector<unsigned> ids;
+  for (unsigned i = 0; i < xs.size(); ++i)
+  {
+    grid.query(xs[i], ys[i], radius, ids);
+    std::sort(ids.begin(), ids.end());
+    if (ids != bruteForce(xs, ys, xs[i], ys[i], radius))
+      return false;
+  }
+  return true;
+}
+
+int
+main(void)
+{
+  Test test("Math::NeighborGrid");
+
+  Math::Random::Generator* prng = Math::Random::Factory::create(Math::Random::Factory::c_default, 42);
+  std::vector<double> xs(c_points);
+  std::vector<double> ys(c_points);
+
+  Math::NeighborGrid grid(25.0);
+  for (unsigned i = 0; i < c_points; ++i)
+  {
+    xs[i] = (prng->uniform() - 0.5) * 1000.0;
+    ys[i] = (prng->uniform() - 0.5) * 1000.0;
+    grid.update(i, xs[i], ys[i]);
+  }
+
+  test.boolean("size", grid.size() == c_points);
+  test.boolean("query matches brute force", matches(grid, xs, ys, 25.0));
+  test.boolean("small radius", matches(grid, xs, ys, 3.0));
+  test.boolean("large radius", matches(grid, xs, ys, 400.0));
+
+  // Move every point a little, crossing cell boundaries.
+  for (unsigned step = 0; step < 20; ++step)
+  {
+    for (unsigned i = 0; i < c_points; ++i)
+    {
+      xs[i] += (prng->uniform() - 0.5) * 20.0;
+      ys[i] += (prng->uniform() - 0.5) * 20.0;
+      grid.update(i, xs[i], ys[i]);
+    }
+  }
+
+  test.boolean("size after updates", grid.size() == c_points);
+  test.boolean("query after updates", matches(grid, xs, ys, 25.0));
+
+  grid.setCellSize(60.0);
+  test.boolean("query after cell size change", matches(grid, xs, ys, 25.0));
+
+  std::vector<unsigned> ids;
+  grid.query(xs[0], ys[0], 0.0, ids);
+  test.boolean("zero radius finds self", ids.size() >= 1 && std::find(ids.begin(), ids.end(), 0u) != ids.end());
+
+  test.boolean("remove existing", grid.remove(0));
+  test.boolean("remove missing", !grid.remove(0));
+  grid.query(xs[0], ys[0], 0.0, ids);
+  test.boolean("removed entry not found", std::find(ids.begin(), ids.end(), 0u) == ids.end());
+  test.boolean("contains", !grid.contains(0) && grid.contains(1));
+
+  grid.clear();
+  test.boolean("clear", grid.size() == 0 && grid.query(0.0, 0.0, 1e6, ids) == 0);
+
+  delete prng;
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,208 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <fstream>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Tasks;
+using DUNE::Time::Clock;
+using DUNE::Time::Delay;
+
+class CountingJob: public PeriodicExecutor::Job
+{
+public:
+  CountingJob(double period, double duration = 0):
+    m_period(period),
+    m_duration(duration),
+    m_runs(0),
+    m_active(0),
+    m_reentered(false)
+  { }
+
+  double
+  getPeriod(void) const
+  {
+    return m_period;
+  }
+
+  void
+  runJob(void)
+  {
+    if (m_active.increment() > 1)
+      m_reentered = true;
+
+    if (m_duration > 0)
+      Delay::wait(m_duration);
+
+    m_runs.increment();
+    m_active.decrement();
+  }
+
+  unsigned
+  getRuns(void)
+  {
+    return m_runs.value();
+  }
+
+  bool
+  reentered(void) const
+  {
+    return m_reentered;
+  }
+
+private:
+  double m_period;
+  double m_duration;
+  DUNE::Concurrency::AtomicInteger m_runs;
+  DUNE::Concurrency::AtomicInteger m_active;
+  bool m_reentered;
+};
+
+class SharedTask: public Periodic
+{
+public:
+  SharedTask(Context& ctx):
+    Periodic("Shared", ctx),
+    acquisitions(0),
+    runs(0)
+  { }
+
+  unsigned acquisitions;
+  unsigned runs;
+
+  void
+  onResourceAcquisition(void)
+  {
+    // Fail once to exercise restarts on the executor.
+    if (++acquisitions == 1)
+      throw RestartNeeded("first acquisition", 0, false);
+  }
+
+  void
+  task(void)
+  {
+    ++runs;
+  }
+};
+
+//! Count threads of this process.
+//! @return number of threads or zero if unknown.
+static unsigned
+countThreads(void)
+{
+  std::ifstream ifs("/proc/self/status");
+  std::string line;
+  while (std::getline(ifs, line))
+  {
+    if (line.compare(0, 8, "Threads:") == 0)
+      return std::atoi(line.c_str() + 8);
+  }
+
+  return 0;
+}
+
+int
+main(void)
+{
+  Test test("Tasks::PeriodicExecutor");
+
+  {
+    PeriodicExecutor executor(2);
+    CountingJob fast(0.01);
+    CountingJob slow(0.1);
+    CountingJob busy(0.02, 0.05);
+
+    executor.add(&fast);
+    executor.add(&slow);
+    executor.add(&busy);
+    executor.add(&fast);
+    Delay::wait(1.0);
+
+    PeriodicExecutor::Statistics fast_stats;
+    PeriodicExecutor::Statistics busy_stats;
+    test.boolean("statistics available", executor.getStatistics(&fast, fast_stats)
+                 && executor.getStatistics(&busy, busy_stats));
+
+    executor.remove(&fast);
+    executor.remove(&slow);
+    executor.remove(&busy);
+
+    unsigned runs = fast.getRuns();
+    test.boolean("100 Hz job frequency", runs >= 80 && runs <= 101);
+    test.boolean("10 Hz job frequency", slow.getRuns() >= 8 && slow.getRuns() <= 10);
+    test.boolean("job is not re-entered", !busy.reentered());
+    test.boolean("busy job overruns", busy_stats.overruns > 0);
+    test.boolean("busy job run time", busy_stats.exec_mean >= 0.04);
+    test.boolean("jitter is measured", fast_stats.runs > 0 && fast_stats.jitter_max >= 0.0);
+
+    Delay::wait(0.1);
+    test.boolean("removed job does not run", fast.getRuns() == runs);
+    test.boolean("statistics of removed job", !executor.getStatistics(&fast, fast_stats));
+  }
+
+  {
+    // Remove while running.
+    PeriodicExecutor executor(1);
+    CountingJob busy(0.01, 0.2);
+    executor.add(&busy);
+    Delay::wait(0.05);
+    executor.remove(&busy);
+    unsigned runs = busy.getRuns();
+    test.boolean("remove waits for running job", runs == 1);
+  }
+
+  {
+    // Periodic task on the shared executor of its context.
+    Context ctx;
+    ctx.config.set("Shared", "Shared Executor", "true");
+    ctx.config.set("Shared", "Execution Frequency", "50");
+
+    SharedTask task(ctx);
+    task.loadConfig();
+    unsigned threads = countThreads();
+    task.start();
+    Delay::wait(0.5);
+    unsigned started = countThreads();
+    task.stopAndJoin();
+
+    test.boolean("shared task has no thread",
+                 started == threads + ctx.executor.getWorkerCount() || threads == 0);
+    test.boolean("shared task restarts", task.acquisitions == 2);
+    test.boolean("shared task runs", task.runs >= 15 && task.runs <= 26);
+    test.boolean("shared task stops", task.isDead());
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,403 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+
+// POSIX headers.
+#include <unistd.h>
+#include <fcntl.h>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Reads everything available on a non-blocking pipe.
+class Reader: public IO::Reactor::Handler
+{
+public:
+  Reader(double delay = 0.0):
+    m_delay(delay),
+    m_bytes(0),
+    m_calls(0),
+    m_reentered(false),
+    m_busy(false)
+  { }
+
+  void
+  onReadable(IO::NativeHandle handle)
+  {
+    m_lock.lock();
+    if (m_busy)
+      m_reentered = true;
+    m_busy = true;
+    m_lock.unlock();
+
+    if (m_delay > 0)
+      Time::Delay::wait(m_delay);
+
+    char bfr[64];
+    unsigned bytes = 0;
+    ssize_t rv;
+    while ((rv = read(handle, bfr, sizeof(bfr))) > 0)
+      bytes += rv;
+
+    m_lock.lock();
+    m_bytes += bytes;
+    ++m_calls;
+    m_busy = false;
+    m_lock.unlock();
+  }
+
+  unsigned
+  getBytes(void)
+  {
+    Concurrency::ScopedMutex l(m_lock);
+    return m_bytes;
+  }
+
+  unsigned
+  getCalls(void)
+  {
+    Concurrency::ScopedMutex l(m_lock);
+    return m_calls;
+  }
+
+  bool
+  isBusy(void)
+  {
+    Concurrency::ScopedMutex l(m_lock);
+    return m_busy;
+  }
+
+  bool
+  reentered(void)
+  {
+    Concurrency::ScopedMutex l(m_lock);
+    return m_reentered;
+  }
+
+private:
+  double m_delay;
+  unsigned m_bytes;
+  unsigned m_calls;
+  bool m_reentered;
+  bool m_busy;
+  Concurrency::Mutex m_lock;
+};
+
+//! Stops watching its handle at end of file.
+class Closer: public IO::Reactor::Handler
+{
+public:
+  Closer(IO::Reactor& reactor):
+    m_reactor(reactor),
+    m_closed(false)
+  { }
+
+  void
+  onReadable(IO::NativeHandle handle)
+  {
+    char bfr[64];
+    ssize_t rv;
+    while ((rv = read(handle, bfr, sizeof(bfr))) > 0)
+    { }
+
+    if (rv == 0)
+    {
+      m_reactor.remove(handle);
+      Concurrency::ScopedMutex l(m_lock);
+      m_closed = true;
+    }
+  }
+
+  bool
+  isClosed(void)
+  {
+    Concurrency::ScopedMutex l(m_lock);
+    return m_closed;
+  }
+
+private:
+  IO::Reactor& m_reactor;
+  bool m_closed;
+  Concurrency::Mutex m_lock;
+};
+
+//! Throws after reading what is available.
+class Thrower: public IO::Reactor::Handler
+{
+public:
+  Thrower(void):
+    m_calls(0)
+  { }
+
+  void
+  onReadable(IO::NativeHandle handle)
+  {
+    char bfr[64];
+    while (read(handle, bfr, sizeof(bfr)) > 0)
+    { }
+
+    {
+      Concurrency::ScopedMutex l(m_lock);
+      ++m_calls;
+    }
+
+    throw std::runtime_error("handler failure");
+  }
+
+  unsigned
+  getCalls(void)
+  {
+    Concurrency::ScopedMutex l(m_lock);
+    return m_calls;
+  }
+
+private:
+  unsigned m_calls;
+  Concurrency::Mutex m_lock;
+};
+
+static void
+openPipe(int fds[2])
+{
+  if (pipe(fds) < 0)
+    throw std::runtime_error("pipe");
+  fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+}
+
+static void
+send(int fd, unsigned bytes)
+{
+  char bfr[256];
+  std::memset(bfr, 'x', sizeof(bfr));
+  if (write(fd, bfr, bytes) != (ssize_t)bytes)
+    throw std::runtime_error("write");
+}
+
+//! Wait until a condition holds or a timeout expires.
+template <typename Predicate>
+static bool
+waitFor(Predicate pred, double timeout = 2.0)
+{
+  double deadline = Time::Clock::get() + timeout;
+  while (!pred())
+  {
+    if (Time::Clock::get() > deadline)
+      return false;
+    Time::Delay::wait(0.005);
+  }
+  return true;
+}
+
+int
+main(void)
+{
+  Test test("IO::Reactor");
+
+  {
+    IO::Reactor reactor(2);
+    int a[2];
+    int b[2];
+    openPipe(a);
+    openPipe(b);
+
+    Reader ra;
+    Reader rb;
+    reactor.add(a[0], &ra);
+    reactor.add(b[0], &rb);
+    test.boolean("handles are watched", reactor.size() == 2);
+
+    send(a[1], 10);
+    send(b[1], 20);
+    test.boolean("readiness is dispatched",
+                 waitFor([&]() { return ra.getBytes() == 10 && rb.getBytes() == 20; }));
+
+    // Idle handles must not trigger further calls.
+    unsigned calls = ra.getCalls();
+    Time::Delay::wait(0.1);
+    test.boolean("idle handle is not dispatched", ra.getCalls() == calls);
+
+    // Data arriving while the handler runs triggers a new call.
+    send(a[1], 5);
+    send(a[1], 5);
+    send(a[1], 5);
+    test.boolean("handle is re-armed", waitFor([&]() { return ra.getBytes() == 25; }));
+
+    reactor.remove(a[0]);
+    test.boolean("handle is removed", reactor.size() == 1);
+    calls = ra.getCalls();
+    send(a[1], 10);
+    Time::Delay::wait(0.1);
+    test.boolean("removed handle is not dispatched", ra.getCalls() == calls);
+
+    reactor.remove(b[0]);
+    close(a[0]);
+    close(a[1]);
+    close(b[0]);
+    close(b[1]);
+  }
+
+  {
+    // A slow handler is never run by two threads at once.
+    IO::Reactor reactor(4);
+    int p[2];
+    openPipe(p);
+
+    Reader slow(0.05);
+    reactor.add(p[0], &slow);
+    for (unsigned i = 0; i < 10; ++i)
+    {
+      send(p[1], 1);
+      Time::Delay::wait(0.01);
+    }
+
+    test.boolean("slow handler reads everything",
+                 waitFor([&]() { return slow.getBytes() == 10; }));
+    test.boolean("handler is not re-entered", !slow.reentered());
+
+    // remove() must wait for a running handler.
+    send(p[1], 1);
+    waitFor([&]() { return slow.isBusy(); });
+    reactor.remove(p[0]);
+    test.boolean("remove waits for running handler", !slow.isBusy());
+
+    close(p[0]);
+    close(p[1]);
+  }
+
+  {
+    // Many handles on a single thread.
+    IO::Reactor reactor(1);
+    const unsigned count = 64;
+    int fds[count][2];
+    Reader readers[count];
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+      openPipe(fds[i]);
+      reactor.add(fds[i][0], &readers[i]);
+    }
+
+    for (unsigned i = 0; i < count; ++i)
+      send(fds[i][1], i + 1);
+
+    bool ok = waitFor([&]()
+                      {
+                        for (unsigned i = 0; i < count; ++i)
+                        {
+                          if (readers[i].getBytes() != i + 1)
+                            return false;
+                        }
+                        return true;
+                      });
+    test.boolean("many handles are dispatched", ok);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+      reactor.remove(fds[i][0]);
+      close(fds[i][0]);
+      close(fds[i][1]);
+    }
+    test.boolean("all handles removed", reactor.size() == 0);
+  }
+
+  {
+    // A handler may remove its own handle.
+    IO::Reactor reactor(1);
+    int p[2];
+    openPipe(p);
+
+    Closer closer(reactor);
+    reactor.add(p[0], &closer);
+    send(p[1], 10);
+    close(p[1]);
+    test.boolean("handler removes its handle",
+                 waitFor([&]() { return closer.isClosed() && reactor.size() == 0; }));
+
+    // Another handle still works after the deferred removal.
+    int q[2];
+    openPipe(q);
+    Reader reader;
+    reactor.add(q[0], &reader);
+    send(q[1], 3);
+    test.boolean("reactor keeps running", waitFor([&]() { return reader.getBytes() == 3; }));
+    reactor.remove(q[0]);
+    close(p[0]);
+    close(q[0]);
+    close(q[1]);
+  }
+
+  {
+    // A throwing handler is dropped without stopping the reactor.
+    IO::Reactor reactor(1);
+    int p[2];
+    int q[2];
+    openPipe(p);
+    openPipe(q);
+
+    Thrower thrower;
+    Reader reader;
+    reactor.add(p[0], &thrower);
+    reactor.add(q[0], &reader);
+    send(p[1], 10);
+    test.boolean("throwing handler is dropped",
+                 waitFor([&]() { return thrower.getCalls() == 1 && reactor.size() == 1; }));
+
+    send(p[1], 10);
+    Time::Delay::wait(0.1);
+    test.boolean("dropped handle is not dispatched", thrower.getCalls() == 1);
+
+    // Must not wait for the failed handler.
+    reactor.remove(p[0]);
+    test.boolean("remove after failure returns", reactor.size() == 1);
+
+    send(q[1], 7);
+    test.boolean("reactor survives throwing handler",
+                 waitFor([&]() { return reader.getBytes() == 7; }));
+
+    // The handle may be watched again.
+    reactor.add(p[0], &reader);
+    send(p[1], 3);
+    test.boolean("failed handle can be added again",
+                 waitFor([&]() { return reader.getBytes() == 20; }));
+
+    reactor.remove(p[0]);
+    reactor.remove(q[0]);
+    close(p[0]);
+    close(p[1]);
+    close(q[0]);
+    close(q[1]);
+  }
+
+  return test.getReturnValue();
+}
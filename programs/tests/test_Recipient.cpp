@@ -0,0 +1,254 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Number of queued messages.
+static const unsigned c_count = 200;
+
+//! Minimal task owning a recipient.
+class FakeTask: public Tasks::AbstractTask
+{
+public:
+  void
+  receive(const IMC::Message*)
+  { }
+
+  void
+  receive(const IMC::SharedMessage&)
+  { }
+
+  const char*
+  getName(void) const
+  {
+    return "Fake";
+  }
+
+  void inf(const char*, ...) { }
+  void war(const char*, ...) { }
+  void err(const char*, ...) { }
+  void cri(const char*, ...) { }
+  void debug(const char*, ...) { }
+  void trace(const char*, ...) { }
+  void spew(const char*, ...) { }
+
+protected:
+  void
+  run(void)
+  { }
+};
+
+//! Records the sequence numbers seen by each consumer.
+class Sink
+{
+public:
+  void
+  onTemperature(const IMC::Temperature* msg)
+  {
+    m_plain.push_back((unsigned)msg->value);
+  }
+
+  void
+  onTemperatureBatch(const IMC::Temperature* const* msgs, size_t count)
+  {
+    m_batches.push_back(std::vector<unsigned>());
+    for (size_t i = 0; i < count; ++i)
+    {
+      m_batched.push_back((unsigned)msgs[i]->value);
+      m_batches.back().push_back((unsigned)msgs[i]->value);
+    }
+  }
+
+  void
+  onDepth(const IMC::Depth* msg)
+  {
+    m_depth.push_back((unsigned)msg->value);
+  }
+
+  void
+  onDepthBatch(const IMC::Depth* const* msgs, size_t count)
+  {
+    for (size_t i = 0; i < count; ++i)
+      m_depth_batched.push_back((unsigned)msgs[i]->value);
+  }
+
+  //! Temperatures seen by the plain consumer.
+  std::vector<unsigned> m_plain;
+  //! Temperatures seen by the batch consumer.
+  std::vector<unsigned> m_batched;
+  //! Batches seen by the batch consumer.
+  std::vector<std::vector<unsigned> > m_batches;
+  //! Depths seen by the plain consumer.
+  std::vector<unsigned> m_depth;
+  //! Depths seen by the batch consumer.
+  std::vector<unsigned> m_depth_batched;
+};
+
+//! Identifier of the i-th queued message, in runs of varying length.
+static uint16_t
+getId(unsigned i)
+{
+  static const unsigned lengths[] = {1, 5, 2, 9, 1, 3, 40, 1};
+  static const uint16_t ids[] =
+  {
+    IMC::Temperature::getIdStatic(),
+    IMC::Depth::getIdStatic(),
+    IMC::Temperature::getIdStatic(),
+    IMC::Pressure::getIdStatic()
+  };
+
+  unsigned run = 0;
+  while (i >= lengths[run % 8])
+  {
+    i -= lengths[run % 8];
+    ++run;
+  }
+
+  return ids[run % 4];
+}
+
+static void
+check(Test& test, const char* name, bool mailbox)
+{
+  std::string prefix = std::string(name) + ": ";
+  Tasks::Context ctx;
+  FakeTask task;
+  Sink sink;
+  Tasks::Recipient recipient(&task, ctx);
+
+  if (mailbox)
+    recipient.setMailbox(c_count, Concurrency::MPSCQueue<IMC::SharedMessage>::OP_BLOCK);
+
+  // Temperature has both kinds of consumer, Depth only plain ones
+  // until the batch consumer is bound below, Pressure none.
+  recipient.bind(IMC::Temperature::getIdStatic(),
+                 new Tasks::Consumer<Sink, IMC::Temperature>(sink, &Sink::onTemperature));
+  recipient.bind(IMC::Temperature::getIdStatic(),
+                 new Tasks::BatchConsumer<Sink, IMC::Temperature>(sink, &Sink::onTemperatureBatch));
+  recipient.bind(IMC::Depth::getIdStatic(),
+                 new Tasks::Consumer<Sink, IMC::Depth>(sink, &Sink::onDepth));
+
+  std::vector<unsigned> temperatures;
+  std::vector<unsigned> depths;
+  for (unsigned i = 0; i < c_count; ++i)
+  {
+    uint16_t id = getId(i);
+    if (id == IMC::Temperature::getIdStatic())
+    {
+      IMC::Temperature msg;
+      msg.value = i;
+      recipient.put(&msg);
+      temperatures.push_back(i);
+    }
+    else if (id == IMC::Depth::getIdStatic())
+    {
+      IMC::Depth msg;
+      msg.value = i;
+      recipient.put(&msg);
+      depths.push_back(i);
+    }
+    else
+    {
+      IMC::Pressure msg;
+      msg.value = i;
+      recipient.put(&msg);
+    }
+  }
+
+  recipient.runCallBacks();
+
+  test.boolean((prefix + "plain consumer sees every message in order").c_str(),
+               sink.m_plain == temperatures);
+  test.boolean((prefix + "batch consumer sees every message in order").c_str(),
+               sink.m_batched == temperatures);
+  test.boolean((prefix + "unbatched identifier is dispatched in order").c_str(),
+               sink.m_depth == depths);
+
+  // Batches never span a message with another identifier.
+  bool contiguous = true;
+  for (size_t i = 0; i < sink.m_batches.size(); ++i)
+  {
+    const std::vector<unsigned>& batch = sink.m_batches[i];
+    for (size_t j = 0; j < batch.size(); ++j)
+    {
+      if (j > 0 && batch[j] != batch[j - 1] + 1)
+        contiguous = false;
+    }
+  }
+
+  test.boolean((prefix + "batches hold consecutive messages").c_str(), contiguous);
+  test.boolean((prefix + "consecutive messages are grouped").c_str(),
+               sink.m_batches.size() < temperatures.size());
+
+  // A batch consumer bound later joins the plain one.
+  recipient.bind(IMC::Depth::getIdStatic(),
+                 new Tasks::BatchConsumer<Sink, IMC::Depth>(sink, &Sink::onDepthBatch));
+
+  sink.m_depth.clear();
+  for (unsigned i = 0; i < 10; ++i)
+  {
+    IMC::Depth msg;
+    msg.value = i;
+    recipient.put(&msg);
+  }
+
+  recipient.runCallBacks();
+
+  std::vector<unsigned> expected;
+  for (unsigned i = 0; i < 10; ++i)
+    expected.push_back(i);
+
+  test.boolean((prefix + "late plain consumer sees every message").c_str(),
+               sink.m_depth == expected);
+  test.boolean((prefix + "late batch consumer sees every message").c_str(),
+               sink.m_depth_batched == expected);
+
+  recipient.unbindAll();
+}
+
+int
+main(void)
+{
+  Test test("Tasks::Recipient");
+
+  check(test, "queue", false);
+  check(test, "mailbox", true);
+
+  return test.getReturnValue();
+}
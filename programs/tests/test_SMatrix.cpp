@@ -0,0 +1,210 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Math;
+using DUNE::Navigation::KalmanFilter;
+
+template <size_t R, size_t C>
+static bool
+almostEqual(const SMatrix<R, C>& a, const Matrix& b, double max_error = 1e-12)
+{
+  if (b.rows() != R || b.columns() != C)
+    return false;
+
+  for (size_t i = 0; i < R; ++i)
+  {
+    for (size_t j = 0; j < C; ++j)
+    {
+      if (std::fabs(a(i, j) - b(i, j)) > max_error)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+//! Build a matrix with deterministic, well conditioned values.
+template <size_t R, size_t C>
+static SMatrix<R, C>
+sample(double seed)
+{
+  SMatrix<R, C> m;
+  for (size_t i = 0; i < R; ++i)
+    for (size_t j = 0; j < C; ++j)
+      m(i, j) = std::sin(seed + i * 1.3 + j * 0.7) + (i == j ? 4.0 : 0.0);
+  return m;
+}
+
+int
+main(void)
+{
+  Test test("Math::SMatrix");
+
+  {
+    SMatrix<3, 3> z;
+    SMatrix<3, 3> i = SMatrix<3, 3>::identity();
+    test.boolean("default is zero", almostEqual(z, Matrix(3, 3, 0.0)));
+    test.boolean("identity", almostEqual(i, Matrix(3)));
+  }
+
+  {
+    SMatrix<3, 4> a = sample<3, 4>(0.1);
+    SMatrix<4, 2> b = sample<4, 2>(0.5);
+    test.boolean("product", almostEqual(a * b, a.toMatrix() * b.toMatrix()));
+    test.boolean("transpose", almostEqual(transpose(a), transpose(a.toMatrix())));
+    test.boolean("sum", almostEqual(a + a * 2.0, a.toMatrix() * 3.0));
+  }
+
+  {
+    SMatrix<4, 4> p = sample<4, 4>(0.3);
+    p.symmetrize();
+    SMatrix<6, 4> a = sample<6, 4>(0.9);
+    Matrix ma = a.toMatrix();
+    test.boolean("quadratic", almostEqual(quadratic(a, p), ma * p.toMatrix() * transpose(ma)));
+  }
+
+  {
+    SMatrix<2, 2> a2 = sample<2, 2>(0.2);
+    SMatrix<3, 3> a3 = sample<3, 3>(0.4);
+    SMatrix<7, 7> a7 = sample<7, 7>(0.6);
+    test.boolean("inverse 2x2", almostEqual(inverse(a2), inverse(a2.toMatrix())));
+    test.boolean("inverse 3x3", almostEqual(inverse(a3), inverse(a3.toMatrix())));
+    test.boolean("inverse 7x7", almostEqual(inverse(a7), inverse(a7.toMatrix()), 1e-10));
+    test.boolean("inverse 7x7 identity", almostEqual(a7 * inverse(a7), Matrix(7), 1e-10));
+
+    bool thrown = false;
+    try
+    {
+      inverse(SMatrix<5, 5>());
+    }
+    catch (Matrix::Error& e)
+    {
+      thrown = true;
+    }
+    test.boolean("inverse singular throws", thrown);
+  }
+
+  {
+    SMatrix<12, 12> a = sample<12, 12>(1.1);
+    SMatrix<12, 12> spd = a * transpose(a);
+    SMatrix<12, 12> l;
+    test.boolean("cholesky", cholesky(spd, l));
+    test.boolean("cholesky product", almostEqual(l * transpose(l), spd.toMatrix(), 1e-9));
+
+    SMatrix<12, 1> b = sample<12, 1>(2.0);
+    SMatrix<12, 1> x = choleskySolve(l, b);
+    test.boolean("cholesky solve", almostEqual(spd * x, b.toMatrix(), 1e-9));
+
+    SMatrix<2, 2> neg(-1.0);
+    SMatrix<2, 2> ln;
+    test.boolean("cholesky not positive definite", !cholesky(neg, ln));
+  }
+
+  {
+    double v[3] = {1, 2, 3};
+    double w[3] = {-2, 0.5, 4};
+    SMatrix<3, 1> a(v);
+    SMatrix<3, 1> b(w);
+    test.boolean("dot", dot(a, b) == 11.0);
+    test.boolean("cross", almostEqual(cross(a, b), skew(a).toMatrix() * b.toMatrix()));
+  }
+
+  {
+    bool thrown = false;
+    try
+    {
+      SMatrix<3, 3> m(Matrix(3, 2, 0.0));
+    }
+    catch (Matrix::Error& e)
+    {
+      thrown = true;
+    }
+    test.boolean("from Matrix with wrong size throws", thrown);
+  }
+
+  {
+    SMatrix<3, 2> a = sample<3, 2>(0.8);
+    Matrix m(3, 2, 1.0);
+    Matrix shared(m);
+    a.copyTo(m);
+    test.boolean("copy to Matrix", almostEqual(a, m) && almostEqual(SMatrix<3, 2>(1.0), shared));
+  }
+
+  {
+    EulerAnglesZyx ea(0.3, -0.7, 2.1);
+    double data[3] = {ea.roll, ea.pitch, ea.yaw};
+    test.boolean("Euler rotation matrix",
+                 almostEqual(ea.rotationMatrix(), Matrix(data, 3, 1).toDCM()));
+
+    Quaternion q(ea);
+    SMatrix<3, 3> dcm;
+    q.rotationMatrix(dcm);
+    test.boolean("quaternion rotation matrix", almostEqual(dcm, q.matrix().toDCM()));
+    test.boolean("quaternion and Euler rotation matrices",
+                 almostEqual(dcm, ea.rotationMatrix().toMatrix()));
+  }
+
+  {
+    // Fixed-size prediction must match the dynamic formulation.
+    KalmanFilter kal;
+    kal.reset(6, 2);
+    SMatrix<6, 6> ax = sample<6, 6>(0.2) * 0.2;
+    SMatrix<6, 6> p = sample<6, 6>(0.8);
+    p = p * transpose(p);
+    Matrix q(6, 6, 0.0);
+    kal.setStateTransition(ax.toMatrix());
+    kal.setCovarianceTransition(ax.toMatrix());
+    for (size_t i = 0; i < 6; ++i)
+    {
+      q(i, i) = 0.01 * (i + 1);
+      kal.setProcessNoise(i, q(i, i));
+      for (size_t j = 0; j < 6; ++j)
+        kal.setCovariance(i, j, p(i, j));
+      kal.setState(i, 1.0 + i);
+    }
+
+    Matrix mx = kal.getState();
+    Matrix mp = kal.getCovariance();
+    Matrix expected_x = ax.toMatrix() * mx;
+    Matrix expected_p = ax.toMatrix() * mp * transpose(ax.toMatrix()) + q;
+
+    kal.predict();
+    test.boolean("Kalman predict state", (kal.getState() - expected_x).norm_2() < 1e-9);
+    test.boolean("Kalman predict covariance", (kal.getCovariance() - expected_p).norm_2() < 1e-9);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,154 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using DUNE::Network::Address;
+using DUNE::Network::TCPSocket;
+
+//! Bind a socket to a free loopback port.
+static uint16_t
+bindLoopback(TCPSocket& sock)
+{
+  for (uint16_t port = 47100; port < 47200; ++port)
+  {
+    try
+    {
+      sock.bind(port, Address::Loopback, false);
+      return port;
+    }
+    catch (std::exception&)
+    { }
+  }
+
+  throw std::runtime_error("no free port");
+}
+
+//! Read exactly size bytes.
+static bool
+readAll(TCPSocket& sock, uint8_t* bfr, size_t size)
+{
+  size_t total = 0;
+  while (total < size)
+  {
+    if (!IO::Poll::poll(sock, 1.0))
+      return false;
+
+    size_t rv = sock.read(bfr + total, size - total);
+    if (rv == 0)
+      return false;
+    total += rv;
+  }
+
+  return true;
+}
+
+int
+main(void)
+{
+  Test test("Network::TCPSocket");
+
+  TCPSocket server;
+  uint16_t port = bindLoopback(server);
+  server.listen(1);
+
+  TCPSocket client;
+  client.connect(Address::Loopback, port);
+  TCPSocket* peer = server.accept();
+
+  {
+    const char* parts[] = {"one", "two", "three"};
+    TCPSocket::Segment segs[3];
+    for (unsigned i = 0; i < 3; ++i)
+    {
+      segs[i].data = (const uint8_t*)parts[i];
+      segs[i].size = std::strlen(parts[i]);
+    }
+
+    test.boolean("vectored write", client.tryWrite(segs, 3) == 11);
+
+    uint8_t bfr[11];
+    test.boolean("vectored write received", readAll(*peer, bfr, sizeof(bfr)) && std::memcmp(bfr, "onetwothree", 11) == 0);
+    test.boolean("empty write", client.tryWrite(segs, 0) == 0);
+  }
+
+  {
+    // Fill the socket buffers without waiting.
+    std::vector<uint8_t> data(64 * 1024, 0x55);
+    TCPSocket::Segment seg;
+    seg.data = &data[0];
+    seg.size = data.size();
+
+    size_t sent = 0;
+    size_t rv = 0;
+    Time::Counter<double> timer(5.0);
+    while ((rv = client.tryWrite(&seg, 1)) > 0 && !timer.overflow())
+      sent += rv;
+
+    test.boolean("full buffer does not block", rv == 0 && sent > 0);
+
+    std::vector<uint8_t> bfr(sent);
+    test.boolean("buffered data received", readAll(*peer, &bfr[0], sent) && bfr == std::vector<uint8_t>(sent, 0x55));
+  }
+
+  {
+    delete peer;
+
+    uint8_t byte = 0;
+    TCPSocket::Segment seg;
+    seg.data = &byte;
+    seg.size = 1;
+
+    bool closed = false;
+    Time::Counter<double> timer(5.0);
+    while (!closed && !timer.overflow())
+    {
+      try
+      {
+        client.tryWrite(&seg, 1);
+        Time::Delay::wait(0.01);
+      }
+      catch (Network::ConnectionClosed&)
+      {
+        closed = true;
+      }
+    }
+
+    test.boolean("closed connection is reported", closed);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,162 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using DUNE::Network::Address;
+using DUNE::Network::UDPSocket;
+
+//! Bind a socket to a free loopback port.
+static uint16_t
+bindLoopback(UDPSocket& sock)
+{
+  for (uint16_t port = 47000; port < 47100; ++port)
+  {
+    try
+    {
+      sock.bind(port, Address::Loopback, false);
+      return port;
+    }
+    catch (std::exception&)
+    { }
+  }
+
+  throw std::runtime_error("no free port");
+}
+
+int
+main(void)
+{
+  Test test("Network::UDPSocket");
+
+  UDPSocket rx_a;
+  UDPSocket rx_b;
+  UDPSocket tx;
+  uint16_t port_a = bindLoopback(rx_a);
+  uint16_t port_b = bindLoopback(rx_b);
+  uint16_t port_tx = bindLoopback(tx);
+
+  {
+    test.boolean("single datagram", tx.write((const uint8_t*)"abc", 3, Address::Loopback, port_a) == 3);
+
+    uint8_t bfr[16];
+    Address addr;
+    uint16_t port = 0;
+    size_t rv = rx_a.read(bfr, sizeof(bfr), &addr, &port);
+    test.boolean("single datagram received", rv == 3 && std::memcmp(bfr, "abc", 3) == 0);
+    test.boolean("single datagram source", addr == Address(Address::Loopback) && port == port_tx);
+  }
+
+  {
+    // 100 datagrams alternating between two hosts.
+    const size_t count = 100;
+    std::vector<uint8_t> data(count);
+    std::vector<UDPSocket::Datagram> dgrams(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      data[i] = (uint8_t)i;
+      dgrams[i].data = &data[i];
+      dgrams[i].size = 1;
+      dgrams[i].addr = Address(Address::Loopback);
+      dgrams[i].port = (i % 2) ? port_b : port_a;
+    }
+
+    test.boolean("batch sent", tx.write(&dgrams[0], count) == count);
+
+    uint8_t bfrs[count][8];
+    UDPSocket::Datagram in[count];
+    bool ok = true;
+    size_t received = 0;
+    UDPSocket* socks[2] = {&rx_a, &rx_b};
+    for (unsigned s = 0; s < 2; ++s)
+    {
+      size_t expected = 0;
+      while (expected < count / 2)
+      {
+        if (!IO::Poll::poll(*socks[s], 1.0))
+          break;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+          in[i].data = bfrs[i];
+          in[i].size = sizeof(bfrs[i]);
+        }
+
+        size_t rv = socks[s]->read(in, count);
+        for (size_t i = 0; i < rv; ++i)
+        {
+          ok = ok && in[i].size == 1 && in[i].data[0] == 2 * expected + s;
+          ok = ok && in[i].addr == Address(Address::Loopback) && in[i].port == port_tx;
+          ++expected;
+        }
+      }
+
+      received += expected;
+    }
+
+    test.boolean("batch received", received == count);
+    test.boolean("batch contents, order and source", ok);
+  }
+
+  {
+    // Unreachable destinations do not prevent sending the others.
+    uint8_t byte = 42;
+    UDPSocket::Datagram dgrams[3];
+    for (unsigned i = 0; i < 3; ++i)
+    {
+      dgrams[i].data = &byte;
+      dgrams[i].size = 1;
+      dgrams[i].addr = Address(Address::Loopback);
+      dgrams[i].port = port_a;
+    }
+    dgrams[1].addr = "0.0.0.0";
+    dgrams[1].port = 0;
+
+    test.boolean("failed datagram is skipped", tx.write(dgrams, 3) == 2);
+
+    uint8_t bfr[8];
+    unsigned received = 0;
+    while (IO::Poll::poll(rx_a, 0.2))
+    {
+      rx_a.read(bfr, sizeof(bfr));
+      ++received;
+    }
+
+    test.boolean("remaining datagrams received", received == 2);
+  }
+
+  return test.getReturnValue();
+}
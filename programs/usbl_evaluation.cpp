@@ -37,6 +37,9 @@
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Messages used by this program.
+static const uint16_t c_ids[] = {DUNE_IMC_LOGGINGCONTROL, DUNE_IMC_ESTIMATEDSTATE, DUNE_IMC_USBLFIXEXTENDED, DUNE_IMC_USBLFIX};
+
 int
 main(int32_t argc, char** argv)
 {
@@ -62,12 +65,6 @@ main(int32_t argc, char** argv)
     std::vector<float> m_bearings;
     float m_sum_ranges = 0.0;
     float m_sum_bearings = 0.0;
-    std::istream* is = 0;
-    DUNE::Compression::Methods method = DUNE::Compression::Factory::detect(argv[i]);
-    if (method == DUNE::Compression::METHOD_UNKNOWN)
-      is = new std::ifstream(argv[i], std::ios::binary);
-    else
-      is = new DUNE::Compression::FileInput(argv[i], method);
 
     DUNE::IMC::Message* msg = NULL;
 
@@ -78,8 +75,15 @@ main(int32_t argc, char** argv)
 
     try
     {
-      while ((msg = DUNE::IMC::Packet::deserialize(*is)) != 0)
+      DUNE::IMC::LogReader reader(argv[i]);
+      reader.setFilter(std::vector<uint16_t>(c_ids, c_ids + sizeof(c_ids) / sizeof(c_ids[0])));
+
+      DUNE::IMC::LogReader::PacketView packet;
+      size_t offset = 0;
+      while (reader.next(offset, reader.getSize(), packet))
       {
+        msg = reader.decode(packet);
+
         if (msg->getId() == DUNE_IMC_LOGGINGCONTROL)
         {
           if (!got_name)
@@ -138,8 +142,6 @@ main(int32_t argc, char** argv)
       std::cerr << "ERROR: " << e.what() << std::endl;
     }
 
-    delete is;
-
     if (m_ranges.size() == 0)
     {
       std::cerr << "\r\nThere is no USBL in " << log_name << "." << std::endl;
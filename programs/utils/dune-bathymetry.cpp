@@ -0,0 +1,107 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Utility program to convert bathymetry data to a raster.                 *
+//***************************************************************************
+
+// ISO C++ headers
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// DUNE headers
+#include <DUNE/DUNE.hpp>
+#include <DUNE/Simulation/Bathymetry.hpp>
+
+using DUNE_NAMESPACES;
+
+int
+main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    fprintf(stderr, "Usage: %s <bathymetry ini> <raster> [resolution (m)] [fill radius (m)]\n", argv[0]);
+    fprintf(stderr, "\nConverts the [Bathymetry] section of a simulation INI file to the\n"
+            "raster used by Simulators.Environment. By default the raster has a\n"
+            "resolution of 1 m and holes are filled from data up to 10 m away.\n");
+    return 1;
+  }
+
+  double resolution = 1.0;
+  double radius = 10.0;
+
+  if (argc > 3 && (!castLexical(argv[3], resolution) || resolution <= 0))
+  {
+    fprintf(stderr, "ERROR: invalid resolution '%s'\n", argv[3]);
+    return 1;
+  }
+
+  if (argc > 4 && (!castLexical(argv[4], radius) || radius < 0))
+  {
+    fprintf(stderr, "ERROR: invalid radius '%s'\n", argv[4]);
+    return 1;
+  }
+
+  try
+  {
+    Parsers::Config cfg(argv[1]);
+    std::vector<std::string> lines;
+    double lat = 0;
+    double lon = 0;
+    cfg.get("Bathymetry", "Data", "", lines);
+    cfg.get("Bathymetry", "Latitude (degrees)", "0", lat);
+    cfg.get("Bathymetry", "Longitude (degrees)", "0", lon);
+
+    std::vector<Simulation::Bathymetry::Sample> samples;
+    samples.reserve(lines.size());
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+      Simulation::Bathymetry::Sample sample;
+      if (std::sscanf(lines[i].c_str(), "%lf %lf %lf", &sample.x, &sample.y, &sample.depth) != 3)
+      {
+        fprintf(stderr, "WARNING: skipping invalid sample '%s'\n", lines[i].c_str());
+        continue;
+      }
+
+      samples.push_back(sample);
+    }
+
+    Simulation::Bathymetry::create(argv[2], lat, lon, samples, resolution, radius);
+
+    Simulation::Bathymetry raster(argv[2]);
+    fprintf(stderr, "%lu samples -> %u x %u raster (%0.2f m)\n",
+            (unsigned long)samples.size(), raster.getRows(), raster.getColumns(),
+            raster.getResolution());
+  }
+  catch (std::exception& e)
+  {
+    fprintf(stderr, "ERROR: %s\n", e.what());
+    return 1;
+  }
+
+  return 0;
+}
@@ -82,11 +82,17 @@ namespace Control
         IMC::DesiredHeadingRate m_hrate_ref;
         //! Depth controller pitch reference
         IMC::DesiredPitch m_pitch_ref;
+        //! State vector.
+        Matrix m_x;
+        //! Control vector.
+        Matrix m_u;
         //! Task Arguments
         Arguments m_args;
 
         Task(const std::string& name, Tasks::Context& ctx):
-          DUNE::Control::BasicAutopilot(name, ctx, c_controllable, c_required)
+          DUNE::Control::BasicAutopilot(name, ctx, c_controllable, c_required),
+          m_x(12, 1, 0.0),
+          m_u(3, 1, 0.0)
         {
           param(DTR_RT("Maximum Fin Rotation"), m_args.max_fin_rot)
           .defaultValue("15.0")
@@ -225,28 +231,26 @@ namespace Control
 
           double heading_error = Angles::normalizeRadian(msg->psi - getYawRef());
 
-          Matrix u(3, 1, 0.0);
-          Matrix x(12, 1, 0.0);
-          x(0) = msg->u;
-          x(1) = msg->v;
-          x(2) = msg->w;
-          x(3) = msg->p;
-          x(4) = msg->q;
-          x(5) = msg->r;
-          x(6) = msg->x;
-          x(7) = msg->y;
-          x(8) = depth_error;
-          x(9) = -msg->phi;
-          x(10) = pitch_error; // msg->theta; // wondering what happens here...
-          x(11) = heading_error;
-
-          u = m_args.k_gain * x;
+          m_x(0) = msg->u;
+          m_x(1) = msg->v;
+          m_x(2) = msg->w;
+          m_x(3) = msg->p;
+          m_x(4) = msg->q;
+          m_x(5) = msg->r;
+          m_x(6) = msg->x;
+          m_x(7) = msg->y;
+          m_x(8) = depth_error;
+          m_x(9) = -msg->phi;
+          m_x(10) = pitch_error; // msg->theta; // wondering what happens here...
+          m_x(11) = heading_error;
+
+          Matrix::multiplyInto(m_args.k_gain, m_x, m_u);
 
           if (m_args.roll_control_enabled)
-            m_torques.k = trimValue(u(0), -m_args.max_fin_rot, m_args.max_fin_rot);
+            m_torques.k = trimValue(m_u(0), -m_args.max_fin_rot, m_args.max_fin_rot);
 
-          m_torques.m = trimValue(u(1), -m_args.max_pitch_act, m_args.max_pitch_act);
-          m_torques.n = trimValue(u(2), -m_args.max_fin_rot, m_args.max_fin_rot);
+          m_torques.m = trimValue(m_u(1), -m_args.max_pitch_act, m_args.max_pitch_act);
+          m_torques.n = trimValue(m_u(2), -m_args.max_fin_rot, m_args.max_fin_rot);
 
           m_torques.flags = IMC::DesiredControl::FL_K | IMC::DesiredControl::FL_M | IMC::DesiredControl::FL_N;
 
@@ -30,6 +30,9 @@
 #ifndef DUNE_ALGORITHMS_CRC16_HPP_INCLUDED_
 #define DUNE_ALGORITHMS_CRC16_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <cstddef>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 
@@ -42,8 +45,19 @@ namespace DUNE
 
     extern const uint16_t c_crc16_ibm_table[256];
 
+    //! Slicing-by-8 tables: entry [k][v] is the CRC of byte v
+    //! followed by k + 1 zero bytes.
+    extern const uint16_t c_crc16_ibm_slice_table[7][256];
+
     //! CRC-16-IBM Algorithm.
     //! The polynomial used is x^16 + x^15 + x^2 + 1 (0x8005)
+    //!
+    //! Buffers shorter than 16 bytes are processed byte-by-byte.
+    //! Longer buffers are processed by the fastest implementation
+    //! available in the running CPU: carry-less multiplication
+    //! (PCLMULQDQ) folding on x86 CPUs that support it and
+    //! slicing-by-8 elsewhere. All implementations yield the same
+    //! result.
     class CRC16
     {
     public:
@@ -53,12 +67,12 @@ namespace DUNE
       //! @param crc CRC-16-IBM value to update.
       //! @return computed CRC-16-IBM.
       static inline uint16_t
-      compute(const uint8_t* buffer, uint16_t len, uint16_t crc = 0)
+      compute(const uint8_t* buffer, size_t len, uint16_t crc = 0)
       {
-        while (len--)
-          crc = (crc >> 8) ^ c_crc16_ibm_table[(crc ^ *buffer++) & 0xff];
+        if (len >= c_block_size)
+          return computeBlock(buffer, len, crc);
 
-        return crc;
+        return computeBytewise(buffer, len, crc);
       }
 
       //! Compute the CRC-16-IBM of a given byte.
@@ -70,6 +84,59 @@ namespace DUNE
       {
         return (crc >> 8) ^ c_crc16_ibm_table[(crc ^ byte) & 0xff];
       }
+
+      //! Compute the CRC-16-IBM of a given data buffer one byte
+      //! at a time.
+      //! @param buffer data buffer.
+      //! @param len data buffer length.
+      //! @param crc CRC-16-IBM value to update.
+      //! @return computed CRC-16-IBM.
+      static inline uint16_t
+      computeBytewise(const uint8_t* buffer, size_t len, uint16_t crc = 0)
+      {
+        while (len--)
+          crc = (crc >> 8) ^ c_crc16_ibm_table[(crc ^ *buffer++) & 0xff];
+
+        return crc;
+      }
+
+      //! Compute the CRC-16-IBM of a given data buffer eight bytes
+      //! at a time.
+      //! @param buffer data buffer.
+      //! @param len data buffer length.
+      //! @param crc CRC-16-IBM value to update.
+      //! @return computed CRC-16-IBM.
+      static uint16_t
+      computeSlicing8(const uint8_t* buffer, size_t len, uint16_t crc = 0);
+
+      //! Compute the CRC-16-IBM of a given data buffer using
+      //! carry-less multiplication. If the CPU does not support it
+      //! the slicing-by-8 implementation is used instead.
+      //! @param buffer data buffer.
+      //! @param len data buffer length.
+      //! @param crc CRC-16-IBM value to update.
+      //! @return computed CRC-16-IBM.
+      static uint16_t
+      computeCLMUL(const uint8_t* buffer, size_t len, uint16_t crc = 0);
+
+      //! Test if the running CPU supports carry-less multiplication.
+      //! @return true if supported, false otherwise.
+      static bool
+      hasCLMUL(void);
+
+      //! Get the name of the implementation used for large buffers.
+      //! @return implementation name.
+      static const char*
+      getImplementation(void);
+
+    private:
+      //! Minimum buffer length handled by the block implementations.
+      static const size_t c_block_size = 16;
+
+      //! Compute the CRC-16-IBM of a large buffer with the
+      //! implementation selected at runtime.
+      static uint16_t
+      computeBlock(const uint8_t* buffer, size_t len, uint16_t crc);
     };
   }
 }
@@ -35,6 +35,7 @@
 #include <DUNE/Concurrency/Condition.hpp>
 #include <DUNE/Time/Utils.hpp>
 #include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/Lockstep.hpp>
 
 namespace DUNE
 {
@@ -94,9 +95,26 @@ namespace DUNE
 #if defined(DUNE_SYS_HAS_PTHREAD_COND)
       int rv = 0;
 
-      if (t > 0)
+      // Participants count as waiting for the clock while blocked.
+      if (Time::Lockstep::isParticipant())
       {
-        if (Time::Clock::getTimeMultiplier() != 1.0)
+        Time::Lockstep::Idle idle(t > 0 ? t : -1, false);
+        while (true)
+        {
+          bool done = idle.done();
+          double period = done ? 0 : Time::Lockstep::Idle::getPeriod();
+          double deadline = period + (m_clock_monotonic ? Time::Clock::getRT() : Time::Clock::getSinceEpochRT());
+          timespec ts = DUNE_TIMESPEC_INIT_SEC_FP(deadline);
+          rv = pthread_cond_timedwait(&m_cond, &m_mutex, &ts);
+
+          if (rv != ETIMEDOUT || done)
+            break;
+        }
+      }
+      else if (t > 0)
+      {
+        // Condition variables always wait in real time.
+        if (Time::Clock::getTimeMultiplier() != 1.0 || Time::Lockstep::isEnabled())
         {
           t /= Time::Clock::getTimeMultiplier();
           t += m_clock_monotonic ? Time::Clock::getRT() : Time::Clock::getSinceEpochRT();
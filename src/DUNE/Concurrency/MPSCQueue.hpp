@@ -0,0 +1,473 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_CONCURRENCY_MPSC_QUEUE_HPP_INCLUDED_
+#define DUNE_CONCURRENCY_MPSC_QUEUE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+
+// ISO C++ 11 headers.
+#include <atomic>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
+#include <DUNE/Concurrency/ScopedCondition.hpp>
+#include <DUNE/Time/Clock.hpp>
+
+namespace DUNE
+{
+  namespace Concurrency
+  {
+    //! Bounded, lock-free, multiple producer / single consumer
+    //! FIFO. Producers and the consumer never share a lock on the
+    //! fast path: slots are claimed with atomic operations on a
+    //! power of two ring of sequenced cells. The consumer only
+    //! sleeps on a condition when the queue is empty and producers
+    //! only touch that condition when the consumer is asleep.
+    template <typename T>
+    class MPSCQueue
+    {
+    public:
+      //! Behaviour when pushing to a full queue.
+      enum OverflowPolicy
+      {
+        //! Wait for the consumer to free a slot (up to the block
+        //! timeout, after which the new element is dropped).
+        OP_BLOCK = 0,
+        //! Discard the oldest element in the queue.
+        OP_DROP_OLDEST = 1,
+        //! Discard the element being pushed.
+        OP_DROP_NEWEST = 2
+      };
+
+      //! Constructor.
+      //! @param[in] capacity minimum number of elements the queue
+      //! can hold (rounded up to a power of two).
+      //! @param[in] policy overflow policy.
+      MPSCQueue(size_t capacity, OverflowPolicy policy = OP_DROP_OLDEST):
+        m_policy(policy),
+        m_block_timeout(1.0),
+        m_enqueue(0),
+        m_dequeue(0),
+        m_sleeping(false),
+        m_blocked(0),
+        m_pushed(0),
+        m_dropped(0),
+        m_high_water(0)
+      {
+        size_t size = 2;
+        while (size < capacity)
+          size <<= 1;
+
+        m_mask = size - 1;
+        m_cells = new Cell[size];
+        for (size_t i = 0; i < size; ++i)
+          m_cells[i].sequence.store(i, std::memory_order_relaxed);
+      }
+
+      //! Destructor.
+      ~MPSCQueue(void)
+      {
+        delete [] m_cells;
+      }
+
+      //! Set the overflow policy.
+      //! @param[in] policy overflow policy.
+      void
+      setOverflowPolicy(OverflowPolicy policy)
+      {
+        m_policy.store(policy, std::memory_order_relaxed);
+      }
+
+      //! Set the maximum amount of time a producer waits for a free
+      //! slot when the overflow policy is OP_BLOCK.
+      //! @param[in] timeout timeout in seconds.
+      void
+      setBlockTimeout(double timeout)
+      {
+        m_block_timeout = timeout;
+      }
+
+      //! Add an element to the end of the queue, applying the
+      //! overflow policy if the queue is full. Safe to call from
+      //! multiple threads.
+      //! @param[in] v element.
+      //! @return true if the element was queued, false if it was
+      //! dropped.
+      bool
+      push(const T& v)
+      {
+        bool queued = tryPush(v);
+
+        if (!queued)
+        {
+          switch (m_policy.load(std::memory_order_relaxed))
+          {
+            case OP_DROP_OLDEST:
+              queued = pushDropOldest(v);
+              break;
+
+            case OP_BLOCK:
+              queued = pushBlock(v);
+              break;
+
+            default:
+              break;
+          }
+        }
+
+        if (!queued)
+        {
+          m_dropped.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+        updateHighWater();
+        wakeConsumer();
+        return true;
+      }
+
+      //! Remove the first element of the queue. Must only be called
+      //! by the consumer.
+      //! @param[out] v element.
+      //! @return true if an element was removed, false if the queue
+      //! was empty.
+      bool
+      pop(T& v)
+      {
+        if (!tryPop(v))
+          return false;
+
+        wakeProducers();
+        return true;
+      }
+
+      //! Remove up to a given number of elements from the queue. Must
+      //! only be called by the consumer.
+      //! @param[out] v destination array.
+      //! @param[in] max maximum number of elements to remove.
+      //! @return number of elements removed.
+      size_t
+      popBatch(T* v, size_t max)
+      {
+        size_t count = 0;
+        while (count < max && tryPop(v[count]))
+          ++count;
+
+        if (count > 0)
+          wakeProducers();
+
+        return count;
+      }
+
+      //! Wait for elements to be available. Must only be called by
+      //! the consumer.
+      //! @param[in] timeout timeout in seconds, use a negative number
+      //! to wait forever.
+      //! @return true if at least one element is available, false
+      //! otherwise.
+      bool
+      waitForItems(double timeout = -1.0)
+      {
+        if (!empty())
+          return true;
+
+        double deadline = Time::Clock::get() + timeout;
+
+        ScopedCondition l(m_cond);
+        m_sleeping.store(true, std::memory_order_seq_cst);
+        while (empty())
+        {
+          // A producer may signal for an element we already consumed.
+          if (timeout < 0)
+          {
+            m_cond.wait();
+            continue;
+          }
+
+          double remaining = deadline - Time::Clock::get();
+          if (remaining <= 0)
+            break;
+
+          m_cond.wait(remaining);
+        }
+        m_sleeping.store(false, std::memory_order_relaxed);
+
+        return !empty();
+      }
+
+      //! Test if the queue is empty (lock-free, approximate when
+      //! producers are active).
+      //! @return true if the queue has no elements, false otherwise.
+      bool
+      empty(void) const
+      {
+        return size() == 0;
+      }
+
+      //! Retrieve the number of elements currently in the queue
+      //! (lock-free, approximate when producers are active).
+      //! @return number of elements.
+      size_t
+      size(void) const
+      {
+        size_t deq = m_dequeue.load(std::memory_order_seq_cst);
+        size_t enq = m_enqueue.load(std::memory_order_seq_cst);
+        return (enq > deq) ? (enq - deq) : 0;
+      }
+
+      //! Retrieve the capacity of the queue.
+      //! @return maximum number of elements.
+      size_t
+      capacity(void) const
+      {
+        return m_mask + 1;
+      }
+
+      //! Retrieve the number of elements successfully pushed.
+      //! @return number of elements.
+      unsigned long
+      getPushed(void) const
+      {
+        return m_pushed.load(std::memory_order_relaxed);
+      }
+
+      //! Retrieve the number of elements dropped due to overflow.
+      //! @return number of elements.
+      unsigned long
+      getDropped(void) const
+      {
+        return m_dropped.load(std::memory_order_relaxed);
+      }
+
+      //! Retrieve the maximum number of elements observed in the
+      //! queue.
+      //! @return number of elements.
+      size_t
+      getHighWater(void) const
+      {
+        return m_high_water.load(std::memory_order_relaxed);
+      }
+
+    private:
+      //! Assumed cache line size.
+      static const size_t c_cache_line = 64;
+
+      //! Ring cell.
+      struct Cell
+      {
+        //! Sequence number.
+        std::atomic<size_t> sequence;
+        //! Stored element.
+        T data;
+      };
+
+      //! Ring of cells.
+      Cell* m_cells;
+      //! Index mask.
+      size_t m_mask;
+      //! Overflow policy.
+      std::atomic<int> m_policy;
+      //! Maximum time to block producers.
+      double m_block_timeout;
+      //! Padding to keep producer and consumer positions in
+      //! separate cache lines.
+      char m_pad0[c_cache_line];
+      //! Enqueue position (shared by producers).
+      std::atomic<size_t> m_enqueue;
+      char m_pad1[c_cache_line];
+      //! Dequeue position.
+      std::atomic<size_t> m_dequeue;
+      char m_pad2[c_cache_line];
+      //! True if the consumer is waiting for elements.
+      std::atomic<bool> m_sleeping;
+      //! Number of producers waiting for free slots.
+      std::atomic<unsigned> m_blocked;
+      //! Consumer condition.
+      Condition m_cond;
+      //! Producer condition.
+      Condition m_space;
+      //! Statistics.
+      std::atomic<unsigned long> m_pushed;
+      std::atomic<unsigned long> m_dropped;
+      std::atomic<size_t> m_high_water;
+
+      bool
+      tryPush(const T& v)
+      {
+        size_t pos = m_enqueue.load(std::memory_order_relaxed);
+        Cell* cell = NULL;
+
+        while (true)
+        {
+          cell = &m_cells[pos & m_mask];
+          size_t seq = cell->sequence.load(std::memory_order_acquire);
+          ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+
+          if (diff == 0)
+          {
+            if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+              break;
+          }
+          else if (diff < 0)
+          {
+            return false;
+          }
+          else
+          {
+            pos = m_enqueue.load(std::memory_order_relaxed);
+          }
+        }
+
+        cell->data = v;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+
+      //! Remove the first element. Safe against concurrent callers so
+      //! that producers may evict the oldest element.
+      bool
+      tryPop(T& v)
+      {
+        size_t pos = m_dequeue.load(std::memory_order_relaxed);
+        Cell* cell = NULL;
+
+        while (true)
+        {
+          cell = &m_cells[pos & m_mask];
+          size_t seq = cell->sequence.load(std::memory_order_acquire);
+          ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)(pos + 1);
+
+          if (diff == 0)
+          {
+            if (m_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+              break;
+          }
+          else if (diff < 0)
+          {
+            return false;
+          }
+          else
+          {
+            pos = m_dequeue.load(std::memory_order_relaxed);
+          }
+        }
+
+        v = cell->data;
+        cell->data = T();
+        cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+      }
+
+      bool
+      pushDropOldest(const T& v)
+      {
+        T old;
+        while (!tryPush(v))
+        {
+          if (tryPop(old))
+          {
+            old = T();
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+
+        return true;
+      }
+
+      bool
+      pushBlock(const T& v)
+      {
+        double deadline = Time::Clock::get() + m_block_timeout;
+
+        m_blocked.fetch_add(1, std::memory_order_seq_cst);
+
+        // The consumer wakes us up after freeing slots, retrying
+        // under the lock guarantees no wake-up is lost.
+        bool queued = false;
+        {
+          ScopedCondition l(m_space);
+          while (!(queued = tryPush(v)))
+          {
+            double remaining = deadline - Time::Clock::get();
+            if (remaining <= 0)
+              break;
+
+            m_space.wait(remaining < 0.1 ? remaining : 0.1);
+          }
+        }
+
+        m_blocked.fetch_sub(1, std::memory_order_relaxed);
+
+        return queued;
+      }
+
+      void
+      updateHighWater(void)
+      {
+        size_t current = size();
+        size_t high = m_high_water.load(std::memory_order_relaxed);
+        while (current > high && !m_high_water.compare_exchange_weak(high, current, std::memory_order_relaxed))
+        { }
+      }
+
+      void
+      wakeConsumer(void)
+      {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_sleeping.load(std::memory_order_seq_cst))
+        {
+          ScopedCondition l(m_cond);
+          m_cond.signal();
+        }
+      }
+
+      void
+      wakeProducers(void)
+      {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_blocked.load(std::memory_order_seq_cst) > 0)
+        {
+          ScopedCondition l(m_space);
+          m_space.broadcast();
+        }
+      }
+
+      //! Non - copyable.
+      MPSCQueue(const MPSCQueue&);
+
+      //! Non - assignable.
+      MPSCQueue&
+      operator=(const MPSCQueue&);
+    };
+  }
+}
+
+#endif
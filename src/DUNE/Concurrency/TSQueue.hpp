@@ -31,6 +31,7 @@
 #define DUNE_CONCURRENCY_TS_QUEUE_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <cstddef>
 #include <queue>
 #include <iostream>
 
@@ -77,7 +78,25 @@ namespace DUNE
           m_queue.pop();
           return v;
         }
-        return 0;
+        return T();
+      }
+
+      //! Retrieve and remove up to a given number of elements from
+      //! the front of the queue, taking the lock only once.
+      //! @param v destination array.
+      //! @param max maximum number of elements to remove.
+      //! @return number of elements removed.
+      inline size_t
+      popBatch(T* v, size_t max)
+      {
+        ScopedCondition l(m_cond);
+        size_t count = 0;
+        while (count < max && !m_queue.empty())
+        {
+          v[count++] = m_queue.front();
+          m_queue.pop();
+        }
+        return count;
       }
 
       //! Wait for items to be available.
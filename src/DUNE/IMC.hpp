@@ -44,6 +44,10 @@ namespace DUNE
 #include <DUNE/IMC/Message.hpp>
 #include <DUNE/IMC/Factory.hpp>
 #include <DUNE/IMC/Packet.hpp>
+#include <DUNE/IMC/Writer.hpp>
+#include <DUNE/IMC/LogIndex.hpp>
+#include <DUNE/IMC/IndexedLogReader.hpp>
+#include <DUNE/IMC/LogReader.hpp>
 #include <DUNE/IMC/Macros.hpp>
 #include <DUNE/IMC/AddressResolver.hpp>
 #include <DUNE/IMC/Parser.hpp>
@@ -31,6 +31,7 @@
 #include <algorithm>
 
 // DUNE headers.
+#include <DUNE/Concurrency/Scheduler.hpp>
 #include <DUNE/Streams/Terminal.hpp>
 #include <DUNE/Utils/String.hpp>
 #include <DUNE/IMC/Factory.hpp>
@@ -44,25 +45,27 @@ namespace DUNE
   {
     struct BackLogEntry
     {
-      BackLogEntry(const Message* msg, Tasks::AbstractTask* exc):
-        message(msg->clone()),
+      BackLogEntry(const SharedMessage& msg, Tasks::AbstractTask* exc):
+        message(msg),
         exclude(exc)
       {  }
 
-      ~BackLogEntry(void)
-      {
-        delete message;
-      }
-
       //! Message.
-      Message* message;
+      SharedMessage message;
       //! Exclude this task.
       Tasks::AbstractTask* exclude;
     };
 
     Bus::Bus(void):
+      m_version(0),
+      m_published(0),
+      m_table(new Table),
+      m_epoch(0),
       m_paused(false)
-    { }
+    {
+      m_readers[0] = 0;
+      m_readers[1] = 0;
+    }
 
     Bus::~Bus(void)
     {
@@ -75,6 +78,14 @@ namespace DUNE
 
       for (unsigned i = 0; i < m_bind_msgs.size(); ++i)
         delete m_bind_msgs[i];
+
+      delete m_table.load();
+
+      for (size_t i = 0; i < m_retired.size(); ++i)
+        delete m_retired[i];
+
+      for (size_t i = 0; i < m_pending.size(); ++i)
+        delete m_pending[i];
     }
 
     void
@@ -86,47 +97,220 @@ namespace DUNE
       bind->consumer = task->getName();
       bind->message_id = id;
 
-      Concurrency::ScopedRWLock l(m_lock, true);
-      m_bind_msgs.push_back(bind);
-      TransportList::iterator itr = std::find(m_recipients[id].begin(), m_recipients[id].end(), task);
-      if (itr == m_recipients[id].end())
-        m_recipients[id].push_back(task);
+      {
+        Concurrency::ScopedMutex l(m_lock);
+        m_bind_msgs.push_back(bind);
+        TransportList& list = m_recipients[id];
+        if (std::find(list.begin(), list.end(), task) != list.end())
+          return;
+
+        list.push_back(task);
+        m_version.fetch_add(1, std::memory_order_release);
+      }
+
+      // Messages dispatched from now on reach the new recipient.
+      Concurrency::ScopedMutex l(m_publish_lock);
+      publish();
+      reclaim();
     }
 
     void
     Bus::unregisterRecipient(Tasks::AbstractTask* task, uint16_t id)
     {
-      Concurrency::ScopedRWLock l(m_lock, true);
-      m_recipients[id].remove(task);
+      {
+        Concurrency::ScopedMutex l(m_lock);
+        std::map<uint16_t, TransportList>::iterator itr = m_recipients.find(id);
+        if (itr == m_recipients.end())
+          return;
+
+        TransportList::iterator titr = std::find(itr->second.begin(), itr->second.end(), task);
+        if (titr == itr->second.end())
+          return;
+
+        itr->second.erase(titr);
+        if (itr->second.empty())
+          m_recipients.erase(itr);
+
+        m_version.fetch_add(1, std::memory_order_release);
+      }
+
+      Concurrency::ScopedMutex l(m_publish_lock);
+      publish();
+      reclaim();
+    }
+
+    void
+    Bus::synchronize(void)
+    {
+      while (true)
+      {
+        {
+          Concurrency::ScopedMutex l(m_publish_lock);
+          publish();
+          if (reclaim() && m_published.load() == m_version.load())
+            return;
+        }
+
+        Concurrency::Scheduler::yield();
+      }
+    }
+
+    bool
+    Bus::reclaim(void)
+    {
+      if (m_retired.empty() && m_pending.empty())
+        return true;
+
+      // Readers of the previous epoch use the other slot. Retired
+      // tables were replaced before the epoch last changed and are
+      // free once those readers have left.
+      unsigned epoch = m_epoch.load(std::memory_order_seq_cst);
+      if (m_readers[(epoch + 1) & 1].load(std::memory_order_seq_cst) != 0)
+        return false;
+
+      for (size_t i = 0; i < m_retired.size(); ++i)
+        delete m_retired[i];
+      m_retired.clear();
+
+      if (m_pending.empty())
+        return true;
+
+      // New readers use the other slot and can only see the current
+      // table, tables replaced so far wait for this epoch to end.
+      m_retired.swap(m_pending);
+      m_epoch.fetch_add(1, std::memory_order_seq_cst);
+      return false;
+    }
+
+    void
+    Bus::publish(void)
+    {
+      RecipientMap recipients;
+      unsigned version = 0;
+
+      {
+        Concurrency::ScopedMutex l(m_lock);
+        version = m_version.load(std::memory_order_acquire);
+        if (version == m_published.load(std::memory_order_relaxed))
+          return;
+
+        recipients = m_recipients;
+      }
+
+      Table* table = new Table;
+
+      if (!recipients.empty())
+      {
+        unsigned count = recipients.rbegin()->first + 1;
+        table->offsets.resize(count + 1, 0);
+
+        RecipientMap::const_iterator itr = recipients.begin();
+        for (unsigned id = 0; id < count; ++id)
+        {
+          table->offsets[id] = table->tasks.size();
+          if (itr != recipients.end() && itr->first == id)
+          {
+            table->tasks.insert(table->tasks.end(), itr->second.begin(), itr->second.end());
+            ++itr;
+          }
+        }
+
+        table->offsets[count] = table->tasks.size();
+      }
+
+      // Readers that entered in the current epoch may still be using
+      // the old table, it is reclaimed by a later call.
+      m_pending.push_back(m_table.exchange(table, std::memory_order_seq_cst));
+      m_published.store(version, std::memory_order_release);
+    }
+
+    unsigned
+    Bus::enter(void)
+    {
+      while (true)
+      {
+        unsigned epoch = m_epoch.load(std::memory_order_seq_cst);
+        unsigned slot = epoch & 1;
+        m_readers[slot].fetch_add(1, std::memory_order_seq_cst);
+
+        // Only proceed if no writer started waiting in between.
+        if (m_epoch.load(std::memory_order_seq_cst) == epoch)
+          return slot;
+
+        m_readers[slot].fetch_sub(1, std::memory_order_release);
+      }
+    }
+
+    void
+    Bus::deliver(const Message* msg, Tasks::AbstractTask* task, SharedMessage& shared)
+    {
+      uint16_t id = msg->getId();
+      unsigned slot = enter();
+
+      const Table* table = m_table.load(std::memory_order_acquire);
+      if (id + 1U < table->offsets.size())
+      {
+        Tasks::AbstractTask* const* itr = table->tasks.data() + table->offsets[id];
+        Tasks::AbstractTask* const* end = table->tasks.data() + table->offsets[id + 1];
+
+        for (; itr != end; ++itr)
+        {
+          if (*itr == task)
+            continue;
+
+          // Only copy the message if someone is listening.
+          if (shared.isNull())
+            shared = SharedMessage(Factory::clone(msg));
+
+          (*itr)->receive(shared);
+        }
+      }
+
+      leave(slot);
     }
 
     void
     Bus::dispatch(const Message* msg, Tasks::AbstractTask* task)
     {
+      if (m_paused.load(std::memory_order_acquire))
       {
         Concurrency::ScopedMutex lock(m_paused_lock);
-        if (m_paused)
+        if (m_paused.load())
         {
-          m_back_log.push(new BackLogEntry(msg, task));
+          m_back_log.push(new BackLogEntry(SharedMessage(Factory::clone(msg)), task));
           return;
         }
       }
 
-      uint16_t id = msg->getId();
-      Concurrency::ScopedRWLock l(m_lock);
-      TransportList& dlst(m_recipients[id]);
-      for (TransportList::iterator itr = dlst.begin(); itr != dlst.end(); ++itr)
+      SharedMessage shared;
+      deliver(msg, task, shared);
+    }
+
+    void
+    Bus::dispatch(const SharedMessage& msg, Tasks::AbstractTask* task)
+    {
+      if (msg.isNull())
+        return;
+
+      if (m_paused.load(std::memory_order_acquire))
       {
-        if (*itr != task)
-          (*itr)->receive(msg);
+        Concurrency::ScopedMutex lock(m_paused_lock);
+        if (m_paused.load())
+        {
+          m_back_log.push(new BackLogEntry(msg, task));
+          return;
+        }
       }
+
+      SharedMessage shared(msg);
+      deliver(msg.get(), task, shared);
     }
 
     void
     Bus::resume(void)
     {
       m_paused_lock.lock();
-      m_paused = false;
+      m_paused.store(false);
       m_paused_lock.unlock();
 
       while (!m_back_log.empty())
@@ -143,7 +327,7 @@ namespace DUNE
     const std::vector<TransportBindings*>
     Bus::getBindings(void)
     {
-      Concurrency::ScopedRWLock l(m_lock);
+      Concurrency::ScopedMutex l(m_lock);
       return m_bind_msgs;
     }
   }
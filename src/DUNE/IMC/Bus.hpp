@@ -39,8 +39,12 @@
 #include <vector>
 #include <queue>
 
+// ISO C++ 11 headers.
+#include <atomic>
+
 // DUNE headers.
 #include <DUNE/Tasks/AbstractTask.hpp>
+#include <DUNE/IMC/SharedMessage.hpp>
 #include <DUNE/Concurrency/TSQueue.hpp>
 #include <DUNE/Concurrency/ScopedMutex.hpp>
 #include <DUNE/Concurrency/ScopedRWLock.hpp>
@@ -66,30 +70,48 @@ namespace DUNE
       ~Bus(void);
 
       //! Register a task as a recipient a given message
-      //! identification number.
+      //! identification number. Messages dispatched after this
+      //! function returns are delivered to the task. Never waits for
+      //! dispatchers.
       //! @param task task object.
       //! @param id message identification number.
       void
       registerRecipient(Tasks::AbstractTask* task, uint16_t id);
 
       //! Unregister a task as a recipient of a given message
-      //! identification number.
+      //! identification number. Messages dispatched after this
+      //! function returns are no longer delivered to the task.
       //! @param task task object.
       //! @param id message identification number.
       void
       unregisterRecipient(Tasks::AbstractTask* task, uint16_t id);
 
-      //! Dispatches a message to registered listeners.
+      //! Wait until all recipient changes are visible to dispatchers
+      //! and no dispatcher uses an older table. Must be called before
+      //! destroying a task that unregistered itself. Blocks without
+      //! holding any lock.
+      void
+      synchronize(void);
+
+      //! Dispatches a message to registered listeners. A single
+      //! copy of the message is made and shared by all recipients.
       //! @param msg message to dispatch.
       //! @param task do not deliver message to this task.
       void
       dispatch(const Message* msg, Tasks::AbstractTask* task = NULL);
 
+      //! Dispatches a shared message to registered listeners
+      //! without copying it.
+      //! @param msg message to dispatch.
+      //! @param task do not deliver message to this task.
+      void
+      dispatch(const SharedMessage& msg, Tasks::AbstractTask* task = NULL);
+
       inline void
       pause(void)
       {
         Concurrency::ScopedMutex lock(m_paused_lock);
-        m_paused = true;
+        m_paused.store(true);
       }
 
       void
@@ -99,13 +121,42 @@ namespace DUNE
       getBindings(void);
 
     private:
-      typedef std::list<Tasks::AbstractTask*> TransportList;
-      //! Table of recipients.
-      std::map<uint16_t, TransportList> m_recipients;
-      //! Internal list lock.
-      Concurrency::RWLock m_lock;
+      //! Immutable dispatch table. Recipients of message 'id' are
+      //! stored contiguously in tasks[offsets[id]] to
+      //! tasks[offsets[id + 1]].
+      struct Table
+      {
+        //! Start of each message's recipient list.
+        std::vector<uint32_t> offsets;
+        //! Recipients.
+        std::vector<Tasks::AbstractTask*> tasks;
+      };
+
+      typedef std::vector<Tasks::AbstractTask*> TransportList;
+      typedef std::map<uint16_t, TransportList> RecipientMap;
+      //! Table of recipients (writer side).
+      RecipientMap m_recipients;
+      //! Version of the table of recipients.
+      std::atomic<unsigned> m_version;
+      //! Version of the published dispatch table.
+      std::atomic<unsigned> m_published;
+      //! Serializes publishers.
+      Concurrency::Mutex m_publish_lock;
+      //! Dispatch table currently used by readers.
+      std::atomic<Table*> m_table;
+      //! Dispatch tables replaced before the current epoch, possibly
+      //! still used by readers of the previous epoch.
+      std::vector<Table*> m_retired;
+      //! Dispatch tables replaced during the current epoch.
+      std::vector<Table*> m_pending;
+      //! Reader epoch.
+      std::atomic<unsigned> m_epoch;
+      //! Number of active readers per epoch parity.
+      std::atomic<unsigned> m_readers[2];
+      //! Lock of the table of recipients.
+      Concurrency::Mutex m_lock;
       //! Bus is paused.
-      bool m_paused;
+      std::atomic<bool> m_paused;
       //! Pause lock.
       Concurrency::Mutex m_paused_lock;
       //! List containing all generated TransportBindings for future logging/reference.
@@ -113,6 +164,41 @@ namespace DUNE
       //! Back log queue. Saves messages when Bus is paused.
       Concurrency::TSQueue<BackLogEntry*> m_back_log;
 
+      //! Build and publish a new dispatch table if the list of
+      //! recipients changed. The table is built outside the lock of
+      //! the list and the replaced table is kept until no reader can
+      //! use it. Must be called with the publish lock held.
+      void
+      publish(void);
+
+      //! Free replaced dispatch tables that no reader can use
+      //! anymore and start a new epoch for the remaining ones. Never
+      //! waits for readers. Must be called with the publish lock
+      //! held.
+      //! @return true if there is no replaced table left.
+      bool
+      reclaim(void);
+
+      //! Enter a read-side critical section.
+      //! @return reader slot, to be passed to leave().
+      unsigned
+      enter(void);
+
+      //! Leave a read-side critical section.
+      //! @param slot reader slot returned by enter().
+      void
+      leave(unsigned slot)
+      {
+        m_readers[slot].fetch_sub(1, std::memory_order_release);
+      }
+
+      //! Deliver a message to the recipients of its identifier.
+      //! @param msg message to dispatch.
+      //! @param task do not deliver message to this task.
+      //! @param shared shared copy of msg (created if empty).
+      void
+      deliver(const Message* msg, Tasks::AbstractTask* task, SharedMessage& shared);
+
       //! Non - copyable.
       Bus(Bus const&);
 
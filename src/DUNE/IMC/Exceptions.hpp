@@ -127,6 +127,15 @@ namespace DUNE
         std::runtime_error(Utils::String::str(DTR("invalid message size %u"), size))
       { }
     };
+
+    //! Invalid or unreadable log index.
+    class InvalidLogIndex: public std::runtime_error
+    {
+    public:
+      InvalidLogIndex(const std::string& path, const std::string& reason):
+        std::runtime_error(Utils::String::str(DTR("invalid log index '%s': %s"), path.c_str(), reason.c_str()))
+      { }
+    };
   }
 }
 
@@ -33,6 +33,10 @@
 #include <string>
 #include <cstdio>
 #include <map>
+#include <typeinfo>
+
+// ISO C++ 11 headers.
+#include <atomic>
 
 // DUNE headers.
 #include <DUNE/Streams/Terminal.hpp>
@@ -41,12 +45,17 @@
 #include <DUNE/IMC/Exceptions.hpp>
 #include <DUNE/IMC/Factory.hpp>
 #include <DUNE/IMC/Definitions.hpp>
+#include <DUNE/IMC/AddressResolver.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
 
 namespace DUNE
 {
   namespace IMC
   {
     typedef Message* (*Creator) (void);
+    typedef void (*Assigner) (Message*, const Message*);
+    typedef bool (*Checker) (const Message*);
 
     template <typename Type>
     static Message*
@@ -55,6 +64,20 @@ namespace DUNE
       return new Type();
     }
 
+    template <typename Type>
+    static void
+    assign(Message* dst, const Message* src)
+    {
+      *static_cast<Type*>(dst) = *static_cast<const Type*>(src);
+    }
+
+    template <typename Type>
+    static bool
+    isExact(const Message* msg)
+    {
+      return typeid(*msg) == typeid(Type);
+    }
+
     static std::pair<uint32_t, std::string> pairs_id_abbrev[] =
     {
 #define MESSAGE(id, abbrev)                             \
@@ -69,25 +92,278 @@ namespace DUNE
 #include <DUNE/IMC/Factory.def>
     };
 
-    static std::pair<int, Creator> creator_pairs_id[] =
+    DUNE_DECLARE_STATIC_MAP(map_id_abbrev, uint32_t, std::string, pairs_id_abbrev);
+    DUNE_DECLARE_STATIC_MAP(map_abbrev_id, std::string, uint32_t, pairs_abbrev_id);
+
+    //! Per-type operations and pool.
+    struct Type
+    {
+      uint32_t id;
+      Creator create;
+      Assigner assign;
+      Checker exact;
+    };
+
+    static const Type c_types[] =
     {
-#define MESSAGE(id, abbrev)                                     \
-      std::pair<int, Creator>(id, &create<abbrev>),
+#define MESSAGE(id, abbrev)                                             \
+      {id, &create<abbrev>, &assign<abbrev>, &isExact<abbrev>},
 #include <DUNE/IMC/Factory.def>
     };
 
-    DUNE_DECLARE_STATIC_MAP(creators_by_id, int, Creator, creator_pairs_id);
-    DUNE_DECLARE_STATIC_MAP(map_id_abbrev, uint32_t, std::string, pairs_id_abbrev);
-    DUNE_DECLARE_STATIC_MAP(map_abbrev_id, std::string, uint32_t, pairs_abbrev_id);
+    //! Number of message types.
+    static const size_t c_type_count = sizeof(c_types) / sizeof(c_types[0]);
+    //! Maximum number of objects in a per-thread cache of a type.
+    static const unsigned c_cache_size = 16;
+    //! Default maximum number of idle objects in a shared pool.
+    static const unsigned c_pool_capacity = 64;
+    //! Default maximum payload size of a recycled object.
+    static const unsigned c_max_object_size = DUNE_IMC_CONST_MAX_SIZE;
+
+    //! Shared pool of a message type.
+    struct Pool
+    {
+      //! Idle objects.
+      std::vector<Message*> items;
+      //! Lock protecting items.
+      Concurrency::Mutex lock;
+      //! Statistics.
+      std::atomic<unsigned long> requests;
+      std::atomic<unsigned long> hits;
+      std::atomic<unsigned long> recycled;
+      std::atomic<unsigned long> idle;
+      std::atomic<unsigned long> high_water;
+
+      Pool(void):
+        requests(0),
+        hits(0),
+        recycled(0),
+        idle(0),
+        high_water(0)
+      { }
+
+      ~Pool(void)
+      {
+        for (size_t i = 0; i < items.size(); ++i)
+          delete items[i];
+      }
+    };
+
+    //! Map of identification numbers to type indexes.
+    class TypeTable
+    {
+    public:
+      TypeTable(void):
+        capacity(c_pool_capacity),
+        max_size(c_max_object_size),
+        m_pools(c_type_count)
+      {
+        uint32_t max_id = 0;
+        for (size_t i = 0; i < c_type_count; ++i)
+          max_id = std::max(max_id, c_types[i].id);
+
+        m_index.resize(max_id + 1, -1);
+        for (size_t i = 0; i < c_type_count; ++i)
+          m_index[c_types[i].id] = (int)i;
+      }
+
+      //! Find the index of a message type.
+      //! @param id message identification number.
+      //! @return type index or -1 if the type is unknown.
+      int
+      find(uint32_t id) const
+      {
+        return (id < m_index.size()) ? m_index[id] : -1;
+      }
+
+      Pool&
+      pool(int index)
+      {
+        return m_pools[index];
+      }
+
+      //! Maximum number of idle objects per shared pool.
+      std::atomic<unsigned> capacity;
+      //! Maximum payload size of a recycled object.
+      std::atomic<unsigned> max_size;
+
+    private:
+      std::vector<int> m_index;
+      std::vector<Pool> m_pools;
+    };
+
+    static TypeTable s_types;
+
+    //! Per-thread cache of idle objects.
+    class ThreadCache
+    {
+    public:
+      struct Bin
+      {
+        Message* items[c_cache_size];
+        unsigned count;
+      };
+
+      ThreadCache(void):
+        m_bins(c_type_count, static_cast<Bin*>(NULL))
+      { }
+
+      ~ThreadCache(void)
+      {
+        for (size_t i = 0; i < m_bins.size(); ++i)
+        {
+          if (m_bins[i] == NULL)
+            continue;
+
+          while (m_bins[i]->count > 0)
+            store(i, m_bins[i]->items[--m_bins[i]->count]);
+
+          delete m_bins[i];
+        }
+      }
+
+      //! Take an idle object of a type.
+      //! @param index type index.
+      //! @return object or NULL if none is available.
+      Message*
+      take(int index)
+      {
+        Bin* bin = m_bins[index];
+
+        if (bin == NULL || bin->count == 0)
+        {
+          if (!refill(index))
+            return NULL;
+
+          bin = m_bins[index];
+        }
+
+        return bin->items[--bin->count];
+      }
+
+      //! Keep an idle object of a type.
+      //! @param index type index.
+      //! @param msg object.
+      void
+      put(int index, Message* msg)
+      {
+        Bin* bin = m_bins[index];
+        if (bin == NULL)
+        {
+          bin = new Bin;
+          bin->count = 0;
+          m_bins[index] = bin;
+        }
+
+        // Hand half of the cache over to the shared pool.
+        if (bin->count == c_cache_size)
+        {
+          while (bin->count > c_cache_size / 2)
+            store(index, bin->items[--bin->count]);
+        }
+
+        bin->items[bin->count++] = msg;
+      }
+
+    private:
+      std::vector<Bin*> m_bins;
+
+      //! Move idle objects from the shared pool to this cache.
+      //! @param index type index.
+      //! @return true if at least one object was moved.
+      bool
+      refill(int index)
+      {
+        Pool& pool = s_types.pool(index);
+
+        Concurrency::ScopedMutex l(pool.lock);
+        if (pool.items.empty())
+          return false;
+
+        Bin* bin = m_bins[index];
+        if (bin == NULL)
+        {
+          bin = new Bin;
+          bin->count = 0;
+          m_bins[index] = bin;
+        }
+
+        while (!pool.items.empty() && bin->count < c_cache_size / 2)
+        {
+          bin->items[bin->count++] = pool.items.back();
+          pool.items.pop_back();
+        }
+
+        return true;
+      }
+
+      //! Move an idle object to the shared pool, deleting it if the
+      //! pool is full.
+      //! @param index type index.
+      //! @param msg object.
+      void
+      store(size_t index, Message* msg)
+      {
+        Pool& pool = s_types.pool(index);
+
+        {
+          Concurrency::ScopedMutex l(pool.lock);
+          if (pool.items.size() < s_types.capacity.load(std::memory_order_relaxed))
+          {
+            pool.items.push_back(msg);
+            return;
+          }
+        }
+
+        pool.idle.fetch_sub(1, std::memory_order_relaxed);
+        delete msg;
+      }
+    };
+
+    static ThreadCache&
+    getThreadCache(void)
+    {
+      static thread_local ThreadCache cache;
+      return cache;
+    }
+
+    //! Take an idle object from the pool of a type.
+    //! @param index type index.
+    //! @return object or NULL.
+    static Message*
+    take(int index)
+    {
+      Pool& pool = s_types.pool(index);
+      pool.requests.fetch_add(1, std::memory_order_relaxed);
+
+      if (pool.idle.load(std::memory_order_relaxed) == 0)
+        return NULL;
+
+      Message* msg = getThreadCache().take(index);
+      if (msg != NULL)
+      {
+        pool.hits.fetch_add(1, std::memory_order_relaxed);
+        pool.idle.fetch_sub(1, std::memory_order_relaxed);
+      }
+
+      return msg;
+    }
 
     Message*
     Factory::produce(uint32_t id)
     {
-      if (creators_by_id[id])
-        return creators_by_id[id]();
+      int index = s_types.find(id);
+      if (index < 0)
+      {
+        DUNE_DBG("IMC Message Factory", "unknown message " << id);
+        return 0;
+      }
 
-      DUNE_DBG("IMC Message Factory", "unknown message " << id);
-      return 0;
+      Message* msg = take(index);
+      if (msg != NULL)
+        return msg;
+
+      return c_types[index].create();
     }
 
     Message*
@@ -98,6 +374,96 @@ namespace DUNE
       return produce(id);
     }
 
+    Message*
+    Factory::clone(const Message* msg)
+    {
+      // Objects of derived types would be sliced.
+      int index = s_types.find(msg->getId());
+      if (index < 0 || !c_types[index].exact(msg))
+        return msg->clone();
+
+      // Copies are assigned to default constructed objects so that
+      // nested message lists refer to their own parent.
+      Message* copy = take(index);
+      if (copy == NULL)
+        copy = c_types[index].create();
+
+      c_types[index].assign(copy, msg);
+      return copy;
+    }
+
+    void
+    Factory::recycle(Message* msg)
+    {
+      if (msg == NULL)
+        return;
+
+      int index = s_types.find(msg->getId());
+      if (index < 0 || !c_types[index].exact(msg)
+          || s_types.capacity.load(std::memory_order_relaxed) == 0)
+      {
+        delete msg;
+        return;
+      }
+
+      // Cleared vectors keep their capacity, so objects that carried
+      // large payloads would pin that memory for as long as they stay
+      // in the pool.
+      if (msg->getPayloadSerializationSize() > s_types.max_size.load(std::memory_order_relaxed))
+      {
+        delete msg;
+        return;
+      }
+
+      msg->clear();
+      msg->setTimeStamp(-1.0);
+      msg->setSource(AddressResolver::invalid());
+      msg->setSourceEntity(DUNE_IMC_CONST_UNK_EID);
+      msg->setDestination(AddressResolver::invalid());
+      msg->setDestinationEntity(DUNE_IMC_CONST_UNK_EID);
+
+      Pool& pool = s_types.pool(index);
+      pool.recycled.fetch_add(1, std::memory_order_relaxed);
+      unsigned long idle = pool.idle.fetch_add(1, std::memory_order_relaxed) + 1;
+      unsigned long high = pool.high_water.load(std::memory_order_relaxed);
+      while (idle > high && !pool.high_water.compare_exchange_weak(high, idle, std::memory_order_relaxed))
+      { }
+
+      getThreadCache().put(index, msg);
+    }
+
+    void
+    Factory::setPoolCapacity(unsigned capacity)
+    {
+      s_types.capacity.store(capacity, std::memory_order_relaxed);
+    }
+
+    void
+    Factory::setPoolMaximumSize(unsigned size)
+    {
+      s_types.max_size.store(size, std::memory_order_relaxed);
+    }
+
+    void
+    Factory::getPoolStatistics(std::vector<PoolStatistics>& v)
+    {
+      for (size_t i = 0; i < c_type_count; ++i)
+      {
+        Pool& pool = s_types.pool(i);
+        unsigned long requests = pool.requests.load(std::memory_order_relaxed);
+        if (requests == 0)
+          continue;
+
+        PoolStatistics stats;
+        stats.id = c_types[i].id;
+        stats.requests = requests;
+        stats.hits = pool.hits.load(std::memory_order_relaxed);
+        stats.recycled = pool.recycled.load(std::memory_order_relaxed);
+        stats.high_water = pool.high_water.load(std::memory_order_relaxed);
+        v.push_back(stats);
+      }
+    }
+
     std::string
     Factory::getAbbrevFromId(uint32_t id)
     {
@@ -45,9 +45,32 @@ namespace DUNE
     // Export DLL Symbol.
     class DUNE_DLL_SYM Factory;
 
+    //! Message objects produced by the factory are taken from
+    //! per-type pools when available. Objects handed back with
+    //! recycle() are cleared and kept for reuse, retaining the
+    //! capacity of their variable length fields. Each thread keeps a
+    //! small cache of objects per type in front of a shared pool, so
+    //! recycling does not contend on a lock in the common case.
+    //! Objects obtained from the factory may still be released with
+    //! delete.
     class Factory
     {
     public:
+      //! Pool statistics of a message type.
+      struct PoolStatistics
+      {
+        //! Message identification number.
+        uint32_t id;
+        //! Number of objects requested with produce() or clone().
+        unsigned long requests;
+        //! Number of requests served from the pool.
+        unsigned long hits;
+        //! Number of objects returned with recycle().
+        unsigned long recycled;
+        //! Maximum number of idle objects held by the pool.
+        unsigned long high_water;
+      };
+
       //! Produce a message object by identification number.
       //! @param key message identification number.
       //! @return message object allocated on the heap.
@@ -60,6 +83,41 @@ namespace DUNE
       static Message*
       produce(const std::string& name);
 
+      //! Copy a message object, reusing a pooled object of the same
+      //! type if one is available.
+      //! @param msg message object.
+      //! @return copy allocated on the heap.
+      static Message*
+      clone(const Message* msg);
+
+      //! Return a message object to its pool. Only objects obtained
+      //! with produce() or clone() may be recycled. Objects whose
+      //! dynamic type is not a message type known to the factory are
+      //! deleted.
+      //! @param msg message object (may be NULL).
+      static void
+      recycle(Message* msg);
+
+      //! Set the maximum number of idle objects kept in the shared
+      //! pool of each message type. A capacity of zero disables
+      //! pooling.
+      //! @param capacity maximum number of idle objects per type.
+      static void
+      setPoolCapacity(unsigned capacity);
+
+      //! Set the maximum payload size of objects kept for reuse.
+      //! Larger objects are deleted by recycle() instead of being
+      //! pooled with their buffers.
+      //! @param size maximum payload size in bytes.
+      static void
+      setPoolMaximumSize(unsigned size);
+
+      //! Retrieve pool statistics of message types that have been
+      //! requested at least once.
+      //! @param v output vector.
+      static void
+      getPoolStatistics(std::vector<PoolStatistics>& v);
+
       //! Retrieve all message abbreviations.
       //! @param v output vector
       static void
@@ -0,0 +1,240 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <limits>
+#include <memory>
+
+// DUNE headers.
+#include <DUNE/IMC/IndexedLogReader.hpp>
+#include <DUNE/IMC/Exceptions.hpp>
+#include <DUNE/IMC/Factory.hpp>
+#include <DUNE/IMC/Message.hpp>
+#include <DUNE/IMC/Packet.hpp>
+#include <DUNE/Compression/Decompressor.hpp>
+#include <DUNE/Compression/Factory.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Tolerance when comparing relative entry timestamps with the
+    //! time window (exact packet timestamps are checked after
+    //! decoding).
+    static const fp64_t c_time_tolerance = 1e-3;
+    //! Marker of an unloaded block.
+    static const size_t c_none = static_cast<size_t>(-1);
+
+    IndexedLogReader::IndexedLogReader(const std::string& path):
+      m_block(0),
+      m_entry(0),
+      m_loaded(c_none),
+      m_ids(65536, false),
+      m_filtered(false),
+      m_start(-std::numeric_limits<fp64_t>::max()),
+      m_end(std::numeric_limits<fp64_t>::max())
+    {
+      m_index.load(path + LogIndex::c_extension);
+
+      m_ifs.open(path.c_str(), std::ios::binary);
+      if (!m_ifs.is_open())
+        throw std::runtime_error(Utils::String::str(DTR("unable to open '%s'"), path.c_str()));
+    }
+
+    bool
+    IndexedLogReader::hasIndex(const std::string& path)
+    {
+      std::ifstream ifs((path + LogIndex::c_extension).c_str(), std::ios::binary);
+      return ifs.is_open();
+    }
+
+    void
+    IndexedLogReader::addFilter(uint16_t id)
+    {
+      m_ids[id] = true;
+      m_filtered = true;
+    }
+
+    void
+    IndexedLogReader::setFilter(const std::vector<uint16_t>& ids)
+    {
+      clearFilter();
+      for (size_t i = 0; i < ids.size(); ++i)
+        addFilter(ids[i]);
+    }
+
+    void
+    IndexedLogReader::clearFilter(void)
+    {
+      m_ids.assign(m_ids.size(), false);
+      m_filtered = false;
+    }
+
+    void
+    IndexedLogReader::setTimeWindow(fp64_t start, fp64_t end)
+    {
+      m_start = start;
+      m_end = end;
+      m_block = m_index.findBlock(start);
+      m_entry = 0;
+    }
+
+    void
+    IndexedLogReader::seek(fp64_t time)
+    {
+      setTimeWindow(time, m_end);
+    }
+
+    void
+    IndexedLogReader::rewind(void)
+    {
+      m_block = 0;
+      m_entry = 0;
+    }
+
+    bool
+    IndexedLogReader::matches(const LogIndex::Block& block, const LogIndex::Entry& entry) const
+    {
+      if (m_filtered && !m_ids[entry.id])
+        return false;
+
+      fp64_t time = block.t_min + entry.delta;
+      return time >= m_start - c_time_tolerance && time <= m_end + c_time_tolerance;
+    }
+
+    bool
+    IndexedLogReader::matches(const LogIndex::Block& block) const
+    {
+      if (block.count == 0)
+        return false;
+
+      if (block.t_max < m_start - c_time_tolerance || block.t_min > m_end + c_time_tolerance)
+        return false;
+
+      const LogIndex::Entry* entries = m_index.getEntries(block);
+      for (uint32_t i = 0; i < block.count; ++i)
+      {
+        if (matches(block, entries[i]))
+          return true;
+      }
+
+      return false;
+    }
+
+    Message*
+    IndexedLogReader::next(void)
+    {
+      while (m_block < m_index.getBlockCount())
+      {
+        const LogIndex::Block& block = m_index.getBlock(m_block);
+
+        if (m_entry == 0 && !matches(block))
+        {
+          ++m_block;
+          continue;
+        }
+
+        const LogIndex::Entry* entries = m_index.getEntries(block);
+        while (m_entry < block.count)
+        {
+          const LogIndex::Entry& entry = entries[m_entry++];
+          if (!matches(block, entry))
+            continue;
+
+          uint32_t end = (m_entry < block.count) ? entries[m_entry].offset : block.raw_size;
+          uint32_t size = end - entry.offset;
+          const uint8_t* data = getPacket(block, entry.offset, size);
+
+          Message* msg = Packet::deserialize(data, size);
+          if (msg->getTimeStamp() >= m_start && msg->getTimeStamp() <= m_end)
+            return msg;
+
+          Factory::recycle(msg);
+        }
+
+        ++m_block;
+        m_entry = 0;
+      }
+
+      return NULL;
+    }
+
+    const uint8_t*
+    IndexedLogReader::getPacket(const LogIndex::Block& block, uint32_t offset, uint32_t size)
+    {
+      if (m_index.getCompression() == Compression::METHOD_UNKNOWN)
+      {
+        read(block.position + offset, size, m_stored);
+        return m_stored.getBuffer();
+      }
+
+      if (m_loaded != m_block)
+      {
+        read(block.position, block.stored_size, m_stored);
+        m_raw.setSize(block.raw_size);
+
+        // Blocks are independent streams: use a fresh decompressor.
+        std::unique_ptr<Compression::Decompressor> dec(Compression::Factory::decompressor(m_index.getCompression()));
+        size_t in = 0;
+        size_t out = 0;
+        while (out < block.raw_size && in < block.stored_size)
+        {
+          dec->decompress(m_raw.getBufferSigned() + out, block.raw_size - out,
+                          m_stored.getBufferSigned() + in, block.stored_size - in);
+
+          if (dec->processed() == 0 && dec->decompressed() == 0)
+            break;
+
+          in += dec->processed();
+          out += dec->decompressed();
+        }
+
+        if (out != block.raw_size)
+          throw std::runtime_error(DTR("log block is truncated or corrupted"));
+
+        m_loaded = m_block;
+      }
+
+      if (offset + size > m_raw.getSize())
+        throw BufferTooShort();
+
+      return m_raw.getBuffer() + offset;
+    }
+
+    void
+    IndexedLogReader::read(uint64_t position, uint32_t size, Utils::ByteBuffer& bfr)
+    {
+      bfr.setSize(size);
+      m_ifs.clear();
+      m_ifs.seekg(static_cast<std::streamoff>(position));
+      m_ifs.read(bfr.getBufferSigned(), size);
+
+      if (m_ifs.gcount() != static_cast<std::streamsize>(size))
+        throw BufferTooShort();
+    }
+  }
+}
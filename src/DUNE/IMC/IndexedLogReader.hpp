@@ -0,0 +1,158 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_IMC_INDEXED_LOG_READER_HPP_INCLUDED_
+#define DUNE_IMC_INDEXED_LOG_READER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <fstream>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/LogIndex.hpp>
+#include <DUNE/Utils/ByteBuffer.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM IndexedLogReader;
+
+    // Forward declarations.
+    class Message;
+
+    //! Reader of LSF logs with a sidecar index (see LogIndex). Only
+    //! the blocks holding packets that match the time window and
+    //! message filter are read (and decompressed); in uncompressed
+    //! logs only the matching packets are read.
+    class IndexedLogReader
+    {
+    public:
+      //! Open a log.
+      //! @param[in] path path to the log file (e.g., Data.lsf.gz). The
+      //! index is read from the same path with LogIndex::c_extension
+      //! appended.
+      IndexedLogReader(const std::string& path);
+
+      //! Test if a log has an index.
+      //! @param[in] path path to the log file.
+      //! @return true if the index file exists, false otherwise.
+      static bool
+      hasIndex(const std::string& path);
+
+      //! Get the log index.
+      //! @return log index.
+      const LogIndex&
+      getIndex(void) const
+      {
+        return m_index;
+      }
+
+      //! Restrict reading to a message type. May be called several
+      //! times to select multiple message types.
+      //! @param[in] id message identification number.
+      void
+      addFilter(uint16_t id);
+
+      //! Restrict reading to a list of message types.
+      //! @param[in] ids message identification numbers.
+      void
+      setFilter(const std::vector<uint16_t>& ids);
+
+      //! Read all message types.
+      void
+      clearFilter(void);
+
+      //! Restrict reading to messages with timestamps in a given
+      //! window and rewind to the first block overlapping it.
+      //! @param[in] start lowest timestamp.
+      //! @param[in] end highest timestamp.
+      void
+      setTimeWindow(fp64_t start, fp64_t end);
+
+      //! Skip to the first message with a timestamp equal to or
+      //! greater than a given time.
+      //! @param[in] time timestamp.
+      void
+      seek(fp64_t time);
+
+      //! Restart reading from the beginning of the log.
+      void
+      rewind(void);
+
+      //! Read the next message matching the filter and time window.
+      //! @return message (owned by the caller) or NULL if there are no
+      //! more messages.
+      Message*
+      next(void);
+
+    private:
+      //! Index.
+      LogIndex m_index;
+      //! Log file.
+      std::ifstream m_ifs;
+      //! Current block.
+      size_t m_block;
+      //! Next entry in the current block.
+      size_t m_entry;
+      //! Block loaded in the decompression buffer.
+      size_t m_loaded;
+      //! Compressed block or raw packet.
+      Utils::ByteBuffer m_stored;
+      //! Decompressed block.
+      Utils::ByteBuffer m_raw;
+      //! Selected message types.
+      std::vector<bool> m_ids;
+      //! True if only selected message types are read.
+      bool m_filtered;
+      //! Time window.
+      fp64_t m_start;
+      fp64_t m_end;
+
+      //! Test if an entry matches the filter and time window.
+      bool
+      matches(const LogIndex::Block& block, const LogIndex::Entry& entry) const;
+
+      //! Test if any entry of a block matches the filter and time window.
+      bool
+      matches(const LogIndex::Block& block) const;
+
+      //! Retrieve the data of a packet.
+      const uint8_t*
+      getPacket(const LogIndex::Block& block, uint32_t offset, uint32_t size);
+
+      //! Read bytes from the log file.
+      void
+      read(uint64_t position, uint32_t size, Utils::ByteBuffer& bfr);
+    };
+  }
+}
+
+#endif
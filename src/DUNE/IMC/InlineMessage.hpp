@@ -199,6 +199,8 @@ namespace DUNE
       uint16_t
       serialize(uint8_t* bfr) const
       {
+        uint8_t* start = bfr;
+
         if (m_msg == NULL)
         {
           bfr += IMC::serialize((uint16_t)DUNE_IMC_CONST_NULL_ID, bfr);
@@ -206,10 +208,10 @@ namespace DUNE
         else
         {
           bfr += IMC::serialize(m_msg->getId(), bfr);
-          m_msg->serializeFields(bfr);
+          bfr = m_msg->serializeFields(bfr);
         }
 
-        return getSerializationSize();
+        return bfr - start;
       }
 
       uint16_t
@@ -0,0 +1,278 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+// DUNE headers.
+#include <DUNE/IMC/LogIndex.hpp>
+#include <DUNE/IMC/Constants.hpp>
+#include <DUNE/IMC/Exceptions.hpp>
+#include <DUNE/IMC/Header.hpp>
+#include <DUNE/IMC/Packet.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Index file magic number ("LSFI").
+    static const uint32_t c_magic = 0x4946534c;
+    //! Block record magic number ("BLK\0").
+    static const uint32_t c_block_magic = 0x004b4c42;
+    //! Index format version.
+    static const uint16_t c_version = 1;
+
+    const char* LogIndex::c_extension = ".idx";
+
+    template <typename Type>
+    static inline void
+    put(uint8_t*& ptr, Type value)
+    {
+      std::memcpy(ptr, &value, sizeof(Type));
+      ptr += sizeof(Type);
+    }
+
+    template <typename Type>
+    static inline void
+    get(const uint8_t*& ptr, Type& value)
+    {
+      std::memcpy(&value, ptr, sizeof(Type));
+      ptr += sizeof(Type);
+    }
+
+    LogIndex::LogIndex(void):
+      m_method(Compression::METHOD_UNKNOWN)
+    { }
+
+    void
+    LogIndex::load(const std::string& path)
+    {
+      std::ifstream ifs(path.c_str(), std::ios::binary);
+      if (!ifs.is_open())
+        throw InvalidLogIndex(path, DTR("unable to open file"));
+
+      std::vector<uint8_t> data;
+      ifs.seekg(0, std::ios::end);
+      data.resize(static_cast<size_t>(ifs.tellg()));
+      ifs.seekg(0, std::ios::beg);
+      if (!data.empty())
+        ifs.read(reinterpret_cast<char*>(&data[0]), data.size());
+
+      if (data.size() < c_header_size || ifs.gcount() != static_cast<std::streamsize>(data.size()))
+        throw InvalidLogIndex(path, DTR("file is too short"));
+
+      const uint8_t* ptr = &data[0];
+      const uint8_t* end = ptr + data.size();
+
+      uint32_t magic = 0;
+      uint16_t version = 0;
+      uint16_t method = 0;
+      get(ptr, magic);
+      get(ptr, version);
+      get(ptr, method);
+
+      if (magic != c_magic)
+        throw InvalidLogIndex(path, DTR("invalid magic number or byte order"));
+
+      if (version != c_version)
+        throw InvalidLogIndex(path, DTR("unsupported version"));
+
+      m_method = static_cast<Compression::Methods>(method);
+      m_blocks.clear();
+      m_t_max.clear();
+      m_entries.clear();
+
+      while (end - ptr >= static_cast<ptrdiff_t>(c_block_size))
+      {
+        uint32_t count = 0;
+        Block block;
+
+        get(ptr, magic);
+        get(ptr, count);
+
+        if (magic != c_block_magic)
+          throw InvalidLogIndex(path, DTR("invalid block record"));
+
+        // Truncated last record.
+        if (static_cast<size_t>(end - ptr) < c_block_size - 8 + count * c_entry_size)
+          break;
+
+        get(ptr, block.position);
+        get(ptr, block.stored_size);
+        get(ptr, block.raw_size);
+        get(ptr, block.t_min);
+        get(ptr, block.t_max);
+        block.first = m_entries.size();
+        block.count = count;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          Entry entry;
+          uint8_t reserved;
+          get(ptr, entry.delta);
+          get(ptr, entry.offset);
+          get(ptr, entry.id);
+          get(ptr, entry.src_ent);
+          get(ptr, reserved);
+          m_entries.push_back(entry);
+        }
+
+        fp64_t t_max = block.count ? block.t_max : -1;
+        if (!m_t_max.empty())
+          t_max = std::max(t_max, m_t_max.back());
+
+        m_blocks.push_back(block);
+        m_t_max.push_back(t_max);
+      }
+    }
+
+    fp64_t
+    LogIndex::getStartTime(void) const
+    {
+      for (size_t i = 0; i < m_blocks.size(); ++i)
+      {
+        if (m_blocks[i].count > 0)
+          return m_blocks[i].t_min;
+      }
+
+      return -1;
+    }
+
+    fp64_t
+    LogIndex::getEndTime(void) const
+    {
+      return m_t_max.empty() ? -1 : m_t_max.back();
+    }
+
+    size_t
+    LogIndex::findBlock(fp64_t time) const
+    {
+      std::vector<fp64_t>::const_iterator itr = std::lower_bound(m_t_max.begin(), m_t_max.end(), time);
+      return itr - m_t_max.begin();
+    }
+
+    size_t
+    LogIndex::scan(const uint8_t* data, size_t size, size_t limit, Block& block, std::vector<Entry>& entries)
+    {
+      entries.clear();
+      block.t_min = 0;
+      block.t_max = 0;
+
+      Header hdr;
+      size_t offset = 0;
+      std::vector<fp64_t> times;
+
+      while (offset < size)
+      {
+        size_t length = 0;
+
+        try
+        {
+          if (size - offset < DUNE_IMC_CONST_HEADER_SIZE)
+            throw BufferTooShort();
+
+          Packet::deserializeHeader(hdr, data + offset, DUNE_IMC_CONST_HEADER_SIZE);
+          length = DUNE_IMC_CONST_HEADER_SIZE + hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
+
+          if (length > size - offset)
+            throw BufferTooShort();
+        }
+        catch (std::runtime_error&)
+        {
+          // Not a well formed packet: end the block here or, if this
+          // is the start of the block, keep the remaining data
+          // unindexed.
+          if (offset == 0)
+            offset = size;
+          break;
+        }
+
+        if (offset > 0 && offset + length > limit)
+          break;
+
+        Entry entry;
+        entry.offset = offset;
+        entry.id = hdr.mgid;
+        entry.src_ent = hdr.src_ent;
+        entries.push_back(entry);
+        times.push_back(hdr.timestamp);
+
+        offset += length;
+      }
+
+      if (!times.empty())
+      {
+        block.t_min = *std::min_element(times.begin(), times.end());
+        block.t_max = *std::max_element(times.begin(), times.end());
+      }
+
+      for (size_t i = 0; i < entries.size(); ++i)
+        entries[i].delta = static_cast<fp32_t>(times[i] - block.t_min);
+
+      block.raw_size = offset;
+      block.first = 0;
+      block.count = entries.size();
+
+      return offset;
+    }
+
+    void
+    LogIndex::encodeHeader(Compression::Methods method, Utils::ByteBuffer& bfr)
+    {
+      bfr.setSize(c_header_size);
+      uint8_t* ptr = bfr.getBuffer();
+      put(ptr, c_magic);
+      put(ptr, c_version);
+      put(ptr, static_cast<uint16_t>(method));
+    }
+
+    void
+    LogIndex::encodeBlock(const Block& block, const std::vector<Entry>& entries, Utils::ByteBuffer& bfr)
+    {
+      bfr.setSize(c_block_size + entries.size() * c_entry_size);
+      uint8_t* ptr = bfr.getBuffer();
+      put(ptr, c_block_magic);
+      put(ptr, static_cast<uint32_t>(entries.size()));
+      put(ptr, block.position);
+      put(ptr, block.stored_size);
+      put(ptr, block.raw_size);
+      put(ptr, block.t_min);
+      put(ptr, block.t_max);
+
+      for (size_t i = 0; i < entries.size(); ++i)
+      {
+        put(ptr, entries[i].delta);
+        put(ptr, entries[i].offset);
+        put(ptr, entries[i].id);
+        put(ptr, entries[i].src_ent);
+        put(ptr, static_cast<uint8_t>(0));
+      }
+    }
+  }
+}
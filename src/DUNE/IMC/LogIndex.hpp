@@ -0,0 +1,210 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_IMC_LOG_INDEX_HPP_INCLUDED_
+#define DUNE_IMC_LOG_INDEX_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Compression/Methods.hpp>
+#include <DUNE/Utils/ByteBuffer.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM LogIndex;
+
+    //! Sidecar index of a LSF log. The log is written as a sequence of
+    //! blocks, each holding whole packets and, for compressed logs,
+    //! compressed independently of the others. The index records the
+    //! position of every block in the log file and the timestamp,
+    //! identification number, source entity and offset of every
+    //! packet inside its block, allowing readers to seek by time or
+    //! select message types without decoding unrelated data.
+    //!
+    //! The index file starts with a header (magic, version and
+    //! compression method) followed by one record per block. Records
+    //! are appended as blocks are written, so a truncated last record
+    //! (e.g., after a power failure) is silently ignored when loading.
+    class LogIndex
+    {
+    public:
+      //! Suffix appended to the log file name to obtain the index file name.
+      static const char* c_extension;
+      //! Size of the index header.
+      static const size_t c_header_size = 8;
+      //! Size of a block record without entries.
+      static const size_t c_block_size = 40;
+      //! Size of an entry record.
+      static const size_t c_entry_size = 12;
+
+      //! Packet entry.
+      struct Entry
+      {
+        //! Timestamp relative to the start of the block.
+        fp32_t delta;
+        //! Offset of the packet inside the uncompressed block.
+        uint32_t offset;
+        //! Message identification number.
+        uint16_t id;
+        //! Source entity.
+        uint8_t src_ent;
+      };
+
+      //! Block of packets.
+      struct Block
+      {
+        //! Position of the block in the log file.
+        uint64_t position;
+        //! Number of bytes used by the block in the log file.
+        uint32_t stored_size;
+        //! Number of bytes of the uncompressed block.
+        uint32_t raw_size;
+        //! Lowest packet timestamp.
+        fp64_t t_min;
+        //! Highest packet timestamp.
+        fp64_t t_max;
+        //! Index of the first entry.
+        uint32_t first;
+        //! Number of entries.
+        uint32_t count;
+      };
+
+      //! Default constructor.
+      LogIndex(void);
+
+      //! Load an index file.
+      //! @param[in] path index file path.
+      void
+      load(const std::string& path);
+
+      //! Get the compression method of the indexed log.
+      //! @return compression method.
+      Compression::Methods
+      getCompression(void) const
+      {
+        return m_method;
+      }
+
+      //! Get number of blocks.
+      //! @return number of blocks.
+      size_t
+      getBlockCount(void) const
+      {
+        return m_blocks.size();
+      }
+
+      //! Get a block.
+      //! @param[in] index block index.
+      //! @return block.
+      const Block&
+      getBlock(size_t index) const
+      {
+        return m_blocks[index];
+      }
+
+      //! Get the entries of a block.
+      //! @param[in] block block.
+      //! @return pointer to the first entry of the block.
+      const Entry*
+      getEntries(const Block& block) const
+      {
+        return block.count ? &m_entries[block.first] : NULL;
+      }
+
+      //! Get total number of indexed packets.
+      //! @return number of packets.
+      size_t
+      getEntryCount(void) const
+      {
+        return m_entries.size();
+      }
+
+      //! Get the lowest timestamp of the log.
+      //! @return timestamp or -1 if the log is empty.
+      fp64_t
+      getStartTime(void) const;
+
+      //! Get the highest timestamp of the log.
+      //! @return timestamp or -1 if the log is empty.
+      fp64_t
+      getEndTime(void) const;
+
+      //! Find the first block holding packets with timestamps equal
+      //! to or greater than a given time.
+      //! @param[in] time timestamp.
+      //! @return block index or getBlockCount() if no such block exists.
+      size_t
+      findBlock(fp64_t time) const;
+
+      //! Scan packets for a new block.
+      //! @param[in] data packet data.
+      //! @param[in] size size of packet data.
+      //! @param[in] limit block size limit. At least one packet is
+      //! always included in the block.
+      //! @param[out] block block; position and stored size are not
+      //! filled.
+      //! @param[out] entries entries of the block.
+      //! @return number of bytes included in the block. If the data
+      //! is not made of well formed packets the remaining bytes are
+      //! included in a block without entries.
+      static size_t
+      scan(const uint8_t* data, size_t size, size_t limit, Block& block, std::vector<Entry>& entries);
+
+      //! Encode the index header.
+      //! @param[in] method compression method of the log.
+      //! @param[out] bfr destination buffer.
+      static void
+      encodeHeader(Compression::Methods method, Utils::ByteBuffer& bfr);
+
+      //! Encode a block record.
+      //! @param[in] block block.
+      //! @param[in] entries block entries.
+      //! @param[out] bfr destination buffer.
+      static void
+      encodeBlock(const Block& block, const std::vector<Entry>& entries, Utils::ByteBuffer& bfr);
+
+    private:
+      //! Compression method.
+      Compression::Methods m_method;
+      //! Blocks.
+      std::vector<Block> m_blocks;
+      //! Highest timestamp up to and including each block.
+      std::vector<fp64_t> m_t_max;
+      //! Entries of all blocks.
+      std::vector<Entry> m_entries;
+    };
+  }
+}
+
+#endif
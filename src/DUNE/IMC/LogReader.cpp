@@ -0,0 +1,358 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/LogReader.hpp>
+#include <DUNE/IMC/Constants.hpp>
+#include <DUNE/IMC/Packet.hpp>
+#include <DUNE/Compression/Factory.hpp>
+#include <DUNE/Compression/FileInput.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Utils/String.hpp>
+
+#if defined(DUNE_SYS_HAS_MMAP)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Size of header and footer.
+    static const size_t c_overhead = DUNE_IMC_CONST_HEADER_SIZE + DUNE_IMC_CONST_FOOTER_SIZE;
+    //! Assumed expansion of compressed logs. Their size is unknown
+    //! until decompressed: gzip trailers only hold the size of the
+    //! last member.
+    static const uint64_t c_expansion = 10;
+
+    //! Retrieve the size of a file.
+    //! @param[in] path path to the file.
+    //! @return size in bytes, zero if the file cannot be read.
+    static uint64_t
+    getFileSize(const std::string& path)
+    {
+      std::ifstream ifs(path.c_str(), std::ios::binary | std::ios::ate);
+      if (!ifs)
+        return 0;
+
+      std::streamoff size = ifs.tellg();
+      return (size > 0) ? (uint64_t)size : 0;
+    }
+
+    //! Worker thread processing one range of a log.
+    class LogReaderWorker: public Concurrency::Thread
+    {
+    public:
+      LogReaderWorker(const LogReader& reader, LogReader::Handler* handler, const LogReader::Range& range):
+        m_reader(reader),
+        m_handler(handler),
+        m_range(range)
+      { }
+
+      //! Error message, empty if the range was processed successfully.
+      std::string error;
+
+      void
+      run(void)
+      {
+        try
+        {
+          LogReader::PacketView packet;
+          size_t offset = m_range.begin;
+          while (m_reader.next(offset, m_range.end, packet))
+            m_handler->onPacket(m_reader, packet);
+        }
+        catch (std::exception& e)
+        {
+          error = e.what();
+        }
+      }
+
+    private:
+      const LogReader& m_reader;
+      LogReader::Handler* m_handler;
+      LogReader::Range m_range;
+    };
+
+    LogReader::LogReader(const std::string& path):
+      m_data(NULL),
+      m_size(0),
+      m_mapped(false),
+      m_ids(65536, false),
+      m_filtered(false)
+    {
+      Compression::Methods method = Compression::Factory::detect(path.c_str());
+
+#if defined(DUNE_SYS_HAS_MMAP)
+      if (method == Compression::METHOD_UNKNOWN)
+      {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+          throw std::runtime_error(Utils::String::str(DTR("unable to open '%s'"), path.c_str()));
+
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+          void* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+          if (data != MAP_FAILED)
+          {
+#if defined(MADV_SEQUENTIAL)
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+#endif
+            m_data = static_cast<const uint8_t*>(data);
+            m_size = st.st_size;
+            m_mapped = true;
+          }
+        }
+
+        ::close(fd);
+
+        if (m_mapped || st.st_size == 0)
+          return;
+      }
+#endif
+
+      // Read the whole (decompressed) log to memory.
+      std::istream* is = NULL;
+      if (method == Compression::METHOD_UNKNOWN)
+        is = new std::ifstream(path.c_str(), std::ios::binary);
+      else
+        is = new Compression::FileInput(path.c_str(), method);
+
+      if (is->fail())
+      {
+        delete is;
+        throw std::runtime_error(Utils::String::str(DTR("unable to open '%s'"), path.c_str()));
+      }
+
+      // The size of uncompressed logs is known, avoid reallocating a
+      // buffer of the size of the log.
+      if (method == Compression::METHOD_UNKNOWN)
+        m_buffer.reserve(getFileSize(path));
+
+      char bfr[64 * 1024];
+      while (is->good())
+      {
+        is->read(bfr, sizeof(bfr));
+        m_buffer.insert(m_buffer.end(), bfr, bfr + is->gcount());
+      }
+
+      delete is;
+
+      m_data = m_buffer.empty() ? NULL : &m_buffer[0];
+      m_size = m_buffer.size();
+    }
+
+    uint64_t
+    LogReader::getMemoryUsage(const std::string& path)
+    {
+      Compression::Methods method = Compression::Factory::detect(path.c_str());
+
+#if defined(DUNE_SYS_HAS_MMAP)
+      if (method == Compression::METHOD_UNKNOWN)
+        return 0;
+#endif
+
+      uint64_t size = getFileSize(path);
+      return (method == Compression::METHOD_UNKNOWN) ? size : size * c_expansion;
+    }
+
+    LogReader::~LogReader(void)
+    {
+#if defined(DUNE_SYS_HAS_MMAP)
+      if (m_mapped)
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    }
+
+    void
+    LogReader::addFilter(uint16_t id)
+    {
+      m_ids[id] = true;
+      m_filtered = true;
+    }
+
+    void
+    LogReader::setFilter(const std::vector<uint16_t>& ids)
+    {
+      clearFilter();
+      for (size_t i = 0; i < ids.size(); ++i)
+        addFilter(ids[i]);
+    }
+
+    void
+    LogReader::clearFilter(void)
+    {
+      m_ids.assign(m_ids.size(), false);
+      m_filtered = false;
+    }
+
+    bool
+    LogReader::isSync(size_t offset) const
+    {
+      uint16_t sync;
+      std::memcpy(&sync, m_data + offset, sizeof(sync));
+      return sync == DUNE_IMC_CONST_SYNC || sync == DUNE_IMC_CONST_SYNC_REV;
+    }
+
+    bool
+    LogReader::parseHeader(size_t offset, size_t end, Header& header, size_t& size) const
+    {
+      if (end - offset < c_overhead || !isSync(offset))
+        return false;
+
+      Packet::deserializeHeader(header, m_data + offset, DUNE_IMC_CONST_HEADER_SIZE);
+      size = c_overhead + header.size;
+      if (size > DUNE_IMC_CONST_MAX_SIZE || size > end - offset)
+        return false;
+
+      // The packet must be followed by another packet or the end of
+      // the range.
+      size_t next = offset + size;
+      return next == end || (end - next >= c_overhead && isSync(next));
+    }
+
+    bool
+    LogReader::next(size_t& offset, size_t end, PacketView& packet) const
+    {
+      size_t size = 0;
+
+      while (offset < end)
+      {
+        if (!parseHeader(offset, end, packet.header, size))
+        {
+          offset = findSync(offset + 1, end);
+          continue;
+        }
+
+        packet.data = m_data + offset;
+        packet.size = size;
+        packet.offset = offset;
+        offset += size;
+
+        if (isSelected(packet.header.mgid))
+          return true;
+      }
+
+      return false;
+    }
+
+    Message*
+    LogReader::decode(const PacketView& packet, Message* msg) const
+    {
+      return Packet::deserialize(packet.data, packet.size, msg);
+    }
+
+    size_t
+    LogReader::findSync(size_t offset, size_t end) const
+    {
+      Header header;
+      size_t size = 0;
+
+      while (offset < end)
+      {
+        // Both byte orders contain the byte 0x54.
+        const void* ptr = std::memchr(m_data + offset, 0x54, end - offset);
+        if (ptr == NULL)
+          return end;
+
+        size_t pos = static_cast<const uint8_t*>(ptr) - m_data;
+        size_t candidates[] = {pos, pos - 1};
+
+        for (unsigned i = 0; i < 2; ++i)
+        {
+          size_t c = candidates[i];
+          if (c < offset || c >= end)
+            continue;
+
+          if (parseHeader(c, end, header, size))
+            return c;
+        }
+
+        offset = pos + 1;
+      }
+
+      return end;
+    }
+
+    std::vector<LogReader::Range>
+    LogReader::split(unsigned parts) const
+    {
+      std::vector<Range> ranges;
+      if (parts == 0)
+        parts = 1;
+
+      size_t begin = 0;
+      for (unsigned i = 1; i <= parts; ++i)
+      {
+        size_t end = (i == parts) ? m_size : findSync(m_size / parts * i, m_size);
+        if (end < begin)
+          end = begin;
+
+        Range range = {begin, end};
+        ranges.push_back(range);
+        begin = end;
+      }
+
+      return ranges;
+    }
+
+    void
+    LogReader::process(const std::vector<Handler*>& handlers) const
+    {
+      std::vector<Range> ranges = split(handlers.size());
+      std::vector<LogReaderWorker*> workers;
+
+      for (size_t i = 0; i < handlers.size(); ++i)
+      {
+        workers.push_back(new LogReaderWorker(*this, handlers[i], ranges[i]));
+        workers.back()->start();
+      }
+
+      std::string error;
+      for (size_t i = 0; i < workers.size(); ++i)
+      {
+        workers[i]->join();
+        if (error.empty())
+          error = workers[i]->error;
+        delete workers[i];
+      }
+
+      if (!error.empty())
+        throw std::runtime_error(error);
+    }
+  }
+}
@@ -0,0 +1,240 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_IMC_LOG_READER_HPP_INCLUDED_
+#define DUNE_IMC_LOG_READER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/Header.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM LogReader;
+
+    // Forward declarations.
+    class Message;
+
+    //! Zero-copy reader of LSF logs. Uncompressed logs are memory
+    //! mapped and packet headers are validated in place. Messages are only
+    //! decoded on request, so packets of unwanted types cost a header
+    //! check. Large logs can be split at packet boundaries and
+    //! processed by several threads (see process()).
+    //!
+    //! Compressed logs (e.g., Data.lsf.gz) cannot be mapped: they are
+    //! decompressed to memory once and each reader holds the whole
+    //! decompressed log until destroyed. Programs reading several
+    //! compressed logs at once should bound the number of open
+    //! readers by getMemoryUsage().
+    //!
+    //! All const member functions are thread safe.
+    class LogReader
+    {
+    public:
+      //! Packet located in the log data.
+      struct PacketView
+      {
+        //! Packet header.
+        Header header;
+        //! Packet data.
+        const uint8_t* data;
+        //! Packet size.
+        uint16_t size;
+        //! Offset of the packet in the log data.
+        size_t offset;
+      };
+
+      //! Range of the log data.
+      struct Range
+      {
+        //! Offset of the first packet.
+        size_t begin;
+        //! Offset past the last packet.
+        size_t end;
+      };
+
+      //! Handler of the packets of one range of a log.
+      class Handler
+      {
+      public:
+        virtual
+        ~Handler(void)
+        { }
+
+        //! Called for each selected packet of the range, in log order.
+        //! @param[in] reader log reader.
+        //! @param[in] packet packet.
+        virtual void
+        onPacket(const LogReader& reader, const PacketView& packet) = 0;
+      };
+
+      //! Open a log.
+      //! @param[in] path path to the log file (e.g., Data.lsf or
+      //! Data.lsf.gz).
+      explicit LogReader(const std::string& path);
+
+      //! Destructor.
+      ~LogReader(void);
+
+      //! Estimate the amount of memory a reader of a log holds. Mapped
+      //! logs use none, compressed logs are assumed to expand ten
+      //! times.
+      //! @param[in] path path to the log file.
+      //! @return amount of memory in bytes.
+      static uint64_t
+      getMemoryUsage(const std::string& path);
+
+      //! Test if the log file is memory mapped.
+      //! @return true if the log is memory mapped, false otherwise.
+      bool
+      isMapped(void) const
+      {
+        return m_mapped;
+      }
+
+      //! Get log data.
+      //! @return pointer to log data.
+      const uint8_t*
+      getData(void) const
+      {
+        return m_data;
+      }
+
+      //! Get size of log data.
+      //! @return size of log data.
+      size_t
+      getSize(void) const
+      {
+        return m_size;
+      }
+
+      //! Select a message type. May be called several times to select
+      //! multiple message types. If no message types are selected all
+      //! packets are returned.
+      //! @param[in] id message identification number.
+      void
+      addFilter(uint16_t id);
+
+      //! Select a list of message types.
+      //! @param[in] ids message identification numbers.
+      void
+      setFilter(const std::vector<uint16_t>& ids);
+
+      //! Select all message types.
+      void
+      clearFilter(void);
+
+      //! Test if a message type is selected.
+      //! @param[in] id message identification number.
+      //! @return true if the message type is selected, false otherwise.
+      bool
+      isSelected(uint16_t id) const
+      {
+        return !m_filtered || m_ids[id];
+      }
+
+      //! Get the whole log data range.
+      //! @return range.
+      Range
+      getRange(void) const
+      {
+        Range range = {0, m_size};
+        return range;
+      }
+
+      //! Find the next selected packet. Invalid data is skipped.
+      //! @param[in,out] offset offset where to start looking, updated
+      //! to the offset past the packet.
+      //! @param[in] end offset where to stop looking.
+      //! @param[out] packet packet.
+      //! @return true if a packet was found, false otherwise.
+      bool
+      next(size_t& offset, size_t end, PacketView& packet) const;
+
+      //! Decode a packet (the CRC is validated).
+      //! @param[in] packet packet.
+      //! @param[in] msg message object to reuse or NULL.
+      //! @return message object, owned by the caller.
+      Message*
+      decode(const PacketView& packet, Message* msg = NULL) const;
+
+      //! Find the first packet boundary at or after a given offset.
+      //! @param[in] offset offset.
+      //! @param[in] end offset where to stop looking.
+      //! @return offset of the packet boundary or end.
+      size_t
+      findSync(size_t offset, size_t end) const;
+
+      //! Split the log data in ranges of similar size, starting at
+      //! packet boundaries.
+      //! @param[in] parts number of ranges.
+      //! @return ranges.
+      std::vector<Range>
+      split(unsigned parts) const;
+
+      //! Process the log in parallel: the log is split in as many
+      //! ranges as handlers and each range is processed by one
+      //! handler in its own thread. Handlers are given ranges in log
+      //! order, so results can be merged in the order of the vector.
+      //! @param[in] handlers packet handlers.
+      void
+      process(const std::vector<Handler*>& handlers) const;
+
+    private:
+      //! Log data.
+      const uint8_t* m_data;
+      //! Size of log data.
+      size_t m_size;
+      //! True if the log file is memory mapped.
+      bool m_mapped;
+      //! Log data, if not memory mapped.
+      std::vector<uint8_t> m_buffer;
+      //! Selected message types.
+      std::vector<bool> m_ids;
+      //! True if only selected message types are returned.
+      bool m_filtered;
+
+      //! Test if there is a synchronization number at an offset.
+      bool
+      isSync(size_t offset) const;
+
+      //! Validate a packet header and check that it is followed by
+      //! another synchronization number or the end of the range.
+      bool
+      parseHeader(size_t offset, size_t end, Header& header, size_t& size) const;
+    };
+  }
+}
+
+#endif
@@ -61,7 +61,7 @@ namespace DUNE
       //! instance.
       //! @param[in] other message.
       MessageList(const MessageList& other):
-        m_parent(NULL)
+        m_parent(other.m_parent)
       {
         copy(other);
       }
@@ -237,6 +237,8 @@ namespace DUNE
       uint16_t
       serialize(uint8_t* bfr) const
       {
+        uint8_t* start = bfr;
+
         // Serialize number count.
         uint16_t nmsgs = m_list.size();
         bfr += IMC::serialize(nmsgs, bfr);
@@ -255,7 +257,7 @@ namespace DUNE
           }
         }
 
-        return getSerializationSize();
+        return bfr - start;
       }
 
       //! Deserialize message from byte buffer.
@@ -451,8 +453,6 @@ namespace DUNE
       void
       copy(const MessageList& other)
       {
-        m_parent = other.m_parent;
-
         clear();
 
         for (unsigned i = 0; i < other.m_list.size(); ++i)
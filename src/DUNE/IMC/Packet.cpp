@@ -43,50 +43,85 @@ namespace DUNE
 {
   namespace IMC
   {
+    //! Messages up to this size are serialized on the stack when
+    //! writing to an output stream.
+    static const uint16_t c_stack_packet_size = 1024;
+
     uint16_t
-    Packet::serialize(const Message* msg, uint8_t* bfr, uint16_t size)
+    Packet::getPacketSize(const Message* msg)
     {
       unsigned total = msg->getSerializationSize();
       if (total > DUNE_IMC_CONST_MAX_SIZE)
         throw InvalidMessageSize(total);
 
-      uint16_t n = total;
-      uint8_t* ptr = bfr;
+      return total;
+    }
 
-      if (size < n)
-        throw BufferTooShort();
+    void
+    Packet::write(const Message* msg, uint8_t* bfr, uint16_t size)
+    {
+      uint16_t payload = size - DUNE_IMC_CONST_HEADER_SIZE - DUNE_IMC_CONST_FOOTER_SIZE;
+
+      // Each part is added to the CRC as soon as it is written, while
+      // it is still in cache.
+      uint8_t* ptr = bfr + writeHeader(msg, payload, bfr);
+      uint16_t crc = Algorithms::CRC16::compute(bfr, DUNE_IMC_CONST_HEADER_SIZE);
 
-      ptr += serializeHeader(msg, bfr, size);
-      msg->serializeFields(ptr);
+      uint8_t* end = msg->serializeFields(ptr);
+      crc = Algorithms::CRC16::compute(ptr, end - ptr, crc);
+      IMC::serialize(crc, end);
+    }
 
-      uint16_t crc = Algorithms::CRC16::compute(bfr, n - DUNE_IMC_CONST_FOOTER_SIZE);
-      IMC::serialize(crc, (bfr + (n - DUNE_IMC_CONST_FOOTER_SIZE)));
+    uint16_t
+    Packet::serialize(const Message* msg, uint8_t* bfr, uint16_t size)
+    {
+      uint16_t n = getPacketSize(msg);
 
+      if (size < n)
+        throw BufferTooShort();
+
+      write(msg, bfr, n);
       return n;
     }
 
     uint16_t
     Packet::serialize(const Message* msg, Utils::ByteBuffer& bfr)
     {
-      unsigned size = msg->getSerializationSize();
-      if (size > 65535)
-        throw InvalidMessageSize(size);
+      uint16_t n = getPacketSize(msg);
 
-      bfr.setSize(size);
-      return serialize(msg, bfr.getBuffer(), size);
+      bfr.setSize(n);
+      write(msg, bfr.getBuffer(), n);
+      return n;
     }
 
     uint16_t
     Packet::serialize(const Message* msg, std::ostream& ofs)
     {
-      unsigned total = msg->getSerializationSize();
-      if (total > DUNE_IMC_CONST_MAX_SIZE)
-        throw InvalidMessageSize(total);
+      uint16_t n = getPacketSize(msg);
+
+      if (n <= c_stack_packet_size)
+      {
+        char data[c_stack_packet_size];
+        write(msg, (uint8_t*)data, n);
+        ofs.write(data, n);
+      }
+      else
+      {
+        std::vector<char> data(n);
+        write(msg, (uint8_t*)&data[0], n);
+        ofs.write(&data[0], n);
+      }
+
+      return n;
+    }
+
+    uint16_t
+    Packet::serialize(const Message* msg, Writer& writer)
+    {
+      uint16_t n = getPacketSize(msg);
 
-      uint16_t n = total;
-      std::vector<char> data(n);
-      serialize(msg, (uint8_t*)&data[0], n);
-      ofs.write(&data[0], n);
+      write(msg, writer.reserve(n), n);
+      writer.commit(n);
       return n;
     }
 
@@ -168,11 +203,17 @@ namespace DUNE
     {
       (void)bfr_len;
 
+      return writeHeader(msg, msg->getPayloadSerializationSize(), bfr);
+    }
+
+    uint16_t
+    Packet::writeHeader(const Message* msg, uint16_t payload, uint8_t* bfr)
+    {
       uint8_t* ptr = bfr;
 
       ptr += IMC::serialize((uint16_t)DUNE_IMC_CONST_SYNC, ptr);
       ptr += IMC::serialize(msg->getId(), ptr);
-      ptr += IMC::serialize((uint16_t)msg->getPayloadSerializationSize(), ptr);
+      ptr += IMC::serialize(payload, ptr);
       ptr += IMC::serialize(msg->getTimeStamp(), ptr);
       ptr += IMC::serialize((uint16_t)msg->getSource(), ptr);
       ptr += IMC::serialize(msg->getSourceEntity(), ptr);
@@ -39,6 +39,7 @@
 #include <DUNE/Utils/ByteBuffer.hpp>
 #include <DUNE/IMC/Constants.hpp>
 #include <DUNE/IMC/Header.hpp>
+#include <DUNE/IMC/Writer.hpp>
 
 namespace DUNE
 {
@@ -76,6 +77,13 @@ namespace DUNE
       static uint16_t
       serialize(const Message* msg, std::ostream& ofs);
 
+      //! Serialize a message object, appending it to a packet arena.
+      //! @param[in] msg message object.
+      //! @param[out] writer destination arena.
+      //! @return number of bytes appended to the arena.
+      static uint16_t
+      serialize(const Message* msg, Writer& writer);
+
       static Message*
       deserialize(const uint8_t* bfr, uint16_t bfr_len, Message* msg = NULL);
 
@@ -93,6 +101,28 @@ namespace DUNE
 
       static Message*
       deserializePayload(const Header& hdr, const uint8_t* bfr, uint16_t bfr_len, Message* msg);
+
+    private:
+      //! Compute the packet size of a message object.
+      //! @param[in] msg message object.
+      //! @return packet size.
+      static uint16_t
+      getPacketSize(const Message* msg);
+
+      //! Write the header of a message object.
+      //! @param[in] msg message object.
+      //! @param[in] payload payload size.
+      //! @param[out] bfr destination buffer.
+      //! @return number of bytes written.
+      static uint16_t
+      writeHeader(const Message* msg, uint16_t payload, uint8_t* bfr);
+
+      //! Write header, fields and footer of a message object.
+      //! @param[in] msg message object.
+      //! @param[out] bfr destination buffer, at least 'size' bytes long.
+      //! @param[in] size packet size as returned by getPacketSize().
+      static void
+      write(const Message* msg, uint8_t* bfr, uint16_t size);
     };
   }
 }
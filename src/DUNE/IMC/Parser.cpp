@@ -27,6 +27,10 @@
 // Author: Eduardo Marques                                                  *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+
 // DUNE headers.
 #include <DUNE/IMC/Parser.hpp>
 #include <DUNE/IMC/Packet.hpp>
@@ -35,6 +39,20 @@ namespace DUNE
 {
   namespace IMC
   {
+    //! First byte of the synchronization number.
+    static const uint8_t c_sync_first = DUNE_IMC_CONST_SYNC >> 8;
+    //! First byte of the byte-swapped synchronization number.
+    static const uint8_t c_sync_rev_first = DUNE_IMC_CONST_SYNC_REV >> 8;
+
+    //! Find the next occurrence of a byte.
+    //! @return position of the byte or size if not found.
+    static inline size_t
+    find(const uint8_t* data, size_t pos, size_t size, uint8_t byte)
+    {
+      const void* p = std::memchr(data + pos, byte, size - pos);
+      return (p == NULL) ? size : (const uint8_t*)p - data;
+    }
+
     Parser::Parser(void)
     {
       reset();
@@ -132,5 +150,135 @@ namespace DUNE
 
       return m;
     }
+
+    size_t
+    Parser::parse(const uint8_t* data, size_t size, const Callback& callback)
+    {
+      size_t count = 0;
+      m_stage = c_sync;
+
+      // Complete the frame left over by previous calls, copying only
+      // the bytes it needs.
+      while (m_pos < m_buf.size() && size > 0)
+      {
+        size_t need = getPendingFrameSize();
+        size_t have = m_buf.size() - m_pos;
+        if (need > have)
+        {
+          size_t take = std::min(need - have, size);
+          m_buf.insert(m_buf.end(), data, data + take);
+          data += take;
+          size -= take;
+
+          if (take < need - have)
+            break;  // need more data
+        }
+
+        m_pos += scan(&m_buf[m_pos], m_buf.size() - m_pos, callback, count);
+      }
+
+      if (m_pos < m_buf.size())
+      {
+        // All data went into the incomplete frame.
+        m_buf.erase(m_buf.begin(), m_buf.begin() + m_pos);
+        m_pos = 0;
+        return count;
+      }
+
+      m_buf.clear();
+      m_pos = 0;
+
+      size_t used = scan(data, size, callback, count);
+      m_buf.assign(data + used, data + size);
+
+      return count;
+    }
+
+    size_t
+    Parser::scan(const uint8_t* data, size_t size, const Callback& callback, size_t& count)
+    {
+      size_t pos = 0;
+      size_t next_sync = find(data, 0, size, c_sync_first);
+      size_t next_sync_rev = find(data, 0, size, c_sync_rev_first);
+
+      while (true)
+      {
+        if (next_sync < pos)
+          next_sync = find(data, pos, size, c_sync_first);
+        if (next_sync_rev < pos)
+          next_sync_rev = find(data, pos, size, c_sync_rev_first);
+
+        pos = std::min(next_sync, next_sync_rev);
+
+        if (pos == size)
+          break;  // no sync in sight, discard data
+
+        size_t n = size - pos;
+        if (n < 2)
+          break;  // need more data
+
+        uint16_t sync = (data[pos] << 8) | data[pos + 1];
+        if (sync != DUNE_IMC_CONST_SYNC && sync != DUNE_IMC_CONST_SYNC_REV)
+        {
+          ++pos;
+          continue;
+        }
+
+        if (n < DUNE_IMC_CONST_HEADER_SIZE)
+          break;  // need more data
+
+        Header hdr;
+        try
+        {
+          Packet::deserializeHeader(hdr, data + pos, DUNE_IMC_CONST_HEADER_SIZE);
+        }
+        catch (...)
+        {
+          ++pos;
+          continue;
+        }
+
+        size_t frame = DUNE_IMC_CONST_HEADER_SIZE + hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
+        if (n < frame)
+          break;  // need more data
+
+        Message* m = 0;
+        try
+        {
+          m = Packet::deserializePayload(hdr, data + pos, (uint16_t)std::min(frame, (size_t)UINT16_MAX), 0);
+        }
+        catch (...)
+        {
+          ++pos;
+          continue;
+        }
+
+        pos += frame;
+        ++count;
+        callback(m);
+      }
+
+      return pos;
+    }
+
+    size_t
+    Parser::getPendingFrameSize(void)
+    {
+      size_t have = m_buf.size() - m_pos;
+      if (have < DUNE_IMC_CONST_HEADER_SIZE)
+        return DUNE_IMC_CONST_HEADER_SIZE;
+
+      Header hdr;
+      try
+      {
+        Packet::deserializeHeader(hdr, &m_buf[m_pos], DUNE_IMC_CONST_HEADER_SIZE);
+      }
+      catch (...)
+      {
+        return have;  // not a frame, the scan will skip it
+      }
+
+      return DUNE_IMC_CONST_HEADER_SIZE + hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
+    }
   }
 }
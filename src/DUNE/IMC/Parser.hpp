@@ -31,8 +31,12 @@
 #define DUNE_IMC_PARSER_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <cstddef>
 #include <vector>
 
+// ISO C++ 11 headers.
+#include <functional>
+
 // DUNE headers.
 #include <DUNE/IMC/Message.hpp>
 
@@ -47,6 +51,10 @@ namespace DUNE
     class Parser
     {
     public:
+      //! Function called for each message found by the bulk parser.
+      //! The function takes ownership of the message.
+      typedef std::function<void (Message*)> Callback;
+
       //! Default constructor.
       Parser(void);
 
@@ -63,6 +71,17 @@ namespace DUNE
       Message*
       parse(uint8_t byte);
 
+      //! Parse a block of data, calling a function for every complete
+      //! message found. Frames are decoded in place; only the bytes
+      //! of a frame that is still incomplete at the end of the block
+      //! are kept, to be completed by later calls.
+      //! @param data data bytes.
+      //! @param size number of bytes.
+      //! @param callback function called for every message.
+      //! @return number of messages found.
+      size_t
+      parse(const uint8_t* data, size_t size, const Callback& callback);
+
     private:
       //! Parser stage constants.
       enum ParserStage
@@ -76,6 +95,22 @@ namespace DUNE
       std::vector<uint8_t> m_buf; //!< Internal buffer.
       unsigned int m_pos; //!< Buffer position.
       Header m_header; //!< Holds parsed header (c_payload stage).
+
+      //! Decode the complete frames of a contiguous block.
+      //! @param data data bytes.
+      //! @param size number of bytes.
+      //! @param callback function called for every message.
+      //! @param count incremented for every message.
+      //! @return number of bytes consumed; the rest is the beginning
+      //! of an incomplete frame.
+      size_t
+      scan(const uint8_t* data, size_t size, const Callback& callback, size_t& count);
+
+      //! Compute the number of bytes needed to decide on the frame
+      //! that begins at the start of the internal buffer.
+      //! @return number of bytes.
+      size_t
+      getPendingFrameSize(void);
     };
   }
 }
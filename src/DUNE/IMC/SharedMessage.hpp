@@ -0,0 +1,176 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_IMC_SHARED_MESSAGE_HPP_INCLUDED_
+#define DUNE_IMC_SHARED_MESSAGE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/AtomicCounter.hpp>
+#include <DUNE/IMC/Message.hpp>
+#include <DUNE/IMC/Factory.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Immutable, reference counted handle to an IMC message. The
+    //! message bus hands out a single instance of each dispatched
+    //! message to all recipients, each of which holds a handle until
+    //! its callbacks have been executed. The message is returned to
+    //! the factory's pool when the last handle is released. Reference counting is
+    //! atomic, handles may be copied and released from different
+    //! threads.
+    class SharedMessage
+    {
+    public:
+      //! Create an empty handle.
+      SharedMessage(void):
+        m_block(NULL)
+      { }
+
+      //! Create a handle that takes ownership of a message.
+      //! @param[in] msg message object obtained with
+      //! Factory::produce() or Factory::clone() (may be NULL).
+      explicit
+      SharedMessage(const Message* msg):
+        m_block(NULL)
+      {
+        if (msg != NULL)
+          m_block = new Block(msg);
+      }
+
+      //! Copy constructor, shares the message.
+      //! @param[in] other handle.
+      SharedMessage(const SharedMessage& other):
+        m_block(other.m_block)
+      {
+        acquire();
+      }
+
+      //! Destructor.
+      ~SharedMessage(void)
+      {
+        release();
+      }
+
+      //! Assignment operator, shares the message.
+      //! @param[in] other handle.
+      //! @return this handle.
+      SharedMessage&
+      operator=(const SharedMessage& other)
+      {
+        if (m_block != other.m_block)
+        {
+          release();
+          m_block = other.m_block;
+          acquire();
+        }
+
+        return *this;
+      }
+
+      //! Release the message held by this handle.
+      void
+      reset(void)
+      {
+        release();
+        m_block = NULL;
+      }
+
+      //! Retrieve the message.
+      //! @return message object or NULL if the handle is empty.
+      const Message*
+      get(void) const
+      {
+        return (m_block == NULL) ? NULL : m_block->message;
+      }
+
+      const Message*
+      operator->(void) const
+      {
+        return get();
+      }
+
+      const Message&
+      operator*(void) const
+      {
+        return *get();
+      }
+
+      //! Test if the handle is empty.
+      //! @return true if the handle holds no message, false otherwise.
+      bool
+      isNull(void) const
+      {
+        return m_block == NULL;
+      }
+
+    private:
+      //! Shared control block.
+      struct Block
+      {
+        Block(const Message* msg):
+          message(msg),
+          refs(1)
+        { }
+
+        ~Block(void)
+        {
+          Factory::recycle(const_cast<Message*>(message));
+        }
+
+        //! Owned message.
+        const Message* message;
+        //! Number of handles sharing the message.
+        Concurrency::AtomicCounter refs;
+      };
+
+      //! Control block.
+      Block* m_block;
+
+      void
+      acquire(void)
+      {
+        if (m_block != NULL)
+          m_block->refs.add(1);
+      }
+
+      void
+      release(void)
+      {
+        if (m_block != NULL && m_block->refs.sub(1) == 0)
+          delete m_block;
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,157 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_IMC_WRITER_HPP_INCLUDED_
+#define DUNE_IMC_WRITER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/Exceptions.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Writer;
+
+    //! Growable arena of serialized IMC packets.
+    //!
+    //! Packets are serialized back-to-back into a single buffer
+    //! that is reused across calls to clear(), so a burst of
+    //! messages can be written to a stream or socket with one call
+    //! and without temporary buffers. Packet boundaries are kept to
+    //! allow scatter/gather I/O of individual packets.
+    class Writer
+    {
+    public:
+      //! Constructor.
+      //! @param[in] capacity initial capacity in bytes.
+      Writer(size_t capacity = 4096):
+        m_data(capacity),
+        m_size(0),
+        m_reserved(0)
+      { }
+
+      //! Discard all packets, keeping the allocated memory.
+      void
+      clear(void)
+      {
+        m_size = 0;
+        m_reserved = 0;
+        m_offsets.clear();
+      }
+
+      //! Reserve space at the end of the arena. The returned
+      //! pointer is valid until the next call to reserve().
+      //! @param[in] size number of bytes to reserve.
+      //! @return pointer to the reserved space.
+      uint8_t*
+      reserve(size_t size)
+      {
+        if (m_size + size > m_data.size())
+          m_data.resize(std::max(m_data.size() * 2, m_size + size));
+
+        m_reserved = size;
+        return &m_data[m_size];
+      }
+
+      //! Commit a packet previously written to reserved space.
+      //! @param[in] size packet size, at most the reserved size.
+      void
+      commit(size_t size)
+      {
+        if (size > m_reserved)
+          throw InternalBufferTooShort();
+
+        m_offsets.push_back(m_size);
+        m_size += size;
+        m_reserved = 0;
+      }
+
+      //! Get serialized data of all packets.
+      //! @return pointer to data.
+      const uint8_t*
+      getData(void) const
+      {
+        return m_data.empty() ? NULL : &m_data[0];
+      }
+
+      //! Get total size of all packets.
+      //! @return size in bytes.
+      size_t
+      getSize(void) const
+      {
+        return m_size;
+      }
+
+      //! Get number of packets.
+      //! @return number of packets.
+      size_t
+      getCount(void) const
+      {
+        return m_offsets.size();
+      }
+
+      //! Get serialized data of a packet.
+      //! @param[in] index packet index.
+      //! @return pointer to packet data.
+      const uint8_t*
+      getPacketData(size_t index) const
+      {
+        return &m_data[m_offsets[index]];
+      }
+
+      //! Get size of a packet.
+      //! @param[in] index packet index.
+      //! @return packet size in bytes.
+      size_t
+      getPacketSize(size_t index) const
+      {
+        size_t end = (index + 1 < m_offsets.size()) ? m_offsets[index + 1] : m_size;
+        return end - m_offsets[index];
+      }
+
+    private:
+      //! Arena.
+      std::vector<uint8_t> m_data;
+      //! Used bytes.
+      size_t m_size;
+      //! Bytes reserved by the last call to reserve().
+      size_t m_reserved;
+      //! Offset of each packet.
+      std::vector<size_t> m_offsets;
+    };
+  }
+}
+
+#endif
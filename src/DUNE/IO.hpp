@@ -38,6 +38,8 @@ namespace DUNE
 }
 
 #include <DUNE/IO/Handle.hpp>
+#include <DUNE/IO/Event.hpp>
 #include <DUNE/IO/Poll.hpp>
+#include <DUNE/IO/Reactor.hpp>
 
 #endif
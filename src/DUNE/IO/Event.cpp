@@ -0,0 +1,157 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cerrno>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/System/Error.hpp>
+#include <DUNE/IO/Event.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_FCNTL_H)
+#  include <fcntl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_EVENTFD)
+#  include <sys/eventfd.h>
+#endif
+
+namespace DUNE
+{
+  namespace IO
+  {
+    using System::Error;
+
+    Event::Event(void)
+    {
+#if defined(DUNE_SYS_HAS_EVENTFD)
+      m_fds[0] = m_fds[1] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+      if (m_fds[0] < 0)
+        throw Error("creating event", Error::getLastMessage());
+
+#elif defined(DUNE_OS_POSIX)
+      if (pipe(m_fds) < 0)
+        throw Error("creating event", Error::getLastMessage());
+
+      for (unsigned i = 0; i < 2; ++i)
+      {
+        fcntl(m_fds[i], F_SETFL, fcntl(m_fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(m_fds[i], F_SETFD, FD_CLOEXEC);
+      }
+
+#elif defined(DUNE_OS_WINDOWS)
+      m_handle = CreateEvent(NULL, TRUE, FALSE, NULL);
+      if (m_handle == NULL)
+        throw Error("creating event", Error::getLastMessage());
+#endif
+    }
+
+    Event::~Event(void)
+    {
+#if defined(DUNE_OS_POSIX)
+      close(m_fds[0]);
+      if (m_fds[1] != m_fds[0])
+        close(m_fds[1]);
+
+#elif defined(DUNE_OS_WINDOWS)
+      CloseHandle(m_handle);
+#endif
+    }
+
+    void
+    Event::signal(void)
+    {
+#if defined(DUNE_SYS_HAS_EVENTFD)
+      uint64_t one = 1;
+      while (::write(m_fds[1], &one, sizeof(one)) < 0 && errno == EINTR)
+      { }
+
+#elif defined(DUNE_OS_POSIX)
+      // A full pipe is already signalled.
+      uint8_t one = 1;
+      while (::write(m_fds[1], &one, sizeof(one)) < 0 && errno == EINTR)
+      { }
+
+#elif defined(DUNE_OS_WINDOWS)
+      SetEvent(m_handle);
+#endif
+    }
+
+    void
+    Event::clear(void)
+    {
+#if defined(DUNE_SYS_HAS_EVENTFD)
+      uint64_t count;
+      while (::read(m_fds[0], &count, sizeof(count)) < 0 && errno == EINTR)
+      { }
+
+#elif defined(DUNE_OS_POSIX)
+      uint8_t bfr[64];
+      ssize_t rv;
+      do
+        rv = ::read(m_fds[0], bfr, sizeof(bfr));
+      while (rv > 0 || (rv < 0 && errno == EINTR));
+
+#elif defined(DUNE_OS_WINDOWS)
+      ResetEvent(m_handle);
+#endif
+    }
+
+    NativeHandle
+    Event::doGetNative(void) const
+    {
+#if defined(DUNE_OS_POSIX)
+      return m_fds[0];
+#elif defined(DUNE_OS_WINDOWS)
+      return m_handle;
+#endif
+    }
+
+    size_t
+    Event::doRead(uint8_t* data, size_t size)
+    {
+      (void)data;
+      (void)size;
+      clear();
+      return 0;
+    }
+
+    size_t
+    Event::doWrite(const uint8_t* data, size_t size)
+    {
+      (void)data;
+      signal();
+      return size;
+    }
+  }
+}
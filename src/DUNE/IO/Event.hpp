@@ -0,0 +1,96 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_IO_EVENT_HPP_INCLUDED_
+#define DUNE_IO_EVENT_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IO/Handle.hpp>
+
+namespace DUNE
+{
+  namespace IO
+  {
+    // Export symbol.
+    class DUNE_DLL_SYM Event;
+
+    //! Event that can be waited for together with other I/O handles
+    //! (e.g., using Poll). The event stays signalled, and its handle
+    //! readable, until it is cleared. On Linux this is an eventfd,
+    //! on other POSIX systems a pipe and on Microsoft Windows a
+    //! manual-reset event object.
+    class Event: public Handle
+    {
+    public:
+      //! Constructor. The event starts cleared.
+      Event(void);
+
+      //! Destructor.
+      ~Event(void);
+
+      //! Signal the event. May be called from any thread.
+      void
+      signal(void);
+
+      //! Clear the event.
+      void
+      clear(void);
+
+    private:
+#if defined(DUNE_OS_POSIX)
+      //! Descriptors: read end and write end (same for eventfd).
+      int m_fds[2];
+#elif defined(DUNE_OS_WINDOWS)
+      //! Event object.
+      HANDLE m_handle;
+#endif
+
+      NativeHandle
+      doGetNative(void) const;
+
+      //! Clear the event.
+      //! @return zero.
+      size_t
+      doRead(uint8_t* data, size_t size);
+
+      //! Signal the event.
+      //! @return size.
+      size_t
+      doWrite(const uint8_t* data, size_t size);
+
+      //! Non-copyable.
+      Event(const Event&);
+
+      //! Non-assignable.
+      Event&
+      operator=(const Event&);
+    };
+  }
+}
+
+#endif
@@ -35,6 +35,7 @@
 #include <DUNE/Config.hpp>
 #include <DUNE/System/Error.hpp>
 #include <DUNE/Time/Constants.hpp>
+#include <DUNE/Time/Lockstep.hpp>
 #include <DUNE/Time/Utils.hpp>
 #include <DUNE/IO/Poll.hpp>
 
@@ -45,6 +46,11 @@ namespace DUNE
     using std::memset;
     using System::Error;
 
+#if defined(DUNE_OS_WINDOWS)
+    //! Wait period while handles are polled for writing (s).
+    static const double c_write_retry = 0.005;
+#endif
+
     void
     Poll::add(const NativeHandle& handle)
     {
@@ -60,6 +66,33 @@ namespace DUNE
         m_handles.erase(itr);
     }
 
+    void
+    Poll::addWrite(const NativeHandle& handle)
+    {
+      if (std::find(m_write_handles.begin(), m_write_handles.end(), handle) == m_write_handles.end())
+        m_write_handles.push_back(handle);
+    }
+
+    void
+    Poll::removeWrite(const NativeHandle& handle)
+    {
+      std::vector<NativeHandle>::iterator itr;
+      itr = std::find(m_write_handles.begin(), m_write_handles.end(), handle);
+      if (itr != m_write_handles.end())
+        m_write_handles.erase(itr);
+    }
+
+    bool
+    Poll::wasWritable(const NativeHandle& handle)
+    {
+#if defined(DUNE_OS_POSIX)
+      return FD_ISSET(handle, &m_wfd) != 0;
+
+#elif defined(DUNE_OS_WINDOWS)
+      return std::find(m_write_handles.begin(), m_write_handles.end(), handle) != m_write_handles.end();
+#endif
+    }
+
     bool
     Poll::wasTriggered(const NativeHandle& handle)
     {
@@ -82,7 +115,50 @@ namespace DUNE
     bool
     Poll::poll(double timeout)
     {
+      if (timeout == 0 || !Time::Lockstep::isParticipant())
+        return wait(timeout);
+
+      // Count as waiting for the clock while blocked.
+      Time::Lockstep::Idle idle(timeout);
+      while (true)
+      {
+        bool done = idle.done();
+        if (wait(done ? 0 : Time::Lockstep::Idle::getPeriod()))
+          return true;
+
+        if (done)
+          return false;
+      }
+    }
+
+    bool
+    Poll::poll(const NativeHandle& handle, double timeout)
+    {
+      if (timeout == 0 || !Time::Lockstep::isParticipant())
+        return wait(handle, timeout);
+
+      // Count as waiting for the clock while blocked.
+      Time::Lockstep::Idle idle(timeout);
+      while (true)
+      {
+        bool done = idle.done();
+        if (wait(handle, done ? 0 : Time::Lockstep::Idle::getPeriod()))
+          return true;
+
+        if (done)
+          return false;
+      }
+    }
+
+    bool
+    Poll::wait(double timeout)
+    {
 #if defined(DUNE_OS_WINDOWS)
+      // Socket write readiness cannot be waited for: retry soon and
+      // report the handles as writable.
+      if (!m_write_handles.empty() && (timeout < 0.0 || timeout > c_write_retry))
+        timeout = c_write_retry;
+
       DWORD count = m_handles.size();
       m_rv = WaitForMultipleObjects(count, &m_handles[0], FALSE, timeout * 1000);
 
@@ -93,7 +169,7 @@ namespace DUNE
 
       if (m_rv == WAIT_TIMEOUT)
       {
-        return false;
+        return !m_write_handles.empty();
       }
 
       if (m_rv == WAIT_FAILED)
@@ -105,6 +181,7 @@ namespace DUNE
       int rv = 0;
       NativeHandle max = 0;
       FD_ZERO(&m_rfd);
+      FD_ZERO(&m_wfd);
 
       for (std::vector<NativeHandle>::iterator itr = m_handles.begin(); itr != m_handles.end(); ++itr)
       {
@@ -113,14 +190,21 @@ namespace DUNE
         FD_SET(*itr, &m_rfd);
       }
 
+      for (std::vector<NativeHandle>::iterator itr = m_write_handles.begin(); itr != m_write_handles.end(); ++itr)
+      {
+        if (*itr > max)
+          max = *itr;
+        FD_SET(*itr, &m_wfd);
+      }
+
       if (timeout < 0.0)
       {
-        rv = select(max + 1, &m_rfd, NULL, NULL, NULL);
+        rv = select(max + 1, &m_rfd, &m_wfd, NULL, NULL);
       }
       else
       {
         timeval tv = DUNE_TIMEVAL_INIT_SEC_FP(timeout);
-        rv = select(max + 1, &m_rfd, NULL, NULL, &tv);
+        rv = select(max + 1, &m_rfd, &m_wfd, NULL, &tv);
       }
 
       if (rv == -1)
@@ -137,7 +221,7 @@ namespace DUNE
     }
 
     bool
-    Poll::poll(const NativeHandle& handle, double timeout)
+    Poll::wait(const NativeHandle& handle, double timeout)
     {
 #if defined(DUNE_OS_WINDOWS)
       DWORD rv = WaitForSingleObjectEx(handle, timeout * 1000, FALSE);
@@ -87,12 +87,53 @@ namespace DUNE
         remove(handle.getNative());
       }
 
+      //! Add native I/O handle to the handles polled for writing.
+      //! poll() then also returns when the handle can be written to.
+      //! On Microsoft Windows the handle is reported as writable
+      //! after at most a few milliseconds.
+      //! @param[in] handle native I/O handle.
+      void
+      addWrite(const NativeHandle& handle);
+
+      //! Add I/O handle to the handles polled for writing.
+      //! @param[in] handle I/O handle.
+      void
+      addWrite(const Handle& handle)
+      {
+        addWrite(handle.getNative());
+      }
+
+      //! Remove native I/O handle from the handles polled for writing.
+      //! @param[in] handle native I/O handle.
+      void
+      removeWrite(const NativeHandle& handle);
+
+      //! Remove I/O handle from the handles polled for writing.
+      //! @param[in] handle I/O handle.
+      void
+      removeWrite(const Handle& handle)
+      {
+        removeWrite(handle.getNative());
+      }
+
       bool
       poll(double timeout);
 
       bool
       wasTriggered(const NativeHandle& handle);
 
+      //! Test if a handle polled for writing can be written to.
+      //! @param[in] handle native I/O handle.
+      //! @return true if the handle is writable, false otherwise.
+      bool
+      wasWritable(const NativeHandle& handle);
+
+      bool
+      wasWritable(const Handle& handle)
+      {
+        return wasWritable(handle.getNative());
+      }
+
       bool
       wasTriggered(const Handle& handle)
       {
@@ -100,10 +141,29 @@ namespace DUNE
       }
 
     private:
+      //! Wait for a handle to become readable in real time.
+      //! @param[in] handle native I/O handle.
+      //! @param[in] timeout amount of time to wait (in seconds),
+      //! negative to wait forever.
+      //! @return true if the handle is readable, false otherwise.
+      static bool
+      wait(const NativeHandle& handle, double timeout);
+
+      //! Wait for any handle of the pool to become readable in real
+      //! time.
+      //! @param[in] timeout amount of time to wait (in seconds),
+      //! negative to wait forever.
+      //! @return true if a handle is readable, false otherwise.
+      bool
+      wait(double timeout);
+
       //! List of native I/O handles.
       std::vector<NativeHandle> m_handles;
+      //! List of native I/O handles polled for writing.
+      std::vector<NativeHandle> m_write_handles;
 #if defined(DUNE_OS_POSIX)
       fd_set m_rfd;
+      fd_set m_wfd;
 #elif defined(DUNE_OS_WINDOWS)
       DWORD m_rv;
 #endif
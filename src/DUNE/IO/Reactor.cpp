@@ -0,0 +1,392 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cerrno>
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/System/Error.hpp>
+#include <DUNE/IO/Poll.hpp>
+#include <DUNE/IO/Reactor.hpp>
+#include <DUNE/Time/Delay.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_EPOLL_CREATE1)
+#  include <sys/epoll.h>
+#  include <unistd.h>
+#  include <fcntl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_EVENTFD)
+#  include <sys/eventfd.h>
+#endif
+
+namespace DUNE
+{
+  namespace IO
+  {
+    using System::Error;
+
+    //! Maximum number of events retrieved by each epoll_wait() call.
+    static const int c_max_events = 16;
+    //! Polling timeout when epoll is not available (s).
+    static const double c_poll_timeout = 0.1;
+    //! Reactor whose handler runs on the calling thread.
+    static thread_local const Reactor* t_reactor = NULL;
+    //! Handle whose handler runs on the calling thread.
+    static thread_local NativeHandle t_handle;
+
+    class Reactor::Dispatcher: public Concurrency::Thread
+    {
+    public:
+      Dispatcher(Reactor& reactor):
+        m_reactor(reactor)
+      { }
+
+    private:
+      Reactor& m_reactor;
+
+      void
+      run(void)
+      {
+        m_reactor.dispatch();
+      }
+    };
+
+#if defined(DUNE_SYS_HAS_EPOLL_CREATE1)
+    //! Encode an epoll event payload.
+    static uint64_t
+    encodeEvent(NativeHandle handle, unsigned generation)
+    {
+      return ((uint64_t)generation << 32) | (uint32_t)handle;
+    }
+#endif
+
+    Reactor::Reactor(unsigned threads):
+      m_thread_count(threads == 0 ? 1 : threads),
+      m_generation(0),
+      m_stopping(false)
+    {
+#if defined(DUNE_SYS_HAS_EPOLL_CREATE1)
+      m_epoll = epoll_create1(EPOLL_CLOEXEC);
+      if (m_epoll < 0)
+        throw Error("creating epoll instance", Error::getLastMessage());
+
+#  if defined(DUNE_SYS_HAS_EVENTFD)
+      m_wakeup[0] = m_wakeup[1] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+      if (m_wakeup[0] < 0)
+        throw Error("creating wake up descriptor", Error::getLastMessage());
+#  else
+      if (pipe(m_wakeup) < 0)
+        throw Error("creating wake up descriptor", Error::getLastMessage());
+#  endif
+
+      // Level-triggered: once written it wakes up every thread.
+      epoll_event ev;
+      std::memset(&ev, 0, sizeof(ev));
+      ev.events = EPOLLIN;
+      ev.data.u64 = encodeEvent(m_wakeup[0], 0);
+      if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup[0], &ev) < 0)
+        throw Error("watching wake up descriptor", Error::getLastMessage());
+#endif
+    }
+
+    Reactor::~Reactor(void)
+    {
+      m_cond.lock();
+      m_stopping = true;
+      m_cond.unlock();
+
+#if defined(DUNE_SYS_HAS_EPOLL_CREATE1)
+      uint64_t one = 1;
+      if (write(m_wakeup[1], &one, sizeof(one)) < 0)
+      { }
+#endif
+
+      for (size_t i = 0; i < m_threads.size(); ++i)
+      {
+        m_threads[i]->stopAndJoin();
+        delete m_threads[i];
+      }
+
+#if defined(DUNE_SYS_HAS_EPOLL_CREATE1)
+      close(m_epoll);
+      close(m_wakeup[0]);
+      if (m_wakeup[1] != m_wakeup[0])
+        close(m_wakeup[1]);
+#endif
+    }
+
+    void
+    Reactor::start(void)
+    {
+      if (!m_threads.empty())
+        return;
+
+      for (unsigned i = 0; i < m_thread_count; ++i)
+      {
+        m_threads.push_back(new Dispatcher(*this));
+        m_threads.back()->start();
+      }
+    }
+
+    void
+    Reactor::add(NativeHandle handle, Handler* handler)
+    {
+      m_cond.lock();
+
+      bool known = m_entries.find(handle) != m_entries.end();
+      Entry& entry = m_entries[handle];
+      entry.handler = handler;
+      entry.generation = ++m_generation;
+      entry.removed = false;
+      if (!known)
+        entry.running = false;
+
+#if defined(DUNE_SYS_HAS_EPOLL_CREATE1)
+      epoll_event ev;
+      std::memset(&ev, 0, sizeof(ev));
+      ev.events = EPOLLIN | EPOLLRDHUP | EPOLLET | EPOLLONESHOT;
+      ev.data.u64 = encodeEvent(handle, entry.generation);
+
+      if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, handle, &ev) < 0
+          && (errno != EEXIST || epoll_ctl(m_epoll, EPOLL_CTL_MOD, handle, &ev) < 0))
+      {
+        if (!known)
+          m_entries.erase(handle);
+        m_cond.unlock();
+        throw Error("watching handle", Error::getLastMessage());
+      }
+#endif
+
+      start();
+      m_cond.unlock();
+    }
+
+    void
+    Reactor::remove(NativeHandle handle)
+    {
+      m_cond.lock();
+
+      std::map<NativeHandle, Entry>::iterator itr = m_entries.find(handle);
+      if (itr == m_entries.end())
+      {
+        m_cond.unlock();
+        return;
+      }
+
+#if defined(DUNE_SYS_HAS_EPOLL_CREATE1)
+      epoll_ctl(m_epoll, EPOLL_CTL_DEL, handle, NULL);
+#endif
+
+      // Removed by its own handler: run() erases the entry when the
+      // handler returns.
+      if (itr->second.running && t_reactor == this && t_handle == handle)
+      {
+        itr->second.removed = true;
+        m_cond.unlock();
+        return;
+      }
+
+      // Events already retrieved for this registration are discarded
+      // by run() once the entry is gone.
+      while (itr != m_entries.end() && itr->second.running)
+      {
+        m_cond.wait();
+        itr = m_entries.find(handle);
+      }
+
+      if (itr != m_entries.end())
+        m_entries.erase(itr);
+
+      m_cond.unlock();
+    }
+
+    size_t
+    Reactor::size(void)
+    {
+      m_cond.lock();
+      size_t rv = m_entries.size();
+      m_cond.unlock();
+      return rv;
+    }
+
+    void
+    Reactor::run(NativeHandle handle, unsigned generation)
+    {
+      m_cond.lock();
+
+      std::map<NativeHandle, Entry>::iterator itr = m_entries.find(handle);
+      if (itr == m_entries.end() || itr->second.running
+          || (generation != 0 && itr->second.generation != generation))
+      {
+        m_cond.unlock();
+        return;
+      }
+
+      Entry& entry = itr->second;
+      entry.running = true;
+      Handler* handler = entry.handler;
+      unsigned current = entry.generation;
+      m_cond.unlock();
+
+      // A handler that throws is dropped, the dispatch thread keeps
+      // serving other handles.
+      bool failed = false;
+      t_reactor = this;
+      t_handle = handle;
+      try
+      {
+        handler->onReadable(handle);
+      }
+      catch (...)
+      {
+        failed = true;
+      }
+      t_reactor = NULL;
+
+      m_cond.lock();
+      // Entries are only erased once they stop running.
+      itr = m_entries.find(handle);
+      itr->second.running = false;
+
+      // Unless the handle was added again meanwhile.
+      if (failed && !itr->second.removed && itr->second.generation == current)
+      {
+#if defined(DUNE_SYS_HAS_EPOLL_CREATE1)
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, handle, NULL);
+#endif
+        itr->second.removed = true;
+      }
+
+      if (itr->second.removed)
+      {
+        m_entries.erase(itr);
+        m_cond.broadcast();
+        m_cond.unlock();
+        return;
+      }
+
+#if defined(DUNE_SYS_HAS_EPOLL_CREATE1)
+      // Re-arm: epoll reports the handle again if data is pending.
+      epoll_event ev;
+      std::memset(&ev, 0, sizeof(ev));
+      ev.events = EPOLLIN | EPOLLRDHUP | EPOLLET | EPOLLONESHOT;
+      ev.data.u64 = encodeEvent(handle, itr->second.generation);
+      epoll_ctl(m_epoll, EPOLL_CTL_MOD, handle, &ev);
+#endif
+
+      m_cond.broadcast();
+      m_cond.unlock();
+    }
+
+#if defined(DUNE_SYS_HAS_EPOLL_CREATE1)
+    void
+    Reactor::dispatch(void)
+    {
+      epoll_event events[c_max_events];
+
+      while (true)
+      {
+        int count = epoll_wait(m_epoll, events, c_max_events, -1);
+        if (count < 0)
+        {
+          if (errno == EINTR)
+            continue;
+
+          throw Error("waiting for events", Error::getLastMessage());
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+          NativeHandle handle = (NativeHandle)(uint32_t)(events[i].data.u64 & 0xffffffff);
+          unsigned generation = (unsigned)(events[i].data.u64 >> 32);
+
+          if (handle == m_wakeup[0] && generation == 0)
+            return;
+
+          run(handle, generation);
+        }
+      }
+    }
+#else
+    void
+    Reactor::dispatch(void)
+    {
+      std::vector<NativeHandle> handles;
+
+      while (true)
+      {
+        Poll poll;
+        handles.clear();
+
+        m_cond.lock();
+        if (m_stopping)
+        {
+          m_cond.unlock();
+          return;
+        }
+
+        std::map<NativeHandle, Entry>::iterator itr = m_entries.begin();
+        for (; itr != m_entries.end(); ++itr)
+        {
+          poll.add(itr->first);
+          handles.push_back(itr->first);
+        }
+        m_cond.unlock();
+
+        if (handles.empty())
+        {
+          Time::Delay::wait(c_poll_timeout);
+          continue;
+        }
+
+        // A handle may be removed and closed while we poll it: the
+        // next iteration uses the updated set.
+        try
+        {
+          if (!poll.poll(c_poll_timeout))
+            continue;
+        }
+        catch (Error&)
+        {
+          continue;
+        }
+
+        for (size_t i = 0; i < handles.size(); ++i)
+        {
+          if (poll.wasTriggered(handles[i]))
+            run(handles[i], 0);
+        }
+      }
+    }
+#endif
+  }
+}
@@ -0,0 +1,179 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_IO_REACTOR_HPP_INCLUDED_
+#define DUNE_IO_REACTOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <map>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
+#include <DUNE/IO/Handle.hpp>
+
+namespace DUNE
+{
+  namespace IO
+  {
+    // Export symbol.
+    class DUNE_DLL_SYM Reactor;
+
+    //! Dispatches read readiness of I/O handles to handlers running on
+    //! a small pool of threads. On Linux this uses edge-triggered,
+    //! one-shot epoll: each handle is watched by the kernel (no
+    //! FD_SETSIZE limit) and its handler is never run by two threads
+    //! at once. The handle is re-armed when the handler returns, so
+    //! data that arrived meanwhile triggers a new call and handlers
+    //! may read as little or as much as they want. On other systems a
+    //! single thread polls the handles with Poll. Threads are started
+    //! when the first handle is added.
+    class Reactor
+    {
+    public:
+      //! Readiness handler.
+      class Handler
+      {
+      public:
+        virtual
+        ~Handler(void)
+        { }
+
+        //! Called when the handle has data to read (or was closed by
+        //! the peer). If it throws an exception the handle is no
+        //! longer watched.
+        //! @param[in] handle native I/O handle.
+        virtual void
+        onReadable(NativeHandle handle) = 0;
+      };
+
+      //! Constructor.
+      //! @param[in] threads number of dispatch threads.
+      Reactor(unsigned threads = 1);
+
+      //! Destructor. Stops all dispatch threads.
+      ~Reactor(void);
+
+      //! Watch a native I/O handle. Adding a handle that is already
+      //! watched replaces its handler.
+      //! @param[in] handle native I/O handle.
+      //! @param[in] handler handler.
+      void
+      add(NativeHandle handle, Handler* handler);
+
+      //! Watch an I/O handle.
+      //! @param[in] handle I/O handle.
+      //! @param[in] handler handler.
+      void
+      add(const Handle& handle, Handler* handler)
+      {
+        add(handle.getNative(), handler);
+      }
+
+      //! Stop watching a native I/O handle. Returns only after the
+      //! handler of this handle is no longer running, so the handle
+      //! may then be closed. When called from that handler (for
+      //! instance on end of file) it returns at once and the handler
+      //! is not called again.
+      //! @param[in] handle native I/O handle.
+      void
+      remove(NativeHandle handle);
+
+      //! Stop watching an I/O handle.
+      //! @param[in] handle I/O handle.
+      void
+      remove(const Handle& handle)
+      {
+        remove(handle.getNative());
+      }
+
+      //! Retrieve the number of watched handles.
+      //! @return number of handles.
+      size_t
+      size(void);
+
+    private:
+      class Dispatcher;
+
+      //! Watched handle.
+      struct Entry
+      {
+        //! Handler.
+        Handler* handler;
+        //! Registration number, used to discard stale events.
+        unsigned generation;
+        //! True while a dispatch thread runs the handler.
+        bool running;
+        //! True if the handler removed its own handle.
+        bool removed;
+      };
+
+      //! Number of dispatch threads.
+      unsigned m_thread_count;
+      //! Dispatch threads.
+      std::vector<Dispatcher*> m_threads;
+      //! Watched handles.
+      std::map<NativeHandle, Entry> m_entries;
+      //! Next registration number.
+      unsigned m_generation;
+      //! Protects the above and signals remove().
+      Concurrency::Condition m_cond;
+      //! True when the reactor is being destroyed.
+      bool m_stopping;
+#if defined(DUNE_SYS_HAS_EPOLL_CREATE1)
+      //! epoll instance.
+      int m_epoll;
+      //! Descriptor used to wake up dispatch threads.
+      int m_wakeup[2];
+#endif
+
+      //! Start dispatch threads if needed.
+      void
+      start(void);
+
+      //! Dispatch loop.
+      void
+      dispatch(void);
+
+      //! Run the handler of a handle.
+      //! @param[in] handle native I/O handle.
+      //! @param[in] generation registration number of the event.
+      void
+      run(NativeHandle handle, unsigned generation);
+
+      //! Non-copyable.
+      Reactor(const Reactor&);
+
+      //! Non-assignable.
+      Reactor&
+      operator=(const Reactor&);
+    };
+  }
+}
+
+#endif
@@ -42,6 +42,7 @@ namespace DUNE
 #include <DUNE/Math/EulerAnglesZyx.hpp>
 #include <DUNE/Math/General.hpp>
 #include <DUNE/Math/Matrix.hpp>
+#include <DUNE/Math/SMatrix.hpp>
 #include <DUNE/Math/Angles.hpp>
 #include <DUNE/Math/Random.hpp>
 #include <DUNE/Math/Optimization.hpp>
@@ -51,5 +52,6 @@ namespace DUNE
 #include <DUNE/Math/MultiMovingAverage.hpp>
 #include <DUNE/Math/Grid.hpp>
 #include <DUNE/Math/FIRFilter.hpp>
+#include <DUNE/Math/NeighborGrid.hpp>
 
 #endif
@@ -24,6 +24,40 @@ namespace DUNE
       yaw   = std::atan2(2*(w*z + x*y), 1 - 2*(y*y + z*z));
     }
 
+    SMatrix<3, 3> EulerAnglesZyx::rotationMatrix() const
+    {
+      const double cr = std::cos(roll);
+      const double sr = std::sin(roll);
+      const double cp = std::cos(pitch);
+      const double sp = std::sin(pitch);
+      const double cy = std::cos(yaw);
+      const double sy = std::sin(yaw);
+
+      double data[9] = {
+        cy*cp, cy*sp*sr - sy*cr, cy*sp*cr + sy*sr,
+        sy*cp, sy*sp*sr + cy*cr, sy*sp*cr - cy*sr,
+          -sp,            cp*sr,            cp*cr,
+      };
+
+      return SMatrix<3, 3>(data);
+    }
+
+    SMatrix<3, 3> EulerAnglesZyx::angVelTransform() const
+    {
+      const double cr = std::cos(roll);
+      const double sr = std::sin(roll);
+      const double cp = std::cos(pitch);
+      const double tp = std::tan(pitch);
+
+      double data[9] = {
+        1, sr*tp, cr*tp,
+        0,    cr,   -sr,
+        0, sr/cp, cr/cp,
+      };
+
+      return SMatrix<3, 3>(data);
+    }
+
     std::ostream& operator<<(std::ostream& os, const EulerAnglesZyx& eul)
     {
       os << eul.roll << std::endl << eul.pitch << std::endl << eul.yaw << std::endl;
@@ -2,6 +2,7 @@
 #define DUNE_MATH_EULER_ANGLES_ZYX_HPP_INCLUDED_
 
 #include <DUNE/Math/Matrix.hpp>
+#include <DUNE/Math/SMatrix.hpp>
 #include <DUNE/Math/Quaternion.hpp>
 
 #include <ostream>
@@ -19,6 +20,10 @@ namespace DUNE
       EulerAnglesZyx();
       EulerAnglesZyx(double roll, double pitch, double yaw);
       EulerAnglesZyx(const Quaternion& quat);
+      // Body to NED rotation matrix, same as Matrix::toDCM() of [roll pitch yaw].
+      SMatrix<3, 3> rotationMatrix() const;
+      // Transform from body angular rates to Euler angle rates.
+      SMatrix<3, 3> angVelTransform() const;
       friend std::ostream& operator<<(std::ostream& os, const EulerAnglesZyx& eul);
       double roll;
       double pitch;
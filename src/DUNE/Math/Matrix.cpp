@@ -60,6 +60,8 @@ namespace DUNE
   {
     //! The value used to test for zero in matrix inversion
     double Matrix::precision = 1e-10;
+    //! Block size (in elements) used by gemm().
+    static const size_t c_gemm_block = 64;
 
     Matrix::Matrix(void):
       m_nrows(0),
@@ -206,6 +208,15 @@ namespace DUNE
       *m_counter = 1;
     }
 
+    void
+    Matrix::prepare(size_t r, size_t c)
+    {
+      if (m_nrows == r && m_ncols == c && m_counter != NULL && *m_counter == 1)
+        return;
+
+      resize(r, c);
+    }
+
     double*
     Matrix::begin(void)
     {
@@ -1530,31 +1541,7 @@ namespace DUNE
         throw Matrix::Error("Incompatible dimensions!");
 
       Matrix s(m1.m_nrows, m2.m_ncols);
-
-      int n = m1.m_nrows;
-      int m = m1.m_ncols;
-      int r = m2.m_ncols;
-
-      double* m1_p = m1.m_data;
-
-      for (int i = 0; i < n; i++)
-      {
-        for (int k = 0; k < m; k++)
-        {
-          double v = *m1_p++; // <-> v = m1(i,k)
-          double* m2_p = m2.m_data + k * r;
-          double* s_p = s.m_data + i * r;
-
-          for (int j = 0; j < r; j++)
-          {
-            if (!k)
-              *s_p = 0;
-            *s_p += v * (*m2_p); // <-> s(i,j) += m1(i,k) * m2(k,j)
-            s_p++;
-            m2_p++;
-          }
-        }
-      }
+      Matrix::gemm(1.0, m1, false, m2, false, 0.0, s);
       return s;
     }
 
@@ -2290,6 +2277,179 @@ namespace DUNE
       return v;
     }
 
+    void
+    Matrix::gemm(double alpha, const Matrix& a, bool ta, const Matrix& b, bool tb,
+                 double beta, Matrix& c)
+    {
+      if (a.isEmpty() || b.isEmpty())
+        throw Error("Trying to access an empty matrix!");
+
+      const size_t n = ta ? a.m_ncols : a.m_nrows;
+      const size_t m = ta ? a.m_nrows : a.m_ncols;
+      const size_t r = tb ? b.m_nrows : b.m_ncols;
+
+      if ((tb ? b.m_ncols : b.m_nrows) != m)
+        throw Error("Incompatible dimensions!");
+
+      // Evaluate into a temporary if the destination shares storage
+      // with one of the operands.
+      if (c.m_data != NULL && (c.m_data == a.m_data || c.m_data == b.m_data))
+      {
+        Matrix t;
+        if (beta != 0.0)
+        {
+          t = c;
+          t.split();
+        }
+
+        gemm(alpha, a, ta, b, tb, beta, t);
+        c = t;
+        return;
+      }
+
+      if (beta != 0.0)
+      {
+        if (c.m_nrows != n || c.m_ncols != r)
+          throw Error("Incompatible dimensions!");
+
+        c.split();
+      }
+      else
+      {
+        c.prepare(n, r);
+      }
+
+      if (beta == 0.0)
+        std::memset(c.m_data, 0, c.m_size * sizeof(double));
+      else if (beta != 1.0)
+        c *= beta;
+
+      if (alpha == 0.0)
+        return;
+
+      const size_t lda = a.m_ncols;
+      const size_t ldb = b.m_ncols;
+      // Packed panel of transpose(b), so that the inner loop is always
+      // contiguous.
+      std::vector<double> panel;
+      if (tb)
+        panel.resize(std::min(c_gemm_block, m) * std::min(c_gemm_block, r));
+
+      for (size_t kk = 0; kk < m; kk += c_gemm_block)
+      {
+        const size_t kn = std::min(c_gemm_block, m - kk);
+
+        for (size_t jj = 0; jj < r; jj += c_gemm_block)
+        {
+          const size_t jn = std::min(c_gemm_block, r - jj);
+          const double* bp = b.m_data + kk * ldb + jj;
+          size_t ldp = ldb;
+
+          if (tb)
+          {
+            for (size_t k = 0; k < kn; ++k)
+              for (size_t j = 0; j < jn; ++j)
+                panel[k * jn + j] = b.m_data[(jj + j) * ldb + kk + k];
+
+            bp = &panel[0];
+            ldp = jn;
+          }
+
+          for (size_t i = 0; i < n; ++i)
+          {
+            double* cp = c.m_data + i * r + jj;
+
+            for (size_t k = 0; k < kn; ++k)
+            {
+              const double v = alpha * (ta ? a.m_data[(kk + k) * lda + i] : a.m_data[i * lda + kk + k]);
+              const double* bk = bp + k * ldp;
+              for (size_t j = 0; j < jn; ++j)
+                cp[j] += v * bk[j];
+            }
+          }
+        }
+      }
+    }
+
+    void
+    Matrix::multiplyInto(const Matrix& a, const Matrix& b, Matrix& c)
+    {
+      gemm(1.0, a, false, b, false, 0.0, c);
+    }
+
+    void
+    Matrix::transposeInto(const Matrix& a, Matrix& c)
+    {
+      if (a.isEmpty())
+        throw Error("Trying to access an empty matrix!");
+
+      if (&a == &c || a.m_data == c.m_data)
+      {
+        c = transpose(a);
+        return;
+      }
+
+      c.prepare(a.m_ncols, a.m_nrows);
+
+      for (size_t i = 0; i < a.m_nrows; ++i)
+        for (size_t j = 0; j < a.m_ncols; ++j)
+          c.m_data[j * a.m_nrows + i] = a.m_data[i * a.m_ncols + j];
+    }
+
+    void
+    Matrix::quadraticInto(const Matrix& a, const Matrix& b, const Matrix& q, Matrix& c)
+    {
+      if (a.isEmpty() || b.isEmpty())
+        throw Error("Trying to access an empty matrix!");
+
+      const size_t n = a.m_nrows;
+      const size_t m = a.m_ncols;
+
+      if (b.m_nrows != m || b.m_ncols != m)
+        throw Error("Incompatible dimensions!");
+
+      if (!q.isEmpty() && (q.m_nrows != n || q.m_ncols != n))
+        throw Error("Incompatible dimensions!");
+
+      if (c.m_data != NULL && (c.m_data == a.m_data || c.m_data == b.m_data))
+        throw Error("Destination matrix must not alias the operands!");
+
+      // 'q' may be 'c' itself: each element of 'q' is read just before
+      // the same element of 'c' is written.
+      if (q.m_data != NULL && q.m_data == c.m_data)
+        c.split();
+      else
+        c.prepare(n, n);
+
+      const double* qp = (q.m_data == c.m_data) ? c.m_data : q.m_data;
+
+      std::vector<double> row(m);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        // row = a(i, :) * b
+        std::fill(row.begin(), row.end(), 0.0);
+        const double* ai = a.m_data + i * m;
+        for (size_t k = 0; k < m; ++k)
+        {
+          const double v = ai[k];
+          const double* bk = b.m_data + k * m;
+          for (size_t j = 0; j < m; ++j)
+            row[j] += v * bk[j];
+        }
+
+        // c(i, j) = row * transpose(a(j, :)) + q(i, j)
+        for (size_t j = 0; j < n; ++j)
+        {
+          const double* aj = a.m_data + j * m;
+          double sum = (qp != NULL) ? qp[i * n + j] : 0.0;
+          for (size_t k = 0; k < m; ++k)
+            sum += row[k] * aj[k];
+          c.m_data[i * n + j] = sum;
+        }
+      }
+    }
+
     void
     Matrix::readFromLines(const std::vector<std::string>& clines)
     {
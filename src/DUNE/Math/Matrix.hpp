@@ -630,6 +630,48 @@ namespace DUNE
       static Matrix
       cross(const Matrix& a, const Matrix& b);
 
+      //! General matrix multiply and accumulate, computed in place:
+      //! c = alpha * op(a) * op(b) + beta * c, where op(x) is x or
+      //! transpose(x). The product is evaluated in cache-sized blocks
+      //! with contiguous inner loops. 'c' may alias 'a' or 'b'. When
+      //! beta is zero 'c' is resized if its dimensions differ,
+      //! otherwise it must already have the dimensions of the product.
+      //! @throw Matrix::Error if the dimensions are incompatible.
+      //! @param[in] alpha product scale factor.
+      //! @param[in] a left operand.
+      //! @param[in] ta true to use transpose(a).
+      //! @param[in] b right operand.
+      //! @param[in] tb true to use transpose(b).
+      //! @param[in] beta scale factor of the previous contents of 'c'.
+      //! @param[in,out] c destination matrix.
+      static void
+      gemm(double alpha, const Matrix& a, bool ta, const Matrix& b, bool tb,
+           double beta, Matrix& c);
+
+      //! Compute c = a * b without allocating a new matrix when 'c'
+      //! already has the right dimensions.
+      //! @param[in] a left operand.
+      //! @param[in] b right operand.
+      //! @param[out] c destination matrix.
+      static void
+      multiplyInto(const Matrix& a, const Matrix& b, Matrix& c);
+
+      //! Compute c = transpose(a) without allocating a new matrix when
+      //! 'c' already has the right dimensions.
+      //! @param[in] a matrix.
+      //! @param[out] c destination matrix.
+      static void
+      transposeInto(const Matrix& a, Matrix& c);
+
+      //! Compute c = a * b * transpose(a) + q in a single pass, one row
+      //! of a * b at a time, as used to propagate covariances.
+      //! @param[in] a n x m matrix.
+      //! @param[in] b m x m matrix.
+      //! @param[in] q n x n matrix or an empty matrix.
+      //! @param[out] c destination matrix (must not alias 'a' or 'b').
+      static void
+      quadraticInto(const Matrix& a, const Matrix& b, const Matrix& q, Matrix& c);
+
       //! This method returns the sum of two matrices.
       //! @param[in] m1 matrix to be summed.
       //! @param[in] m2 matrix to be summed.
@@ -867,6 +909,13 @@ namespace DUNE
       //! This method creates a unique copy of the data of a Matrix.
       void
       split(void);
+
+      //! Make this matrix an unshared r x c matrix, keeping the
+      //! current storage when possible. Contents are undefined.
+      //! @param[in] r number of rows.
+      //! @param[in] c number of columns.
+      void
+      prepare(size_t r, size_t c);
     };
 
     //! This function returns a 3x3 skew symmetrical
@@ -0,0 +1,276 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_MATH_NEIGHBOR_GRID_HPP_INCLUDED_
+#define DUNE_MATH_NEIGHBOR_GRID_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// ISO C++ 11 headers.
+#include <cstdint>
+#include <unordered_map>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    //! Uniform grid index of planar positions, used to find the
+    //! neighbors of a point without testing every stored entry.
+    //! Entries are identified by an unsigned number and can be
+    //! moved one at a time as new positions become available: an
+    //! update that keeps the entry in the same cell does not touch
+    //! the grid. Neighbor queries cost is proportional to the number
+    //! of entries in the cells overlapped by the query circle, so
+    //! the cell size should be close to the typical query radius.
+    class NeighborGrid
+    {
+    public:
+      //! Constructor.
+      //! @param[in] cell_size side of a grid cell.
+      NeighborGrid(double cell_size):
+        m_cell_size(cell_size)
+      { }
+
+      //! Change the side of the grid cells. Stored entries are
+      //! redistributed by the new cell size.
+      //! @param[in] cell_size side of a grid cell.
+      void
+      setCellSize(double cell_size)
+      {
+        if (cell_size == m_cell_size)
+          return;
+
+        m_cell_size = cell_size;
+        m_cells.clear();
+
+        std::unordered_map<unsigned, Entry>::iterator itr = m_entries.begin();
+        for (; itr != m_entries.end(); ++itr)
+        {
+          itr->second.key = key(cell(itr->second.x), cell(itr->second.y));
+          m_cells[itr->second.key].push_back(itr->first);
+        }
+      }
+
+      //! Get the side of the grid cells.
+      //! @return cell size.
+      double
+      getCellSize(void) const
+      {
+        return m_cell_size;
+      }
+
+      //! Insert an entry or move an existing one.
+      //! @param[in] id entry identifier.
+      //! @param[in] x first coordinate.
+      //! @param[in] y second coordinate.
+      void
+      update(unsigned id, double x, double y)
+      {
+        uint64_t k = key(cell(x), cell(y));
+        std::unordered_map<unsigned, Entry>::iterator itr = m_entries.find(id);
+
+        if (itr == m_entries.end())
+        {
+          Entry entry = {x, y, k};
+          m_entries[id] = entry;
+          m_cells[k].push_back(id);
+          return;
+        }
+
+        itr->second.x = x;
+        itr->second.y = y;
+
+        if (itr->second.key == k)
+          return;
+
+        unlink(id, itr->second.key);
+        itr->second.key = k;
+        m_cells[k].push_back(id);
+      }
+
+      //! Remove an entry.
+      //! @param[in] id entry identifier.
+      //! @return true if the entry existed, false otherwise.
+      bool
+      remove(unsigned id)
+      {
+        std::unordered_map<unsigned, Entry>::iterator itr = m_entries.find(id);
+        if (itr == m_entries.end())
+          return false;
+
+        unlink(id, itr->second.key);
+        m_entries.erase(itr);
+        return true;
+      }
+
+      //! Test if an entry exists.
+      //! @param[in] id entry identifier.
+      //! @return true if the entry exists, false otherwise.
+      bool
+      contains(unsigned id) const
+      {
+        return m_entries.find(id) != m_entries.end();
+      }
+
+      //! Remove all entries.
+      void
+      clear(void)
+      {
+        m_entries.clear();
+        m_cells.clear();
+      }
+
+      //! Get the number of entries.
+      //! @return number of entries.
+      size_t
+      size(void) const
+      {
+        return m_entries.size();
+      }
+
+      //! Find the entries within a given distance of a point. The
+      //! order of the identifiers in the output is unspecified.
+      //! @param[in] x first coordinate of the point.
+      //! @param[in] y second coordinate of the point.
+      //! @param[in] radius search radius.
+      //! @param[out] ids identifiers of the entries found.
+      //! @return number of entries found.
+      size_t
+      query(double x, double y, double radius, std::vector<unsigned>& ids) const
+      {
+        ids.clear();
+
+        if (radius < 0 || m_entries.empty())
+          return 0;
+
+        double r2 = radius * radius;
+        int64_t x0 = cell(x - radius);
+        int64_t x1 = cell(x + radius);
+        int64_t y0 = cell(y - radius);
+        int64_t y1 = cell(y + radius);
+
+        // Visiting the occupied cells is cheaper than visiting a
+        // circle much larger than the populated area.
+        if ((double)(x1 - x0 + 1) * (double)(y1 - y0 + 1) > (double)m_cells.size())
+        {
+          std::unordered_map<uint64_t, std::vector<unsigned> >::const_iterator itr = m_cells.begin();
+          for (; itr != m_cells.end(); ++itr)
+            collect(itr->second, x, y, r2, ids);
+          return ids.size();
+        }
+
+        for (int64_t cx = x0; cx <= x1; ++cx)
+        {
+          for (int64_t cy = y0; cy <= y1; ++cy)
+          {
+            std::unordered_map<uint64_t, std::vector<unsigned> >::const_iterator itr = m_cells.find(key(cx, cy));
+            if (itr != m_cells.end())
+              collect(itr->second, x, y, r2, ids);
+          }
+        }
+
+        return ids.size();
+      }
+
+    private:
+      //! Indexed position.
+      struct Entry
+      {
+        //! First coordinate.
+        double x;
+        //! Second coordinate.
+        double y;
+        //! Key of the cell holding the entry.
+        uint64_t key;
+      };
+
+      //! Side of a grid cell.
+      double m_cell_size;
+      //! Indexed positions.
+      std::unordered_map<unsigned, Entry> m_entries;
+      //! Entries of each occupied cell.
+      std::unordered_map<uint64_t, std::vector<unsigned> > m_cells;
+
+      //! Compute the cell index of a coordinate.
+      int64_t
+      cell(double v) const
+      {
+        return (int64_t)std::floor(v / m_cell_size);
+      }
+
+      //! Compute the key of a cell.
+      static uint64_t
+      key(int64_t cx, int64_t cy)
+      {
+        return ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy;
+      }
+
+      //! Remove an entry from the list of a cell.
+      void
+      unlink(unsigned id, uint64_t k)
+      {
+        std::unordered_map<uint64_t, std::vector<unsigned> >::iterator itr = m_cells.find(k);
+        if (itr == m_cells.end())
+          return;
+
+        std::vector<unsigned>& list = itr->second;
+        for (size_t i = 0; i < list.size(); ++i)
+        {
+          if (list[i] == id)
+          {
+            list[i] = list.back();
+            list.pop_back();
+            break;
+          }
+        }
+
+        if (list.empty())
+          m_cells.erase(itr);
+      }
+
+      //! Append the entries of a cell that are within range.
+      void
+      collect(const std::vector<unsigned>& list, double x, double y, double r2,
+              std::vector<unsigned>& ids) const
+      {
+        for (size_t i = 0; i < list.size(); ++i)
+        {
+          const Entry& e = m_entries.find(list[i])->second;
+          double dx = e.x - x;
+          double dy = e.y - y;
+          if (dx * dx + dy * dy <= r2)
+            ids.push_back(list[i]);
+        }
+      }
+    };
+  }
+}
+
+#endif
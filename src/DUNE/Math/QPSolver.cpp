@@ -515,17 +515,8 @@ l2a:    /* Step 2a: determine step direction */
     static void
     compute_d(Matrix& d, const Matrix& J, const Matrix& np)
     {
-      int i, j, n = d.rows();
-      double sum;
-
       /* compute d = H^T * np */
-      for (i = 0; i < n; i++)
-      {
-        sum = 0.0;
-        for (j = 0; j < n; j++)
-          sum += J(j, i) * np(j);
-        d(i) = sum;
-      }
+      Matrix::gemm(1.0, J, true, np, false, 0.0, d);
     }
 
     static void
@@ -8,13 +8,11 @@ namespace DUNE
   namespace Math
   {
     Quaternion::Quaternion()
-    : m_matrix(4, 1)
     {
       this->identity();
     }
 
     Quaternion::Quaternion(double qw, double qx, double qy, double qz)
-    : m_matrix(4, 1)
     {
       m_matrix(INDEX_W) = qw;
       m_matrix(INDEX_X) = qx;
@@ -23,7 +21,6 @@ namespace DUNE
     }
 
     Quaternion::Quaternion(const std::vector<double>& q)
-    : m_matrix(4, 1)
     {
       if (q.size() != 4)
         throw std::invalid_argument("vector must have length 4");
@@ -35,7 +32,6 @@ namespace DUNE
     }
 
     Quaternion::Quaternion(const double qw, const std::vector<double>& v)
-    : m_matrix(4, 1)
     {
       if (v.size() != 3)
         throw std::invalid_argument("vector must have length 3");
@@ -47,16 +43,14 @@ namespace DUNE
     }
 
     Quaternion::Quaternion(const Matrix& q)
-    : m_matrix(4, 1)
     {
       if (!q.isColumnVector() || q.size() != 4)
         throw std::invalid_argument("matrix must have size 4x1");
 
-      m_matrix = q;
+      m_matrix = SMatrix<4, 1>(q);
     }
 
     Quaternion::Quaternion(double qw, const Matrix& v)
-    : m_matrix(4, 1)
     {
       if (!v.isColumnVector() || v.size() != 3)
         throw std::invalid_argument("matrix must have size 3x1");
@@ -67,8 +61,11 @@ namespace DUNE
       m_matrix(INDEX_Z) = v(2);
     }
 
+    Quaternion::Quaternion(const SMatrix<4, 1>& q)
+    : m_matrix(q)
+    { }
+
     Quaternion::Quaternion(const EulerAnglesZyx& euler)
-    : m_matrix(4, 1)
     {
       const double cr = std::cos(euler.roll / 2);
       const double sr = std::sin(euler.roll / 2);
@@ -87,9 +84,14 @@ namespace DUNE
     double Quaternion::x() const { return m_matrix(INDEX_X); }
     double Quaternion::y() const { return m_matrix(INDEX_Y); }
     double Quaternion::z() const { return m_matrix(INDEX_Z); }
-    Matrix Quaternion::vec() const { return m_matrix.get(INDEX_X, INDEX_Z, 0, 0); }
+    Matrix Quaternion::vec() const { return m_matrix.block<3, 1>(INDEX_X, 0).toMatrix(); }
 
     Matrix Quaternion::matrix() const
+    {
+      return m_matrix.toMatrix();
+    }
+
+    const SMatrix<4, 1>& Quaternion::smatrix() const
     {
       return m_matrix;
     }
@@ -108,7 +110,29 @@ namespace DUNE
 
     Matrix Quaternion::rotationMatrix() const
     {
-      return (m_matrix / this->norm()).toDCM();
+      SMatrix<3, 3> dcm;
+      rotationMatrix(dcm);
+      return dcm.toMatrix();
+    }
+
+    void Quaternion::rotationMatrix(SMatrix<3, 3>& dcm) const
+    {
+      // Same as Matrix::toDCM() of the normalized quaternion.
+      const SMatrix<4, 1> q = m_matrix / this->norm();
+      const double qw = q(INDEX_W);
+      const double qx = q(INDEX_X);
+      const double qy = q(INDEX_Y);
+      const double qz = q(INDEX_Z);
+
+      dcm(0, 0) = qw * qw + qx * qx - qy * qy - qz * qz;
+      dcm(0, 1) = 2 * (qx * qy - qw * qz);
+      dcm(0, 2) = 2 * (qx * qz + qw * qy);
+      dcm(1, 0) = 2 * (qx * qy + qw * qz);
+      dcm(1, 1) = qw * qw - qx * qx + qy * qy - qz * qz;
+      dcm(1, 2) = 2 * (qy * qz - qw * qx);
+      dcm(2, 0) = 2 * (qx * qz - qw * qy);
+      dcm(2, 1) = 2 * (qy * qz + qw * qx);
+      dcm(2, 2) = qw * qw - qx * qx - qy * qy + qz * qz;
     }
 
     Matrix Quaternion::angVelTransform() const
@@ -136,18 +160,18 @@ namespace DUNE
 
     Quaternion Quaternion::operator-() const
     {
-      return Quaternion(-this->matrix());
+      return Quaternion(-m_matrix);
     }
 
     Quaternion& Quaternion::operator+=(const Quaternion& rhs)
     {
-      m_matrix += rhs.matrix();
+      m_matrix += rhs.smatrix();
       return *this;
     }
 
     Quaternion& Quaternion::operator-=(const Quaternion& rhs)
     {
-      m_matrix -= rhs.matrix();
+      m_matrix -= rhs.smatrix();
       return *this;
     }
 
@@ -184,7 +208,7 @@ namespace DUNE
 
     bool operator==(const Quaternion& lhs, const Quaternion& rhs)
     {
-      return lhs.matrix() == rhs.matrix();
+      return lhs.smatrix() == rhs.smatrix();
     }
 
     bool operator!=(const Quaternion& lhs, const Quaternion& rhs)
@@ -204,7 +228,7 @@ namespace DUNE
       if (!rhs.isColumnVector() || rhs.size() != 4)
         throw std::invalid_argument("matrix must have size 4x1");
 
-      return Quaternion(lhs.matrix() + rhs);
+      return Quaternion(lhs.smatrix() + SMatrix<4, 1>(rhs));
     }
 
     Quaternion operator+(const Matrix& lhs, const Quaternion& rhs)
@@ -212,7 +236,7 @@ namespace DUNE
       if (lhs.isColumnVector() || lhs.size() != 4)
         throw std::invalid_argument("matrix must have size 4x1");
 
-      return Quaternion(lhs + rhs.matrix());
+      return Quaternion(SMatrix<4, 1>(lhs) + rhs.smatrix());
     }
 
     Quaternion operator*(const Quaternion& lhs, const Quaternion& rhs)
@@ -2,6 +2,7 @@
 #define DUNE_MATH_QUATERNION_HPP_INCLUDED_
 
 #include <DUNE/Math/Matrix.hpp>
+#include <DUNE/Math/SMatrix.hpp>
 #include <DUNE/Math/EulerAnglesZyx.hpp>
 
 #include <ostream>
@@ -36,6 +37,9 @@ namespace DUNE
       // Initialize from scalar element w and 3x1 Matrix v = [x y z].
       Quaternion(double qw, const Matrix& v);
 
+      // Initialize from fixed-size 4x1 matrix q = [w x y z].
+      explicit Quaternion(const SMatrix<4, 1>& q);
+
       // Convert from ZYX-convention Euler angles.
       explicit Quaternion(const EulerAnglesZyx& euler);
 
@@ -46,9 +50,12 @@ namespace DUNE
       Matrix vec() const;
 
       Matrix matrix() const;
+      const SMatrix<4, 1>& smatrix() const;
       double norm() const;
       Quaternion normalized() const;
       Matrix rotationMatrix() const;
+      // Rotation matrix without heap allocation.
+      void rotationMatrix(SMatrix<3, 3>& dcm) const;
       Matrix angVelTransform() const;
 
       void identity();
@@ -59,7 +66,7 @@ namespace DUNE
       Quaternion& operator-=(const Quaternion& rhs);
       Quaternion& operator*=(const Quaternion& rhs);
     private:
-      Matrix m_matrix;
+      SMatrix<4, 1> m_matrix;
       enum Index {INDEX_W, INDEX_X, INDEX_Y, INDEX_Z};
     };
 
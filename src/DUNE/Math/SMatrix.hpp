@@ -0,0 +1,657 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_MATH_SMATRIX_HPP_INCLUDED_
+#define DUNE_MATH_SMATRIX_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Math/Matrix.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    //! Fixed-size matrix with compile-time dimensions, stored in
+    //! row-major order on the stack. Intended for the small matrices
+    //! (up to about 12x12) of navigation and control code, where
+    //! Matrix would allocate memory for every temporary. Element
+    //! loops have compile-time bounds and are unrolled/vectorized by
+    //! the compiler. Use SMatrix(const Matrix&) and toMatrix() to
+    //! interoperate with Matrix.
+    template <size_t R, size_t C>
+    class SMatrix
+    {
+    public:
+      //! Number of rows.
+      static const size_t c_rows = R;
+      //! Number of columns.
+      static const size_t c_columns = C;
+      //! Number of elements.
+      static const size_t c_size = R * C;
+
+      //! Construct a zero matrix.
+      SMatrix(void)
+      {
+        fill(0.0);
+      }
+
+      //! Construct a matrix with all elements set to a value.
+      //! @param[in] value value.
+      explicit SMatrix(double value)
+      {
+        fill(value);
+      }
+
+      //! Construct a matrix from an array.
+      //! @param[in] data R * C elements in row-major order.
+      explicit SMatrix(const double* data)
+      {
+        for (size_t i = 0; i < c_size; ++i)
+          m_data[i] = data[i];
+      }
+
+      //! Construct a matrix from a Matrix with the same dimensions.
+      //! @param[in] m matrix.
+      explicit SMatrix(const Matrix& m)
+      {
+        if (m.rows() != R || m.columns() != C)
+          throw Matrix::Error("incompatible dimensions");
+
+        std::copy(m.cbegin(), m.cend(), m_data);
+      }
+
+      //! Get a zero matrix.
+      //! @return zero matrix.
+      static SMatrix
+      zero(void)
+      {
+        return SMatrix();
+      }
+
+      //! Get an identity matrix.
+      //! @return identity matrix.
+      static SMatrix
+      identity(void)
+      {
+        SMatrix m;
+        for (size_t i = 0; i < R && i < C; ++i)
+          m(i, i) = 1.0;
+        return m;
+      }
+
+      //! Get number of rows.
+      //! @return number of rows.
+      static size_t
+      rows(void)
+      {
+        return R;
+      }
+
+      //! Get number of columns.
+      //! @return number of columns.
+      static size_t
+      columns(void)
+      {
+        return C;
+      }
+
+      //! Get number of elements.
+      //! @return number of elements.
+      static size_t
+      size(void)
+      {
+        return c_size;
+      }
+
+      //! Convert to a Matrix.
+      //! @return matrix.
+      Matrix
+      toMatrix(void) const
+      {
+        return Matrix(m_data, R, C);
+      }
+
+      //! Copy elements to a Matrix, resizing it only if its
+      //! dimensions differ.
+      //! @param[out] m matrix.
+      void
+      copyTo(Matrix& m) const
+      {
+        if (m.rows() != R || m.columns() != C)
+          m.resizeAndFill(R, C, 0.0);
+
+        // Writing the first element through operator() makes the
+        // matrix stop sharing its data with other copies, so the rest
+        // can be copied directly.
+        m(0) = m_data[0];
+        std::copy(m_data + 1, m_data + c_size, m.begin() + 1);
+      }
+
+      //! Set all elements to a value.
+      //! @param[in] value value.
+      void
+      fill(double value)
+      {
+        for (size_t i = 0; i < c_size; ++i)
+          m_data[i] = value;
+      }
+
+      //! Get pointer to elements (row-major order).
+      //! @return pointer to elements.
+      double*
+      data(void)
+      {
+        return m_data;
+      }
+
+      //! Get pointer to elements (row-major order).
+      //! @return pointer to elements.
+      const double*
+      data(void) const
+      {
+        return m_data;
+      }
+
+      double&
+      operator()(size_t i, size_t j)
+      {
+        return m_data[i * C + j];
+      }
+
+      double
+      operator()(size_t i, size_t j) const
+      {
+        return m_data[i * C + j];
+      }
+
+      //! Access elements of a row or column vector (or of any matrix
+      //! in row-major order).
+      double&
+      operator()(size_t i)
+      {
+        return m_data[i];
+      }
+
+      double
+      operator()(size_t i) const
+      {
+        return m_data[i];
+      }
+
+      //! Get a sub-matrix.
+      //! @param[in] i first row.
+      //! @param[in] j first column.
+      //! @return sub-matrix with RB rows and CB columns.
+      template <size_t RB, size_t CB>
+      SMatrix<RB, CB>
+      block(size_t i, size_t j) const
+      {
+        SMatrix<RB, CB> m;
+        for (size_t r = 0; r < RB; ++r)
+          for (size_t c = 0; c < CB; ++c)
+            m(r, c) = (*this)(i + r, j + c);
+        return m;
+      }
+
+      //! Set a sub-matrix.
+      //! @param[in] i first row.
+      //! @param[in] j first column.
+      //! @param[in] m sub-matrix.
+      template <size_t RB, size_t CB>
+      void
+      setBlock(size_t i, size_t j, const SMatrix<RB, CB>& m)
+      {
+        for (size_t r = 0; r < RB; ++r)
+          for (size_t c = 0; c < CB; ++c)
+            (*this)(i + r, j + c) = m(r, c);
+      }
+
+      SMatrix&
+      operator+=(const SMatrix& m)
+      {
+        for (size_t i = 0; i < c_size; ++i)
+          m_data[i] += m.m_data[i];
+        return *this;
+      }
+
+      SMatrix&
+      operator-=(const SMatrix& m)
+      {
+        for (size_t i = 0; i < c_size; ++i)
+          m_data[i] -= m.m_data[i];
+        return *this;
+      }
+
+      SMatrix&
+      operator*=(double x)
+      {
+        for (size_t i = 0; i < c_size; ++i)
+          m_data[i] *= x;
+        return *this;
+      }
+
+      SMatrix&
+      operator/=(double x)
+      {
+        return *this *= (1.0 / x);
+      }
+
+      SMatrix
+      operator-(void) const
+      {
+        SMatrix m;
+        for (size_t i = 0; i < c_size; ++i)
+          m.m_data[i] = -m_data[i];
+        return m;
+      }
+
+      bool
+      operator==(const SMatrix& m) const
+      {
+        for (size_t i = 0; i < c_size; ++i)
+        {
+          if (m_data[i] != m.m_data[i])
+            return false;
+        }
+
+        return true;
+      }
+
+      bool
+      operator!=(const SMatrix& m) const
+      {
+        return !(*this == m);
+      }
+
+      //! Compute the trace.
+      //! @return trace.
+      double
+      trace(void) const
+      {
+        double t = 0;
+        for (size_t i = 0; i < R && i < C; ++i)
+          t += (*this)(i, i);
+        return t;
+      }
+
+      //! Compute the Euclidean (Frobenius) norm.
+      //! @return norm.
+      double
+      norm_2(void) const
+      {
+        double s = 0;
+        for (size_t i = 0; i < c_size; ++i)
+          s += m_data[i] * m_data[i];
+        return std::sqrt(s);
+      }
+
+      //! Make a square matrix symmetric by averaging it with its
+      //! transpose.
+      void
+      symmetrize(void)
+      {
+        for (size_t i = 0; i < R; ++i)
+        {
+          for (size_t j = i + 1; j < C; ++j)
+          {
+            double v = 0.5 * ((*this)(i, j) + (*this)(j, i));
+            (*this)(i, j) = v;
+            (*this)(j, i) = v;
+          }
+        }
+      }
+
+    private:
+      //! Elements in row-major order.
+      double m_data[R * C];
+    };
+
+    //! Column vector.
+    typedef SMatrix<2, 1> SVector2;
+    typedef SMatrix<3, 1> SVector3;
+    typedef SMatrix<4, 1> SVector4;
+    //! Square matrices.
+    typedef SMatrix<2, 2> SMatrix2;
+    typedef SMatrix<3, 3> SMatrix3;
+    typedef SMatrix<4, 4> SMatrix4;
+
+    template <size_t R, size_t C>
+    inline SMatrix<R, C>
+    operator+(const SMatrix<R, C>& a, const SMatrix<R, C>& b)
+    {
+      SMatrix<R, C> m(a);
+      m += b;
+      return m;
+    }
+
+    template <size_t R, size_t C>
+    inline SMatrix<R, C>
+    operator-(const SMatrix<R, C>& a, const SMatrix<R, C>& b)
+    {
+      SMatrix<R, C> m(a);
+      m -= b;
+      return m;
+    }
+
+    template <size_t R, size_t C>
+    inline SMatrix<R, C>
+    operator*(const SMatrix<R, C>& a, double x)
+    {
+      SMatrix<R, C> m(a);
+      m *= x;
+      return m;
+    }
+
+    template <size_t R, size_t C>
+    inline SMatrix<R, C>
+    operator*(double x, const SMatrix<R, C>& a)
+    {
+      return a * x;
+    }
+
+    template <size_t R, size_t C>
+    inline SMatrix<R, C>
+    operator/(const SMatrix<R, C>& a, double x)
+    {
+      return a * (1.0 / x);
+    }
+
+    //! Matrix product. The inner loop runs over contiguous rows of
+    //! both operands so that it can be vectorized.
+    template <size_t R, size_t K, size_t C>
+    inline SMatrix<R, C>
+    operator*(const SMatrix<R, K>& a, const SMatrix<K, C>& b)
+    {
+      SMatrix<R, C> m;
+      for (size_t i = 0; i < R; ++i)
+      {
+        for (size_t k = 0; k < K; ++k)
+        {
+          const double aik = a(i, k);
+          for (size_t j = 0; j < C; ++j)
+            m(i, j) += aik * b(k, j);
+        }
+      }
+
+      return m;
+    }
+
+    //! Compute the transpose of a matrix.
+    template <size_t R, size_t C>
+    inline SMatrix<C, R>
+    transpose(const SMatrix<R, C>& a)
+    {
+      SMatrix<C, R> m;
+      for (size_t i = 0; i < R; ++i)
+        for (size_t j = 0; j < C; ++j)
+          m(j, i) = a(i, j);
+      return m;
+    }
+
+    //! Compute a * b * transpose(a), as used to propagate
+    //! covariances, without forming transpose(a).
+    template <size_t R, size_t C>
+    inline SMatrix<R, R>
+    quadratic(const SMatrix<R, C>& a, const SMatrix<C, C>& b)
+    {
+      SMatrix<R, C> ab = a * b;
+      SMatrix<R, R> m;
+      for (size_t i = 0; i < R; ++i)
+      {
+        for (size_t j = 0; j < R; ++j)
+        {
+          double s = 0;
+          for (size_t k = 0; k < C; ++k)
+            s += ab(i, k) * a(j, k);
+          m(i, j) = s;
+        }
+      }
+
+      return m;
+    }
+
+    //! Compute the dot product of two vectors.
+    template <size_t N>
+    inline double
+    dot(const SMatrix<N, 1>& a, const SMatrix<N, 1>& b)
+    {
+      double s = 0;
+      for (size_t i = 0; i < N; ++i)
+        s += a(i) * b(i);
+      return s;
+    }
+
+    //! Compute the cross product of two 3D vectors.
+    inline SMatrix<3, 1>
+    cross(const SMatrix<3, 1>& a, const SMatrix<3, 1>& b)
+    {
+      SMatrix<3, 1> m;
+      m(0) = a(1) * b(2) - a(2) * b(1);
+      m(1) = a(2) * b(0) - a(0) * b(2);
+      m(2) = a(0) * b(1) - a(1) * b(0);
+      return m;
+    }
+
+    //! Compute the skew symmetric matrix of a 3D vector.
+    inline SMatrix<3, 3>
+    skew(const SMatrix<3, 1>& a)
+    {
+      double data[9] = {0, -a(2), a(1),
+                        a(2), 0, -a(0),
+                        -a(1), a(0), 0};
+      return SMatrix<3, 3>(data);
+    }
+
+    //! Compute the inverse of a square matrix using Gauss-Jordan
+    //! elimination with partial pivoting.
+    template <size_t N>
+    inline SMatrix<N, N>
+    inverse(const SMatrix<N, N>& a)
+    {
+      SMatrix<N, N> m(a);
+      SMatrix<N, N> inv = SMatrix<N, N>::identity();
+
+      for (size_t c = 0; c < N; ++c)
+      {
+        size_t p = c;
+        for (size_t r = c + 1; r < N; ++r)
+        {
+          if (std::fabs(m(r, c)) > std::fabs(m(p, c)))
+            p = r;
+        }
+
+        if (m(p, c) == 0.0)
+          throw Matrix::Error("matrix is singular");
+
+        if (p != c)
+        {
+          for (size_t j = 0; j < N; ++j)
+          {
+            std::swap(m(p, j), m(c, j));
+            std::swap(inv(p, j), inv(c, j));
+          }
+        }
+
+        const double d = 1.0 / m(c, c);
+        for (size_t j = 0; j < N; ++j)
+        {
+          m(c, j) *= d;
+          inv(c, j) *= d;
+        }
+
+        for (size_t r = 0; r < N; ++r)
+        {
+          if (r == c)
+            continue;
+
+          const double f = m(r, c);
+          if (f == 0.0)
+            continue;
+
+          for (size_t j = 0; j < N; ++j)
+          {
+            m(r, j) -= f * m(c, j);
+            inv(r, j) -= f * inv(c, j);
+          }
+        }
+      }
+
+      return inv;
+    }
+
+    //! Compute the inverse of a 2x2 matrix.
+    template <>
+    inline SMatrix<2, 2>
+    inverse(const SMatrix<2, 2>& a)
+    {
+      const double det = a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+      if (det == 0.0)
+        throw Matrix::Error("matrix is singular");
+
+      double data[4] = {a(1, 1), -a(0, 1), -a(1, 0), a(0, 0)};
+      return SMatrix<2, 2>(data) / det;
+    }
+
+    //! Compute the inverse of a 3x3 matrix.
+    template <>
+    inline SMatrix<3, 3>
+    inverse(const SMatrix<3, 3>& a)
+    {
+      double data[9] =
+      {
+        a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1),
+        a(0, 2) * a(2, 1) - a(0, 1) * a(2, 2),
+        a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1),
+        a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2),
+        a(0, 0) * a(2, 2) - a(0, 2) * a(2, 0),
+        a(0, 2) * a(1, 0) - a(0, 0) * a(1, 2),
+        a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0),
+        a(0, 1) * a(2, 0) - a(0, 0) * a(2, 1),
+        a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0)
+      };
+
+      const double det = a(0, 0) * data[0] + a(0, 1) * data[3] + a(0, 2) * data[6];
+      if (det == 0.0)
+        throw Matrix::Error("matrix is singular");
+
+      return SMatrix<3, 3>(data) / det;
+    }
+
+    //! Compute the Cholesky factorization a = l * transpose(l) of a
+    //! symmetric positive definite matrix.
+    //! @param[in] a symmetric positive definite matrix.
+    //! @param[out] l lower triangular factor.
+    //! @return true if the factorization succeeded, false if the
+    //! matrix is not positive definite.
+    template <size_t N>
+    inline bool
+    cholesky(const SMatrix<N, N>& a, SMatrix<N, N>& l)
+    {
+      l.fill(0.0);
+
+      for (size_t j = 0; j < N; ++j)
+      {
+        double d = a(j, j);
+        for (size_t k = 0; k < j; ++k)
+          d -= l(j, k) * l(j, k);
+
+        if (d <= 0.0)
+          return false;
+
+        l(j, j) = std::sqrt(d);
+        const double inv = 1.0 / l(j, j);
+
+        for (size_t i = j + 1; i < N; ++i)
+        {
+          double s = a(i, j);
+          for (size_t k = 0; k < j; ++k)
+            s -= l(i, k) * l(j, k);
+          l(i, j) = s * inv;
+        }
+      }
+
+      return true;
+    }
+
+    //! Solve a * x = b given the Cholesky factor of a.
+    //! @param[in] l lower triangular factor computed by cholesky().
+    //! @param[in] b right-hand side.
+    //! @return solution.
+    template <size_t N, size_t C>
+    inline SMatrix<N, C>
+    choleskySolve(const SMatrix<N, N>& l, const SMatrix<N, C>& b)
+    {
+      SMatrix<N, C> x(b);
+
+      // Forward substitution: l * y = b.
+      for (size_t c = 0; c < C; ++c)
+      {
+        for (size_t i = 0; i < N; ++i)
+        {
+          double s = x(i, c);
+          for (size_t k = 0; k < i; ++k)
+            s -= l(i, k) * x(k, c);
+          x(i, c) = s / l(i, i);
+        }
+
+        // Backward substitution: transpose(l) * x = y.
+        for (size_t i = N; i-- > 0;)
+        {
+          double s = x(i, c);
+          for (size_t k = i + 1; k < N; ++k)
+            s -= l(k, i) * x(k, c);
+          x(i, c) = s / l(i, i);
+        }
+      }
+
+      return x;
+    }
+
+    template <size_t R, size_t C>
+    inline std::ostream&
+    operator<<(std::ostream& os, const SMatrix<R, C>& a)
+    {
+      for (size_t i = 0; i < R; ++i)
+      {
+        for (size_t j = 0; j < C; ++j)
+          os << a(i, j) << " ";
+        os << std::endl;
+      }
+
+      return os;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,359 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Media/FramePipeline.hpp>
+#include <DUNE/Concurrency/ScopedCondition.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Time/Clock.hpp>
+
+namespace DUNE
+{
+  namespace Media
+  {
+    using Concurrency::ScopedCondition;
+
+    //! Compression worker. Each worker owns its compressor and
+    //! decoder, so frames are processed without sharing state.
+    class FramePipeline::Worker: public Concurrency::Thread
+    {
+    public:
+      Worker(FramePipeline& parent):
+        m_parent(parent),
+        m_debayer(parent.m_settings.tile, parent.m_settings.method)
+      {
+        const Settings& s = parent.m_settings;
+
+        m_jpeg.setInputDimensions(s.width, s.height);
+        if (s.format == PF_GRAY8)
+        {
+          // libjpeg cannot add color to grayscale input.
+          m_jpeg.setInputColorSpace(JPEGCompressor::CS_GRAYSCALE);
+          m_jpeg.setOutputColorSpace(JPEGCompressor::CS_GRAYSCALE);
+        }
+        else
+        {
+          m_jpeg.setInputColorSpace(JPEGCompressor::CS_RGB);
+          m_jpeg.setOutputColorSpace(s.output);
+        }
+      }
+
+    private:
+      //! Parent pipeline.
+      FramePipeline& m_parent;
+      //! Bayer decoder.
+      BayerDecoder m_debayer;
+      //! JPEG compressor.
+      JPEGCompressor m_jpeg;
+
+      void
+      run(void)
+      {
+        const Settings& s = m_parent.m_settings;
+        unsigned quality = 0;
+
+        while (true)
+        {
+          Frame* frame = m_parent.take(quality);
+          if (frame == NULL)
+            break;
+
+          frame->m_started = Time::Clock::get();
+
+          uint8_t* input = frame->getRaw();
+          if (s.format == PF_BAYER8)
+          {
+            m_debayer.decodeToRGB24(input, &frame->m_rgb[0], s.width, s.height);
+            input = &frame->m_rgb[0];
+          }
+
+          frame->m_converted = Time::Clock::get();
+
+          bool success = m_jpeg.compress(input, quality);
+          if (success)
+          {
+            const uint8_t* img = m_jpeg.imageData();
+            frame->m_jpeg.assign(img, img + m_jpeg.imageSize());
+          }
+          else
+          {
+            frame->m_jpeg.clear();
+          }
+
+          frame->m_encoded = Time::Clock::get();
+          m_parent.complete(frame, success);
+        }
+      }
+    };
+
+    FramePipeline::FramePipeline(const Settings& settings):
+      m_settings(settings),
+      m_sequence(0),
+      m_quality(settings.quality),
+      m_stop(false),
+      m_event(NULL)
+    {
+      if (m_settings.workers == 0)
+        m_settings.workers = 1;
+
+      // At least one frame per worker plus one being captured.
+      if (m_settings.buffers < m_settings.workers + 1)
+        m_settings.buffers = m_settings.workers + 1;
+
+      size_t pixels = (size_t)m_settings.width * m_settings.height;
+      size_t raw_size = (m_settings.format == PF_RGB24) ? pixels * 3 : pixels;
+      size_t rgb_size = (m_settings.format == PF_BAYER8) ? pixels * 3 : 0;
+
+      for (unsigned i = 0; i < m_settings.buffers; ++i)
+      {
+        m_frames.push_back(new Frame(raw_size, rgb_size));
+        m_free.push_back(m_frames.back());
+      }
+
+      for (unsigned i = 0; i < m_settings.workers; ++i)
+      {
+        m_workers.push_back(new Worker(*this));
+        m_workers.back()->start();
+      }
+    }
+
+    FramePipeline::~FramePipeline(void)
+    {
+      {
+        ScopedCondition l(m_cond);
+        m_stop = true;
+        m_cond.broadcast();
+      }
+
+      for (size_t i = 0; i < m_workers.size(); ++i)
+      {
+        m_workers[i]->stopAndJoin();
+        delete m_workers[i];
+      }
+
+      for (size_t i = 0; i < m_frames.size(); ++i)
+        delete m_frames[i];
+    }
+
+    void
+    FramePipeline::setQuality(unsigned quality)
+    {
+      ScopedCondition l(m_cond);
+      m_quality = quality;
+    }
+
+    void
+    FramePipeline::setEvent(IO::Event* event)
+    {
+      ScopedCondition l(m_cond);
+      m_event = event;
+      notify();
+    }
+
+    FramePipeline::Frame*
+    FramePipeline::acquire(void)
+    {
+      Frame* frame = NULL;
+
+      {
+        ScopedCondition l(m_cond);
+
+        if (!m_free.empty())
+        {
+          frame = m_free.back();
+          m_free.pop_back();
+        }
+        else if (!m_queued.empty())
+        {
+          frame = m_queued.front();
+          m_queued.pop_front();
+          m_in_flight.erase(frame->m_sequence);
+          ++m_metrics.dropped;
+
+          // Frames completed after the dropped one may now be
+          // deliverable.
+          notify();
+        }
+        else
+        {
+          ++m_metrics.dropped;
+          return NULL;
+        }
+      }
+
+      frame->m_tstamp = -1;
+      frame->m_acquired = Time::Clock::get();
+      return frame;
+    }
+
+    void
+    FramePipeline::submit(Frame* frame)
+    {
+      double now = Time::Clock::get();
+
+      ScopedCondition l(m_cond);
+      frame->m_sequence = m_sequence++;
+      frame->m_submitted = now;
+      m_metrics.capture.add(now - frame->m_acquired);
+      ++m_metrics.submitted;
+
+      m_in_flight.insert(frame->m_sequence);
+      m_queued.push_back(frame);
+      m_cond.broadcast();
+    }
+
+    FramePipeline::Frame*
+    FramePipeline::poll(double timeout)
+    {
+      ScopedCondition l(m_cond);
+
+      Frame* frame = nextDone();
+      if (frame == NULL && timeout > 0)
+      {
+        double deadline = Time::Clock::get() + timeout;
+        while (frame == NULL && !m_stop)
+        {
+          double remaining = deadline - Time::Clock::get();
+          if (remaining <= 0)
+            break;
+
+          m_cond.wait(remaining);
+          frame = nextDone();
+        }
+      }
+
+      if (frame == NULL)
+        return NULL;
+
+      double now = Time::Clock::get();
+      m_metrics.delivery.add(now - frame->m_encoded);
+      m_metrics.total.add(now - frame->m_acquired);
+      return frame;
+    }
+
+    void
+    FramePipeline::release(Frame* frame)
+    {
+      if (frame == NULL)
+        return;
+
+      ScopedCondition l(m_cond);
+      m_free.push_back(frame);
+    }
+
+    size_t
+    FramePipeline::getPending(void)
+    {
+      ScopedCondition l(m_cond);
+      return m_in_flight.size() + m_done.size();
+    }
+
+    FramePipeline::Metrics
+    FramePipeline::getMetrics(void)
+    {
+      ScopedCondition l(m_cond);
+      return m_metrics;
+    }
+
+    void
+    FramePipeline::resetMetrics(void)
+    {
+      ScopedCondition l(m_cond);
+      m_metrics = Metrics();
+    }
+
+    FramePipeline::Frame*
+    FramePipeline::take(unsigned& quality)
+    {
+      ScopedCondition l(m_cond);
+
+      while (m_queued.empty() && !m_stop)
+        m_cond.wait();
+
+      if (m_stop)
+        return NULL;
+
+      Frame* frame = m_queued.front();
+      m_queued.pop_front();
+      quality = m_quality;
+      return frame;
+    }
+
+    void
+    FramePipeline::complete(Frame* frame, bool success)
+    {
+      ScopedCondition l(m_cond);
+
+      m_metrics.queue.add(frame->m_started - frame->m_submitted);
+      m_metrics.convert.add(frame->m_converted - frame->m_started);
+      m_metrics.encode.add(frame->m_encoded - frame->m_converted);
+      m_in_flight.erase(frame->m_sequence);
+
+      if (success)
+      {
+        ++m_metrics.encoded;
+        m_done[frame->m_sequence] = frame;
+      }
+      else
+      {
+        ++m_metrics.failed;
+        m_free.push_back(frame);
+      }
+
+      notify();
+    }
+
+    void
+    FramePipeline::notify(void)
+    {
+      m_cond.broadcast();
+
+      if (m_event == NULL || m_done.empty())
+        return;
+
+      if (m_in_flight.empty() || *m_in_flight.begin() > m_done.begin()->first)
+        m_event->signal();
+    }
+
+    FramePipeline::Frame*
+    FramePipeline::nextDone(void)
+    {
+      if (m_done.empty())
+        return NULL;
+
+      std::map<unsigned long, Frame*>::iterator itr = m_done.begin();
+
+      // Deliver in order: wait for older frames still in flight.
+      if (!m_in_flight.empty() && *m_in_flight.begin() < itr->first)
+        return NULL;
+
+      Frame* frame = itr->second;
+      m_done.erase(itr);
+      return frame;
+    }
+  }
+}
@@ -0,0 +1,414 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_MEDIA_FRAME_PIPELINE_HPP_INCLUDED_
+#define DUNE_MEDIA_FRAME_PIPELINE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
+#include <DUNE/IO/Event.hpp>
+#include <DUNE/Media/BayerDecoder.hpp>
+#include <DUNE/Media/JPEGCompressor.hpp>
+
+namespace DUNE
+{
+  namespace Media
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM FramePipeline;
+
+    //! Multi-threaded capture, conversion and JPEG compression
+    //! pipeline. The capture thread takes a recycled frame buffer
+    //! with acquire(), fills it and hands it over with submit(). A
+    //! pool of worker threads, each with its own JPEGCompressor,
+    //! converts (e.g., Bayer demosaicing) and compresses queued
+    //! frames concurrently. Compressed frames are retrieved in
+    //! capture order with poll() and returned to the pool with
+    //! release(). An event set with setEvent() is signalled as soon
+    //! as a compressed frame can be retrieved.
+    //!
+    //! The number of frame buffers bounds the amount of frames in
+    //! flight. The capture thread never waits for compression: when
+    //! every buffer is in use the oldest frame still waiting for a
+    //! worker is dropped and its buffer reused.
+    class FramePipeline
+    {
+    public:
+      //! Pixel format of captured frames.
+      enum PixelFormat
+      {
+        //! Red, Green and Blue, 8 bits per component.
+        PF_RGB24,
+        //! Grayscale, 8 bits per pixel.
+        PF_GRAY8,
+        //! Bayer mosaic, 8 bits per pixel.
+        PF_BAYER8
+      };
+
+      //! Pipeline settings.
+      struct Settings
+      {
+        //! Frame width.
+        unsigned width;
+        //! Frame height.
+        unsigned height;
+        //! Pixel format of captured frames.
+        PixelFormat format;
+        //! Bayer tile format (PF_BAYER8 only).
+        BayerDecoder::Tile tile;
+        //! Bayer decoding method (PF_BAYER8 only).
+        BayerDecoder::Method method;
+        //! JPEG output color space.
+        JPEGCompressor::ColorSpace output;
+        //! JPEG quality.
+        unsigned quality;
+        //! Number of compression workers.
+        unsigned workers;
+        //! Number of frame buffers.
+        unsigned buffers;
+
+        Settings(void):
+          width(0),
+          height(0),
+          format(PF_RGB24),
+          tile(BayerDecoder::TILE_GBRG),
+          method(BayerDecoder::METHOD_BILINEAR),
+          output(JPEGCompressor::CS_RGB),
+          quality(90),
+          workers(2),
+          buffers(8)
+        { }
+      };
+
+      //! Latency statistics of a pipeline stage, in seconds.
+      struct StageMetrics
+      {
+        //! Number of samples.
+        unsigned long count;
+        //! Sum of samples.
+        double total;
+        //! Largest sample.
+        double max;
+
+        StageMetrics(void):
+          count(0),
+          total(0),
+          max(0)
+        { }
+
+        //! Add a sample.
+        //! @param[in] value sample value.
+        void
+        add(double value)
+        {
+          ++count;
+          total += value;
+          if (value > max)
+            max = value;
+        }
+
+        //! Retrieve the average of all samples.
+        //! @return average value.
+        double
+        mean(void) const
+        {
+          return (count == 0) ? 0.0 : total / count;
+        }
+      };
+
+      //! Pipeline statistics.
+      struct Metrics
+      {
+        //! From acquire() to submit().
+        StageMetrics capture;
+        //! Time spent waiting for a worker.
+        StageMetrics queue;
+        //! Pixel format conversion.
+        StageMetrics convert;
+        //! JPEG compression.
+        StageMetrics encode;
+        //! From the end of compression to poll().
+        StageMetrics delivery;
+        //! From acquire() to poll().
+        StageMetrics total;
+        //! Number of submitted frames.
+        unsigned long submitted;
+        //! Number of compressed frames.
+        unsigned long encoded;
+        //! Number of frames that failed to compress.
+        unsigned long failed;
+        //! Number of frames dropped for lack of buffers.
+        unsigned long dropped;
+
+        Metrics(void):
+          submitted(0),
+          encoded(0),
+          failed(0),
+          dropped(0)
+        { }
+      };
+
+      //! Recyclable frame buffer.
+      class Frame
+      {
+      public:
+        //! Retrieve the raw frame buffer, to be filled by the
+        //! capture thread.
+        //! @return raw frame buffer.
+        uint8_t*
+        getRaw(void)
+        {
+          return &m_raw[0];
+        }
+
+        //! Retrieve the size of the raw frame buffer.
+        //! @return size in bytes.
+        size_t
+        getRawSize(void) const
+        {
+          return m_raw.size();
+        }
+
+        //! Retrieve the RGB24 image decoded from a Bayer mosaic.
+        //! @return RGB24 image or NULL if the pixel format is not
+        //! PF_BAYER8.
+        const uint8_t*
+        getRGB(void) const
+        {
+          return m_rgb.empty() ? NULL : &m_rgb[0];
+        }
+
+        //! Retrieve the compressed image.
+        //! @return JPEG image.
+        const uint8_t*
+        getJPEG(void) const
+        {
+          return m_jpeg.empty() ? NULL : &m_jpeg[0];
+        }
+
+        //! Retrieve the size of the compressed image.
+        //! @return size in bytes, zero if compression failed.
+        size_t
+        getJPEGSize(void) const
+        {
+          return m_jpeg.size();
+        }
+
+        //! Retrieve the sequence number assigned on submission.
+        //! @return sequence number.
+        unsigned long
+        getSequence(void) const
+        {
+          return m_sequence;
+        }
+
+        //! Set the capture timestamp.
+        //! @param[in] value timestamp.
+        void
+        setTimeStamp(double value)
+        {
+          m_tstamp = value;
+        }
+
+        //! Retrieve the capture timestamp.
+        //! @return timestamp.
+        double
+        getTimeStamp(void) const
+        {
+          return m_tstamp;
+        }
+
+      private:
+        friend class FramePipeline;
+
+        //! Raw frame.
+        std::vector<uint8_t> m_raw;
+        //! Decoded frame.
+        std::vector<uint8_t> m_rgb;
+        //! Compressed frame.
+        std::vector<uint8_t> m_jpeg;
+        //! Sequence number.
+        unsigned long m_sequence;
+        //! Capture timestamp.
+        double m_tstamp;
+        //! Stage times.
+        double m_acquired;
+        double m_submitted;
+        double m_started;
+        double m_converted;
+        double m_encoded;
+
+        Frame(size_t raw_size, size_t rgb_size):
+          m_raw(raw_size),
+          m_rgb(rgb_size),
+          m_sequence(0),
+          m_tstamp(-1),
+          m_acquired(0),
+          m_submitted(0),
+          m_started(0),
+          m_converted(0),
+          m_encoded(0)
+        { }
+      };
+
+      //! Constructor. Allocates all frame buffers and starts the
+      //! worker threads.
+      //! @param[in] settings pipeline settings.
+      FramePipeline(const Settings& settings);
+
+      //! Destructor. Stops the worker threads and releases all
+      //! frame buffers.
+      ~FramePipeline(void);
+
+      //! Set JPEG quality of frames compressed from now on.
+      //! @param[in] quality JPEG quality.
+      void
+      setQuality(unsigned quality);
+
+      //! Signal an event whenever a compressed frame becomes ready
+      //! to be retrieved with poll(), so that the consumer can wait
+      //! for frames and other I/O handles at the same time. The event
+      //! is never cleared by the pipeline.
+      //! @param[in] event event or NULL to stop signalling.
+      void
+      setEvent(IO::Event* event);
+
+      //! Take a free frame buffer. If every buffer is in use the
+      //! oldest frame waiting for a worker is dropped and its buffer
+      //! returned.
+      //! @return frame buffer or NULL if all buffers are being
+      //! compressed or are held by the consumer.
+      Frame*
+      acquire(void);
+
+      //! Queue an acquired frame for conversion and compression.
+      //! @param[in] frame frame buffer.
+      void
+      submit(Frame* frame);
+
+      //! Retrieve the next compressed frame, in submission order.
+      //! @param[in] timeout maximum amount of time to wait in
+      //! seconds, zero to return immediately.
+      //! @return compressed frame or NULL if none is available. The
+      //! frame must be given back with release().
+      Frame*
+      poll(double timeout = 0.0);
+
+      //! Return a frame buffer to the pool. Frames taken with
+      //! acquire() that are not submitted must also be released.
+      //! @param[in] frame frame buffer.
+      void
+      release(Frame* frame);
+
+      //! Retrieve the number of frames submitted but not yet
+      //! retrieved with poll().
+      //! @return number of frames.
+      size_t
+      getPending(void);
+
+      //! Retrieve pipeline statistics.
+      //! @return statistics.
+      Metrics
+      getMetrics(void);
+
+      //! Reset pipeline statistics.
+      void
+      resetMetrics(void);
+
+    private:
+      class Worker;
+      friend class Worker;
+
+      //! Pipeline settings.
+      Settings m_settings;
+      //! Lock and condition shared by all stages.
+      Concurrency::Condition m_cond;
+      //! All frame buffers.
+      std::vector<Frame*> m_frames;
+      //! Free frame buffers.
+      std::vector<Frame*> m_free;
+      //! Frames waiting for a worker.
+      std::deque<Frame*> m_queued;
+      //! Sequence numbers of frames waiting for or being compressed.
+      std::set<unsigned long> m_in_flight;
+      //! Compressed frames waiting for the consumer.
+      std::map<unsigned long, Frame*> m_done;
+      //! Worker threads.
+      std::vector<Worker*> m_workers;
+      //! Next sequence number.
+      unsigned long m_sequence;
+      //! JPEG quality.
+      unsigned m_quality;
+      //! True if workers must terminate.
+      bool m_stop;
+      //! Statistics.
+      Metrics m_metrics;
+      //! Event signalled when frames are ready.
+      IO::Event* m_event;
+
+      //! Wait for a queued frame. Called by workers.
+      //! @param[out] quality JPEG quality to use.
+      //! @return frame or NULL if the pipeline is stopping.
+      Frame*
+      take(unsigned& quality);
+
+      //! Mark a frame as compressed. Called by workers.
+      //! @param[in] frame frame buffer.
+      //! @param[in] success true if compression succeeded.
+      void
+      complete(Frame* frame, bool success);
+
+      //! Wake consumers if a frame can be delivered. Must be called
+      //! with the lock held.
+      void
+      notify(void);
+
+      //! Retrieve the next frame that can be delivered in order.
+      //! Must be called with the lock held.
+      //! @return frame or NULL.
+      Frame*
+      nextDone(void);
+
+      //! Non-copyable.
+      FramePipeline(const FramePipeline&);
+
+      //! Non-copyable.
+      FramePipeline&
+      operator=(const FramePipeline&);
+    };
+  }
+}
+
+#endif
@@ -28,6 +28,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <stdexcept>
 #include <cstdio>
 #include <cstdlib>
@@ -39,6 +40,7 @@
 
 // DUNE headers.
 #include <DUNE/Media/VideoCapture.hpp>
+#include <DUNE/IO/Poll.hpp>
 #include <DUNE/System/Error.hpp>
 #include <DUNE/Utils/String.hpp>
 
@@ -101,7 +103,13 @@ namespace DUNE
 
 #endif
 
-    VideoCapture::VideoCapture(const std::string& dev, uint32_t w, uint32_t h)
+    //! Number of user buffers the driver can hold at once.
+    static const unsigned c_user_buffers = 4;
+
+    VideoCapture::VideoCapture(const std::string& dev, uint32_t w, uint32_t h, bool user_buffers):
+      m_bfrs(NULL),
+      m_user_ptr(false),
+      m_user_index(0)
     {
       // Video 4 Linux library implementation.
 #if defined(DUNE_SYS_HAS_LIBV4L2_H)
@@ -122,15 +130,29 @@ namespace DUNE
       if (m_fmt->fmt.pix.pixelformat != V4L2_PIX_FMT_RGB24)
         throw std::runtime_error("pixel format RGB24 is not supported by device");
 
-      // Initialize V4L2 request buffers.
+      m_bfr = new v4l2_buffer;
       m_bfr_req = new v4l2_requestbuffers;
+
+      // Let the driver write frames straight to user buffers.
+      if (user_buffers && m_fmt->fmt.pix.bytesperline == m_fmt->fmt.pix.width * 3)
+      {
+        std::memset(m_bfr_req, 0, sizeof(v4l2_requestbuffers));
+        m_bfr_req->count = c_user_buffers;
+        m_bfr_req->type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        m_bfr_req->memory = V4L2_MEMORY_USERPTR;
+        m_user_ptr = (testIoctl(m_fd, VIDIOC_REQBUFS, m_bfr_req) == 0 && m_bfr_req->count > 0);
+      }
+
+      if (m_user_ptr)
+        return;
+
+      // Initialize V4L2 request buffers.
       std::memset(m_bfr_req, 0, sizeof(v4l2_requestbuffers));
       m_bfr_req->count = 2;
       m_bfr_req->type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
       m_bfr_req->memory = V4L2_MEMORY_MMAP;
       doIoctl(m_fd, VIDIOC_REQBUFS, m_bfr_req);
 
-      m_bfr = new v4l2_buffer;
       m_bfrs = (Buffer*)calloc(m_bfr_req->count, sizeof(Buffer));
 
       for (unsigned i = 0; i < m_bfr_req->count; ++i)
@@ -163,6 +185,7 @@ namespace DUNE
       (void)dev;
       (void)h;
       (void)w;
+      (void)user_buffers;
 
       throw std::runtime_error("VideoCapture is not yet implemented in this system.");
 #endif
@@ -174,8 +197,11 @@ namespace DUNE
 #if defined(DUNE_SYS_HAS_LIBV4L2_H)
       stop();
 
-      for (unsigned i = 0; i < m_bfr_req->count; ++i)
-        v4l2_munmap(m_bfrs[i].start, m_bfrs[i].length);
+      if (m_bfrs != NULL)
+      {
+        for (unsigned i = 0; i < m_bfr_req->count; ++i)
+          v4l2_munmap(m_bfrs[i].start, m_bfrs[i].length);
+      }
       v4l2_close(m_fd);
 
       free(m_bfrs);
@@ -192,6 +218,9 @@ namespace DUNE
       v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
       doIoctl(m_fd, VIDIOC_STREAMON, &type);
 
+      if (m_user_ptr)
+        return;
+
       // Read one frame to allow for captureFrame() to enqueue/deque
       // buffers in one run.
       std::memset(m_bfr, 0, sizeof(v4l2_buffer));
@@ -244,6 +273,10 @@ namespace DUNE
     VideoCapture::frameCapture(void)
     {
 #if defined(DUNE_SYS_HAS_LIBV4L2_H)
+      // Frames go to user buffers.
+      if (m_user_ptr)
+        return false;
+
       fd_set fds;
       timeval tv;
       int rv = 0;
@@ -293,6 +326,9 @@ namespace DUNE
     VideoCapture::frameData(void) const
     {
 #if defined(DUNE_SYS_HAS_LIBV4L2_H)
+      if (m_bfrs == NULL)
+        return 0;
+
       return (uint8_t*)m_bfrs[m_bfr->index].start;
 #else
       return 0;
@@ -306,6 +342,78 @@ namespace DUNE
       return m_bfr->bytesused;
 #else
       return 0;
+#endif
+    }
+
+    void
+    VideoCapture::queueFrame(uint8_t* data, size_t size)
+    {
+#if defined(DUNE_SYS_HAS_LIBV4L2_H)
+      if (size < (size_t)m_fmt->fmt.pix.width * m_fmt->fmt.pix.height * 3)
+        throw std::runtime_error("frame buffer is too small");
+
+      if (m_user_ptr)
+      {
+        if (m_user_bfrs.size() >= m_bfr_req->count)
+          throw std::runtime_error("too many frame buffers queued");
+
+        // Buffers are dequeued in order, so indices are reused in
+        // order too.
+        v4l2_buffer bfr;
+        std::memset(&bfr, 0, sizeof(v4l2_buffer));
+        bfr.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        bfr.memory = V4L2_MEMORY_USERPTR;
+        bfr.index = m_user_index;
+        bfr.m.userptr = (unsigned long)data;
+        bfr.length = size;
+        doIoctl(m_fd, VIDIOC_QBUF, &bfr);
+
+        m_user_index = (m_user_index + 1) % m_bfr_req->count;
+      }
+
+      Buffer bfr = {data, size};
+      m_user_bfrs.push_back(bfr);
+#else
+      (void)data;
+      (void)size;
+#endif
+    }
+
+    uint8_t*
+    VideoCapture::dequeueFrame(double timeout)
+    {
+#if defined(DUNE_SYS_HAS_LIBV4L2_H)
+      if (m_user_bfrs.empty())
+        return NULL;
+
+      if (!IO::Poll::poll(m_fd, timeout))
+        return NULL;
+
+      Buffer bfr = m_user_bfrs.front();
+
+      if (m_user_ptr)
+      {
+        std::memset(m_bfr, 0, sizeof(v4l2_buffer));
+        m_bfr->type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        m_bfr->memory = V4L2_MEMORY_USERPTR;
+        doIoctl(m_fd, VIDIOC_DQBUF, m_bfr);
+      }
+      else
+      {
+        doIoctl(m_fd, VIDIOC_QBUF, m_bfr);
+        std::memset(m_bfr, 0, sizeof(v4l2_buffer));
+        m_bfr->type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        m_bfr->memory = V4L2_MEMORY_MMAP;
+        doIoctl(m_fd, VIDIOC_DQBUF, m_bfr);
+        std::memcpy(bfr.start, m_bfrs[m_bfr->index].start,
+                    std::min(bfr.length, (size_t)m_bfr->bytesused));
+      }
+
+      m_user_bfrs.pop_front();
+      return (uint8_t*)bfr.start;
+#else
+      (void)timeout;
+      return NULL;
 #endif
     }
   }
@@ -31,6 +31,8 @@
 #define DUNE_MEDIA_VIDEO_CAPTURE_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <cstddef>
+#include <deque>
 #include <string>
 
 // DUNE headers.
@@ -60,7 +62,16 @@ namespace DUNE
         STANDARD_NTSC
       };
 
-      VideoCapture(const std::string& dev, uint32_t width, uint32_t height);
+      //! Constructor.
+      //! @param[in] dev video device.
+      //! @param[in] width frame width.
+      //! @param[in] height frame height.
+      //! @param[in] user_buffers if true frames are captured into
+      //! buffers given with queueFrame() instead of the driver's
+      //! buffers. Drivers that cannot write to user memory, or that
+      //! pad frame lines, fill them by copying.
+      VideoCapture(const std::string& dev, uint32_t width, uint32_t height,
+                   bool user_buffers = false);
 
       ~VideoCapture(void);
 
@@ -88,6 +99,24 @@ namespace DUNE
       uint32_t
       frameSize(void) const;
 
+      //! Hand a buffer over to be filled with a frame. Buffers are
+      //! filled in the order they are queued and must remain valid
+      //! until dequeued or the capture is destroyed. Requires user
+      //! buffers.
+      //! @param[in] data buffer.
+      //! @param[in] size buffer size in bytes (at least
+      //! width * height * 3).
+      void
+      queueFrame(uint8_t* data, size_t size);
+
+      //! Wait for the oldest queued buffer to be filled.
+      //! @param[in] timeout maximum amount of time to wait in
+      //! seconds, zero to return immediately.
+      //! @return filled buffer or NULL if no frame arrived in time or
+      //! no buffer is queued.
+      uint8_t*
+      dequeueFrame(double timeout);
+
     private:
       struct Buffer
       {
@@ -100,6 +129,12 @@ namespace DUNE
       struct v4l2_buffer* m_bfr;
       struct v4l2_requestbuffers* m_bfr_req;
       struct Buffer* m_bfrs;
+      //! True if the driver writes frames to user buffers.
+      bool m_user_ptr;
+      //! Index of the next user buffer handed to the driver.
+      unsigned m_user_index;
+      //! User buffers waiting for frames.
+      std::deque<Buffer> m_user_bfrs;
     };
   }
 }
@@ -119,6 +119,14 @@ namespace DUNE
       .defaultValue("true")
       .description("This variable signals that a depth sensor device is installed on system");
 
+      param("Kalman Update Mode", m_kal_update_mode)
+      .values("Batch, Sequential, UD")
+      .defaultValue("Batch")
+      .visibility(Tasks::Parameter::VISIBILITY_DEVELOPER)
+      .description("Kalman filter measurement update algorithm: all outputs at once,"
+                   " one output at a time, or one output at a time on the U-D"
+                   " factors of the covariance matrix");
+
       param("DVL sanity timeout", m_dvl_sanity_timeout)
       .units(Units::Second)
       .defaultValue("10.0")
@@ -268,6 +276,13 @@ namespace DUNE
       m_time_without_euler.setTop(m_without_euler_timeout);
       m_dvl_sanity_timer.setTop(m_dvl_sanity_timeout);
 
+      if (m_kal_update_mode == "Sequential")
+        m_kal.setUpdateMode(KalmanFilter::UPDATE_SEQUENTIAL);
+      else if (m_kal_update_mode == "UD")
+        m_kal.setUpdateMode(KalmanFilter::UPDATE_UD);
+      else
+        m_kal.setUpdateMode(KalmanFilter::UPDATE_BATCH);
+
       // Distance DVL to vehicle Center of Gravity is 0 in Simulation.
       if (m_ctx.profiles.isSelected("Simulation"))
       {
@@ -924,17 +939,17 @@ namespace DUNE
     {
       // "Outlier Rejection for Autonomous Acoustic Navigation"
       // Jerome Vaganay, John J. Leonard and James G. Bellingham. MIT
-      Math::Matrix H(1, 2, 0.0);
+      Math::SMatrix<1, 2> H;
       H(0, 0) = dx / exp_range;
       H(0, 1) = dy / exp_range;
-      Math::Matrix P(2, 2, 0.0);
-      P = m_kal.getCovariance(STATE_X, STATE_Y, STATE_X, STATE_Y);
+      Math::SMatrix<2, 2> P(m_kal.getCovariance(STATE_X, STATE_Y, STATE_X, STATE_Y));
+      double hph = Math::quadratic(H, P)(0);
 
       double k = getLblRejectionValue(exp_range);
-      double R = std::max(k, (H * P * transpose (H))(0));
+      double R = std::max(k, hph);
 
       double d = range - exp_range;
-      m_navdata.lbl_rej_level = (d * (1 / ((H * P * transpose (H))(0) + R)) * d);
+      m_navdata.lbl_rej_level = (d * (1 / (hph + R)) * d);
 
       // Is rejection level above maximum threshold?
       if (m_navdata.lbl_rej_level >= m_lbl_threshold)
@@ -1215,21 +1230,19 @@ namespace DUNE
     void
     BasicNavigation::extractEarthRotation(double& p, double& q, double& r)
     {
-      // Insert euler angles into row matrix.
-      Math::Matrix ea(3,1);
-      ea(0) = Math::Angles::normalizeRadian(getEuler(AXIS_X));
-      ea(1) = Math::Angles::normalizeRadian(getEuler(AXIS_Y));
-      ea(2) = Math::Angles::normalizeRadian(getEuler(AXIS_Z));
+      // Euler angles.
+      Math::EulerAnglesZyx ea(Math::Angles::normalizeRadian(getEuler(AXIS_X)),
+                              Math::Angles::normalizeRadian(getEuler(AXIS_Y)),
+                              Math::Angles::normalizeRadian(getEuler(AXIS_Z)));
 
       // Earth rotation vector.
-      Math::Matrix we(3,1);
+      Math::SMatrix<3, 1> we;
       we(0) = Math::c_earth_rotation * std::cos(m_last_lat);
       we(1) = 0.0;
       we(2) = - Math::c_earth_rotation * std::sin(m_last_lat);
 
       // Sensed angular velocities due to Earth rotation effect.
-      Math::Matrix av(3,1);
-      av = transpose(ea.toDCM()) * we;
+      Math::SMatrix<3, 1> av = transpose(ea.rotationMatrix()) * we;
 
       // Extract from angular velocities measurements.
       p -= av(0);
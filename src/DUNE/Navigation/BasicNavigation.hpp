@@ -42,7 +42,9 @@
 #include <DUNE/Memory.hpp>
 #include <DUNE/Math/Angles.hpp>
 #include <DUNE/Math/Derivative.hpp>
+#include <DUNE/Math/EulerAnglesZyx.hpp>
 #include <DUNE/Math/MovingAverage.hpp>
+#include <DUNE/Math/SMatrix.hpp>
 #include <DUNE/Navigation/KalmanFilter.hpp>
 #include <DUNE/Navigation/Ranging.hpp>
 #include <DUNE/Navigation/StreamEstimator.hpp>
@@ -637,6 +639,8 @@ namespace DUNE
       bool m_reject_all_lbl;
       //! Use a Depth sensor.
       bool m_depth_sensor;
+      //! Kalman filter measurement update algorithm.
+      std::string m_kal_update_mode;
       //! LBL rejection constants.
       std::vector<float> m_lbl_reject_constants;
       //! Displacement between DVL and vehicle center of gravity.
@@ -28,14 +28,20 @@
 // Author: José Braga                                                       *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+
 // DUNE headers.
 #include <DUNE/Navigation/KalmanFilter.hpp>
+#include <DUNE/Math/SMatrix.hpp>
 
 namespace DUNE
 {
   namespace Navigation
   {
-    KalmanFilter::KalmanFilter(void)
+    KalmanFilter::KalmanFilter(void):
+      m_update_mode(UPDATE_BATCH),
+      m_rejected(0)
     {
       m_state_count = 1;
       Math::Matrix I(1);
@@ -43,7 +49,9 @@ namespace DUNE
       m_x = m_y = m_ax = m_ap = m_c = m_p = m_q = m_r = m_innov = I;
     }
 
-    KalmanFilter::KalmanFilter(Math::Matrix& A, Math::Matrix& C, Math::Matrix& P, Math::Matrix& Q)
+    KalmanFilter::KalmanFilter(Math::Matrix& A, Math::Matrix& C, Math::Matrix& P, Math::Matrix& Q):
+      m_update_mode(UPDATE_BATCH),
+      m_rejected(0)
     {
       m_ax = A;
       m_ap = A;
@@ -107,6 +115,48 @@ namespace DUNE
       m_p = 0.5 * (m_p + transpose(m_p));
     }
 
+    //! Fixed-size prediction: x = ax * x and p = ap * p * ap' + q.
+    template <size_t N>
+    static void
+    predictKernel(const Math::Matrix& ax, const Math::Matrix& ap, const Math::Matrix& q,
+                  Math::Matrix* x, Math::Matrix& p)
+    {
+      const Math::SMatrix<N, N> sap(ap);
+      const Math::SMatrix<N, N> sp(p);
+      (Math::quadratic(sap, sp) + Math::SMatrix<N, N>(q)).copyTo(p);
+
+      if (x != NULL)
+        (Math::SMatrix<N, N>(ax) * Math::SMatrix<N, 1>(*x)).copyTo(*x);
+    }
+
+    bool
+    KalmanFilter::predictFixed(Math::Matrix* x)
+    {
+      switch (m_state_count)
+      {
+        case 1: predictKernel<1>(m_ax, m_ap, m_q, x, m_p); return true;
+        case 2: predictKernel<2>(m_ax, m_ap, m_q, x, m_p); return true;
+        case 3: predictKernel<3>(m_ax, m_ap, m_q, x, m_p); return true;
+        case 4: predictKernel<4>(m_ax, m_ap, m_q, x, m_p); return true;
+        case 5: predictKernel<5>(m_ax, m_ap, m_q, x, m_p); return true;
+        case 6: predictKernel<6>(m_ax, m_ap, m_q, x, m_p); return true;
+        case 7: predictKernel<7>(m_ax, m_ap, m_q, x, m_p); return true;
+        case 8: predictKernel<8>(m_ax, m_ap, m_q, x, m_p); return true;
+        case 9: predictKernel<9>(m_ax, m_ap, m_q, x, m_p); return true;
+        case 10: predictKernel<10>(m_ax, m_ap, m_q, x, m_p); return true;
+        case 11: predictKernel<11>(m_ax, m_ap, m_q, x, m_p); return true;
+        case 12: predictKernel<12>(m_ax, m_ap, m_q, x, m_p); return true;
+        default: return false;
+      }
+    }
+
+    void
+    KalmanFilter::predictCovariance(void)
+    {
+      Math::Matrix::quadraticInto(m_ap, m_p, m_q, m_p_next);
+      std::swap(m_p, m_p_next);
+    }
+
     void
     KalmanFilter::predict(Math::Matrix& b, Math::Matrix& u)
     {
@@ -114,14 +164,19 @@ namespace DUNE
         throw std::runtime_error(DTR("invalid dimensions"));
 
       m_x = m_ax * m_x + b * u;
-      m_p = m_ap * m_p * transpose(m_ap) + m_q;
+
+      if (!predictFixed(NULL))
+        predictCovariance();
     }
 
     void
     KalmanFilter::predict(void)
     {
-      m_x = m_ax * m_x;
-      m_p = m_ap * m_p * transpose(m_ap) + m_q;
+      if (!predictFixed(&m_x))
+      {
+        m_x = m_ax * m_x;
+        predictCovariance();
+      }
     }
 
     int
@@ -139,6 +194,33 @@ namespace DUNE
       if (m_r.rows() != m_r.columns() || m_r.rows() != m_innov.rows())
         throw std::runtime_error(DTR("invalid dimensions"));
 
+      m_rejected = 0;
+
+      if (m_update_mode != UPDATE_BATCH)
+      {
+        bool diagonal = true;
+        for (int i = 0; i < m_r.rows() && diagonal; ++i)
+        {
+          for (int j = 0; j < m_r.columns(); ++j)
+          {
+            if (i != j && m_r(i, j) != 0.0)
+            {
+              diagonal = false;
+              break;
+            }
+          }
+        }
+
+        if (diagonal)
+          return updateSequential(threshold, m_update_mode == UPDATE_UD);
+      }
+
+      return updateBatch(threshold);
+    }
+
+    int
+    KalmanFilter::updateBatch(float threshold)
+    {
       // Measurement prediction covariance.
       Math::Matrix S = (m_c * m_p * transpose(m_c)) + m_r;
       Math::Matrix S_1;
@@ -160,7 +242,10 @@ namespace DUNE
         double level = (transpose(m_innov) * S_1 * m_innov)(0);
 
         if (level >= threshold)
+        {
+          m_rejected = m_innov.rows();
           return -1;
+        }
       }
 
       // Kalman Gain.
@@ -175,6 +260,200 @@ namespace DUNE
       return 0;
     }
 
+    void
+    KalmanFilter::factorUD(void)
+    {
+      const size_t n = m_state_count;
+      std::vector<double>& u = m_work_p;
+      std::vector<double>& d = m_work_d;
+
+      // Work upwards from the last column: P = U * D * U'.
+      for (size_t j = n; j-- > 0;)
+      {
+        double dj = m_p(j, j);
+        for (size_t k = j + 1; k < n; ++k)
+          dj -= d[k] * u[j * n + k] * u[j * n + k];
+
+        // Clamp round-off and states with no uncertainty left.
+        d[j] = (dj > 0.0) ? dj : 0.0;
+        u[j * n + j] = 1.0;
+
+        for (size_t i = 0; i < j; ++i)
+        {
+          if (d[j] == 0.0)
+          {
+            u[i * n + j] = 0.0;
+            continue;
+          }
+
+          double pij = m_p(i, j);
+          for (size_t k = j + 1; k < n; ++k)
+            pij -= d[k] * u[i * n + k] * u[j * n + k];
+          u[i * n + j] = pij / d[j];
+        }
+
+        for (size_t i = j + 1; i < n; ++i)
+          u[i * n + j] = 0.0;
+      }
+    }
+
+    int
+    KalmanFilter::updateSequential(float threshold, bool ud)
+    {
+      const size_t n = m_state_count;
+      const size_t m = m_innov.rows();
+
+      m_work_p.resize(n * n);
+      m_work_d.resize(n);
+      m_work_x.resize(2 * n);
+      m_work_h.resize(3 * n);
+
+      // Covariance (or U) and its diagonal factor.
+      double* P = &m_work_p[0];
+      double* D = &m_work_d[0];
+      // State correction accumulated over the outputs processed so far.
+      double* dx = &m_work_x[0];
+      // Observation row.
+      double* h = &m_work_h[0];
+      // P * h' or U' * h'.
+      double* f = &m_work_h[n];
+      // Gain (D * U' * h' in U-D form).
+      double* g = &m_work_h[2 * n];
+
+      if (ud)
+      {
+        factorUD();
+      }
+      else
+      {
+        for (size_t i = 0; i < n; ++i)
+          for (size_t j = 0; j < n; ++j)
+            P[i * n + j] = m_p(i, j);
+      }
+
+      std::fill(dx, dx + n, 0.0);
+
+      for (size_t o = 0; o < m; ++o)
+      {
+        bool observed = false;
+        for (size_t j = 0; j < n; ++j)
+        {
+          h[j] = m_c(o, j);
+          observed = observed || h[j] != 0.0;
+        }
+
+        if (!observed)
+          continue;
+
+        // Innovations are relative to the predicted state: account for
+        // the corrections made by the outputs already processed.
+        double nu = m_innov(o);
+        for (size_t j = 0; j < n; ++j)
+          nu -= h[j] * dx[j];
+
+        // Measurement prediction variance.
+        double s = m_r(o, o);
+
+        if (ud)
+        {
+          for (size_t j = 0; j < n; ++j)
+          {
+            f[j] = h[j];
+            for (size_t i = 0; i < j; ++i)
+              f[j] += P[i * n + j] * h[i];
+            g[j] = D[j] * f[j];
+            s += f[j] * g[j];
+          }
+        }
+        else
+        {
+          for (size_t i = 0; i < n; ++i)
+          {
+            f[i] = 0.0;
+            for (size_t j = 0; j < n; ++j)
+              f[i] += P[i * n + j] * h[j];
+            s += h[i] * f[i];
+          }
+        }
+
+        if (s <= 0.0 || (threshold != 0 && nu * nu / s >= threshold))
+        {
+          ++m_rejected;
+          continue;
+        }
+
+        if (ud)
+        {
+          // Bierman's scalar measurement update of U and D.
+          double alpha = m_r(o, o);
+          double gamma = 1.0 / alpha;
+
+          for (size_t j = 0; j < n; ++j)
+          {
+            double beta = alpha;
+            alpha += f[j] * g[j];
+            double lambda = -f[j] * gamma;
+            gamma = 1.0 / alpha;
+            D[j] *= beta * gamma;
+
+            for (size_t i = 0; i < j; ++i)
+            {
+              beta = P[i * n + j];
+              P[i * n + j] = beta + g[i] * lambda;
+              g[i] += g[j] * beta;
+            }
+          }
+
+          for (size_t j = 0; j < n; ++j)
+            dx[j] += g[j] * gamma * nu;
+        }
+        else
+        {
+          // Gain and covariance update, keeping P symmetric.
+          for (size_t j = 0; j < n; ++j)
+            g[j] = f[j] / s;
+
+          for (size_t i = 0; i < n; ++i)
+          {
+            dx[i] += g[i] * nu;
+            for (size_t j = i; j < n; ++j)
+            {
+              P[i * n + j] -= g[i] * f[j];
+              P[j * n + i] = P[i * n + j];
+            }
+          }
+        }
+      }
+
+      for (size_t i = 0; i < n; ++i)
+        m_x(i) += dx[i];
+
+      if (ud)
+      {
+        // P = U * D * U' (symmetric and positive semi-definite by
+        // construction).
+        for (size_t i = 0; i < n; ++i)
+        {
+          for (size_t j = i; j < n; ++j)
+          {
+            double v = 0.0;
+            for (size_t k = j; k < n; ++k)
+              v += P[i * n + k] * D[k] * P[j * n + k];
+            m_p(i, j) = v;
+            m_p(j, i) = v;
+          }
+        }
+      }
+      else
+      {
+        for (size_t i = 0; i < n; ++i)
+          for (size_t j = 0; j < n; ++j)
+            m_p(i, j) = P[i * n + j];
+      }
+
+      return m_rejected ? -1 : 0;
+    }
+
     void
     KalmanFilter::setState(short pos, double value)
     {
@@ -45,6 +45,7 @@
 // ISO C++ 98 headers.
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include <cmath>
 
 // DUNE headers.
@@ -61,6 +62,18 @@ namespace DUNE
     class KalmanFilter
     {
     public:
+      //! Measurement update algorithms.
+      enum UpdateMode
+      {
+        //! All outputs at once, inverting the innovation covariance.
+        UPDATE_BATCH,
+        //! One output at a time as scalar updates (no matrix inverse).
+        UPDATE_SEQUENTIAL,
+        //! Scalar updates of the U-D factors of the covariance matrix
+        //! (Bierman).
+        UPDATE_UD
+      };
+
       //! Constructor.
       KalmanFilter(void);
 
@@ -104,11 +117,42 @@ namespace DUNE
       predict(void);
 
       //! Kalman Filter update function.
+      //! In batch mode the threshold is applied to the whole innovation
+      //! vector and nothing is updated if it is exceeded. In sequential
+      //! and U-D modes it is applied to each output and only the
+      //! offending outputs are discarded. Outputs whose observation row
+      //! is zero are skipped. Sequential and U-D modes require a
+      //! diagonal measurement noise covariance matrix, otherwise the
+      //! batch update is used.
       //! @param threshold threshold to reject large state innovations.
       //! @return 0 if update is successful, -1 otherwise.
       int
       update(float threshold);
 
+      //! Select the measurement update algorithm.
+      //! @param mode update mode.
+      void
+      setUpdateMode(UpdateMode mode)
+      {
+        m_update_mode = mode;
+      }
+
+      //! Get the measurement update algorithm.
+      //! @return update mode.
+      UpdateMode
+      getUpdateMode(void) const
+      {
+        return m_update_mode;
+      }
+
+      //! Get the number of outputs rejected by the last update.
+      //! @return number of rejected outputs.
+      unsigned
+      getRejectedCount(void) const
+      {
+        return m_rejected;
+      }
+
       //! Get filter state value.
       //! @param pos matrix index.
       //! @return state matrix value.
@@ -341,6 +385,35 @@ namespace DUNE
       setMeasurementNoise(double value);
 
     private:
+      //! Propagate the state covariance matrix (and optionally the
+      //! state vector) using fixed-size stack matrices.
+      //! @param x state vector to propagate or NULL.
+      //! @return true if the state count has a fixed-size
+      //! implementation, false otherwise.
+      bool
+      predictFixed(Math::Matrix* x);
+
+      //! Propagate the state covariance matrix for any state count.
+      void
+      predictCovariance(void);
+
+      //! Update all outputs at once.
+      //! @param threshold innovation rejection threshold.
+      //! @return 0 if update is successful, -1 otherwise.
+      int
+      updateBatch(float threshold);
+
+      //! Update one output at a time.
+      //! @param threshold innovation rejection threshold.
+      //! @param ud true to update the U-D factors of the covariance.
+      //! @return 0 if all outputs were accepted, -1 otherwise.
+      int
+      updateSequential(float threshold, bool ud);
+
+      //! Factor the covariance matrix as P = U * D * U'.
+      void
+      factorUD(void);
+
       //! Kalman filter state count.
       size_t m_state_count;
       //! State vector.
@@ -361,6 +434,20 @@ namespace DUNE
       Math::Matrix m_r;
       //! Innovation vector.
       Math::Matrix m_innov;
+      //! Scratch storage for the propagated covariance matrix.
+      Math::Matrix m_p_next;
+      //! Measurement update algorithm.
+      UpdateMode m_update_mode;
+      //! Outputs rejected by the last update.
+      unsigned m_rejected;
+      //! Covariance (or unit upper triangular U) scratch storage.
+      std::vector<double> m_work_p;
+      //! Diagonal D scratch storage.
+      std::vector<double> m_work_d;
+      //! State and state correction scratch storage.
+      std::vector<double> m_work_x;
+      //! Output row and gain scratch storage.
+      std::vector<double> m_work_h;
     };
   }
 }
@@ -28,6 +28,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 #include <iostream>
@@ -121,6 +122,11 @@ namespace DUNE
 {
   namespace Network
   {
+#if defined(DUNE_SYS_HAS_SENDMSG)
+    //! Maximum number of segments per sendmsg() call.
+    static const size_t c_max_segments = 64;
+#endif
+
     TCPSocket::TCPSocket(bool create):
       m_handle(INVALID_SOCKET)
     {
@@ -252,6 +258,53 @@ namespace DUNE
       return static_cast<size_t>(rv);
     }
 
+    size_t
+    TCPSocket::tryWrite(const Segment* segs, size_t count)
+    {
+      if (count == 0)
+        return 0;
+
+      int flags = 0;
+
+#if defined(MSG_NOSIGNAL)
+      flags |= MSG_NOSIGNAL;
+#endif
+
+#if defined(MSG_DONTWAIT)
+      flags |= MSG_DONTWAIT;
+#endif
+
+#if defined(DUNE_SYS_HAS_SENDMSG)
+      iovec iovs[c_max_segments];
+      size_t n = std::min(count, c_max_segments);
+      for (size_t i = 0; i < n; ++i)
+      {
+        iovs[i].iov_base = const_cast<uint8_t*>(segs[i].data);
+        iovs[i].iov_len = segs[i].size;
+      }
+
+      msghdr msg;
+      std::memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = iovs;
+      msg.msg_iovlen = n;
+
+      ssize_t rv = ::sendmsg(m_handle, &msg, flags);
+#else
+      ssize_t rv = ::send(m_handle, (char*)segs[0].data, segs[0].size, flags);
+#endif
+
+      if (rv < 0)
+      {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+          return 0;
+        if (errno == EPIPE || errno == ECONNRESET)
+          throw ConnectionClosed();
+        throw NetworkError(DTR("error sending data"), getLastErrorMessage());
+      }
+
+      return static_cast<size_t>(rv);
+    }
+
     void
     TCPSocket::doFlushInput(void)
     {
@@ -55,6 +55,15 @@ namespace DUNE
     class TCPSocket: public IO::Handle
     {
     public:
+      //! Data segment descriptor used by vectored transfers.
+      struct Segment
+      {
+        //! Segment data.
+        const uint8_t* data;
+        //! Length of data.
+        size_t size;
+      };
+
       //! Create an unbound TCP socket.
       TCPSocket(bool create = true);
 
@@ -74,6 +83,16 @@ namespace DUNE
       TCPSocket*
       accept(Address* a = 0, uint16_t* port = 0);
 
+      //! Send as much as possible of a sequence of data segments
+      //! without waiting for buffer space. Where available this uses
+      //! a single sendmsg() system call per group of segments.
+      //! @param segs data segments.
+      //! @param count number of segments.
+      //! @return number of bytes sent, zero if the socket's output
+      //! buffer is full.
+      size_t
+      tryWrite(const Segment* segs, size_t count);
+
       bool
       writeFile(const char* filename, int64_t off_end, int64_t off_beg = -1);
 
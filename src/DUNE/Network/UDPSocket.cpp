@@ -28,7 +28,9 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <cerrno>
+#include <cstring>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
@@ -93,6 +95,11 @@ namespace DUNE
 {
   namespace Network
   {
+#if defined(DUNE_SYS_HAS_SENDMMSG) || defined(DUNE_SYS_HAS_RECVMMSG)
+    //! Maximum number of datagrams per sendmmsg()/recvmmsg() call.
+    static const size_t c_max_batch = 64;
+#endif
+
     UDPSocket::UDPSocket(void):
       m_con_port(0)
     {
@@ -232,6 +239,108 @@ namespace DUNE
       return rv;
     }
 
+    size_t
+    UDPSocket::write(const Datagram* dgrams, size_t count)
+    {
+      size_t sent = 0;
+
+#if defined(DUNE_SYS_HAS_SENDMMSG)
+      sockaddr_in hosts[c_max_batch];
+      iovec iovs[c_max_batch];
+      mmsghdr msgs[c_max_batch];
+
+      size_t index = 0;
+      while (index < count)
+      {
+        size_t n = std::min(count - index, c_max_batch);
+        std::memset(hosts, 0, n * sizeof(sockaddr_in));
+        std::memset(msgs, 0, n * sizeof(mmsghdr));
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          const Datagram& dgram = dgrams[index + i];
+          hosts[i].sin_family = AF_INET;
+          hosts[i].sin_port = Utils::ByteCopy::toBE(dgram.port);
+          hosts[i].sin_addr.s_addr = dgram.addr.toInteger();
+          iovs[i].iov_base = dgram.data;
+          iovs[i].iov_len = dgram.size;
+          msgs[i].msg_hdr.msg_name = &hosts[i];
+          msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+          msgs[i].msg_hdr.msg_iov = &iovs[i];
+          msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int rv = sendmmsg(m_handle, msgs, n, 0);
+        if (rv < 0 && errno == EINTR)
+          continue;
+
+        // sendmmsg() stops at the first datagram that fails: skip it.
+        if (rv <= 0)
+        {
+          ++index;
+          continue;
+        }
+
+        sent += rv;
+        index += rv;
+      }
+#else
+      for (size_t i = 0; i < count; ++i)
+      {
+        try
+        {
+          write(dgrams[i].data, dgrams[i].size, dgrams[i].addr, dgrams[i].port);
+          ++sent;
+        }
+        catch (std::runtime_error&)
+        { }
+      }
+#endif
+
+      return sent;
+    }
+
+    size_t
+    UDPSocket::read(Datagram* dgrams, size_t count)
+    {
+      if (count == 0)
+        return 0;
+
+#if defined(DUNE_SYS_HAS_RECVMMSG)
+      size_t n = std::min(count, c_max_batch);
+      sockaddr_in hosts[c_max_batch];
+      iovec iovs[c_max_batch];
+      mmsghdr msgs[c_max_batch];
+      std::memset(msgs, 0, n * sizeof(mmsghdr));
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        iovs[i].iov_base = dgrams[i].data;
+        iovs[i].iov_len = dgrams[i].size;
+        msgs[i].msg_hdr.msg_name = &hosts[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      int rv = recvmmsg(m_handle, msgs, n, MSG_WAITFORONE, NULL);
+      if (rv <= 0)
+        throw NetworkError(DTR("error receiving data"), DUNE_SOCKET_ERROR);
+
+      for (int i = 0; i < rv; ++i)
+      {
+        dgrams[i].size = msgs[i].msg_len;
+        dgrams[i].addr = (::sockaddr*)&hosts[i];
+        dgrams[i].port = Utils::ByteCopy::fromBE(hosts[i].sin_port);
+      }
+
+      return rv;
+#else
+      dgrams[0].size = read(dgrams[0].data, dgrams[0].size, &dgrams[0].addr, &dgrams[0].port);
+      return 1;
+#endif
+    }
+
     void
     UDPSocket::createEventHandle(void)
     {
@@ -51,6 +51,19 @@ namespace DUNE
     class UDPSocket: public IO::Handle
     {
     public:
+      //! Datagram descriptor used by batched transfers.
+      struct Datagram
+      {
+        //! Datagram data.
+        uint8_t* data;
+        //! Length of data (buffer capacity when reading).
+        size_t size;
+        //! Remote host address.
+        Address addr;
+        //! Remote host port.
+        uint16_t port;
+      };
+
       //! Create an unbound UDP socket.
       UDPSocket(void);
 
@@ -97,6 +110,27 @@ namespace DUNE
       size_t
       read(uint8_t* buffer, size_t size, Address* addr = NULL, uint16_t* port = NULL);
 
+      //! Send several UDP datagrams, each to its own host. Where
+      //! available this uses a single sendmmsg() system call per
+      //! group of datagrams. Datagrams that cannot be sent (e.g.,
+      //! unreachable host) are skipped.
+      //! @param dgrams datagrams to send.
+      //! @param count number of datagrams.
+      //! @return number of datagrams sent.
+      size_t
+      write(const Datagram* dgrams, size_t count);
+
+      //! Receive one or more UDP datagrams. Waits for the first
+      //! datagram and then retrieves, without waiting, the ones
+      //! already queued (using a single recvmmsg() system call where
+      //! available). On return the size, address and port of each
+      //! received datagram are updated.
+      //! @param dgrams datagram buffers.
+      //! @param count number of datagram buffers.
+      //! @return number of datagrams received.
+      size_t
+      read(Datagram* dgrams, size_t count);
+
     private:
       //! Platform specific handle.
 #if defined(DUNE_OS_WINDOWS)
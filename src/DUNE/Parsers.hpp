@@ -39,6 +39,8 @@ namespace DUNE
 
 #include <DUNE/Parsers/Config.hpp>
 #include <DUNE/Parsers/PD4.hpp>
+#include <DUNE/Parsers/NMEATokenizer.hpp>
+#include <DUNE/Parsers/NMEADispatcher.hpp>
 #include <DUNE/Parsers/NMEAReader.hpp>
 #include <DUNE/Parsers/NMEAWriter.hpp>
 #include <DUNE/Parsers/AbstractStringReader.hpp>
@@ -47,5 +49,6 @@ namespace DUNE
 #include <DUNE/Parsers/BasicStringWriter.hpp>
 #include <DUNE/Parsers/PlanConfigParser.hpp>
 #include <DUNE/Parsers/HDF5Reader.hpp>
+#include <DUNE/Parsers/HDF5BlockCache.hpp>
 
 #endif
@@ -0,0 +1,494 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_PARSERS_HDF5_BLOCK_CACHE_HPP_INCLUDED_
+#define DUNE_PARSERS_HDF5_BLOCK_CACHE_HPP_INCLUDED_
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <functional>
+#include <list>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DUNE/Concurrency/Condition.hpp"
+#include "DUNE/Concurrency/ScopedCondition.hpp"
+#include "DUNE/Concurrency/Thread.hpp"
+#include "DUNE/Parsers/HDF5Reader.hpp"
+
+namespace DUNE
+{
+  namespace Parsers
+  {
+    //! Least recently used cache of the blocks of a large dataset.
+    //!
+    //! The dataset is divided in rectangular blocks which are read on
+    //! demand and kept while they fit in a memory budget; the least
+    //! recently used blocks are evicted first. Blocks can be prefetched
+    //! by a background thread so that they are available when needed.
+    //! @tparam T type of the data values.
+    //! @tparam dim number of dimensions of the dataset.
+    template<typename T, size_t dim>
+    class HDF5BlockCache
+    {
+    public:
+      //! Index of a point of the dataset.
+      using Index = std::array<size_t, dim>;
+
+      //! Reads a block of data, in row-major order, given the index of its
+      //! first point and its number of points in each dimension. It may be
+      //! called concurrently by the prefetch thread and by callers of get().
+      using Loader = std::function<std::vector<T>(Index const&, Index const&)>;
+
+      //! Constructor for a dataset of an HDF5 file.
+      //! @param[in] reader HDF5 file. It must outlive the cache. Reads are
+      //! serialized by the reader, so several caches may share it.
+      //! @param[in] path path to the dataset in the file.
+      //! @param[in] block number of points of a block in each dimension.
+      //! @param[in] capacity memory budget (bytes).
+      HDF5BlockCache(HDF5Reader const& reader,
+                     std::string const& path,
+                     Index const& block,
+                     size_t capacity)
+          : HDF5BlockCache(toIndex(reader.getDatasetDimensions(path)),
+                           [&reader, path](Index const& offset, Index const& size) {
+                             return reader
+                                 .getHyperslab<T>(path,
+                                                  std::vector<size_t>(std::begin(offset), std::end(offset)),
+                                                  std::vector<size_t>(std::begin(size), std::end(size)))
+                                 .data;
+                           },
+                           block,
+                           capacity)
+      { }
+
+      //! Constructor.
+      //! @param[in] dimensions number of points of the dataset in each
+      //! dimension.
+      //! @param[in] loader function reading blocks of the dataset.
+      //! @param[in] block number of points of a block in each dimension.
+      //! @param[in] capacity memory budget (bytes). At least one block is
+      //! always kept.
+      HDF5BlockCache(Index const& dimensions,
+                     Loader loader,
+                     Index const& block,
+                     size_t capacity);
+
+      //! Destructor. Stops the prefetch thread.
+      ~HDF5BlockCache();
+
+      //! Get a value of the dataset, reading its block if needed.
+      //! @param[in] indices index of the point.
+      //! @return value at the given point.
+      T
+      get(Index const& indices);
+
+      //! Request a block to be read in the background.
+      //! @param[in] indices index of any point of the block.
+      void
+      prefetch(Index const& indices);
+
+      //! Get the number of points of the dataset along a dimension.
+      //! @param[in] dimension index of the dimension to query.
+      //! @return number of points along the given dimension.
+      size_t
+      getDimensions(size_t dimension) const
+      {
+        return m_dims.at(dimension);
+      }
+
+      //! Get the number of points of a block along a dimension.
+      //! @param[in] dimension index of the dimension to query.
+      //! @return number of points along the given dimension.
+      size_t
+      getBlockDimensions(size_t dimension) const
+      {
+        return m_block.at(dimension);
+      }
+
+      //! @return number of values found in cached blocks.
+      size_t
+      getHits()
+      {
+        Concurrency::ScopedCondition l(m_cond);
+        return m_hits;
+      }
+
+      //! @return number of values whose block had to be read.
+      size_t
+      getMisses()
+      {
+        Concurrency::ScopedCondition l(m_cond);
+        return m_misses;
+      }
+
+      //! @return memory used by cached blocks (bytes).
+      size_t
+      getUsage()
+      {
+        Concurrency::ScopedCondition l(m_cond);
+        return m_usage;
+      }
+
+    private:
+      //! Prefetch thread.
+      class Prefetcher: public Concurrency::Thread
+      {
+      public:
+        Prefetcher(HDF5BlockCache& cache):
+          m_cache(cache)
+        { }
+
+      private:
+        //! Owner.
+        HDF5BlockCache& m_cache;
+
+        void
+        run(void)
+        {
+          m_cache.run();
+        }
+      };
+
+      //! Cached block.
+      struct Block
+      {
+        //! Block number.
+        size_t key;
+        //! Number of points in each dimension.
+        Index size;
+        //! Values in row-major order.
+        std::vector<T> data;
+      };
+
+      using List = std::list<Block>;
+
+      //! Number of points of the dataset in each dimension.
+      Index m_dims;
+      //! Number of points of a block in each dimension.
+      Index m_block;
+      //! Number of blocks in each dimension.
+      Index m_blocks;
+      //! Memory budget (bytes).
+      size_t m_capacity;
+      //! Reads blocks of the dataset.
+      Loader m_loader;
+      //! Blocks, most recently used first.
+      List m_lru;
+      //! Blocks by block number.
+      std::unordered_map<size_t, typename List::iterator> m_index;
+      //! Memory used by cached blocks (bytes).
+      size_t m_usage;
+      //! Blocks being read.
+      std::set<size_t> m_loading;
+      //! Blocks to prefetch.
+      std::deque<size_t> m_requests;
+      //! Number of cache hits.
+      size_t m_hits;
+      //! Number of cache misses.
+      size_t m_misses;
+      //! True to stop the prefetch thread.
+      bool m_stop;
+      //! Protects the above and signals loaded blocks and prefetch
+      //! requests.
+      Concurrency::Condition m_cond;
+      //! Prefetch thread, started on the first request.
+      Prefetcher* m_prefetcher;
+
+      static Index
+      toIndex(std::vector<size_t> const& v)
+      {
+        if (v.size() != dim)
+          throw std::runtime_error(
+              "HDF5BlockCache::HDF5BlockCache(): invalid number of "
+              "dimensions.");
+
+        Index index;
+        std::copy(std::begin(v), std::end(v), std::begin(index));
+        return index;
+      }
+
+      //! Compute the number of the block holding a point.
+      size_t
+      getKey(Index const& indices) const;
+
+      //! Read a block. Must be called without holding m_cond.
+      Block
+      load(size_t key);
+
+      //! Insert a block and evict the least recently used ones.
+      //! Must be called holding m_cond.
+      void
+      insert(Block&& block);
+
+      //! Prefetch thread.
+      void
+      run();
+    };
+
+    template<typename T, size_t dim>
+    HDF5BlockCache<T, dim>::HDF5BlockCache(Index const& dimensions,
+                                           Loader loader,
+                                           Index const& block,
+                                           size_t capacity)
+        : m_dims(dimensions),
+          m_capacity(capacity),
+          m_loader(loader),
+          m_usage(0),
+          m_hits(0),
+          m_misses(0),
+          m_stop(false),
+          m_prefetcher(NULL)
+    {
+      for (size_t i = 0; i < dim; ++i)
+      {
+        if (m_dims[i] == 0)
+          throw std::runtime_error("HDF5BlockCache::HDF5BlockCache(): empty dataset.");
+
+        m_block[i] = std::max<size_t>(1, std::min(block[i], m_dims[i]));
+        m_blocks[i] = (m_dims[i] + m_block[i] - 1) / m_block[i];
+      }
+    }
+
+    template<typename T, size_t dim>
+    HDF5BlockCache<T, dim>::~HDF5BlockCache()
+    {
+      m_cond.lock();
+      m_stop = true;
+      m_cond.broadcast();
+      m_cond.unlock();
+
+      if (m_prefetcher != NULL)
+      {
+        m_prefetcher->stopAndJoin();
+        delete m_prefetcher;
+      }
+    }
+
+    template<typename T, size_t dim>
+    size_t
+    HDF5BlockCache<T, dim>::getKey(Index const& indices) const
+    {
+      size_t key = 0;
+
+      for (size_t i = 0; i < dim; ++i)
+      {
+        if (indices[i] >= m_dims[i])
+          throw std::runtime_error("HDF5BlockCache::get(): out of bounds.");
+
+        key = m_blocks[i] * key + indices[i] / m_block[i];
+      }
+
+      return key;
+    }
+
+    template<typename T, size_t dim>
+    typename HDF5BlockCache<T, dim>::Block
+    HDF5BlockCache<T, dim>::load(size_t key)
+    {
+      Block block;
+      block.key = key;
+
+      Index offset;
+      for (size_t i = dim; i > 0; --i)
+      {
+        offset[i - 1] = (key % m_blocks[i - 1]) * m_block[i - 1];
+        block.size[i - 1] = std::min(m_block[i - 1], m_dims[i - 1] - offset[i - 1]);
+        key /= m_blocks[i - 1];
+      }
+
+      block.data = m_loader(offset, block.size);
+
+      size_t size = 1;
+      for (size_t i = 0; i < dim; ++i)
+        size *= block.size[i];
+
+      if (block.data.size() != size)
+        throw std::runtime_error("HDF5BlockCache::load(): invalid block size.");
+
+      return block;
+    }
+
+    template<typename T, size_t dim>
+    void
+    HDF5BlockCache<T, dim>::insert(Block&& block)
+    {
+      if (m_index.find(block.key) != m_index.end())
+        return;
+
+      m_usage += block.data.size() * sizeof(T);
+      m_lru.push_front(std::move(block));
+      m_index[m_lru.front().key] = m_lru.begin();
+
+      while (m_usage > m_capacity && m_lru.size() > 1)
+      {
+        m_usage -= m_lru.back().data.size() * sizeof(T);
+        m_index.erase(m_lru.back().key);
+        m_lru.pop_back();
+      }
+    }
+
+    template<typename T, size_t dim>
+    T
+    HDF5BlockCache<T, dim>::get(Index const& indices)
+    {
+      size_t key = getKey(indices);
+
+      Concurrency::ScopedCondition l(m_cond);
+      bool missed = false;
+
+      while (true)
+      {
+        auto itr = m_index.find(key);
+        if (itr != m_index.end())
+        {
+          if (!missed)
+            ++m_hits;
+
+          m_lru.splice(m_lru.begin(), m_lru, itr->second);
+          break;
+        }
+
+        // Wait for a prefetch in progress.
+        if (m_loading.count(key) > 0)
+        {
+          m_cond.wait();
+          continue;
+        }
+
+        ++m_misses;
+        missed = true;
+        m_loading.insert(key);
+        m_cond.unlock();
+
+        Block block;
+        try
+        {
+          block = load(key);
+        }
+        catch (...)
+        {
+          m_cond.lock();
+          m_loading.erase(key);
+          m_cond.broadcast();
+          throw;
+        }
+
+        m_cond.lock();
+        m_loading.erase(key);
+        insert(std::move(block));
+        m_cond.broadcast();
+      }
+
+      Block const& block = m_lru.front();
+
+      size_t offset = 0;
+      for (size_t i = 0; i < dim; ++i)
+        offset = block.size[i] * offset + indices[i] % m_block[i];
+
+      return block.data[offset];
+    }
+
+    template<typename T, size_t dim>
+    void
+    HDF5BlockCache<T, dim>::prefetch(Index const& indices)
+    {
+      for (size_t i = 0; i < dim; ++i)
+      {
+        if (indices[i] >= m_dims[i])
+          return;
+      }
+
+      size_t key = getKey(indices);
+
+      Concurrency::ScopedCondition l(m_cond);
+
+      if (m_index.count(key) > 0 || m_loading.count(key) > 0 ||
+          std::find(std::begin(m_requests), std::end(m_requests), key) !=
+              std::end(m_requests))
+        return;
+
+      m_requests.push_back(key);
+      m_cond.broadcast();
+
+      if (m_prefetcher == NULL)
+      {
+        m_prefetcher = new Prefetcher(*this);
+        m_prefetcher->start();
+      }
+    }
+
+    template<typename T, size_t dim>
+    void
+    HDF5BlockCache<T, dim>::run()
+    {
+      Concurrency::ScopedCondition l(m_cond);
+
+      while (true)
+      {
+        while (!m_stop && m_requests.empty())
+          m_cond.wait();
+
+        if (m_stop)
+          return;
+
+        size_t key = m_requests.front();
+        m_requests.pop_front();
+
+        if (m_index.count(key) > 0 || m_loading.count(key) > 0)
+          continue;
+
+        m_loading.insert(key);
+        m_cond.unlock();
+
+        Block block;
+        bool loaded = true;
+        try
+        {
+          block = load(key);
+        }
+        catch (...)
+        {
+          // get() will report the error if the block is needed.
+          loaded = false;
+        }
+
+        m_cond.lock();
+        m_loading.erase(key);
+        if (loaded)
+          insert(std::move(block));
+        m_cond.broadcast();
+      }
+    }
+  }    // namespace Parsers
+}    // namespace DUNE
+
+#endif
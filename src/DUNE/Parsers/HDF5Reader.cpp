@@ -31,6 +31,7 @@
 #include <numeric>
 
 #include "DUNE/I18N.hpp"
+#include "DUNE/Concurrency/ScopedMutex.hpp"
 
 // This component depends on the h5cpp library
 // (https://github.com/ess-dmsc/h5cpp.com).
@@ -90,12 +91,23 @@ namespace DUNE
       return f->root().has_dataset(path);
       return false;
     }
+
+    inline std::vector<size_t>
+    dsetDimensions(File const* f, std::string const& path)
+    {
+      auto dset = f->root().get_dataset(path);
+      auto dimensions =
+          hdf5::dataspace::Simple(dset.dataspace()).current_dimensions();
+
+      return std::vector<size_t>(std::begin(dimensions), std::end(dimensions));
+    }
 #endif
 
     bool
     HDF5Reader::datasetExists(std::string const& path) const
     {
 #ifdef DUNE_H5CPP_ENABLED
+      Concurrency::ScopedMutex l(m_mutex);
       return dsetExists(m_file.get(), path);
 #else
       (void)path;
@@ -108,6 +120,8 @@ namespace DUNE
     HDF5Reader::getDataset(std::string const& path) const
     {
 #ifdef DUNE_H5CPP_ENABLED
+      Concurrency::ScopedMutex l(m_mutex);
+
       if (!dsetExists(m_file.get(), path))
         throw std::runtime_error(
             DTR("HDF5Reader::getDataset(): The requested dataset does not "
@@ -120,7 +134,7 @@ namespace DUNE
       // Total number of gridpoints is the product of the sizes of all
       // dimensions.
       size_t size = std::accumulate(
-          std::begin(dimensions), std::end(dimensions), 1, std::multiplies<size_t>());
+          std::begin(dimensions), std::end(dimensions), size_t(1), std::multiplies<size_t>());
 
       std::vector<T> data(size);
       dset.read(data);
@@ -139,12 +153,80 @@ namespace DUNE
 #endif
     }
 
+    std::vector<size_t>
+    HDF5Reader::getDatasetDimensions(std::string const& path) const
+    {
+#ifdef DUNE_H5CPP_ENABLED
+      Concurrency::ScopedMutex l(m_mutex);
+
+      if (!dsetExists(m_file.get(), path))
+        throw std::runtime_error(
+            DTR("HDF5Reader::getDatasetDimensions(): The requested dataset "
+                "does not exist."));
+
+      return dsetDimensions(m_file.get(), path);
+#else
+      (void)path;
+      return {};
+#endif
+    }
+
+    template<typename T>
+    HDF5Reader::HDF5Dataset<T>
+    HDF5Reader::getHyperslab(std::string const& path,
+                             std::vector<size_t> const& offset,
+                             std::vector<size_t> const& block) const
+    {
+#ifdef DUNE_H5CPP_ENABLED
+      Concurrency::ScopedMutex l(m_mutex);
+
+      if (!dsetExists(m_file.get(), path))
+        throw std::runtime_error(
+            DTR("HDF5Reader::getHyperslab(): The requested dataset does not "
+                "exist."));
+
+      auto dimensions = dsetDimensions(m_file.get(), path);
+
+      if (offset.size() != dimensions.size() ||
+          block.size() != dimensions.size())
+        throw std::runtime_error(
+            DTR("HDF5Reader::getHyperslab(): invalid number of dimensions."));
+
+      for (size_t i = 0; i < dimensions.size(); ++i)
+      {
+        if (block[i] == 0 || offset[i] + block[i] > dimensions[i])
+          throw std::runtime_error(
+              DTR("HDF5Reader::getHyperslab(): block is out of bounds."));
+      }
+
+      auto dset = m_file->root().get_dataset(path);
+
+      size_t size = std::accumulate(
+          std::begin(block), std::end(block), size_t(1), std::multiplies<size_t>());
+
+      std::vector<T> data(size);
+      hdf5::dataspace::Hyperslab slab(
+          hdf5::Dimensions(std::begin(offset), std::end(offset)),
+          hdf5::Dimensions(std::begin(block), std::end(block)));
+      dset.read(data, slab);
+
+      return {block, data};
+#else
+      (void)path;
+      (void)offset;
+      (void)block;
+      return {};
+#endif
+    }
+
     template<typename T>
     std::vector<T>
     HDF5Reader::getAttribute(std::string const& path,
                              std::string const& attribute) const
     {
 #ifdef DUNE_H5CPP_ENABLED
+      Concurrency::ScopedMutex l(m_mutex);
+
       auto node = hdf5::node::get_node(m_file->root(), path);
       auto attributes = node.attributes;
 
@@ -177,6 +259,22 @@ namespace DUNE
     template HDF5Reader::HDF5Dataset<long double>
     HDF5Reader::getDataset(std::string const&) const;
 
+    // Template specialization declarations for getHyperslab
+    template HDF5Reader::HDF5Dataset<float>
+    HDF5Reader::getHyperslab(std::string const&,
+                             std::vector<size_t> const&,
+                             std::vector<size_t> const&) const;
+
+    template HDF5Reader::HDF5Dataset<double>
+    HDF5Reader::getHyperslab(std::string const&,
+                             std::vector<size_t> const&,
+                             std::vector<size_t> const&) const;
+
+    template HDF5Reader::HDF5Dataset<long double>
+    HDF5Reader::getHyperslab(std::string const&,
+                             std::vector<size_t> const&,
+                             std::vector<size_t> const&) const;
+
     // Template specialization declarations for getAttribute
     template std::vector<char>
     HDF5Reader::getAttribute<char>(std::string const&,
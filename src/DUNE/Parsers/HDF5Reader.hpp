@@ -35,6 +35,8 @@
 #include <string>
 #include <vector>
 
+#include <DUNE/Concurrency/Mutex.hpp>
+
 namespace hdf5
 {
   namespace file
@@ -50,6 +52,8 @@ namespace DUNE
     using hdf5::file::File;
 
     //! Simplifies reading data and attributes from HDF5 format files.
+    //! The HDF5 library is not thread-safe, so all accesses to the file
+    //! are serialized and the reader may be shared between threads.
     class HDF5Reader
     {
     public:
@@ -83,6 +87,25 @@ namespace DUNE
       HDF5Dataset<T>
       getDataset(std::string const& path) const;
 
+      //! Get the dimensions of a dataset without reading its data.
+      //! @param[in] path path to the dataset in the file.
+      //! @return number of points in each dimension.
+      std::vector<size_t>
+      getDatasetDimensions(std::string const& path) const;
+
+      //! Get a hyperslab (a rectangular block) of a dataset. Only the
+      //! requested block is read from the file.
+      //! @param[in] path path to the dataset in the file.
+      //! @param[in] offset index of the first point of the block in each
+      //! dimension.
+      //! @param[in] block number of points of the block in each dimension.
+      //! @return structure containing the block data and its dimensions.
+      template<typename T>
+      HDF5Dataset<T>
+      getHyperslab(std::string const& path,
+                   std::vector<size_t> const& offset,
+                   std::vector<size_t> const& block) const;
+
       //! Get an attribute.
       //! @param[in] path path to the node in the file where the attribute is
       //! stored.
@@ -95,6 +118,8 @@ namespace DUNE
     private:
       //! Handle to an HDF5 file.
       std::unique_ptr<File> m_file;
+      //! Serializes accesses to the file.
+      mutable Concurrency::Mutex m_mutex;
     };
   }    // namespace Parsers
 }    // namespace DUNE
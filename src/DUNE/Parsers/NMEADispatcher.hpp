@@ -0,0 +1,199 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_PARSERS_NMEA_DISPATCHER_HPP_INCLUDED_
+#define DUNE_PARSERS_NMEA_DISPATCHER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Parsers/NMEATokenizer.hpp>
+
+namespace DUNE
+{
+  namespace Parsers
+  {
+    //! Calls the handler of a NMEA sentence, chosen by sentence
+    //! identifier (see NMEATokenizer::getSentence()) with a single
+    //! lookup in a perfect hash table. The table is rebuilt, looking
+    //! for a hash seed without collisions, every time a handler is
+    //! added.
+    //! @tparam T handler class.
+    template <typename T>
+    class NMEADispatcher
+    {
+    public:
+      //! Sentence handler.
+      typedef void (T::*Handler)(const NMEATokenizer& stn);
+
+      //! Constructor.
+      //! @param[in] object object whose handlers are called.
+      NMEADispatcher(T* object):
+        m_object(object),
+        m_seed(0),
+        m_mask(0)
+      { }
+
+      //! Add the handler of a sentence identifier (e.g., "GGA" for
+      //! any talker, or "PUBX"). Adding an identifier again replaces
+      //! its handler.
+      //! @param[in] id sentence identifier.
+      //! @param[in] handler handler.
+      void
+      add(const char* id, Handler handler)
+      {
+        size_t size = std::strlen(id);
+        if (size == 0 || size > c_max_id_size)
+          throw std::invalid_argument("invalid NMEA sentence identifier");
+
+        for (size_t i = 0; i < m_entries.size(); ++i)
+        {
+          if (m_entries[i].size == size && std::memcmp(m_entries[i].id, id, size) == 0)
+          {
+            m_entries[i].handler = handler;
+            return;
+          }
+        }
+
+        Entry entry;
+        std::memcpy(entry.id, id, size);
+        entry.size = size;
+        entry.handler = handler;
+        m_entries.push_back(entry);
+        rebuild();
+      }
+
+      //! Call the handler of a sentence.
+      //! @param[in] stn tokenized sentence.
+      //! @return true if the sentence has a handler, false otherwise.
+      bool
+      dispatch(const NMEATokenizer& stn) const
+      {
+        if (m_table.empty())
+          return false;
+
+        NMEATokenizer::Field id = stn.getSentence();
+        const Entry* entry = m_table[hash(id.data, id.size, m_seed) & m_mask];
+        if (entry == NULL || entry->size != id.size || std::memcmp(entry->id, id.data, id.size) != 0)
+          return false;
+
+        (m_object->*entry->handler)(stn);
+        return true;
+      }
+
+    private:
+      //! Maximum length of a sentence identifier.
+      static const size_t c_max_id_size = 8;
+
+      //! Registered handler.
+      struct Entry
+      {
+        //! Sentence identifier.
+        char id[c_max_id_size];
+        //! Length of the sentence identifier.
+        size_t size;
+        //! Handler.
+        Handler handler;
+      };
+
+      //! Handler object.
+      T* m_object;
+      //! Registered handlers.
+      std::vector<Entry> m_entries;
+      //! Hash table.
+      std::vector<const Entry*> m_table;
+      //! Hash seed.
+      uint32_t m_seed;
+      //! Hash table index mask.
+      uint32_t m_mask;
+
+      //! Seeded FNV-1a hash.
+      static uint32_t
+      hash(const char* data, size_t size, uint32_t seed)
+      {
+        uint32_t h = 2166136261u ^ seed;
+        for (size_t i = 0; i < size; ++i)
+        {
+          h ^= (uint8_t)data[i];
+          h *= 16777619u;
+        }
+
+        return h ^ (h >> 15);
+      }
+
+      //! Find a table size and seed without collisions.
+      void
+      rebuild(void)
+      {
+        size_t size = 1;
+        while (size < m_entries.size() * 2)
+          size <<= 1;
+
+        while (true)
+        {
+          for (uint32_t seed = 0; seed < 1024; ++seed)
+          {
+            std::vector<const Entry*> table(size, (const Entry*)NULL);
+            bool perfect = true;
+
+            for (size_t i = 0; i < m_entries.size() && perfect; ++i)
+            {
+              const Entry*& slot = table[hash(m_entries[i].id, m_entries[i].size, seed) & (size - 1)];
+              if (slot != NULL)
+                perfect = false;
+              else
+                slot = &m_entries[i];
+            }
+
+            if (perfect)
+            {
+              m_table.swap(table);
+              m_seed = seed;
+              m_mask = (uint32_t)(size - 1);
+              return;
+            }
+          }
+
+          size <<= 1;
+        }
+      }
+
+      //! Non-copyable.
+      NMEADispatcher(const NMEADispatcher&);
+
+      //! Non-assignable.
+      NMEADispatcher&
+      operator=(const NMEADispatcher&);
+    };
+  }
+}
+
+#endif
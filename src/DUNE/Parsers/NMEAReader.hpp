@@ -32,10 +32,10 @@
 
 // ISO C++ 98 headers.
 #include <string>
-#include <sstream>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
+#include <DUNE/Parsers/NMEATokenizer.hpp>
 
 namespace DUNE
 {
@@ -45,7 +45,8 @@ namespace DUNE
     class DUNE_DLL_SYM NMEAReader;
 
     //! NMEA Sentence reader is a simple NMEA parser capable of
-    //! validating and converting sentence fields.
+    //! validating and converting sentence fields. The sentence is
+    //! split once by NMEATokenizer.
     class NMEAReader
     {
     public:
@@ -57,9 +58,6 @@ namespace DUNE
       //! @param sentence string with NMEA sentence.
       NMEAReader(const std::string& sentence);
 
-      //! Destructor.
-      ~NMEAReader(void);
-
       //! Retrieve sentence code.
       //! @return sentence code.
       const char*
@@ -118,26 +116,33 @@ namespace DUNE
       eos(void);
 
     private:
-      //! Input stream.
-      std::istringstream m_stream;
+      //! Copy of the sentence.
+      std::string m_sentence;
+      //! Sentence fields.
+      NMEATokenizer m_tokens;
       //! Sentence code.
       std::string m_code;
-      //! Sentence length in bytes.
-      unsigned m_length;
       //! Current field number.
       unsigned m_field;
-      //! Internal buffer.
-      char* m_bfr;
 
-      //! Check if we can convert the next field.
+      //! Retrieve the next field.
+      //! @return field.
+      const NMEATokenizer::Field&
+      nextField(void);
+
+      //! Convert the next field to a number.
+      //! @param[in] type type name used in error messages.
+      //! @param[out] value output variable.
+      template <typename T>
       void
-      checkFieldStart(void);
+      readNumber(const char* type, T& value);
 
-      //! Parse NMEA checksum.
-      //! @param checksum in ASCII format.
-      //! @return checksum in unsigned char format.
-      unsigned char
-      parseChecksum(const char* str);
+      //! Non-copyable.
+      NMEAReader(const NMEAReader&);
+
+      //! Non-assignable.
+      NMEAReader&
+      operator=(const NMEAReader&);
     };
   }
 }
@@ -0,0 +1,289 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Parsers/NMEATokenizer.hpp>
+
+namespace DUNE
+{
+  namespace Parsers
+  {
+    //! Powers of ten that are exactly representable as double.
+    static const double c_pow10[] =
+    {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    //! Maximum number of significant digits accumulated as integer.
+    static const unsigned c_max_digits = 19;
+
+    //! Test if a character is a blank.
+    static inline bool
+    isBlank(char c)
+    {
+      return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    //! Convert an hexadecimal digit.
+    //! @param[in] c character.
+    //! @return value or -1 if not an hexadecimal digit.
+    static inline int
+    hexValue(char c)
+    {
+      if (c >= '0' && c <= '9')
+        return c - '0';
+      if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+      if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+      return -1;
+    }
+
+    NMEATokenizer::NMEATokenizer(void):
+      m_count(0),
+      m_has_checksum(false),
+      m_ccsum(0),
+      m_rcsum(0)
+    {
+      m_fields[0].data = "";
+      m_fields[0].size = 0;
+    }
+
+    NMEATokenizer::Status
+    NMEATokenizer::parse(const char* data, size_t size)
+    {
+      m_count = 0;
+      m_has_checksum = false;
+      m_ccsum = 0;
+      m_rcsum = 0;
+      m_fields[0].data = "";
+      m_fields[0].size = 0;
+
+      // Skip leading noise.
+      size_t i = 0;
+      while (i < size && data[i] != '$' && data[i] != '!')
+        ++i;
+
+      if (i == size)
+        return ST_NO_START;
+
+      ++i;
+
+      // Split fields and compute checksum in one pass.
+      const char* start = data + i;
+      uint8_t csum = 0;
+      for (; i < size; ++i)
+      {
+        char c = data[i];
+        if (c == '*' || c == '\r' || c == '\n')
+          break;
+
+        csum ^= (uint8_t)c;
+
+        if (c == ',')
+        {
+          if (m_count == c_max_fields - 1)
+            return ST_TOO_MANY_FIELDS;
+
+          m_fields[m_count].data = start;
+          m_fields[m_count].size = (data + i) - start;
+          ++m_count;
+          start = data + i + 1;
+        }
+      }
+
+      m_fields[m_count].data = start;
+      m_fields[m_count].size = (data + i) - start;
+      ++m_count;
+      m_ccsum = csum;
+
+      if (i < size && data[i] == '*')
+      {
+        int hi = (i + 1 < size) ? hexValue(data[i + 1]) : -1;
+        int lo = (i + 2 < size) ? hexValue(data[i + 2]) : -1;
+        if (hi < 0 || lo < 0)
+          return ST_INVALID_CHECKSUM;
+
+        for (size_t j = i + 3; j < size; ++j)
+        {
+          if (!isBlank(data[j]))
+            return ST_INVALID_CHECKSUM;
+        }
+
+        m_has_checksum = true;
+        m_rcsum = (uint8_t)((hi << 4) | lo);
+      }
+      else
+      {
+        // Trailing blanks are not part of the last field.
+        Field& last = m_fields[m_count - 1];
+        while (last.size > 0 && isBlank(last.data[last.size - 1]))
+          --last.size;
+      }
+
+      if (m_fields[0].size == 0)
+        return ST_NO_CODE;
+
+      if (m_has_checksum && m_rcsum != m_ccsum)
+        return ST_CHECKSUM_MISMATCH;
+
+      return ST_OK;
+    }
+
+    NMEATokenizer::Field
+    NMEATokenizer::getTalker(void) const
+    {
+      Field talker = m_fields[0];
+      if (talker.size < 3 || talker.data[0] == 'P')
+        talker.size = 0;
+      else
+        talker.size = 2;
+
+      return talker;
+    }
+
+    NMEATokenizer::Field
+    NMEATokenizer::getSentence(void) const
+    {
+      Field sentence = m_fields[0];
+      if (sentence.size >= 3 && sentence.data[0] != 'P')
+      {
+        sentence.data += 2;
+        sentence.size -= 2;
+      }
+
+      return sentence;
+    }
+
+    bool
+    NMEATokenizer::parseInteger(const Field& field, int64_t& value)
+    {
+      size_t i = 0;
+      bool negative = false;
+      if (i < field.size && (field.data[i] == '-' || field.data[i] == '+'))
+      {
+        negative = field.data[i] == '-';
+        ++i;
+      }
+
+      if (i == field.size)
+        return false;
+
+      uint64_t v = 0;
+      for (; i < field.size; ++i)
+      {
+        unsigned d = (unsigned char)field.data[i] - '0';
+        if (d > 9)
+          return false;
+
+        if (v > ((uint64_t)std::numeric_limits<int64_t>::max() - d) / 10)
+          return false;
+
+        v = v * 10 + d;
+      }
+
+      value = negative ? -(int64_t)v : (int64_t)v;
+      return true;
+    }
+
+    bool
+    NMEATokenizer::parseReal(const Field& field, double& value)
+    {
+      size_t i = 0;
+      bool negative = false;
+      if (i < field.size && (field.data[i] == '-' || field.data[i] == '+'))
+      {
+        negative = field.data[i] == '-';
+        ++i;
+      }
+
+      uint64_t mantissa = 0;
+      unsigned digits = 0;
+      // Power of ten applied to the mantissa.
+      int exponent = 0;
+      bool any = false;
+      bool point = false;
+
+      for (; i < field.size; ++i)
+      {
+        char c = field.data[i];
+        if (c == '.' && !point)
+        {
+          point = true;
+          continue;
+        }
+
+        unsigned d = (unsigned char)c - '0';
+        if (d > 9)
+          return false;
+
+        any = true;
+
+        // Leading zeros are not significant.
+        if (digits == 0 && d == 0)
+        {
+          if (point)
+            --exponent;
+          continue;
+        }
+
+        if (digits < c_max_digits)
+        {
+          mantissa = mantissa * 10 + d;
+          ++digits;
+          if (point)
+            --exponent;
+        }
+        else if (!point)
+        {
+          ++exponent;
+        }
+      }
+
+      if (!any)
+        return false;
+
+      double v = (double)mantissa;
+      if (mantissa != 0)
+      {
+        // A single rounding when mantissa and power are exact.
+        if (exponent < 0 && -exponent <= 22)
+          v /= c_pow10[-exponent];
+        else if (exponent > 0 && exponent <= 22)
+          v *= c_pow10[exponent];
+        else if (exponent != 0)
+          v *= std::pow(10.0, exponent);
+      }
+
+      value = negative ? -v : v;
+      return true;
+    }
+  }
+}
@@ -0,0 +1,292 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_PARSERS_NMEA_TOKENIZER_HPP_INCLUDED_
+#define DUNE_PARSERS_NMEA_TOKENIZER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+
+// ISO C++ 11 headers.
+#include <cstdint>
+#include <type_traits>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Parsers
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM NMEATokenizer;
+
+    //! Splits NMEA sentences into fields without copying or
+    //! allocating memory. Fields point into the sentence, which must
+    //! outlive them. The checksum is validated while splitting and
+    //! numbers are converted without using the C/C++ locale.
+    class NMEATokenizer
+    {
+    public:
+      //! Maximum number of fields, including the sentence code.
+      static const size_t c_max_fields = 48;
+
+      //! Sentence field.
+      struct Field
+      {
+        //! First character.
+        const char* data;
+        //! Number of characters.
+        size_t size;
+
+        //! Test if the field is empty.
+        //! @return true if empty, false otherwise.
+        bool
+        empty(void) const
+        {
+          return size == 0;
+        }
+
+        //! Compare with a C-style string.
+        //! @param[in] str string.
+        //! @return true if equal, false otherwise.
+        bool
+        operator==(const char* str) const
+        {
+          return std::strncmp(data, str, size) == 0 && str[size] == '\0';
+        }
+
+        //! Compare with a string.
+        //! @param[in] str string.
+        //! @return true if equal, false otherwise.
+        bool
+        operator==(const std::string& str) const
+        {
+          return str.size() == size && std::memcmp(data, str.data(), size) == 0;
+        }
+
+        template <typename T>
+        bool
+        operator!=(const T& other) const
+        {
+          return !(*this == other);
+        }
+
+        //! Copy the field into a string.
+        //! @return string.
+        std::string
+        str(void) const
+        {
+          return std::string(data, size);
+        }
+      };
+
+      //! Result of splitting a sentence.
+      enum Status
+      {
+        //! Valid sentence.
+        ST_OK,
+        //! No start delimiter ('$' or '!').
+        ST_NO_START,
+        //! Empty sentence code.
+        ST_NO_CODE,
+        //! Malformed checksum or data after it.
+        ST_INVALID_CHECKSUM,
+        //! Checksum does not match the data.
+        ST_CHECKSUM_MISMATCH,
+        //! More than c_max_fields fields.
+        ST_TOO_MANY_FIELDS
+      };
+
+      //! Constructor.
+      NMEATokenizer(void);
+
+      //! Split a sentence into fields. Characters before the start
+      //! delimiter are ignored, as are blanks after the checksum. The
+      //! checksum is optional (see hasChecksum()).
+      //! @param[in] data sentence.
+      //! @param[in] size sentence length.
+      //! @return status.
+      Status
+      parse(const char* data, size_t size);
+
+      //! Split a sentence into fields.
+      //! @param[in] sentence sentence.
+      //! @return status.
+      Status
+      parse(const std::string& sentence)
+      {
+        return parse(sentence.data(), sentence.size());
+      }
+
+      //! Retrieve the number of fields, including the sentence code.
+      //! @return number of fields.
+      size_t
+      size(void) const
+      {
+        return m_count;
+      }
+
+      //! Retrieve a field. The first field is the sentence code.
+      //! @param[in] index field index (less than size()).
+      //! @return field.
+      const Field&
+      operator[](size_t index) const
+      {
+        return m_fields[index];
+      }
+
+      //! Retrieve the sentence code (e.g., "GPGGA" or "PUBX").
+      //! @return sentence code.
+      const Field&
+      getCode(void) const
+      {
+        return m_fields[0];
+      }
+
+      //! Retrieve the talker identifier of the sentence (e.g., "GP").
+      //! @return talker identifier, empty for proprietary sentences.
+      Field
+      getTalker(void) const;
+
+      //! Retrieve the sentence identifier: the code without the
+      //! talker (e.g., "GGA") or the whole code of proprietary
+      //! sentences (e.g., "PUBX").
+      //! @return sentence identifier.
+      Field
+      getSentence(void) const;
+
+      //! Test if the sentence has a checksum.
+      //! @return true if it has a checksum, false otherwise.
+      bool
+      hasChecksum(void) const
+      {
+        return m_has_checksum;
+      }
+
+      //! Retrieve the checksum computed from the data.
+      //! @return checksum.
+      uint8_t
+      getComputedChecksum(void) const
+      {
+        return m_ccsum;
+      }
+
+      //! Retrieve the checksum found in the sentence.
+      //! @return checksum.
+      uint8_t
+      getReceivedChecksum(void) const
+      {
+        return m_rcsum;
+      }
+
+      //! Convert a field to a number. The field must only contain an
+      //! optional sign, digits and, for floating point types, an
+      //! optional decimal point. Real numbers with up to 15
+      //! significant digits are correctly rounded.
+      //! @param[in] field field.
+      //! @param[out] value number.
+      //! @return true if successful, false otherwise (value is not
+      //! changed).
+      template <typename T>
+      static bool
+      toNumber(const Field& field, T& value)
+      {
+        return toNumber(field, value, std::is_integral<T>());
+      }
+
+      //! Convert a field to a number.
+      //! @param[in] index field index.
+      //! @param[out] value number.
+      //! @return true if successful, false otherwise.
+      template <typename T>
+      bool
+      read(size_t index, T& value) const
+      {
+        return index < m_count && toNumber(m_fields[index], value);
+      }
+
+    private:
+      //! Fields.
+      Field m_fields[c_max_fields];
+      //! Number of fields.
+      size_t m_count;
+      //! True if the sentence has a checksum.
+      bool m_has_checksum;
+      //! Computed checksum.
+      uint8_t m_ccsum;
+      //! Received checksum.
+      uint8_t m_rcsum;
+
+      //! Convert a field to an integer.
+      //! @param[in] field field.
+      //! @param[out] value integer.
+      //! @return true if successful, false otherwise.
+      static bool
+      parseInteger(const Field& field, int64_t& value);
+
+      //! Convert a field to a real number.
+      //! @param[in] field field.
+      //! @param[out] value real number.
+      //! @return true if successful, false otherwise.
+      static bool
+      parseReal(const Field& field, double& value);
+
+      template <typename T>
+      static bool
+      toNumber(const Field& field, T& value, std::true_type)
+      {
+        int64_t v = 0;
+        if (!parseInteger(field, v))
+          return false;
+
+        if (v < (int64_t)std::numeric_limits<T>::min() || (v > 0 && (uint64_t)v > (uint64_t)std::numeric_limits<T>::max()))
+          return false;
+
+        value = static_cast<T>(v);
+        return true;
+      }
+
+      template <typename T>
+      static bool
+      toNumber(const Field& field, T& value, std::false_type)
+      {
+        double v = 0;
+        if (!parseReal(field, v))
+          return false;
+
+        value = static_cast<T>(v);
+        return true;
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,368 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Simulation/Bathymetry.hpp>
+#include <DUNE/Utils/String.hpp>
+
+#if defined(DUNE_SYS_HAS_MMAP)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace DUNE
+{
+  namespace Simulation
+  {
+    //! Magic number ("BATH").
+    static const uint32_t c_magic = 0x48544142;
+    //! Format version.
+    static const uint32_t c_version = 1;
+    //! Number of samples on each side of a tile.
+    static const unsigned c_tile_size = 64;
+    //! Maximum number of samples in a raster (create() needs about
+    //! 20 bytes per sample).
+    static const size_t c_max_samples = 4096 * 4096;
+    //! Maximum number of samples on each side of a tile.
+    static const size_t c_max_tile_size = 4096;
+
+    //! Sample without data.
+    static inline float
+    noData(void)
+    {
+      return std::numeric_limits<float>::quiet_NaN();
+    }
+
+    //! Swap the byte order of a 32-bit value.
+    static inline uint32_t
+    swap32(uint32_t v)
+    {
+      return (v >> 24) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) | (v << 24);
+    }
+
+    Bathymetry::Bathymetry(const std::string& path):
+      m_data(NULL),
+      m_size(0)
+    {
+#if defined(DUNE_SYS_HAS_MMAP)
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        throw std::runtime_error(Utils::String::str(DTR("unable to open '%s'"), path.c_str()));
+
+      struct stat st;
+      if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(Header))
+      {
+        void* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+#if defined(MADV_RANDOM)
+          madvise(data, st.st_size, MADV_RANDOM);
+#endif
+          m_data = static_cast<const uint8_t*>(data);
+          m_size = st.st_size;
+        }
+      }
+
+      ::close(fd);
+#endif
+
+      if (m_data != NULL)
+      {
+        std::memcpy(&m_header, m_data, sizeof(Header));
+      }
+      else
+      {
+        m_file.open(path.c_str(), std::ios::binary);
+        if (!m_file.is_open())
+          throw std::runtime_error(Utils::String::str(DTR("unable to open '%s'"), path.c_str()));
+
+        m_file.seekg(0, std::ios::end);
+        m_size = m_file.tellg();
+        m_file.seekg(0, std::ios::beg);
+
+        if (!m_file.read((char*)&m_header, sizeof(Header)))
+          m_size = 0;
+      }
+
+      const char* error = NULL;
+      if (m_size < sizeof(Header))
+        error = DTR("truncated bathymetry raster '%s'");
+      else if (m_header.magic == swap32(c_magic))
+        error = DTR("incompatible byte order in bathymetry raster '%s'");
+      else if (m_header.magic != c_magic || m_header.version != c_version)
+        error = DTR("invalid bathymetry raster '%s'");
+      else if (m_header.rows == 0 || m_header.cols == 0 || m_header.tile_size == 0
+               || !(m_header.resolution > 0))
+        error = DTR("invalid bathymetry raster '%s'");
+      // Bounding each dimension keeps the size computations below
+      // from overflowing.
+      else if (m_header.rows > c_max_samples / m_header.cols
+               || m_header.tile_size > c_max_tile_size)
+        error = DTR("invalid bathymetry raster '%s'");
+
+      size_t tiles_x = 0;
+      if (error == NULL)
+      {
+        size_t tile_size = m_header.tile_size;
+        tiles_x = (m_header.rows + tile_size - 1) / tile_size;
+        m_tiles_y = (m_header.cols + tile_size - 1) / tile_size;
+        m_tile_samples = tile_size * tile_size;
+
+        if (m_size < sizeof(Header) + tiles_x * m_tiles_y * m_tile_samples * sizeof(float))
+          error = DTR("truncated bathymetry raster '%s'");
+      }
+
+      if (error != NULL)
+      {
+#if defined(DUNE_SYS_HAS_MMAP)
+        if (m_data != NULL)
+          munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+        throw std::runtime_error(Utils::String::str(error, path.c_str()));
+      }
+
+      if (m_data == NULL)
+        m_tiles.resize(tiles_x * m_tiles_y);
+    }
+
+    Bathymetry::~Bathymetry(void)
+    {
+#if defined(DUNE_SYS_HAS_MMAP)
+      if (m_data != NULL)
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    }
+
+    const float*
+    Bathymetry::getTile(unsigned tx, unsigned ty)
+    {
+      size_t index = (size_t)tx * m_tiles_y + ty;
+      size_t offset = sizeof(Header) + index * m_tile_samples * sizeof(float);
+
+      if (m_data != NULL)
+        return reinterpret_cast<const float*>(m_data + offset);
+
+      std::vector<float>& tile = m_tiles[index];
+      if (tile.empty())
+      {
+        tile.resize(m_tile_samples, noData());
+        m_file.clear();
+        m_file.seekg(offset);
+        m_file.read((char*)&tile[0], m_tile_samples * sizeof(float));
+      }
+
+      return &tile[0];
+    }
+
+    float
+    Bathymetry::getSample(unsigned row, unsigned col)
+    {
+      if (row >= m_header.rows || col >= m_header.cols)
+        return noData();
+
+      unsigned size = m_header.tile_size;
+      const float* tile = getTile(row / size, col / size);
+      return tile[(row % size) * size + col % size];
+    }
+
+    bool
+    Bathymetry::getDepth(double x, double y, double& depth)
+    {
+      double u = (x - m_header.x0) / m_header.resolution;
+      double v = (y - m_header.y0) / m_header.resolution;
+
+      // Negated comparisons also reject NaN.
+      if (!(u >= 0 && u <= m_header.rows - 1 && v >= 0 && v <= m_header.cols - 1))
+        return false;
+
+      unsigned i = std::min((unsigned)u, m_header.rows > 1 ? m_header.rows - 2 : 0);
+      unsigned j = std::min((unsigned)v, m_header.cols > 1 ? m_header.cols - 2 : 0);
+      double fu = u - i;
+      double fv = v - j;
+
+      float samples[4] = {getSample(i, j), getSample(i, j + 1),
+                          getSample(i + 1, j), getSample(i + 1, j + 1)};
+      double weights[4] = {(1 - fu) * (1 - fv), (1 - fu) * fv,
+                           fu * (1 - fv), fu * fv};
+
+      double sum = 0;
+      double weight = 0;
+      for (unsigned k = 0; k < 4; ++k)
+      {
+        if (std::isnan(samples[k]) || weights[k] <= 0)
+          continue;
+
+        sum += weights[k] * samples[k];
+        weight += weights[k];
+      }
+
+      if (weight <= 0)
+        return false;
+
+      depth = sum / weight;
+      return true;
+    }
+
+    void
+    Bathymetry::create(const std::string& path, double lat, double lon,
+                       const std::vector<Sample>& samples, double resolution, double radius)
+    {
+      if (samples.empty() || !(resolution > 0))
+        throw std::runtime_error(DTR("invalid bathymetry samples"));
+
+      Header header;
+      std::memset(&header, 0, sizeof(header));
+      header.magic = c_magic;
+      header.version = c_version;
+      header.lat = lat;
+      header.lon = lon;
+      header.resolution = resolution;
+      header.tile_size = c_tile_size;
+
+      double x_max = samples[0].x;
+      double y_max = samples[0].y;
+      header.x0 = x_max;
+      header.y0 = y_max;
+      for (size_t k = 1; k < samples.size(); ++k)
+      {
+        header.x0 = std::min(header.x0, samples[k].x);
+        header.y0 = std::min(header.y0, samples[k].y);
+        x_max = std::max(x_max, samples[k].x);
+        y_max = std::max(y_max, samples[k].y);
+      }
+
+      double rows = std::floor((x_max - header.x0) / resolution + 0.5) + 1;
+      double cols = std::floor((y_max - header.y0) / resolution + 0.5) + 1;
+      if (rows * cols > (double)c_max_samples)
+        throw std::runtime_error(DTR("bathymetry raster is too large"));
+
+      header.rows = (uint32_t)rows;
+      header.cols = (uint32_t)cols;
+
+      // Mean of the samples nearest to each raster sample.
+      std::vector<double> sums((size_t)header.rows * header.cols, 0.0);
+      std::vector<uint32_t> counts(sums.size(), 0);
+      for (size_t k = 0; k < samples.size(); ++k)
+      {
+        size_t i = (size_t)((samples[k].x - header.x0) / resolution + 0.5);
+        size_t j = (size_t)((samples[k].y - header.y0) / resolution + 0.5);
+        size_t index = std::min(i, (size_t)header.rows - 1) * header.cols
+          + std::min(j, (size_t)header.cols - 1);
+        sums[index] += samples[k].depth;
+        ++counts[index];
+      }
+
+      std::vector<float> grid(sums.size(), noData());
+      for (size_t k = 0; k < grid.size(); ++k)
+      {
+        if (counts[k] > 0)
+          grid[k] = (float)(sums[k] / counts[k]);
+      }
+
+      // Fill holes from the raster samples that have data.
+      int reach = (int)std::floor(std::max(0.0, radius) / resolution);
+      std::vector<float> filled(grid);
+      for (int i = 0; i < (int)header.rows; ++i)
+      {
+        for (int j = 0; j < (int)header.cols; ++j)
+        {
+          if (counts[(size_t)i * header.cols + j] > 0)
+            continue;
+
+          double sum = 0;
+          double weight = 0;
+          for (int di = -reach; di <= reach; ++di)
+          {
+            if (i + di < 0 || i + di >= (int)header.rows)
+              continue;
+
+            for (int dj = -reach; dj <= reach; ++dj)
+            {
+              if (j + dj < 0 || j + dj >= (int)header.cols)
+                continue;
+
+              size_t index = (size_t)(i + di) * header.cols + (j + dj);
+              double d2 = (double)(di * di + dj * dj) * resolution * resolution;
+              if (counts[index] == 0 || d2 > radius * radius)
+                continue;
+
+              sum += grid[index] / d2;
+              weight += 1.0 / d2;
+            }
+          }
+
+          if (weight > 0)
+            filled[(size_t)i * header.cols + j] = (float)(sum / weight);
+        }
+      }
+
+      std::ofstream ofs(path.c_str(), std::ios::binary | std::ios::trunc);
+      if (!ofs.is_open())
+        throw std::runtime_error(Utils::String::str(DTR("unable to open '%s'"), path.c_str()));
+
+      ofs.write((const char*)&header, sizeof(header));
+
+      unsigned tiles_x = (header.rows + c_tile_size - 1) / c_tile_size;
+      unsigned tiles_y = (header.cols + c_tile_size - 1) / c_tile_size;
+      std::vector<float> tile(c_tile_size * c_tile_size);
+      for (unsigned tx = 0; tx < tiles_x; ++tx)
+      {
+        for (unsigned ty = 0; ty < tiles_y; ++ty)
+        {
+          std::fill(tile.begin(), tile.end(), noData());
+          for (unsigned r = 0; r < c_tile_size; ++r)
+          {
+            size_t i = (size_t)tx * c_tile_size + r;
+            if (i >= header.rows)
+              break;
+
+            size_t j = (size_t)ty * c_tile_size;
+            size_t n = std::min((size_t)c_tile_size, header.cols - j);
+            std::copy(filled.begin() + i * header.cols + j,
+                      filled.begin() + i * header.cols + j + n,
+                      tile.begin() + r * c_tile_size);
+          }
+
+          ofs.write((const char*)&tile[0], tile.size() * sizeof(float));
+        }
+      }
+
+      if (!ofs.good())
+        throw std::runtime_error(Utils::String::str(DTR("unable to write '%s'"), path.c_str()));
+    }
+  }
+}
@@ -0,0 +1,205 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_SIMULATION_BATHYMETRY_HPP_INCLUDED_
+#define DUNE_SIMULATION_BATHYMETRY_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <fstream>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Simulation
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Bathymetry;
+
+    //! Read-only bathymetry raster.
+    //!
+    //! The raster is a regular grid of depths, in meters, with
+    //! samples along the north (x) and east (y) axes of a reference
+    //! WGS-84 location. The file holds a fixed-size header followed by
+    //! square tiles of single precision samples, stored tile after
+    //! tile and row-major inside each tile; samples without data are
+    //! NaN. The file is memory-mapped so tiles are only read from
+    //! disk when first used; without mmap tiles are read on demand.
+    class Bathymetry
+    {
+    public:
+      //! Bathymetry sample (north, east offsets and depth).
+      struct Sample
+      {
+        //! North offset to the reference location (m).
+        double x;
+        //! East offset to the reference location (m).
+        double y;
+        //! Depth (m).
+        double depth;
+      };
+
+      //! File header.
+      struct Header
+      {
+        //! Magic number, also used to detect the byte order.
+        uint32_t magic;
+        //! Format version.
+        uint32_t version;
+        //! Reference latitude (degrees).
+        double lat;
+        //! Reference longitude (degrees).
+        double lon;
+        //! North offset of the first sample (m).
+        double x0;
+        //! East offset of the first sample (m).
+        double y0;
+        //! Distance between samples (m).
+        double resolution;
+        //! Number of samples along the north axis.
+        uint32_t rows;
+        //! Number of samples along the east axis.
+        uint32_t cols;
+        //! Number of samples on each side of a tile.
+        uint32_t tile_size;
+        //! Reserved.
+        uint32_t reserved;
+      };
+
+      //! Open a bathymetry raster.
+      //! @param[in] path path to the raster file.
+      Bathymetry(const std::string& path);
+
+      //! Destructor.
+      ~Bathymetry(void);
+
+      //! Reference latitude.
+      //! @return latitude (degrees).
+      double
+      getLatitude(void) const
+      {
+        return m_header.lat;
+      }
+
+      //! Reference longitude.
+      //! @return longitude (degrees).
+      double
+      getLongitude(void) const
+      {
+        return m_header.lon;
+      }
+
+      //! Distance between samples.
+      //! @return resolution (m).
+      double
+      getResolution(void) const
+      {
+        return m_header.resolution;
+      }
+
+      //! Number of samples along the north axis.
+      unsigned
+      getRows(void) const
+      {
+        return m_header.rows;
+      }
+
+      //! Number of samples along the east axis.
+      unsigned
+      getColumns(void) const
+      {
+        return m_header.cols;
+      }
+
+      //! Retrieve a raster sample.
+      //! @param[in] row sample index along the north axis.
+      //! @param[in] col sample index along the east axis.
+      //! @return depth or NaN if there is no data.
+      float
+      getSample(unsigned row, unsigned col);
+
+      //! Bilinear interpolation of the depth at a position. Samples
+      //! without data are left out of the interpolation.
+      //! @param[in] x north offset to the reference location (m).
+      //! @param[in] y east offset to the reference location (m).
+      //! @param[out] depth interpolated depth (m).
+      //! @return false if the position is out of bounds or has no
+      //! data around it, true otherwise.
+      bool
+      getDepth(double x, double y, double& depth);
+
+      //! Create a raster from scattered samples. Each raster sample
+      //! is the mean of the input samples nearest to it; samples with
+      //! no input are then filled by inverse distance weighting of
+      //! the raster samples within the given radius.
+      //! @param[in] path path to the raster file.
+      //! @param[in] lat reference latitude (degrees).
+      //! @param[in] lon reference longitude (degrees).
+      //! @param[in] samples scattered samples.
+      //! @param[in] resolution distance between raster samples (m).
+      //! @param[in] radius fill radius (m).
+      static void
+      create(const std::string& path, double lat, double lon,
+             const std::vector<Sample>& samples, double resolution, double radius);
+
+    private:
+      //! File header.
+      Header m_header;
+      //! Number of tiles along the east axis.
+      unsigned m_tiles_y;
+      //! Number of samples in a tile.
+      size_t m_tile_samples;
+      //! Mapped file.
+      const uint8_t* m_data;
+      //! Size of mapped file.
+      size_t m_size;
+      //! Raster file, when not mapped.
+      std::ifstream m_file;
+      //! Tiles read from the raster file, when not mapped.
+      std::vector<std::vector<float> > m_tiles;
+
+      //! Retrieve a tile.
+      //! @param[in] tx tile index along the north axis.
+      //! @param[in] ty tile index along the east axis.
+      //! @return tile samples.
+      const float*
+      getTile(unsigned tx, unsigned ty);
+
+      //! Non-copyable.
+      Bathymetry(const Bathymetry&);
+
+      //! Non-assignable.
+      Bathymetry&
+      operator=(const Bathymetry&);
+    };
+  }
+}
+
+#endif
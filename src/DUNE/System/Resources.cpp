@@ -33,6 +33,9 @@
 #include <cerrno>
 #include <cstring>
 
+// ISO C++ 11 headers.
+#include <thread>
+
 // DUNE headers.
 #include <DUNE/System/Resources.hpp>
 #include <DUNE/Time/Constants.hpp>
@@ -180,6 +183,26 @@ namespace DUNE
       return proc_delta * 100 / global_delta;
     }
 
+    unsigned
+    Resources::getProcessorCount(void)
+    {
+      unsigned count = std::thread::hardware_concurrency();
+      return (count > 0) ? count : 1;
+    }
+
+    uint64_t
+    Resources::getMemorySize(void)
+    {
+#if defined(DUNE_SYS_HAS_UNISTD_H) && defined(_SC_PHYS_PAGES) && defined(_SC_PAGESIZE)
+      long pages = sysconf(_SC_PHYS_PAGES);
+      long page_size = sysconf(_SC_PAGESIZE);
+      if (pages > 0 && page_size > 0)
+        return (uint64_t)pages * (uint64_t)page_size;
+#endif
+
+      return 0;
+    }
+
     void
     Resources::lockMemory(void)
     {
@@ -83,6 +83,17 @@ namespace DUNE
       static void
       unlockMemory(const void* addr, size_t length);
 
+      //! Retrieve the number of processors available to the process.
+      //! @return number of processors (at least one).
+      static unsigned
+      getProcessorCount(void);
+
+      //! Retrieve the amount of physical memory.
+      //! @return physical memory in bytes or zero if not available
+      //! in the current platform.
+      static uint64_t
+      getMemorySize(void);
+
     private:
       //! Last process's CPU time.
       uint64_t m_last_proc_time;
@@ -41,6 +41,7 @@ namespace DUNE
 #include <DUNE/Tasks/Exceptions.hpp>
 #include <DUNE/Tasks/Consumer.hpp>
 #include <DUNE/Tasks/Periodic.hpp>
+#include <DUNE/Tasks/PeriodicExecutor.hpp>
 #include <DUNE/Tasks/Profiles.hpp>
 #include <DUNE/Tasks/Task.hpp>
 #include <DUNE/Tasks/Context.hpp>
@@ -30,6 +30,9 @@
 #ifndef DUNE_TASKS_ABSTRACT_CONSUMER_HPP_INCLUDED_
 #define DUNE_TASKS_ABSTRACT_CONSUMER_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <cstddef>
+
 // DUNE headers.
 #include <DUNE/IMC/Message.hpp>
 
@@ -49,6 +52,27 @@ namespace DUNE
       virtual void
       consume(const IMC::Message*) = 0;
 
+      //! Consume a burst of consecutive messages with the same
+      //! identifier. The default implementation consumes them one at
+      //! a time.
+      //! @param msgs array of messages.
+      //! @param count number of messages.
+      virtual void
+      consumeBatch(const IMC::Message* const* msgs, size_t count)
+      {
+        for (size_t i = 0; i < count; ++i)
+          consume(msgs[i]);
+      }
+
+      //! Test if this consumer prefers to receive bursts of messages
+      //! through consumeBatch().
+      //! @return true if batches are preferred, false otherwise.
+      virtual bool
+      isBatched(void) const
+      {
+        return false;
+      }
+
       virtual
       ~AbstractConsumer(void)
       { }
@@ -62,6 +62,45 @@ namespace DUNE
       T& m_obj;
       Routine m_fun;
     };
+
+    //! Consumer of bursts of messages of the same type.
+    template <typename T, typename M>
+    class BatchConsumer: public AbstractConsumer
+    {
+    public:
+      typedef void (T::* Routine)(const M* const*, size_t);
+
+      //! Constructor.
+      BatchConsumer(T& o, Routine f):
+        m_obj(o),
+        m_fun(f)
+      { }
+
+      void
+      consume(const IMC::Message* msg)
+      {
+        consumeBatch(&msg, 1);
+      }
+
+      void
+      consumeBatch(const IMC::Message* const* msgs, size_t count)
+      {
+        ((m_obj).*(m_fun))(reinterpret_cast<const M* const*>(msgs), count);
+      }
+
+      bool
+      isBatched(void) const
+      {
+        return true;
+      }
+
+      ~BatchConsumer(void)
+      { }
+
+    private:
+      T& m_obj;
+      Routine m_fun;
+    };
   }
 }
 
@@ -40,6 +40,8 @@
 #include <DUNE/Entities/EntityDataBase.hpp>
 #include <DUNE/Utils/ByteBuffer.hpp>
 #include <DUNE/Tasks/Profiles.hpp>
+#include <DUNE/Tasks/PeriodicExecutor.hpp>
+#include <DUNE/IO/Reactor.hpp>
 #include <DUNE/IMC/Bus.hpp>
 #include <DUNE/IMC/AddressResolver.hpp>
 
@@ -88,6 +90,10 @@ namespace DUNE
       FileSystem::Path dir_scripts;
       //! UID of this instance.
       uint64_t uid;
+      //! Shared executor of periodic tasks.
+      PeriodicExecutor executor;
+      //! Shared dispatcher of I/O readiness.
+      IO::Reactor reactor;
     };
   }
 }
@@ -36,6 +36,7 @@
 
 // DUNE headers.
 #include <DUNE/Time/Delay.hpp>
+#include <DUNE/Time/Lockstep.hpp>
 #include <DUNE/Tasks/Task.hpp>
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Factory.hpp>
@@ -178,15 +179,19 @@ namespace DUNE
 
       try
       {
+        // Virtual time must wait for the task to reach its first wait.
+        Time::Lockstep::attach();
         task->inf(DTR("starting"));
         task->start();
       }
       catch (std::exception& e)
       {
+        Time::Lockstep::cancel();
         task->err("%s", e.what());
       }
       catch (...)
       {
+        Time::Lockstep::cancel();
         task->err(DTR("unknown exception"));
       }
     }
@@ -30,6 +30,7 @@
 // ISO C++ 98 headers.
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 
 // DUNE headers.
 #include <DUNE/IMC/Bus.hpp>
@@ -37,20 +38,37 @@
 #include <DUNE/Tasks/Periodic.hpp>
 #include <DUNE/Time/Clock.hpp>
 #include <DUNE/Time/Delay.hpp>
+#include <DUNE/Time/Lockstep.hpp>
 
 namespace DUNE
 {
   namespace Tasks
   {
+    //! Period of execution statistics reports (s).
+    static const double c_stats_period = 60.0;
+    //! Execution priority of shared worker threads.
+    static const unsigned c_shared_priority = 10;
+
     Periodic::Periodic(const std::string& name, Context& ctx):
       Task(name, ctx),
       m_run_count(0),
-      m_run_time(0)
+      m_run_time(0),
+      m_shared_active(false),
+      m_phase(SP_START),
+      m_restart_time(0),
+      m_report_time(0),
+      m_job(*this)
     {
       param(DTR_RT("Execution Frequency"), m_frequency)
       .units(Units::Hertz)
       .defaultValue("1.0")
       .description(DTR("Frequency at which task is executed"));
+
+      param(DTR_RT("Shared Executor"), m_shared)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .defaultValue("false")
+      .description(DTR("Run the task on the shared pool of worker threads"
+                       " instead of its own thread"));
     }
 
     void
@@ -83,5 +101,118 @@ namespace DUNE
         now = Time::Clock::get();
       }
     }
+
+    void
+    Periodic::startImpl(void)
+    {
+      // Shared workers run at the default priority.
+      if (m_shared && getPriority() != c_shared_priority)
+        war(DTR("execution priority %u is not honoured by the shared executor,"
+                " running on own thread"), getPriority());
+
+      // Shared workers keep real-time schedules.
+      m_shared_active = m_shared && getPriority() == c_shared_priority
+      && !Time::Lockstep::isEnabled();
+      if (!m_shared_active)
+      {
+        Thread::startImpl();
+        return;
+      }
+
+      setStateImpl(StateRunning);
+      m_phase = SP_START;
+      m_report_time = Time::Clock::get() + c_stats_period;
+      m_ctx.executor.add(&m_job);
+    }
+
+    void
+    Periodic::joinImpl(void)
+    {
+      if (!m_shared_active)
+      {
+        Thread::joinImpl();
+        return;
+      }
+
+      m_ctx.executor.remove(&m_job);
+      releaseResources();
+      setStateImpl(StateDead);
+    }
+
+    double
+    Periodic::getSharedPeriod(void) const
+    {
+      switch (m_phase)
+      {
+        case SP_RUN:
+          return 1.0 / m_frequency;
+        case SP_RESTART:
+          // Entity state is reported every second while waiting.
+          return std::max(0.0, std::min(1.0, m_restart_time - Time::Clock::get()));
+        default:
+          return 0;
+      }
+    }
+
+    void
+    Periodic::runShared(void)
+    {
+      if (stopping())
+        return;
+
+      try
+      {
+        switch (m_phase)
+        {
+          case SP_START:
+            startExecution();
+            m_phase = SP_RUN;
+            break;
+
+          case SP_RUN:
+            m_run_time = Time::Clock::get();
+            consumeMessages();
+            if (!stopping())
+            {
+              task();
+              ++m_run_count;
+            }
+            break;
+
+          case SP_RESTART:
+            reportEntityState();
+            if (Time::Clock::get() >= m_restart_time)
+            {
+              reloadParameters();
+              m_phase = SP_START;
+            }
+            break;
+        }
+      }
+      catch (RestartNeeded& e)
+      {
+        reportRestart(e);
+        m_restart_time = Time::Clock::get() + e.getDelay();
+        m_phase = SP_RESTART;
+      }
+      catch (std::exception& e)
+      {
+        reportFailure(e);
+        m_phase = SP_START;
+      }
+
+      if (m_run_time < m_report_time)
+        return;
+
+      m_report_time += c_stats_period;
+      PeriodicExecutor::Statistics stats;
+      if (m_ctx.executor.getStatistics(&m_job, stats))
+      {
+        debug("shared executor: %u runs, %u overruns, jitter %.3f / %.3f ms,"
+              " run time %.3f / %.3f ms", stats.runs, stats.overruns,
+              stats.jitter_mean * 1e3, stats.jitter_max * 1e3,
+              stats.exec_mean * 1e3, stats.exec_max * 1e3);
+      }
+    }
   }
 }
@@ -37,6 +37,7 @@
 #include <string>
 
 // Local headers.
+#include <DUNE/Tasks/PeriodicExecutor.hpp>
 #include <DUNE/Tasks/Task.hpp>
 
 namespace DUNE
@@ -49,7 +50,12 @@ namespace DUNE
     // Forward declarations
     struct Context;
 
-    //! Periodic task.
+    //! Periodic task. When the 'Shared Executor' parameter is set the
+    //! task does not get a thread of its own: its whole life cycle,
+    //! including resource acquisition and restarts, runs in cycles of
+    //! the shared executor of the context, unless a non-default
+    //! 'Execution Priority' is also set. Derived classes that
+    //! override onMain() must not enable it.
     class Periodic: public Task
     {
     public:
@@ -99,17 +105,84 @@ namespace DUNE
       virtual void
       task(void) = 0;
 
+    protected:
+      //! Start the task thread, or register the task with the shared
+      //! executor.
+      void
+      startImpl(void);
+
+      //! Wait for the task thread to finish, or remove the task from
+      //! the shared executor and release its resources.
+      void
+      joinImpl(void);
+
     private:
+      //! Phases of a task running on the shared executor.
+      enum SharedPhase
+      {
+        //! Acquire and initialize resources.
+        SP_START,
+        //! Run the task.
+        SP_RUN,
+        //! Wait before restarting.
+        SP_RESTART
+      };
+
+      //! Runs the task on the shared executor.
+      class Job: public PeriodicExecutor::Job
+      {
+      public:
+        Job(Periodic& task):
+          m_task(task)
+        { }
+
+        double
+        getPeriod(void) const
+        {
+          return m_task.getSharedPeriod();
+        }
+
+        void
+        runJob(void)
+        {
+          m_task.runShared();
+        }
+
+      private:
+        Periodic& m_task;
+      };
+
       //! Number of executions thus far.
       unsigned m_run_count;
       //! Time of last run.
       double m_run_time;
       //! Task frequency (Hz).
       double m_frequency;
+      //! True to run on the shared executor.
+      bool m_shared;
+      //! True if the task was started on the shared executor.
+      bool m_shared_active;
+      //! Current phase on the shared executor.
+      SharedPhase m_phase;
+      //! Time at which to restart after a restart request.
+      double m_restart_time;
+      //! Time of the next statistics report.
+      double m_report_time;
+      //! Shared executor job.
+      Job m_job;
 
       //! Task entry point.
       void
       onMain(void);
+
+      //! Get the delay until the next cycle on the shared executor.
+      //! @return delay in seconds.
+      double
+      getSharedPeriod(void) const;
+
+      //! Run one cycle on the shared executor.
+      void
+      runShared(void);
     };
   }
 }
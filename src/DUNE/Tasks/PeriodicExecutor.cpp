@@ -0,0 +1,241 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/System/Resources.hpp>
+#include <DUNE/Tasks/PeriodicExecutor.hpp>
+#include <DUNE/Time/Clock.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    class PeriodicExecutor::Worker: public Concurrency::Thread
+    {
+    public:
+      Worker(PeriodicExecutor& executor):
+        m_executor(executor)
+      { }
+
+    private:
+      PeriodicExecutor& m_executor;
+
+      void
+      run(void)
+      {
+        m_executor.work();
+      }
+    };
+
+    PeriodicExecutor::PeriodicExecutor(unsigned workers):
+      m_worker_count(workers),
+      m_stopping(false)
+    {
+      if (m_worker_count == 0)
+        m_worker_count = std::max(2u, System::Resources::getProcessorCount());
+    }
+
+    PeriodicExecutor::~PeriodicExecutor(void)
+    {
+      m_cond.lock();
+      m_stopping = true;
+      m_cond.broadcast();
+      m_cond.unlock();
+
+      for (size_t i = 0; i < m_workers.size(); ++i)
+      {
+        m_workers[i]->stopAndJoin();
+        delete m_workers[i];
+      }
+
+      // Entries of removed jobs may still be queued.
+      while (!m_queue.empty())
+      {
+        Entry* entry = m_queue.top().second;
+        m_queue.pop();
+        if (entry->removed)
+          delete entry;
+      }
+
+      std::map<const Job*, Entry*>::iterator itr = m_entries.begin();
+      for (; itr != m_entries.end(); ++itr)
+        delete itr->second;
+    }
+
+    void
+    PeriodicExecutor::add(Job* job)
+    {
+      m_cond.lock();
+
+      if (m_entries.find(job) != m_entries.end())
+      {
+        m_cond.unlock();
+        return;
+      }
+
+      Entry* entry = new Entry;
+      entry->job = job;
+      entry->deadline = Time::Clock::get() + job->getPeriod();
+      entry->running = false;
+      entry->removed = false;
+
+      if (m_workers.empty())
+      {
+        for (unsigned i = 0; i < m_worker_count; ++i)
+        {
+          m_workers.push_back(new Worker(*this));
+          m_workers.back()->start();
+        }
+      }
+
+      m_entries[job] = entry;
+      m_queue.push(Item(entry->deadline, entry));
+      m_cond.broadcast();
+      m_cond.unlock();
+    }
+
+    void
+    PeriodicExecutor::remove(Job* job)
+    {
+      m_cond.lock();
+
+      std::map<const Job*, Entry*>::iterator itr = m_entries.find(job);
+      if (itr != m_entries.end())
+      {
+        Entry* entry = itr->second;
+        m_entries.erase(itr);
+        entry->removed = true;
+
+        // A queued entry is freed by the worker that pops it, a running
+        // one is freed here once the worker is done with it.
+        if (entry->running)
+        {
+          while (entry->running)
+            m_cond.wait();
+
+          delete entry;
+        }
+      }
+
+      m_cond.unlock();
+    }
+
+    bool
+    PeriodicExecutor::getStatistics(const Job* job, Statistics& stats)
+    {
+      bool found = false;
+
+      m_cond.lock();
+      std::map<const Job*, Entry*>::const_iterator itr = m_entries.find(job);
+      if (itr != m_entries.end())
+      {
+        stats = itr->second->stats;
+        found = true;
+      }
+      m_cond.unlock();
+
+      return found;
+    }
+
+    void
+    PeriodicExecutor::work(void)
+    {
+      m_cond.lock();
+
+      while (!m_stopping)
+      {
+        if (m_queue.empty())
+        {
+          m_cond.wait();
+          continue;
+        }
+
+        Entry* entry = m_queue.top().second;
+        if (entry->removed && !entry->running)
+        {
+          m_queue.pop();
+          delete entry;
+          continue;
+        }
+
+        double now = Time::Clock::get();
+        if (m_queue.top().first > now)
+        {
+          m_cond.wait(m_queue.top().first - now);
+          continue;
+        }
+
+        m_queue.pop();
+        entry->running = true;
+        m_cond.unlock();
+
+        double start = Time::Clock::get();
+        entry->job->runJob();
+        double end = Time::Clock::get();
+
+        m_cond.lock();
+        entry->running = false;
+
+        if (entry->removed)
+        {
+          // Wake up remove().
+          m_cond.broadcast();
+          continue;
+        }
+
+        Statistics& stats = entry->stats;
+        double jitter = start - entry->deadline;
+        double exec = end - start;
+        ++stats.runs;
+        stats.jitter_mean += (jitter - stats.jitter_mean) / stats.runs;
+        stats.jitter_max = std::max(stats.jitter_max, jitter);
+        stats.exec_mean += (exec - stats.exec_mean) / stats.runs;
+        stats.exec_max = std::max(stats.exec_max, exec);
+
+        // Next deadline, skipping cycles that were missed.
+        double period = entry->job->getPeriod();
+        entry->deadline += period;
+        if (entry->deadline <= end && period > 0)
+        {
+          double missed = std::ceil((end - entry->deadline) / period);
+          stats.overruns += static_cast<unsigned>(missed);
+          entry->deadline += missed * period;
+        }
+
+        m_queue.push(Item(entry->deadline, entry));
+        m_cond.signal();
+      }
+
+      m_cond.unlock();
+    }
+  }
+}
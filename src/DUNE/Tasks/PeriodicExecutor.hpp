@@ -0,0 +1,186 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_TASKS_PERIODIC_EXECUTOR_HPP_INCLUDED_
+#define DUNE_TASKS_PERIODIC_EXECUTOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <map>
+#include <queue>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM PeriodicExecutor;
+
+    //! Runs periodic jobs on a shared pool of worker threads. Jobs
+    //! are kept in a deadline queue and each one is run by at most one
+    //! worker at a time. A job that is still running (or waiting for
+    //! a worker) when its next deadline expires is not queued twice:
+    //! the missed cycles are skipped and counted as overruns. Worker
+    //! threads are started when the first job is added.
+    class PeriodicExecutor
+    {
+    public:
+      //! Job run by the executor.
+      class Job
+      {
+      public:
+        virtual
+        ~Job(void)
+        { }
+
+        //! Get the current job period. Called after each run, so the
+        //! period may change at any time.
+        //! @return period in seconds.
+        virtual double
+        getPeriod(void) const = 0;
+
+        //! Run one cycle.
+        virtual void
+        runJob(void) = 0;
+      };
+
+      //! Per-job execution statistics.
+      struct Statistics
+      {
+        //! Number of runs.
+        unsigned runs;
+        //! Number of skipped cycles.
+        unsigned overruns;
+        //! Mean delay between deadline and start of run (s).
+        double jitter_mean;
+        //! Maximum delay between deadline and start of run (s).
+        double jitter_max;
+        //! Mean run time (s).
+        double exec_mean;
+        //! Maximum run time (s).
+        double exec_max;
+
+        Statistics(void):
+          runs(0),
+          overruns(0),
+          jitter_mean(0),
+          jitter_max(0),
+          exec_mean(0),
+          exec_max(0)
+        { }
+      };
+
+      //! Constructor.
+      //! @param workers number of worker threads, 0 to use the number
+      //! of processors (at least two).
+      PeriodicExecutor(unsigned workers = 0);
+
+      //! Destructor. Stops all worker threads.
+      ~PeriodicExecutor(void);
+
+      //! Add a job. Its first run is due one period from now. Adding a
+      //! job that is already registered has no effect.
+      //! @param job job.
+      void
+      add(Job* job);
+
+      //! Remove a job. Returns only after the job is no longer running.
+      //! Must not be called from the job itself.
+      //! @param job job.
+      void
+      remove(Job* job);
+
+      //! Retrieve execution statistics of a job.
+      //! @param job job.
+      //! @param stats statistics.
+      //! @return true if the job is registered, false otherwise.
+      bool
+      getStatistics(const Job* job, Statistics& stats);
+
+      //! Retrieve the number of worker threads.
+      //! @return number of worker threads.
+      unsigned
+      getWorkerCount(void) const
+      {
+        return m_worker_count;
+      }
+
+    private:
+      class Worker;
+
+      //! Registered job.
+      struct Entry
+      {
+        //! Job.
+        Job* job;
+        //! Next deadline.
+        double deadline;
+        //! True while a worker runs the job.
+        bool running;
+        //! True if the job was removed.
+        bool removed;
+        //! Statistics.
+        Statistics stats;
+      };
+
+      //! Deadline queue item.
+      typedef std::pair<double, Entry*> Item;
+      //! Deadline queue (earliest first).
+      typedef std::priority_queue<Item, std::vector<Item>, std::greater<Item> > Queue;
+
+      //! Number of worker threads.
+      unsigned m_worker_count;
+      //! Worker threads.
+      std::vector<Worker*> m_workers;
+      //! Deadline queue.
+      Queue m_queue;
+      //! Registered jobs.
+      std::map<const Job*, Entry*> m_entries;
+      //! Protects all of the above and signals workers.
+      Concurrency::Condition m_cond;
+      //! True when the executor is being destroyed.
+      bool m_stopping;
+
+      //! Worker thread loop.
+      void
+      work(void);
+
+      //! Non-copyable.
+      PeriodicExecutor(const PeriodicExecutor&);
+
+      //! Non-assignable.
+      PeriodicExecutor&
+      operator=(const PeriodicExecutor&);
+    };
+  }
+}
+
+#endif
@@ -29,89 +29,268 @@
 
 // ISO C++ 98 headers.
 #include <cstddef>
+#include <algorithm>
 
 // DUNE headers.
+#include <DUNE/Config.hpp>
 #include <DUNE/IMC/Bus.hpp>
 #include <DUNE/IMC/Factory.hpp>
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Recipient.hpp>
+#include <DUNE/Time/Clock.hpp>
 
 namespace DUNE
 {
   namespace Tasks
   {
+    //! Maximum number of messages drained from the queue at once.
+    static const size_t c_batch_size = 32;
+
     Recipient::Recipient(AbstractTask* task, Context& ctx):
       m_task(task),
-      m_ctx(ctx)
+      m_ctx(ctx),
+      m_mqueue_size(0),
+      m_mailbox(NULL),
+      m_dropped(0),
+      m_dropped_report(0),
+      m_event(NULL),
+      m_event_signalled(false)
     { }
 
     Recipient::~Recipient(void)
     {
       unbindAll();
 
+      for (size_t id = 0; id < m_cbacks.size(); ++id)
+        delete m_cbacks[id];
+
       while (!m_mqueue.empty())
-      {
-        IMC::Message* msg = m_mqueue.pop();
-        if (msg)
-          delete msg;
-      }
+        m_mqueue.pop();
+
+      delete m_mailbox.load();
     }
 
     void
     Recipient::unbindAll(void)
     {
-      std::map<uint32_t, std::vector<AbstractConsumer*> >::iterator itr = m_cbacks.begin();
+      bool unregistered = false;
 
-      for (; itr != m_cbacks.end(); ++itr)
+      for (size_t id = 0; id < m_cbacks.size(); ++id)
       {
-        m_ctx.mbus.unregisterRecipient(m_task, itr->first);
+        if (m_cbacks[id] == NULL)
+          continue;
 
-        for (size_t i = 0; i < itr->second.size(); ++i)
-          delete itr->second[i];
+        m_ctx.mbus.unregisterRecipient(m_task, id);
+        unregistered = true;
 
-        itr->second.clear();
+        for (size_t i = 0; i < m_cbacks[id]->consumers.size(); ++i)
+          delete m_cbacks[id]->consumers[i];
+
+        delete m_cbacks[id];
+        m_cbacks[id] = NULL;
       }
+
+      // No dispatcher may reach this task once it is destroyed.
+      if (unregistered)
+        m_ctx.mbus.synchronize();
     }
 
     void
     Recipient::bind(uint32_t id, AbstractConsumer* consumer)
     {
-      std::map<uint32_t, std::vector<AbstractConsumer*> >::iterator itr = m_cbacks.find(id);
-      if (itr == m_cbacks.end())
+      if (id >= m_cbacks.size())
+        m_cbacks.resize(id + 1, NULL);
+
+      if (m_cbacks[id] == NULL)
+      {
+        m_cbacks[id] = new Callbacks;
         m_ctx.mbus.registerRecipient(m_task, id);
+      }
+
+      m_cbacks[id]->consumers.push_back(consumer);
+      m_cbacks[id]->batched = m_cbacks[id]->batched || consumer->isBatched();
+    }
 
-      m_cbacks[id].push_back(consumer);
+    void
+    Recipient::setMailbox(size_t capacity, Mailbox::OverflowPolicy policy)
+    {
+      Mailbox* mailbox = m_mailbox.load(std::memory_order_acquire);
+      if (mailbox == NULL)
+      {
+        mailbox = new Mailbox(capacity, policy);
+        m_mailbox.store(mailbox, std::memory_order_release);
+      }
+      else
+      {
+        mailbox->setOverflowPolicy(policy);
+      }
     }
 
     void
     Recipient::waitForMessages(double timeout)
     {
-      if (m_mqueue.waitForItems(timeout))
+      if (Time::Lockstep::isEnabled())
+      {
+        waitForMessagesLockstep(timeout);
+        return;
+      }
+
+      Mailbox* mailbox = m_mailbox.load(std::memory_order_acquire);
+      if (mailbox == NULL)
+      {
+        if (m_mqueue.waitForItems(timeout))
+          runCallBacks();
+        return;
+      }
+
+      // Messages queued before the mailbox was created.
+      if (m_mqueue_size.load(std::memory_order_acquire) > 0 || mailbox->waitForItems(timeout))
+        runCallBacks();
+    }
+
+    void
+    Recipient::waitForMessagesLockstep(double timeout)
+    {
+      // Notifications after this point are not lost.
+      Time::Lockstep::clear(m_signal);
+
+      Mailbox* mailbox = m_mailbox.load(std::memory_order_acquire);
+      bool empty = m_mqueue_size.load(std::memory_order_acquire) == 0
+      && (mailbox == NULL || mailbox->empty());
+
+      if (!empty || Time::Lockstep::wait(m_signal, timeout))
         runCallBacks();
     }
 
     void
     Recipient::put(const IMC::Message* msg)
     {
-      m_mqueue.push(msg->clone());
+      put(IMC::SharedMessage(IMC::Factory::clone(msg)));
     }
 
     void
-    Recipient::runCallBacks(void)
+    Recipient::put(const IMC::SharedMessage& msg)
+    {
+      Mailbox* mailbox = m_mailbox.load(std::memory_order_acquire);
+      if (mailbox == NULL)
+      {
+        m_mqueue.push(msg);
+        m_mqueue_size.fetch_add(1, std::memory_order_release);
+      }
+      else
+        mailbox->push(msg);
+
+      if (Time::Lockstep::isEnabled())
+        Time::Lockstep::notify(m_signal);
+
+      // Only the first message after the event is cleared signals it.
+      IO::Event* event = m_event.load(std::memory_order_acquire);
+      if (event != NULL && !m_event_signalled.exchange(true))
+        event->signal();
+    }
+
+    void
+    Recipient::consume(IMC::SharedMessage* msgs, size_t count)
     {
-      unsigned int size = m_mqueue.size();
+      const IMC::Message* ptrs[c_batch_size];
+      for (size_t i = 0; i < count; ++i)
+        ptrs[i] = msgs[i].get();
 
-      for (unsigned int i = 0; i < size; ++i)
+      // Consumers may bind new messages, so m_cbacks is indexed on
+      // every call.
+      size_t i = 0;
+      while (i < count)
       {
-        const IMC::Message* msg = m_mqueue.pop();
-        if (msg)
+        uint16_t id = ptrs[i]->getId();
+        if (id >= m_cbacks.size() || m_cbacks[id] == NULL)
+        {
+          ++i;
+          continue;
+        }
+
+        // Group consecutive messages with the same identifier.
+        size_t n = 1;
+        if (m_cbacks[id]->batched)
+        {
+          while (i + n < count && ptrs[i + n]->getId() == id)
+            ++n;
+        }
+
+        for (size_t j = 0; j < m_cbacks[id]->consumers.size(); ++j)
         {
-          uint32_t id = msg->getId();
-          for (size_t j = 0; j < m_cbacks[id].size(); ++j)
-            m_cbacks[id][j]->consume(msg);
-          delete msg;
+          if (n == 1)
+            m_cbacks[id]->consumers[j]->consume(ptrs[i]);
+          else
+            m_cbacks[id]->consumers[j]->consumeBatch(ptrs + i, n);
         }
+
+        i += n;
+      }
+
+      for (size_t k = 0; k < count; ++k)
+        msgs[k].reset();
+    }
+
+    void
+    Recipient::reportOverflow(void)
+    {
+      Mailbox* mailbox = m_mailbox.load(std::memory_order_acquire);
+      unsigned long dropped = mailbox->getDropped();
+      if (dropped == m_dropped)
+        return;
+
+      double now = Time::Clock::get();
+      if (now - m_dropped_report < 5.0)
+        return;
+
+      m_task->war(DTR("mailbox overflow: %lu messages dropped (high water %u)"),
+                  dropped - m_dropped, (unsigned)mailbox->getHighWater());
+      m_dropped = dropped;
+      m_dropped_report = now;
+    }
+
+    void
+    Recipient::runCallBacks(void)
+    {
+      // Messages queued after this point signal the event again.
+      IO::Event* event = m_event.load(std::memory_order_acquire);
+      if (event != NULL)
+      {
+        event->clear();
+        m_event_signalled.store(false);
+      }
+
+      IMC::SharedMessage batch[c_batch_size];
+
+      // Drain only what is currently queued, in batches.
+      size_t pending = m_mqueue_size.load(std::memory_order_acquire);
+      while (pending > 0)
+      {
+        size_t count = m_mqueue.popBatch(batch, std::min(pending, c_batch_size));
+        if (count == 0)
+          break;
+
+        m_mqueue_size.fetch_sub(count, std::memory_order_relaxed);
+        consume(batch, count);
+        pending -= count;
       }
+
+      Mailbox* mailbox = m_mailbox.load(std::memory_order_acquire);
+      if (mailbox == NULL)
+        return;
+
+      pending = mailbox->size();
+      while (pending > 0)
+      {
+        size_t count = mailbox->popBatch(batch, std::min(pending, c_batch_size));
+        if (count == 0)
+          break;
+
+        consume(batch, count);
+        pending -= count;
+      }
+
+      reportOverflow();
     }
   }
 }
@@ -34,10 +34,17 @@
 #include <map>
 #include <vector>
 
+// ISO C++ 11 headers.
+#include <atomic>
+
 // DUNE headers.
 #include <DUNE/Concurrency/TSQueue.hpp>
+#include <DUNE/Concurrency/MPSCQueue.hpp>
+#include <DUNE/IMC/SharedMessage.hpp>
+#include <DUNE/IO/Event.hpp>
 #include <DUNE/Tasks/Consumer.hpp>
 #include <DUNE/Tasks/AbstractTask.hpp>
+#include <DUNE/Time/Lockstep.hpp>
 
 namespace DUNE
 {
@@ -61,8 +68,15 @@ namespace DUNE
       void
       unbindAll(void);
 
+      //! Queue a private copy of a message.
+      //! @param msg message object.
+      void
+      put(const IMC::Message* msg);
+
+      //! Queue a shared message, no copy is made.
+      //! @param msg shared message handle.
       void
-      put(const IMC::Message*);
+      put(const IMC::SharedMessage& msg);
 
       void
       bind(uint32_t id, AbstractConsumer* c);
@@ -73,15 +87,95 @@ namespace DUNE
       void
       runCallBacks(void);
 
+      //! Replace the default unbounded message queue with a bounded
+      //! lock-free mailbox. The mailbox can only be created once,
+      //! later calls only update the overflow policy.
+      //! @param capacity mailbox capacity.
+      //! @param policy overflow policy.
+      void
+      setMailbox(size_t capacity, Concurrency::MPSCQueue<IMC::SharedMessage>::OverflowPolicy policy);
+
+      //! Signal an event whenever a message is queued, so the task
+      //! can wait for messages and I/O handles at the same time. The
+      //! event is cleared by runCallBacks().
+      //! @param event event or NULL to stop signalling.
+      void
+      setEvent(IO::Event* event)
+      {
+        m_event.store(event, std::memory_order_release);
+      }
+
+      //! Retrieve the signal notified whenever a message is queued
+      //! while using virtual time.
+      //! @return message arrival signal.
+      Time::Lockstep::Signal&
+      getSignal(void)
+      {
+        return m_signal;
+      }
+
+      //! Retrieve the bounded mailbox.
+      //! @return mailbox or NULL if the unbounded queue is in use.
+      const Concurrency::MPSCQueue<IMC::SharedMessage>*
+      getMailbox(void) const
+      {
+        return m_mailbox.load(std::memory_order_acquire);
+      }
+
     private:
+      //! Bounded mailbox type.
+      typedef Concurrency::MPSCQueue<IMC::SharedMessage> Mailbox;
+
       //! Task.
       AbstractTask* m_task;
       //! Context.
       Context& m_ctx;
-      //! Callbacks.
-      std::map<uint32_t, std::vector<AbstractConsumer*> > m_cbacks;
+      //! Consumers of a message identifier.
+      struct Callbacks
+      {
+        Callbacks(void):
+          batched(false)
+        { }
+
+        //! Consumers.
+        std::vector<AbstractConsumer*> consumers;
+        //! True if at least one consumer prefers batches.
+        bool batched;
+      };
+
+      //! Callbacks indexed by message identifier.
+      std::vector<Callbacks*> m_cbacks;
       //! Message queue.
-      Concurrency::TSQueue<IMC::Message*> m_mqueue;
+      Concurrency::TSQueue<IMC::SharedMessage> m_mqueue;
+      //! Number of messages in the message queue, readable without
+      //! taking the queue lock.
+      std::atomic<size_t> m_mqueue_size;
+      //! Bounded mailbox (optional).
+      std::atomic<Mailbox*> m_mailbox;
+      //! Number of dropped messages already reported.
+      unsigned long m_dropped;
+      //! Time of the last overflow report.
+      double m_dropped_report;
+      //! Message arrival signal, used with virtual time.
+      Time::Lockstep::Signal m_signal;
+      //! Message arrival event (optional).
+      std::atomic<IO::Event*> m_event;
+      //! True if the event was signalled and not yet cleared.
+      std::atomic<bool> m_event_signalled;
+
+      //! Wait for messages using virtual time.
+      //! @param timeout amount of time to wait.
+      void
+      waitForMessagesLockstep(double timeout);
+
+      //! Run the consumers of an array of messages.
+      //! @param msgs messages (released on return).
+      //! @param count number of messages.
+      void
+      consume(IMC::SharedMessage* msgs, size_t count);
+
+      void
+      reportOverflow(void);
     };
   }
 }
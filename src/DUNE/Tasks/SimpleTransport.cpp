@@ -36,9 +36,15 @@ namespace DUNE
 {
   namespace Tasks
   {
+    //! Reception timeout when outgoing messages are polled (s).
+    static const double c_poll_timeout = 0.005;
+    //! Reception timeout when outgoing messages wake up the task (s).
+    static const double c_idle_timeout = 1.0;
+
     SimpleTransport::SimpleTransport(const std::string& name, Tasks::Context& ctx):
       Tasks::Task(name, ctx),
-      m_buf(2048)
+      m_buf(2048),
+      m_msg_watched(false)
     {
       param("Transports", m_gargs.transports)
       .defaultValue("")
@@ -61,7 +67,16 @@ namespace DUNE
     }
 
     SimpleTransport::~SimpleTransport(void)
-    { }
+    {
+      setMessageEvent(NULL);
+    }
+
+    void
+    SimpleTransport::watchMessages(IO::Poll& poll)
+    {
+      poll.add(m_msg_event);
+      m_msg_watched = true;
+    }
 
     void
     SimpleTransport::consume(const IMC::Message* msg)
@@ -69,18 +84,13 @@ namespace DUNE
       if (m_rl.filter(msg))
         return;
 
-      unsigned int n = msg->getSerializationSize();
-
-      m_buf.grow(n);
-
-      uint8_t* p = m_buf.getBuffer();
-
-      IMC::Packet::serialize(msg, p, n);
+      m_writer.clear();
+      unsigned int n = IMC::Packet::serialize(msg, m_writer);
 
       if (m_gargs.trace_out)
         inf(DTR("outgoing: %s"), msg->getName());
 
-      onDataTransmission(p, n);
+      onDataTransmission(m_writer.getData(), n);
     }
 
     void
@@ -90,31 +100,35 @@ namespace DUNE
       m_rl.setupEntities(m_gargs.entities_flt, this);
       bind(this, m_gargs.transports);
 
+      double timeout = c_poll_timeout;
+      if (m_msg_watched)
+      {
+        setMessageEvent(&m_msg_event);
+        timeout = c_idle_timeout;
+      }
+
       while (!stopping())
       {
         consumeMessages();
 
-        onDataReception(m_buf.getBuffer(), m_buf.getCapacity(), 0.005);
+        onDataReception(m_buf.getBuffer(), m_buf.getCapacity(), timeout);
       }
+
+      setMessageEvent(NULL);
     }
 
     void
     SimpleTransport::handleData(IMC::Parser& parser, const uint8_t* p, unsigned int n)
     {
-      for (const uint8_t* e = p + n; p != e; ++p)
+      parser.parse(p, n, [this](IMC::Message* m)
       {
-        IMC::Message* m = parser.parse(*p);
+        dispatch(m, DF_KEEP_TIME | DF_KEEP_SRC_EID);
 
-        if (m)
-        {
-          dispatch(m, DF_KEEP_TIME | DF_KEEP_SRC_EID);
+        if (m_gargs.trace_in)
+          inf(DTR("incoming: %s"), m->getName());
 
-          if (m_gargs.trace_in)
-            inf(DTR("incoming: %s"), m->getName());
-
-          delete m;
-        }
-      }
+        IMC::Factory::recycle(m);
+      });
     }
   }
 }
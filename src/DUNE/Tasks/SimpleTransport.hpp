@@ -36,7 +36,10 @@
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Utils/ByteBuffer.hpp>
+#include <DUNE/IO/Event.hpp>
+#include <DUNE/IO/Poll.hpp>
 #include <DUNE/IMC/Parser.hpp>
+#include <DUNE/IMC/Writer.hpp>
 #include <DUNE/Tasks/Task.hpp>
 #include <DUNE/Tasks/MessageFilter.hpp>
 
@@ -64,12 +67,27 @@ namespace DUNE
       virtual void
       onDataTransmission(const uint8_t* p, unsigned int n) = 0;
 
+      //! Wait for incoming data. If watchMessages() was called the
+      //! timeout is long and the wait ends as soon as a message is
+      //! queued for transmission, otherwise it is a few milliseconds.
+      //! @param[in] p buffer.
+      //! @param[in] n buffer capacity.
+      //! @param[in] timeout maximum amount of time to wait.
       virtual void
       onDataReception(uint8_t* p, unsigned int n, double timeout) = 0;
 
       void
       handleData(IMC::Parser& parser, const uint8_t* p, unsigned int n);
 
+    protected:
+      //! Add the handle signalled by messages queued for
+      //! transmission to the I/O selector used by
+      //! onDataReception(), so that waiting for incoming data does
+      //! not delay outgoing messages.
+      //! @param[in] poll I/O selector.
+      void
+      watchMessages(IO::Poll& poll);
+
     private:
       struct GArguments
       {
@@ -86,6 +104,11 @@ namespace DUNE
       };
       GArguments m_gargs;
       Utils::ByteBuffer m_buf;
+      //! Signalled when messages are queued for transmission.
+      IO::Event m_msg_event;
+      //! True if onDataReception() waits for m_msg_event.
+      bool m_msg_watched;
+      IMC::Writer m_writer;
       MessageFilter m_rl;
     };
   }
@@ -38,6 +38,7 @@
 #include <DUNE/Time/Delay.hpp>
 #include <DUNE/Time/PeriodicDelay.hpp>
 #include <DUNE/Time/Counter.hpp>
+#include <DUNE/Time/Lockstep.hpp>
 #include <DUNE/Status/Messages.hpp>
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Exceptions.hpp>
@@ -69,6 +70,7 @@ namespace DUNE
       m_args.act_time = 0;
       m_args.deact_time = 0;
       m_args.active = false;
+      m_args.mailbox_capacity = 0;
 
       param(DTR_RT("Entity Label"), m_args.elabel)
       .defaultValue("")
@@ -88,6 +90,18 @@ namespace DUNE
       .defaultValue("None")
       .values("None, Debug, Trace, Spew");
 
+      param(DTR_RT("Mailbox Capacity"), m_args.mailbox_capacity)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .defaultValue("0")
+      .description(DTR("Number of messages held by a bounded lock-free mailbox,"
+                       " zero to use an unbounded queue"));
+
+      param(DTR_RT("Mailbox Overflow Policy"), m_args.mailbox_policy)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .defaultValue("Drop Oldest")
+      .values("Block, Drop Oldest, Drop Newest")
+      .description(DTR("Action taken when a message arrives at a full mailbox"));
+
       m_recipient = new Recipient(this, ctx);
       m_entity = new Entities::StatefulEntity(this, m_ctx);
       m_entities.push_back(m_entity);
@@ -239,6 +253,18 @@ namespace DUNE
       else
         m_debug_level = DEBUG_LEVEL_NONE;
 
+      if (m_args.mailbox_capacity > 0)
+      {
+        typedef Concurrency::MPSCQueue<IMC::SharedMessage> Mailbox;
+        Mailbox::OverflowPolicy policy = Mailbox::OP_DROP_OLDEST;
+        if (m_args.mailbox_policy == "Block")
+          policy = Mailbox::OP_BLOCK;
+        else if (m_args.mailbox_policy == "Drop Newest")
+          policy = Mailbox::OP_DROP_NEWEST;
+
+        m_recipient->setMailbox(m_args.mailbox_capacity, policy);
+      }
+
       onUpdateParameters();
 
       if (m_honours_active)
@@ -354,6 +380,9 @@ namespace DUNE
       prctl(PR_SET_NAME, getName(), 0, 0, 0);
 #endif
 
+      // Messages end the waits of the task for I/O.
+      Time::Lockstep::bind(&m_recipient->getSignal());
+
       try
       {
         setPriority(m_args.priority);
@@ -365,36 +394,15 @@ namespace DUNE
       {
         try
         {
-          resolveEntities();
-          releaseResources();
-          acquireResources();
-          initializeResources();
-
-          if (m_honours_active)
-          {
-            Parameter::Scope active_scope = Parameter::scopeFromString(m_args.active_scope);
-            if (m_args.active && ((active_scope == Parameter::SCOPE_GLOBAL) || (active_scope == Parameter::SCOPE_IDLE)))
-              requestActivation();
-          }
-
+          startExecution();
           onMain();
           releaseResources();
         }
         catch (RestartNeeded& e)
         {
-          unsigned delay = e.getDelay();
+          reportRestart(e);
 
-          if (e.isError())
-          {
-            setEntityState(IMC::EntityState::ESTA_FAILURE, DTR("restarting"));
-
-            if (delay == 0)
-              err(DTR("restarting immediately due to error: %s"), e.getError());
-            else
-              err(DTR("restarting in %u seconds due to error: %s"), delay, e.getError());
-          }
-
-          Time::Counter<double> counter(static_cast<double>(delay));
+          Time::Counter<double> counter(static_cast<double>(e.getDelay()));
           while (!stopping() && !counter.overflow())
           {
             double remaining = counter.getRemaining();
@@ -402,23 +410,69 @@ namespace DUNE
             reportEntityState();
           }
 
-          try
-          {
-            updateParameters();
-          }
-          catch (std::runtime_error& pe)
-          {
-            err(DTR("failed to update parameters: %s"), pe.what());
-          }
+          reloadParameters();
         }
         catch (std::exception& e)
         {
-          IMC::EntityState estate;
-          setEntityState(IMC::EntityState::ESTA_FAILURE, e.what());
-          dispatch(estate);
-          err(DTR("task died with uncaught exception: %s: restarting"), e.what());
+          reportFailure(e);
         }
       }
+
+      Time::Lockstep::detach();
+    }
+
+    void
+    Task::startExecution(void)
+    {
+      resolveEntities();
+      releaseResources();
+      acquireResources();
+      initializeResources();
+
+      if (m_honours_active)
+      {
+        Parameter::Scope active_scope = Parameter::scopeFromString(m_args.active_scope);
+        if (m_args.active && ((active_scope == Parameter::SCOPE_GLOBAL) || (active_scope == Parameter::SCOPE_IDLE)))
+          requestActivation();
+      }
+    }
+
+    void
+    Task::reportRestart(RestartNeeded& e)
+    {
+      unsigned delay = e.getDelay();
+
+      if (e.isError())
+      {
+        setEntityState(IMC::EntityState::ESTA_FAILURE, DTR("restarting"));
+
+        if (delay == 0)
+          err(DTR("restarting immediately due to error: %s"), e.getError());
+        else
+          err(DTR("restarting in %u seconds due to error: %s"), delay, e.getError());
+      }
+    }
+
+    void
+    Task::reportFailure(std::exception& e)
+    {
+      IMC::EntityState estate;
+      setEntityState(IMC::EntityState::ESTA_FAILURE, e.what());
+      dispatch(estate);
+      err(DTR("task died with uncaught exception: %s: restarting"), e.what());
+    }
+
+    void
+    Task::reloadParameters(void)
+    {
+      try
+      {
+        updateParameters();
+      }
+      catch (std::runtime_error& pe)
+      {
+        err(DTR("failed to update parameters: %s"), pe.what());
+      }
     }
 
     void
@@ -52,6 +52,7 @@
 #include <DUNE/Parsers/BasicStringWriter.hpp>
 #include <DUNE/Tasks/AbstractTask.hpp>
 #include <DUNE/Tasks/Context.hpp>
+#include <DUNE/Tasks/Exceptions.hpp>
 #include <DUNE/Tasks/BasicParameterParser.hpp>
 #include <DUNE/Tasks/ParameterTable.hpp>
 #include <DUNE/Entities/BasicEntity.hpp>
@@ -336,6 +337,14 @@ namespace DUNE
         m_recipient->put(msg);
       }
 
+      //! Queue a shared message for later consumption.
+      //! @param msg shared message handle.
+      void
+      receive(const IMC::SharedMessage& msg)
+      {
+        m_recipient->put(msg);
+      }
+
       //! Instruct task to reserve all entity identifiers that it
       //! needs for normal execution.
       void
@@ -504,6 +513,16 @@ namespace DUNE
         m_recipient->runCallBacks();
       }
 
+      //! Signal an event whenever a message is queued for this task,
+      //! so that it can wait for messages and I/O handles at the same
+      //! time. The event is cleared by consumeMessages().
+      //! @param[in] event event or NULL to stop signalling.
+      void
+      setMessageEvent(IO::Event* event)
+      {
+        m_recipient->setEvent(event);
+      }
+
       //! Declare a configuration parameter that can be parsed using
       //! the basic parameter parser.
       //! @tparam T type of the destination variable.
@@ -595,6 +614,45 @@ namespace DUNE
           bind(list[i], new Consumer<T, M>(*task_obj, consumer));
       }
 
+      //! Bind a message to a batch consumer method. Consecutive
+      //! messages of this type waiting in the queue are delivered in
+      //! a single call.
+      //! @param task_obj consumer task.
+      //! @param consumer batch consumer method.
+      template <typename M, typename T>
+      void
+      bindBatch(T* task_obj, void (T::* consumer)(const M* const*, size_t) = &T::consumeBatch)
+      {
+        bind(M::getIdStatic(), new BatchConsumer<T, M>(*task_obj, consumer));
+      }
+
+      //! Bind multiple messages to a batch consumer method.
+      //! @param task_obj consumer object.
+      //! @param list list of message identifiers.
+      //! @param consumer batch consumer method.
+      template <typename T>
+      void
+      bindBatch(T* task_obj, const std::vector<uint32_t>& list,
+                void (T::* consumer)(const IMC::Message* const*, size_t) = &T::consumeBatch)
+      {
+        for (unsigned int i = 0; i < list.size(); ++i)
+          bind(list[i], new BatchConsumer<T, IMC::Message>(*task_obj, consumer));
+      }
+
+      //! Bind multiple messages to a batch consumer method.
+      //! @param task_obj consumer object.
+      //! @param list list of message abbreviations.
+      //! @param consumer batch consumer method.
+      template <typename T>
+      void
+      bindBatch(T* task_obj, const std::vector<std::string>& list,
+                void (T::* consumer)(const IMC::Message* const*, size_t) = &T::consumeBatch)
+      {
+        for (unsigned int i = 0; i < list.size(); ++i)
+          bind(IMC::Factory::getIdFromAbbrev(list[i]),
+               new BatchConsumer<T, IMC::Message>(*task_obj, consumer));
+      }
+
       //! Bind multiple messages to a default consumer method.
       //! @param task_obj consumer task.
       //! @param list list of message abbreviations.
@@ -768,6 +826,31 @@ namespace DUNE
       virtual void
       onMain(void) = 0;
 
+      //! Prepare normal execution: acquire and initialize resources
+      //! and request activation if the task is configured to.
+      void
+      startExecution(void);
+
+      //! Report a restart request.
+      //! @param[in] e restart request.
+      void
+      reportRestart(RestartNeeded& e);
+
+      //! Report an unexpected failure.
+      //! @param[in] e exception.
+      void
+      reportFailure(std::exception& e);
+
+      //! Update parameters before restarting after a restart request.
+      void
+      reloadParameters(void);
+
+      //! Report current entity states by dispatching EntityState
+      //! messages. This function will at least report the state of
+      //! the main entity.
+      void
+      reportEntityState(void);
+
     private:
       struct BasicArguments
       {
@@ -785,6 +868,10 @@ namespace DUNE
         std::string active_scope;
         //! Visibility of 'Active' parameter.
         std::string active_visibility;
+        //! Capacity of the bounded mailbox (0 for unbounded queue).
+        unsigned mailbox_capacity;
+        //! Overflow policy of the bounded mailbox.
+        std::string mailbox_policy;
       };
 
       //! Message recipient (queue).
@@ -808,12 +895,6 @@ namespace DUNE
       //! Name of parameter section editor.
       std::string m_param_editor;
 
-      //! Report current entity states by dispatching EntityState
-      //! messages. This function will at least report the state of
-      //! the main entity.
-      void
-      reportEntityState(void);
-
       void
       log(IMC::LogBookEntry::TypeEnum type, const char* format, std::va_list arg_list);
 
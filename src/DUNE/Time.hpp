@@ -42,6 +42,7 @@ namespace DUNE
 #include <DUNE/Time/BrokenDown.hpp>
 #include <DUNE/Time/Delay.hpp>
 #include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/Lockstep.hpp>
 #include <DUNE/Time/Utils.hpp>
 #include <DUNE/Time/Delta.hpp>
 #include <DUNE/Time/Counter.hpp>
@@ -36,6 +36,7 @@
 #include <DUNE/Config.hpp>
 #include <DUNE/Time/Constants.hpp>
 #include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/Lockstep.hpp>
 #include <DUNE/System/Error.hpp>
 
 // Platform headers.
@@ -62,6 +63,9 @@ namespace DUNE
     uint64_t
     Clock::getNsec(void)
     {
+      if (Lockstep::isEnabled())
+        return s_starttime_mono + Lockstep::getNsec();
+
       uint64_t time = getNsecRT();
       if (Clock::s_time_multiplier != 1.0) {
         double ellapsed_time = (time - s_starttime_mono);
@@ -97,6 +101,9 @@ namespace DUNE
     uint64_t
     Clock::getSinceEpochNsec(void)
     {
+      if (Lockstep::isEnabled())
+        return s_starttime_epoch + Lockstep::getNsec();
+
       uint64_t time = getSinceEpochNsecRT();
       if (Clock::s_time_multiplier != 1.0) {
         double ellapsed_time = (time - s_starttime_epoch);
@@ -108,6 +115,12 @@ namespace DUNE
     void
     Clock::set(double value)
     {
+      if (Lockstep::isEnabled())
+      {
+        s_starttime_epoch = value * c_nsec_per_sec - Lockstep::getNsec();
+        return;
+      }
+
       if (Clock::s_time_multiplier != 1.0) {
         s_starttime_epoch = value * c_nsec_per_sec;
         setTimeMultiplier(Clock::s_time_multiplier);
@@ -128,12 +141,25 @@ namespace DUNE
     void
     Clock::setTimeMultiplier(double mul)
     {
+      // Virtual time already runs as fast as possible.
+      if (Lockstep::isEnabled())
+        return;
+
       Clock::s_time_multiplier = 1.0;
       s_starttime_epoch = getSinceEpochNsecRT();
       s_starttime_mono = getNsecRT();
       Clock::s_time_multiplier = mul;
     }
 
+    void
+    Clock::setLockstep(void)
+    {
+      s_starttime_epoch = getSinceEpochNsecRT();
+      s_starttime_mono = getNsecRT();
+      s_time_multiplier = 1.0;
+      Lockstep::enable();
+    }
+
     double
     Clock::getTimeMultiplier(void)
     {
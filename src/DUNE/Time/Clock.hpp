@@ -127,6 +127,12 @@ namespace DUNE
       static void
       setTimeMultiplier(double mul);
 
+      //! Switch to a discrete-event simulation clock, where time only
+      //! advances when all tasks are waiting (see Lockstep). Must be
+      //! called before any task is started.
+      static void
+      setLockstep(void);
+
       //! Return configured time multipler
       //! @return simulation time multiplier (1.0 for real-time)
       static double
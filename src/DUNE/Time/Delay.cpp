@@ -32,6 +32,7 @@
 #include <DUNE/Time/Delay.hpp>
 #include <DUNE/Time/Constants.hpp>
 #include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/Lockstep.hpp>
 
 // Platform headers.
 #if defined(DUNE_SYS_HAS_TIME_H)
@@ -49,7 +50,18 @@ namespace DUNE
     void
     Delay::waitNsec(uint64_t nsec)
     {
+      if (Lockstep::isEnabled())
+      {
+        Lockstep::sleep(nsec);
+        return;
+      }
 
+      waitNsecRT(nsec);
+    }
+
+    void
+    Delay::waitNsecRT(uint64_t nsec)
+    {
       // Microsoft Windows.
 #if defined(DUNE_SYS_HAS_CREATE_WAITABLE_TIMER)
       HANDLE t = CreateWaitableTimer(0, TRUE, 0);
@@ -51,6 +51,13 @@ namespace DUNE
       static void
       waitNsec(uint64_t nsec);
 
+      //! Suspends the execution of the calling thread for the
+      //! specified amount of real time (in nanosecond), even if the
+      //! process runs on virtual time (see Lockstep).
+      //! @param nsec the amount of nanoseconds to suspend.
+      static void
+      waitNsecRT(uint64_t nsec);
+
       //! Suspends the execution of the calling thread for the
       //! specified amount of time (in microsecond).
       //! @param usec the amount of microseconds to suspend.
@@ -81,6 +88,17 @@ namespace DUNE
         nsecs /= Time::Clock::getTimeMultiplier();
         waitNsec(nsecs);
       }
+
+      //! Suspends the execution of the calling thread for the
+      //! specified amount of real time (in seconds), even if the
+      //! process runs on virtual time (see Lockstep).
+      //! @param s the amount of time to suspend.
+      static void
+      waitRT(double s)
+      {
+        uint64_t secs = (uint64_t)s;
+        waitNsecRT(secs * c_nsec_per_sec + (uint64_t)((s - secs) * c_nsec_per_sec_fp));
+      }
     };
   }
 }
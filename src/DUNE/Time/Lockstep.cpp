@@ -0,0 +1,360 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// ISO C++ 11 headers.
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+// DUNE headers.
+#include <DUNE/Time/Constants.hpp>
+#include <DUNE/Time/Lockstep.hpp>
+
+namespace DUNE
+{
+  namespace Time
+  {
+    //! Deadline of waits without timeout.
+    static const uint64_t c_forever = UINT64_MAX;
+
+    //! Waiting thread.
+    struct Waiter
+    {
+      //! Virtual time at which the wait expires.
+      uint64_t deadline;
+      //! True if the thread is a participant.
+      bool participant;
+      //! True once released.
+      bool woken;
+      //! Condition of the thread.
+      std::condition_variable cond;
+    };
+
+    //! Shared state of the clock.
+    struct State
+    {
+      State(void):
+        participants(0),
+        reserved(0),
+        idle(0)
+      {
+        now.store(0);
+      }
+
+      //! Lock of the state.
+      std::mutex mutex;
+      //! Current virtual time.
+      std::atomic<uint64_t> now;
+      //! Number of participants, including reserved slots.
+      unsigned participants;
+      //! Number of slots reserved and not yet bound.
+      unsigned reserved;
+      //! Number of participants waiting.
+      unsigned idle;
+      //! Waiting threads.
+      std::vector<Waiter*> waiters;
+    };
+
+    //! Clock state.
+    static State s_state;
+    //! True if the calling thread is a participant.
+    static thread_local bool t_bound = false;
+    //! Wake-up signal of the calling thread.
+    static thread_local Lockstep::Signal* t_signal = NULL;
+
+    bool Lockstep::s_enabled = false;
+
+    //! Release a waiting thread. Must be called with the state locked.
+    static void
+    release(Waiter* w)
+    {
+      std::vector<Waiter*>::iterator itr = std::find(s_state.waiters.begin(), s_state.waiters.end(), w);
+      if (itr != s_state.waiters.end())
+        s_state.waiters.erase(itr);
+
+      if (w->participant)
+        --s_state.idle;
+
+      w->woken = true;
+      w->cond.notify_one();
+    }
+
+    //! Move virtual time to the next deadline while all participants
+    //! are waiting. Must be called with the state locked.
+    static void
+    advance(void)
+    {
+      while (s_state.idle == s_state.participants && !s_state.waiters.empty())
+      {
+        uint64_t next = c_forever;
+        for (size_t i = 0; i < s_state.waiters.size(); ++i)
+        {
+          if (s_state.waiters[i]->deadline < next)
+            next = s_state.waiters[i]->deadline;
+        }
+
+        // Nothing but external events can wake the participants.
+        if (next == c_forever)
+          return;
+
+        if (next > s_state.now.load())
+          s_state.now.store(next);
+
+        // Release in order of registration to keep runs repeatable.
+        std::vector<Waiter*> expired;
+        for (size_t i = 0; i < s_state.waiters.size(); ++i)
+        {
+          if (s_state.waiters[i]->deadline <= next)
+            expired.push_back(s_state.waiters[i]);
+        }
+
+        for (size_t i = 0; i < expired.size(); ++i)
+          release(expired[i]);
+      }
+    }
+
+    //! Block the calling thread until released. Must be called with
+    //! the state locked.
+    static void
+    block(std::unique_lock<std::mutex>& lock, Waiter& w)
+    {
+      w.participant = t_bound;
+      w.woken = false;
+      s_state.waiters.push_back(&w);
+      if (w.participant)
+        ++s_state.idle;
+
+      advance();
+
+      while (!w.woken)
+        w.cond.wait(lock);
+    }
+
+    void
+    Lockstep::enable(void)
+    {
+      s_enabled = true;
+    }
+
+    uint64_t
+    Lockstep::getNsec(void)
+    {
+      return s_state.now.load();
+    }
+
+    void
+    Lockstep::attach(void)
+    {
+      if (!s_enabled)
+        return;
+
+      std::lock_guard<std::mutex> l(s_state.mutex);
+      ++s_state.participants;
+      ++s_state.reserved;
+    }
+
+    void
+    Lockstep::cancel(void)
+    {
+      if (!s_enabled)
+        return;
+
+      std::lock_guard<std::mutex> l(s_state.mutex);
+      if (s_state.reserved == 0)
+        return;
+
+      --s_state.reserved;
+      --s_state.participants;
+      advance();
+    }
+
+    void
+    Lockstep::bind(Signal* signal)
+    {
+      if (!s_enabled || t_bound)
+        return;
+
+      std::lock_guard<std::mutex> l(s_state.mutex);
+      t_bound = true;
+      t_signal = signal;
+      if (s_state.reserved > 0)
+        --s_state.reserved;
+      else
+        ++s_state.participants;
+    }
+
+    void
+    Lockstep::detach(void)
+    {
+      if (!t_bound)
+        return;
+
+      std::lock_guard<std::mutex> l(s_state.mutex);
+      t_bound = false;
+      t_signal = NULL;
+      --s_state.participants;
+      advance();
+    }
+
+    bool
+    Lockstep::isParticipant(void)
+    {
+      return t_bound;
+    }
+
+    void
+    Lockstep::sleep(uint64_t nsec)
+    {
+      std::unique_lock<std::mutex> l(s_state.mutex);
+      Waiter w;
+      w.deadline = s_state.now.load() + nsec;
+      block(l, w);
+    }
+
+    bool
+    Lockstep::wait(Signal& signal, double timeout)
+    {
+      std::unique_lock<std::mutex> l(s_state.mutex);
+
+      if (!signal.m_pending)
+      {
+        Waiter w;
+        w.deadline = c_forever;
+        if (timeout > 0)
+          w.deadline = s_state.now.load() + (uint64_t)(timeout * c_nsec_per_sec_fp);
+        signal.m_waiter = &w;
+        block(l, w);
+        signal.m_waiter = NULL;
+      }
+
+      bool pending = signal.m_pending;
+      signal.m_pending = false;
+      return pending;
+    }
+
+    void
+    Lockstep::clear(Signal& signal)
+    {
+      std::lock_guard<std::mutex> l(s_state.mutex);
+      signal.m_pending = false;
+    }
+
+    void
+    Lockstep::notify(Signal& signal)
+    {
+      std::lock_guard<std::mutex> l(s_state.mutex);
+      signal.m_pending = true;
+
+      Waiter* w = static_cast<Waiter*>(signal.m_waiter);
+      if (w != NULL && !w->woken)
+        release(w);
+    }
+
+    Lockstep::Idle::Idle(double timeout, bool wake):
+      m_waiter(NULL),
+      m_signal(NULL),
+      m_done(false)
+    {
+      if (!t_bound)
+        return;
+
+      if (timeout == 0)
+      {
+        m_done = true;
+        return;
+      }
+
+      std::lock_guard<std::mutex> l(s_state.mutex);
+
+      if (wake && t_signal != NULL)
+      {
+        // Events queued while running must be handled first.
+        if (t_signal->m_pending)
+        {
+          t_signal->m_pending = false;
+          m_done = true;
+          return;
+        }
+
+        m_signal = t_signal;
+      }
+
+      Waiter* w = new Waiter;
+      w->deadline = c_forever;
+      if (timeout > 0)
+        w->deadline = s_state.now.load() + (uint64_t)(timeout * c_nsec_per_sec_fp);
+      w->participant = true;
+      w->woken = false;
+      s_state.waiters.push_back(w);
+      ++s_state.idle;
+
+      if (m_signal != NULL)
+        m_signal->m_waiter = w;
+
+      m_waiter = w;
+      advance();
+    }
+
+    Lockstep::Idle::~Idle(void)
+    {
+      if (m_waiter == NULL)
+        return;
+
+      Waiter* w = static_cast<Waiter*>(m_waiter);
+
+      std::lock_guard<std::mutex> l(s_state.mutex);
+      if (!w->woken)
+      {
+        std::vector<Waiter*>::iterator itr = std::find(s_state.waiters.begin(), s_state.waiters.end(), w);
+        if (itr != s_state.waiters.end())
+          s_state.waiters.erase(itr);
+
+        --s_state.idle;
+      }
+
+      if (m_signal != NULL && m_signal->m_waiter == w)
+        m_signal->m_waiter = NULL;
+
+      delete w;
+    }
+
+    bool
+    Lockstep::Idle::done(void) const
+    {
+      if (m_waiter == NULL)
+        return m_done;
+
+      std::lock_guard<std::mutex> l(s_state.mutex);
+      return static_cast<Waiter*>(m_waiter)->woken;
+    }
+  }
+}
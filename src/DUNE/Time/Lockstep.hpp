@@ -0,0 +1,213 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_TIME_LOCKSTEP_HPP_INCLUDED_
+#define DUNE_TIME_LOCKSTEP_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Time
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Lockstep;
+
+    //! Discrete-event simulation clock.
+    //!
+    //! When enabled, Clock reports virtual time that only moves when
+    //! every participant thread is waiting. Participants are the
+    //! threads bound with bind(), normally the task threads; while
+    //! one of them is running, time stands still. Once all of them
+    //! are waiting, virtual time jumps to the earliest pending
+    //! deadline and the threads waiting for it are released. A
+    //! simulation therefore runs as fast as its tasks can process
+    //! events and the timing of those events does not depend on the
+    //! load of the host.
+    //!
+    //! Threads that are not participants can still wait on virtual
+    //! time, but the clock does not wait for them.
+    //!
+    //! Participants that block outside the clock (on I/O or condition
+    //! variables) do so inside an Idle scope, which counts them as
+    //! waiting until a virtual deadline. Wake-ups from outside the
+    //! clock (e.g., data arriving on a socket) are not ordered with
+    //! it: the clock may move before the woken participant resumes.
+    class Lockstep
+    {
+    public:
+      //! Wake-up token of a thread waiting for an external event
+      //! (e.g., a message) or a timeout.
+      class Signal
+      {
+      public:
+        Signal(void):
+          m_pending(false),
+          m_waiter(0)
+        { }
+
+      private:
+        friend class Lockstep;
+        //! True if notified since the last wait.
+        bool m_pending;
+        //! Waiting thread, if any.
+        void* m_waiter;
+      };
+
+      //! Scope in which a participant blocks outside the clock. The
+      //! participant counts as waiting until the timeout expires in
+      //! virtual time, its wake-up signal (see bind()) is notified,
+      //! or the scope ends. The blocking call must be split in
+      //! periods of getPeriod() real seconds, testing done() between
+      //! them. Only participants (see isParticipant()) may use it.
+      class Idle
+      {
+      public:
+        //! Start waiting.
+        //! @param[in] timeout amount of virtual time to wait (in
+        //! seconds), zero to not wait, negative to wait forever.
+        //! @param[in] wake true to stop waiting when the wake-up
+        //! signal of the thread is notified.
+        Idle(double timeout, bool wake = true);
+
+        //! Stop waiting. The participant counts as running again.
+        ~Idle(void);
+
+        //! Test if the participant must stop blocking.
+        //! @return true if the timeout expired or the wake-up signal
+        //! was notified, false otherwise.
+        bool
+        done(void) const;
+
+        //! Get the amount of real time to block between calls to
+        //! done().
+        //! @return time in seconds.
+        static double
+        getPeriod(void)
+        {
+          return 0.01;
+        }
+
+      private:
+        //! Registered wait, if any.
+        void* m_waiter;
+        //! Wake-up signal of the thread, if used.
+        Signal* m_signal;
+        //! True if the scope ended before waiting.
+        bool m_done;
+
+        //! Non-copyable.
+        Idle(const Idle&);
+
+        //! Non-assignable.
+        Idle&
+        operator=(const Idle&);
+      };
+
+      //! Switch the process to virtual time. This must be called
+      //! before any participant thread is started and cannot be
+      //! undone.
+      static void
+      enable(void);
+
+      //! Test if virtual time is in use.
+      //! @return true if enabled, false otherwise.
+      static bool
+      isEnabled(void)
+      {
+        return s_enabled;
+      }
+
+      //! Get the amount of virtual time elapsed since enable().
+      //! @return time in nanoseconds.
+      static uint64_t
+      getNsec(void);
+
+      //! Reserve a participant slot for a thread that is about to
+      //! be started. The clock counts the thread as running until
+      //! it calls bind() and then waits or detaches. Participant
+      //! management has no effect while virtual time is disabled.
+      static void
+      attach(void);
+
+      //! Cancel a slot reserved with attach() for a thread that
+      //! failed to start.
+      static void
+      cancel(void);
+
+      //! Make the calling thread a participant, using a slot
+      //! reserved with attach() when available.
+      //! @param[in] signal wake-up signal notified when events are
+      //! queued for the thread (e.g., messages), if any. It ends the
+      //! Idle scopes of the thread and must outlive the binding.
+      static void
+      bind(Signal* signal = NULL);
+
+      //! Test if the calling thread is a participant.
+      //! @return true if the thread is a participant, false otherwise.
+      static bool
+      isParticipant(void);
+
+      //! Remove the calling thread from the participants.
+      static void
+      detach(void);
+
+      //! Suspend the calling thread for an amount of virtual time.
+      //! @param[in] nsec amount of nanoseconds to suspend.
+      static void
+      sleep(uint64_t nsec);
+
+      //! Suspend the calling thread until the signal is notified or
+      //! the timeout expires.
+      //! @param[in] signal wake-up token.
+      //! @param[in] timeout amount of virtual time to wait (in
+      //! seconds), zero or negative to wait forever.
+      //! @return true if the signal was notified, false on timeout.
+      static bool
+      wait(Signal& signal, double timeout);
+
+      //! Discard a pending notification of a signal.
+      //! @param[in] signal wake-up token.
+      static void
+      clear(Signal& signal);
+
+      //! Notify a signal, waking the thread waiting on it. The woken
+      //! thread counts as running from this moment, so virtual time
+      //! cannot move before it handles the event.
+      //! @param[in] signal wake-up token.
+      static void
+      notify(Signal& signal);
+
+    private:
+      //! True if virtual time is in use.
+      static bool s_enabled;
+    };
+  }
+}
+
+#endif
@@ -41,6 +41,7 @@
 // DUNE headers.
 #include <DUNE/Time/Constants.hpp>
 #include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/Lockstep.hpp>
 
 namespace DUNE
 {
@@ -51,7 +52,8 @@ namespace DUNE
     public:
       PeriodicDelay(uint32_t delay_usec = 0):
         m_deadline(0),
-        m_delay(0)
+        m_delay(0),
+        m_delay_nsec(0)
       {
         set(delay_usec);
       }
@@ -61,6 +63,7 @@ namespace DUNE
       {
 
         delay_usec = (uint32_t) (delay_usec / Clock::getTimeMultiplier());
+        m_delay_nsec = (uint64_t)delay_usec * 1000;
 
         // Microsoft Windows.
 #if defined(DUNE_SYS_HAS_GET_SYSTEM_TIME_AS_FILE_TIME)
@@ -80,6 +83,12 @@ namespace DUNE
       void
       reset(void)
       {
+        if (Lockstep::isEnabled())
+        {
+          m_deadline = Clock::getNsec() + m_delay_nsec;
+          return;
+        }
+
         // Microsoft Windows.
 #if defined(DUNE_SYS_HAS_GET_SYSTEM_TIME_AS_FILE_TIME)
         FILETIME ft;
@@ -105,6 +114,15 @@ namespace DUNE
       void
       wait(void)
       {
+        if (Lockstep::isEnabled())
+        {
+          uint64_t now = Clock::getNsec();
+          if (now < m_deadline)
+            Lockstep::sleep(m_deadline - now);
+          m_deadline += m_delay_nsec;
+          return;
+        }
+
         // Microsoft Windows.
 #if defined(DUNE_SYS_HAS_CREATE_WAITABLE_TIMER)
         HANDLE th = CreateWaitableTimer(0, TRUE, 0);
@@ -139,6 +157,8 @@ namespace DUNE
     private:
       uint64_t m_deadline;
       uint64_t m_delay;
+      //! Delay in nanoseconds, used with virtual time.
+      uint64_t m_delay_nsec;
     };
   }
 }
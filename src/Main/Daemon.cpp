@@ -167,6 +167,7 @@ runDaemon(DUNE::Daemon& daemon)
 
   try
   {
+    Time::Lockstep::attach();
     daemon.start();
 
     while (!s_stop)
@@ -177,7 +178,8 @@ runDaemon(DUNE::Daemon& daemon)
         break;
       }
 
-      Delay::wait(1.0);
+      // Keep handling signals if virtual time stands still.
+      Delay::waitRT(1.0);
     }
 
     DUNE_WRN("Daemon", DTR("stopping tasks"));
@@ -238,7 +240,9 @@ main(int argc, char** argv)
   .add("-V", "--vehicle",
        "Vehicle name override", "VEHICLE")
   .add("-X", "--dump-params-xml",
-       "Dump parameters XML to folder DIR", "DIR");
+       "Dump parameters XML to folder DIR", "DIR")
+  .add("-L", "--lockstep",
+       "Run on a discrete-event simulation clock");
 
   // Parse command line arguments.
   if (!options.parse(argc, argv))
@@ -259,6 +263,10 @@ main(int argc, char** argv)
 #endif
   }
 
+  // If requested, advance time only when all tasks are idle.
+  if (!options.value("--lockstep").empty())
+    Clock::setLockstep();
+
   // If requested, set alternate configuration directory.
   if (options.value("--config-dir") != "")
   {
@@ -31,6 +31,8 @@
 #include <cstring>
 #include <string>
 #include <cmath>
+#include <limits>
+#include <set>
 #include <vector>
 
 // DUNE headers.
@@ -324,6 +326,23 @@ namespace Maneuver
         std::vector<std::string> m_formation_systems;
         unsigned int m_formation_frame;
         Matrix m_formation_pos;
+        //! Largest horizontal distance between formation positions
+        double m_formation_span;
+        //! Index of the team vehicles horizontal positions
+        Math::NeighborGrid m_neighbors;
+        //! Indexed horizontal speed of each team vehicle (NaN if not indexed)
+        std::vector<double> m_neighbor_speed;
+        //! Indexed horizontal speeds of the team vehicles
+        std::multiset<double> m_neighbor_speeds;
+        //! Team vehicles near the one being controlled
+        std::vector<unsigned> m_neighbor_ids;
+        //! Formation control sliding surface, virtual error, and control
+        //! weights of each vehicle (only the leader and neighbor entries
+        //! are set, and they are cleared after each control computation)
+        Matrix m_surf_uav;
+        Matrix m_virt_err_uav;
+        Matrix m_weight_gain;
+        Matrix m_ctrl_weight;
         IMC::PlanControl m_current_plan;
 
         //! Process logic control variables
@@ -414,6 +433,8 @@ namespace Maneuver
           m_uav_ind(0),
           m_formation_frame(IMC::Formation::OP_EARTH_FIXED),
           m_formation_pos(3, 1, 0.0),
+          m_formation_span(0.0),
+          m_neighbors(100.0),
           m_ctrl_active(false),
           m_team_plan_init(false),
           m_team_leader_init(false),
@@ -651,6 +672,7 @@ namespace Maneuver
             m_uav_n = 1;
             m_uav_ind = 0;
             m_formation_pos = Matrix(3, 1, 0.0);
+            m_formation_span = 0.0;
           }
 
           //==========================================
@@ -836,6 +858,8 @@ namespace Maneuver
             for (unsigned int ind_uav2 = 0; ind_uav2 < t_uav_n; ++ind_uav2)
               if (!t_keep_data[ind_uav2])
                 delete t_models[ind_uav2];
+
+            resetNeighbors();
           }
 
           //==========================================
@@ -1157,6 +1181,7 @@ namespace Maneuver
                 m_formation_pos(2, uav_ind) = (*it)->off_z;
                 m_uav_n = ++uav_ind;
               }
+              updateFormationSpan();
               m_leader_bank_lim = msg->leader_bank_lim;
               m_leader_speed_min = msg->leader_speed_min;
               m_leader_speed_max = msg->leader_speed_max;
@@ -1172,6 +1197,7 @@ namespace Maneuver
                 m_uav_n = 1;
                 m_uav_ind = 0;
                 m_formation_pos = Matrix(3, 1, 0.0);
+                m_formation_span = 0.0;
               }
               bool is_in_formation = false;
               for (uav_ind = 0; uav_ind < m_uav_n; uav_ind++)
@@ -1221,6 +1247,7 @@ namespace Maneuver
                 m_uav_n = 1;
                 m_uav_ind = 0;
                 m_formation_pos = Matrix(3, 1, 0.0);
+                m_formation_span = 0.0;
 
                 if (isActive())
                 {
@@ -1567,6 +1594,7 @@ namespace Maneuver
                 msg->phi, msg->theta, msg->psi,
                 msg->p,   msg->q,     msg->r};
             m_vehicle_state.set(0, 11, m_uav_ind+1, m_uav_ind+1, Matrix(vt_uav_state, 12, 1));
+            updateNeighbor(m_uav_ind);
             // ToDo - Check the difference between the vehicle real and simulated state
 
             //! - Update own vehicle simulation model
@@ -1819,6 +1847,7 @@ namespace Maneuver
                 msg->lat, msg->lon, msg->height, &vt_uav_state[0], &vt_uav_state[1], &vt_uav_state[2]);
             // Update vehicle state vector
             m_vehicle_state.set(0, 11, ind_uav+1, ind_uav+1, Matrix(vt_uav_state, 12, 1));
+            updateNeighbor(ind_uav);
             // Set airspeed command starting point
             if (!m_vehicle_state_flag[ind_uav] || !isActive())
             {
@@ -2048,7 +2077,8 @@ namespace Maneuver
           // UAV velocity components, on ground frame
           Matrix vd_gnd_vel = m_velocity.get(0, 2, 0, 0);
           //! UAV velocity rotation to the body frame
-          Matrix vd_body_vel = transpose(md_rot_body2gnd) * vd_gnd_vel;
+          Matrix vd_body_vel;
+          Matrix::gemm(1.0, md_rot_body2gnd, true, vd_gnd_vel, false, 0.0, vd_body_vel);
 
           //! Fill position.
           m_estate_leader.x = m_position(0);
@@ -2429,6 +2459,7 @@ namespace Maneuver
                               vertCat(vd_vel.get(0, 2, 0, 0).
                                       vertCat(vd_pos.get(3, 5, 0, 0).
                                               vertCat(vd_vel.get(3, 5, 0, 0)))));
+              updateNeighbor(ind_uav);
               //spew("Assynchronous update 2.3");
               if (ind_uav != m_uav_ind)
               {
@@ -2446,6 +2477,115 @@ namespace Maneuver
           spew("Assynchronous update - End");
         }
 
+        //! Update the largest horizontal distance between formation positions
+        void
+        updateFormationSpan(void)
+        {
+          m_formation_span = 0.0;
+          for (unsigned int ind_uav = 0; ind_uav < m_uav_n; ++ind_uav)
+          {
+            for (unsigned int ind_uav2 = ind_uav + 1; ind_uav2 < m_uav_n; ++ind_uav2)
+            {
+              double d_dx = m_formation_pos(0, ind_uav) - m_formation_pos(0, ind_uav2);
+              double d_dy = m_formation_pos(1, ind_uav) - m_formation_pos(1, ind_uav2);
+              m_formation_span = std::max(m_formation_span, std::sqrt(d_dx*d_dx + d_dy*d_dy));
+            }
+          }
+        }
+
+        //! Rebuild the index of the team vehicles states
+        void
+        resetNeighbors(void)
+        {
+          m_neighbors.clear();
+          m_neighbor_speeds.clear();
+          m_neighbor_speed.assign(m_uav_n, std::numeric_limits<double>::quiet_NaN());
+
+          for (unsigned int ind_uav = 0; ind_uav < m_uav_n; ++ind_uav)
+            updateNeighbor(ind_uav);
+        }
+
+        //! Move a team vehicle in the index after its state has changed.
+        //! Only vehicles changing grid cell are moved in the grid, and
+        //! vehicles without a valid horizontal state are left out
+        void
+        updateNeighbor(unsigned int ind_uav)
+        {
+          if (ind_uav >= m_neighbor_speed.size() || (int)ind_uav+1 >= m_vehicle_state.columns())
+            return;
+
+          double& d_speed = m_neighbor_speed[ind_uav];
+          if (!Math::isNaN(d_speed))
+            m_neighbor_speeds.erase(m_neighbor_speeds.find(d_speed));
+
+          double d_x = m_vehicle_state(0, ind_uav+1);
+          double d_y = m_vehicle_state(1, ind_uav+1);
+          d_speed = std::sqrt(m_vehicle_state(3, ind_uav+1)*m_vehicle_state(3, ind_uav+1) +
+              m_vehicle_state(4, ind_uav+1)*m_vehicle_state(4, ind_uav+1));
+
+          if (Math::isNaN(d_x) || Math::isNaN(d_y) || Math::isNaN(d_speed))
+          {
+            d_speed = std::numeric_limits<double>::quiet_NaN();
+            m_neighbors.remove(ind_uav);
+            return;
+          }
+
+          m_neighbor_speeds.insert(d_speed);
+          m_neighbors.update(ind_uav, d_x, d_y);
+        }
+
+        //! Select the team vehicles that may influence the control of "ind_uav".
+        //! A vehicle whose predicted distance can neither reach the deconfliction
+        //! distance nor fall within "d_long_dist" times the formation span gets a
+        //! null control weight, so it is left out of the formation sweep.
+        //! Predicted distances are bounded by braking at the lowest acceleration
+        //! limit from the highest speed in the team. The index follows the team
+        //! states in "m_vehicle_state", which "md_uav_state" refers to.
+        void
+        selectNeighbors(const Matrix& md_uav_state, const unsigned int& ind_uav,
+            double d_deconfliction_dist, double d_long_dist, bool b_prune)
+        {
+          m_neighbor_ids.clear();
+
+          double d_accel_min = std::min(m_accel_lim_x, m_g * std::tan(m_bank_lim*0.75));
+
+          //! Vehicles without a valid state cannot be located in the grid
+          if (d_accel_min <= 0 || m_uav_n < 3 || m_neighbor_speed.size() != m_uav_n ||
+              m_neighbors.size() != m_uav_n)
+            b_prune = false;
+
+          double d_speed_max = m_neighbor_speeds.empty() ? 0 : *m_neighbor_speeds.rbegin();
+          double d_range = std::max(d_deconfliction_dist, m_formation_span*d_long_dist) +
+              4 * d_speed_max*d_speed_max*(1+m_acc_safety_marg)/d_accel_min;
+
+          if (!b_prune || Math::isNaN(d_range))
+          {
+            for (unsigned int ind_uav2 = 0; ind_uav2 < m_uav_n; ++ind_uav2)
+              m_neighbor_ids.push_back(ind_uav2);
+            return;
+          }
+
+          //! Keep the grid cells close to the search range
+          if (d_range > 2 * m_neighbors.getCellSize() || d_range < 0.5 * m_neighbors.getCellSize())
+            m_neighbors.setCellSize(d_range);
+
+          m_neighbors.query(md_uav_state(0, ind_uav+1), md_uav_state(1, ind_uav+1),
+              d_range, m_neighbor_ids);
+        }
+
+        //! Clear the formation control entries of a vehicle
+        //! (0 is the leader, "ind_uav"+1 a team vehicle)
+        void
+        clearControlEntries(unsigned int ind_entry)
+        {
+          m_surf_uav(0, ind_entry) = 0;
+          m_surf_uav(1, ind_entry) = 0;
+          m_virt_err_uav(0, ind_entry) = 0;
+          m_virt_err_uav(1, ind_entry) = 0;
+          m_weight_gain(ind_entry) = 0;
+          m_ctrl_weight(ind_entry) = 0;
+        }
+
         void
         formationControl(const Matrix& md_uav_state, const Matrix& md_vehicle_accel,
             const unsigned int& ind_uav, const double& d_time_step, Matrix* vd_cmd,
@@ -2545,9 +2685,16 @@ namespace Maneuver
           double d_inter_uav_angle_dot;
           Matrix vt_surf_deriv =  Matrix(2, 1, 0.0);
 
-          Matrix vd_surf_uav = Matrix(2, m_uav_n+1, 0.0);
-          Matrix vt_virt_err_uav = Matrix(2, m_uav_n+1, 0.0);
-          Matrix vd_weight_gain = Matrix(m_uav_n+1, 1, 0.0);
+          if (m_weight_gain.rows() != (int)m_uav_n+1)
+          {
+            m_surf_uav = Matrix(2, m_uav_n+1, 0.0);
+            m_virt_err_uav = Matrix(2, m_uav_n+1, 0.0);
+            m_weight_gain = Matrix(m_uav_n+1, 1, 0.0);
+            m_ctrl_weight = Matrix(m_uav_n+1, 1, 0.0);
+          }
+          Matrix& vd_surf_uav = m_surf_uav;
+          Matrix& vt_virt_err_uav = m_virt_err_uav;
+          Matrix& vd_weight_gain = m_weight_gain;
 
           //double d_time = Clock::get();
 
@@ -2647,10 +2794,18 @@ namespace Maneuver
           //! Formation UAV sweep
           //-------------------------------------------
 
+          //! The formation span does not bound the desired distances of a
+          //! curved formation shape, and the monitoring output covers every UAV
+          selectNeighbors(md_uav_state, ind_uav, d_deconfliction_dist, k_long_dist2,
+              !b_debug && !(m_formation_frame == IMC::Formation::OP_PATH_CURVED &&
+              md_uav_state(6, 0) != 0));
+
           // ToDo - check - verificar inclusão do líder como elemento 0 dos vectores e matrizes
           // da formação, em vez de elemento m_uav_n em apenas algumas
-          for (unsigned int ind_uav2 = 0; ind_uav2 < m_uav_n; ind_uav2++)
+          for (unsigned int ind_nb = 0; ind_nb < m_neighbor_ids.size(); ind_nb++)
           {
+            unsigned int ind_uav2 = m_neighbor_ids[ind_nb];
+
             // Skipping the current UAV index
             if (ind_uav == ind_uav2)
               continue;
@@ -3165,11 +3320,22 @@ namespace Maneuver
           //!-------------------------------------------
 
           //! UAV weight on control strategy
-          Matrix vd_ctrl_weight = Matrix(m_uav_n+1, 1, 1.0);
-          vd_ctrl_weight(0) = k_form_ref;
-          vd_ctrl_weight(ind_uav+1) = 0;
-          vd_ctrl_weight &= vd_weight_gain;
-          vd_ctrl_weight /= sum(vd_ctrl_weight);
+          //! Vehicles outside the neighbor set have a null weight
+          Matrix& vd_ctrl_weight = m_ctrl_weight;
+          vd_ctrl_weight(0) = k_form_ref*vd_weight_gain(0);
+          double d_ctrl_weight_sum = vd_ctrl_weight(0);
+          for (unsigned int ind_nb = 0; ind_nb < m_neighbor_ids.size(); ind_nb++)
+          {
+            unsigned int ind_uav2 = m_neighbor_ids[ind_nb];
+            if (ind_uav != ind_uav2)
+            {
+              vd_ctrl_weight(ind_uav2+1) = vd_weight_gain(ind_uav2+1);
+              d_ctrl_weight_sum += vd_ctrl_weight(ind_uav2+1);
+            }
+          }
+          vd_ctrl_weight(0) /= d_ctrl_weight_sum;
+          for (unsigned int ind_nb = 0; ind_nb < m_neighbor_ids.size(); ind_nb++)
+            vd_ctrl_weight(m_neighbor_ids[ind_nb]+1) /= d_ctrl_weight_sum;
 
           //! Tracking output
           if (b_debug)
@@ -3183,8 +3349,14 @@ namespace Maneuver
           }
 
           //! Sliding surface data mixing
-          Matrix vd_surf = vd_surf_uav * vd_ctrl_weight;
-          Matrix vt_virt_err = vt_virt_err_uav * vd_ctrl_weight;
+          Matrix vd_surf = vd_surf_uav.get(0, 1, 0, 0) * vd_ctrl_weight(0);
+          Matrix vt_virt_err = vt_virt_err_uav.get(0, 1, 0, 0) * vd_ctrl_weight(0);
+          for (unsigned int ind_nb = 0; ind_nb < m_neighbor_ids.size(); ind_nb++)
+          {
+            unsigned int ind_uav2 = m_neighbor_ids[ind_nb];
+            vd_surf += vd_surf_uav.get(0, 1, ind_uav2+1, ind_uav2+1) * vd_ctrl_weight(ind_uav2+1);
+            vt_virt_err += vt_virt_err_uav.get(0, 1, ind_uav2+1, ind_uav2+1) * vd_ctrl_weight(ind_uav2+1);
+          }
 
           /*
           // Debug
@@ -3213,7 +3385,8 @@ namespace Maneuver
           }
           else
             vd_sat_surf = vd_surf/d_ss_bnd_layer;
-          Matrix vd_surf_conv = transpose(md_rot_ground2yaw)*md_gain_mtx*md_rot_ground2yaw * vd_sat_surf;
+          Matrix vd_surf_conv;
+          Matrix::gemm(1.0, md_rot_ground2yaw, true, md_gain_mtx * md_rot_ground2yaw * vd_sat_surf, false, 0.0, vd_surf_conv);
 
           //!-------------------------------------------
           //! Sliding surface unknown disturbance term
@@ -3228,8 +3401,10 @@ namespace Maneuver
 
           //! UAVs Uncertainty compensation
           double t_SurfSqr;
-          for (unsigned int ind_uav2 = 0; ind_uav2 < m_uav_n; ind_uav2++)
+          for (unsigned int ind_nb = 0; ind_nb < m_neighbor_ids.size(); ind_nb++)
           {
+            unsigned int ind_uav2 = m_neighbor_ids[ind_nb];
+
             // Skipping the current UAV index
             if (ind_uav == ind_uav2)
               continue;
@@ -3244,6 +3419,12 @@ namespace Maneuver
           t_SurfSqr = vd_surf_uav(0, 0)*vd_surf_uav(0, 0) + vd_surf_uav(1, 0)*vd_surf_uav(1, 0);
           if (t_SurfSqr)
             vd_surf_unit += k_form_ref*vd_surf_uav.get(0, 1, 0, 0)*vd_ctrl_weight(0)/std::sqrt(t_SurfSqr);
+
+          //! Clear the entries used by this computation
+          clearControlEntries(0);
+          for (unsigned int ind_nb = 0; ind_nb < m_neighbor_ids.size(); ind_nb++)
+            clearControlEntries(m_neighbor_ids[ind_nb]+1);
+
           //! Formation - Uncertainty compensation
           Matrix vd_surf_unkn = vd_surf_unit*m_flow_accel_max/(m_uav_n-1+k_form_ref);
           /*
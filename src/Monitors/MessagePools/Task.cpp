@@ -0,0 +1,106 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Monitors
+{
+  //! This task periodically reports the usage of the IMC message
+  //! object pools (see IMC::Factory) as an EntityParameters message,
+  //! with one parameter per message type.
+  namespace MessagePools
+  {
+    using DUNE_NAMESPACES;
+
+    //! %Task arguments.
+    struct Arguments
+    {
+      //! Maximum number of idle objects per message type.
+      unsigned capacity;
+      //! Maximum payload size of pooled objects.
+      unsigned max_size;
+    };
+
+    struct Task: public DUNE::Tasks::Periodic
+    {
+      //! Pool statistics.
+      std::vector<IMC::Factory::PoolStatistics> m_stats;
+      //! Task arguments.
+      Arguments m_args;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        Tasks::Periodic(name, ctx)
+      {
+        param("Pool Capacity", m_args.capacity)
+        .defaultValue("64")
+        .description("Maximum number of idle objects kept per message type, zero disables pooling");
+
+        param("Maximum Object Size", m_args.max_size)
+        .defaultValue("65535")
+        .units(Units::Byte)
+        .description("Objects with larger payloads are deleted instead of pooled");
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        IMC::Factory::setPoolCapacity(m_args.capacity);
+        IMC::Factory::setPoolMaximumSize(m_args.max_size);
+      }
+
+      void
+      task(void)
+      {
+        m_stats.clear();
+        IMC::Factory::getPoolStatistics(m_stats);
+
+        IMC::EntityParameters eps;
+        eps.name = getEntityLabel();
+
+        for (size_t i = 0; i < m_stats.size(); ++i)
+        {
+          const IMC::Factory::PoolStatistics& s = m_stats[i];
+
+          IMC::EntityParameter ep;
+          ep.name = IMC::Factory::getAbbrevFromId(s.id);
+          ep.value = String::str("requests=%lu hit rate=%0.1f%% recycled=%lu high water=%lu",
+                                 s.requests, 100.0 * s.hits / s.requests,
+                                 s.recycled, s.high_water);
+          eps.params.push_back(ep);
+        }
+
+        dispatch(eps);
+      }
+    };
+  }
+}
+
+DUNE_TASK
@@ -31,7 +31,6 @@
 #include <cstring>
 #include <algorithm>
 #include <cstddef>
-#include <sstream>
 #include <string>
 #include <vector>
 
@@ -53,10 +52,10 @@ namespace Sensors
 
     //! Read buffer size.
     static const size_t c_read_buffer_size = 82;
-    //! NMEA 5 body index.
-    static const size_t c_nmea5_body_index = 15;
-    //! NMEA 5 trailing chunk in first fragment.
-    static const size_t c_nmea5_trail = 5;
+    //! Minimum number of fields of VDM/VDO sentences.
+    static const size_t c_vdm_fields = 7;
+    //! Maximum payload size of a multi-fragment message.
+    static const size_t c_max_payload = 512;
     //! Line termination character.
     static const char c_line_term = '\n';
 
@@ -77,16 +76,19 @@ namespace Sensors
       Arguments m_args;
       //! Current line.
       std::string m_line;
-      //! Saved first part of NMEA 5 class message.
-      std::string m_nmea5_fg;
-      //! Waiting fragment.
-      bool m_nmea5_wait_fg;
+      //! Current sentence.
+      NMEATokenizer m_stn;
+      //! Payload of the current message, joined from its fragments.
+      std::string m_payload;
+      //! Number of the last fragment added to the payload.
+      unsigned m_fragment;
       //! Vehicle Type.
       std::map<int, std::string> m_systems;
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Task(name, ctx),
-        m_handle(NULL)
+        m_handle(NULL),
+        m_fragment(0)
       {
         // Define configuration parameters.
         param("Serial Port - Device", m_args.uart_dev)
@@ -97,7 +99,7 @@ namespace Sensors
         .defaultValue("38400")
         .description("Serial port baud rate");
 
-        m_nmea5_wait_fg = false;
+        m_payload.reserve(c_max_payload);
       }
 
       void
@@ -141,42 +143,64 @@ namespace Sensors
       }
 
       //! Process AIS NMEA message.
+      //! @param[in] nmea_msg sentence.
       void
-      process(std::string nmea_msg)
+      process(const std::string& nmea_msg)
       {
-        // Remove carriage return.
-        nmea_msg.erase(std::remove(nmea_msg.begin(), nmea_msg.end(), '\r'), nmea_msg.end());
-
         // Log NMEA msg.
         IMC::DevDataText text;
         text.value = nmea_msg;
+        text.value.erase(std::remove(text.value.begin(), text.value.end(), '\r'), text.value.end());
         dispatch(text);
 
-        // Get body of NMEA message.
-        std::string nmea_payload = GetBody(nmea_msg.c_str());
-
-        // Static and Voyage Related Data, first fragment.
-        if (nmea_payload[0] == '5' && !m_nmea5_wait_fg)
+        if (m_stn.parse(nmea_msg) != NMEATokenizer::ST_OK || m_stn.size() < c_vdm_fields)
         {
-          nmea_msg.erase(nmea_msg.size() - c_nmea5_trail - 1, c_nmea5_trail);
-          m_nmea5_fg = nmea_msg;
-          m_nmea5_wait_fg = true;
+          debug("invalid sentence: %s", text.value.c_str());
           return;
         }
 
-        // Static and Voyage Related Data, second fragment.
-        if (m_nmea5_wait_fg)
+        unsigned total = 0;
+        unsigned number = 0;
+        unsigned pad = 0;
+        if (!m_stn.read(1, total) || !m_stn.read(2, number) || !m_stn.read(6, pad))
+          return;
+
+        // Join the payload of multi-fragment messages.
+        const NMEATokenizer::Field& body = m_stn[5];
+        if (number == 1)
         {
-          nmea_msg.erase(0, c_nmea5_body_index);
-          nmea_msg = m_nmea5_fg.append(nmea_msg);
-          nmea_payload = GetBody(nmea_msg.c_str());
+          m_payload.assign(body.data, body.size);
+        }
+        else if (number == m_fragment + 1 && m_payload.size() + body.size <= c_max_payload)
+        {
+          m_payload.append(body.data, body.size);
+        }
+        else
+        {
+          m_fragment = 0;
+          return;
         }
 
-        // Static and Voyage Related Data, second fragment.
-        if (m_nmea5_wait_fg)
+        m_fragment = number;
+        if (number < total)
+          return;
+
+        m_fragment = 0;
+        if (!m_payload.empty())
+          decode(pad);
+      }
+
+      //! Decode the current message payload.
+      //! @param[in] pad number of fill bits.
+      void
+      decode(unsigned pad)
+      {
+        // Static and Voyage Related Data.
+        if (m_payload[0] == '5')
         {
-          m_nmea5_wait_fg = false;
-          Ais5 msg(nmea_payload.c_str(), GetPad(nmea_msg));
+          Ais5 msg(m_payload.c_str(), pad);
+          if (msg.had_error())
+            return;
 
           // Add system MMSI and Type if not existent.
           std::map<int, std::string>::iterator itr = m_systems.find(msg.mmsi);
@@ -188,15 +212,17 @@ namespace Sensors
         }
 
         // Position Report Class A.
-        if ((nmea_payload[0] == '1') ||
-            (nmea_payload[0] == '2') ||
-            (nmea_payload[0] == '3'))
+        if ((m_payload[0] == '1') ||
+            (m_payload[0] == '2') ||
+            (m_payload[0] == '3'))
         {
-          Ais1_2_3 msg(nmea_payload.c_str(), GetPad(nmea_msg));
+          Ais1_2_3 msg(m_payload.c_str(), pad);
+          if (msg.had_error())
+            return;
 
           // We are able to send a message with ship information.
           IMC::RemoteSensorInfo rsi;
-          rsi.id = static_cast<std::ostringstream*>(&(std::ostringstream() << msg.mmsi))->str();
+          rsi.id = String::str("%d", msg.mmsi);
 
           // Find ship type.
           std::map<int, std::string>::iterator itr = m_systems.find(msg.mmsi);
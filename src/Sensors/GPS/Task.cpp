@@ -110,13 +110,18 @@ namespace Sensors
       Reader* m_reader;
       //! Buffer forEntityState
       char m_bufer_entity[64];
+      //! Current sentence.
+      NMEATokenizer m_stn;
+      //! Sentence handlers.
+      NMEADispatcher<Task> m_handlers;
 
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Task(name, ctx),
         m_handle(NULL),
         m_has_agvel(false),
         m_has_euler(false),
-        m_reader(NULL)
+        m_reader(NULL),
+        m_handlers(this)
       {
         // Define configuration parameters.
         param("Serial Port - Device", m_args.uart_dev)
@@ -155,6 +160,16 @@ namespace Sensors
         // Initialize messages.
         clearMessages();
 
+        // Sentence handlers.
+        m_handlers.add("ZDA", &Task::interpretZDA);
+        m_handlers.add("GGA", &Task::interpretGGA);
+        m_handlers.add("VTG", &Task::interpretVTG);
+        m_handlers.add("HDM", &Task::interpretHDM);
+        m_handlers.add("HDT", &Task::interpretHDT);
+        m_handlers.add("ROT", &Task::interpretROT);
+        m_handlers.add("PSAT", &Task::interpretPSAT);
+        m_handlers.add("PUBX", &Task::interpretPUBX);
+
         bind<IMC::DevDataText>(this);
         bind<IMC::IoEvent>(this);
       }
@@ -303,97 +318,83 @@ namespace Sensors
         return false;
       }
 
-      //! Read time from string.
-      //! @param[in] str string.
+      //! Read time from sentence field.
+      //! @param[in] field sentence field (hhmmss[.ss]).
       //! @param[out] dst time.
       //! @return true if successful, false otherwise.
       bool
-      readTime(const std::string& str, float& dst)
+      readTime(const NMEATokenizer::Field& field, float& dst)
       {
+        if (field.size < 6)
+          return false;
+
+        NMEATokenizer::Field hf = {field.data, 2};
+        NMEATokenizer::Field mf = {field.data + 2, 2};
+        NMEATokenizer::Field sf = {field.data + 4, field.size - 4};
         unsigned h = 0;
         unsigned m = 0;
-        unsigned s = 0;
-        double sfp = 0;
+        double s = 0;
 
-        if (std::sscanf(str.c_str(), "%02u%02u%lf", &h, &m, &sfp) != 3)
-        {
-          if (std::sscanf(str.c_str(), "%02u%02u%02u", &h, &m, &s) != 3)
-            return false;
-        }
+        if (!NMEATokenizer::toNumber(hf, h)
+            || !NMEATokenizer::toNumber(mf, m)
+            || !NMEATokenizer::toNumber(sf, s))
+          return false;
 
-        dst = (h * 3600) + (m * 60) + s + sfp;
+        dst = (h * 3600) + (m * 60) + s;
 
         return true;
       }
 
-      //! Read latitude from string.
-      //! @param[in] str input string.
-      //! @param[in] h either North (N) or South (S).
-      //! @param[out] dst latitude.
+      //! Read latitude or longitude from sentence fields.
+      //! @param[in] field sentence field ([d]ddmm.mmmm).
+      //! @param[in] digits number of digits of degrees.
+      //! @param[in] negative true if the hemisphere is negative.
+      //! @param[out] dst angle in decimal degrees.
       //! @return true if successful, false otherwise.
       bool
-      readLatitude(const std::string& str, const std::string& h, double& dst)
+      readAngle(const NMEATokenizer::Field& field, size_t digits, bool negative, double& dst)
       {
-        int degrees = 0;
-        double minutes = 0;
-
-        if (std::sscanf(str.c_str(), "%02d%lf", &degrees, &minutes) != 2)
+        if (field.size <= digits)
           return false;
 
-        dst = Angles::convertDMSToDecimal(degrees, minutes);
-
-        if (h == "S")
-          dst = -dst;
-
-        return true;
-      }
-
-      //! Read longitude from string.
-      //! @param[in] str input string.
-      //! @param[in] h either West (W) or East (E).
-      //! @param[out] dst longitude.
-      //! @return true if successful, false otherwise.
-      double
-      readLongitude(const std::string& str, const std::string& h, double& dst)
-      {
+        NMEATokenizer::Field df = {field.data, digits};
+        NMEATokenizer::Field mf = {field.data + digits, field.size - digits};
         int degrees = 0;
         double minutes = 0;
 
-        if (std::sscanf(str.c_str(), "%03d%lf", &degrees, &minutes) != 2)
+        if (!NMEATokenizer::toNumber(df, degrees) || !NMEATokenizer::toNumber(mf, minutes))
           return false;
 
         dst = Angles::convertDMSToDecimal(degrees, minutes);
 
-        if (h == "W")
+        if (negative)
           dst = -dst;
 
         return true;
       }
 
-      //! Read decimal from input string.
-      //! @param[in] str input string.
-      //! @param[out] dst decimal.
+      //! Read latitude from sentence fields.
+      //! @param[in] stn sentence.
+      //! @param[in] index index of the latitude field, followed by
+      //! either North (N) or South (S).
+      //! @param[out] dst latitude.
       //! @return true if successful, false otherwise.
-      template <typename T>
       bool
-      readDecimal(const std::string& str, T& dst)
+      readLatitude(const NMEATokenizer& stn, size_t index, double& dst)
       {
-        unsigned idx = 0;
-        while (str[idx] == '0')
-          ++idx;
-
-        return castLexical(std::string(str, idx), dst);
+        return readAngle(stn[index], 2, stn[index + 1] == "S", dst);
       }
 
-      //! Read number from input string.
-      //! @param[in] str input string.
-      //! @param[out] dst number.
+      //! Read longitude from sentence fields.
+      //! @param[in] stn sentence.
+      //! @param[in] index index of the longitude field, followed by
+      //! either West (W) or East (E).
+      //! @param[out] dst longitude.
       //! @return true if successful, false otherwise.
-      template <typename T>
       bool
-      readNumber(const std::string& str, T& dst)
+      readLongitude(const NMEATokenizer& stn, size_t index, double& dst)
       {
-        return castLexical(str, dst);
+        return readAngle(stn[index], 3, stn[index + 1] == "W", dst);
       }
 
       //! Process sentence.
@@ -401,59 +402,39 @@ namespace Sensors
       void
       processSentence(const std::string& line)
       {
-        // Discard leading noise.
-        size_t sidx = 0;
-        for (sidx = 0; sidx < line.size(); ++sidx)
-        {
-          if (line[sidx] == '$')
-            break;
-        }
+        NMEATokenizer::Status status = m_stn.parse(line);
 
-        // Discard trailing noise.
-        size_t eidx = 0;
-        for (eidx = line.size() - 1; eidx > sidx; --eidx)
+        if (status == NMEATokenizer::ST_CHECKSUM_MISMATCH)
         {
-          if (line[eidx] == '*')
-            break;
+          trace("Checksum field does not match computed checksum, will not "
+                "parse sentence.");
+          return;
         }
 
-        if (sidx >= eidx)
+        if (status != NMEATokenizer::ST_OK)
           return;
 
-        // Compute checksum.
-        uint8_t ccsum = 0;
-        for (size_t i = sidx + 1; i < eidx; ++i)
-          ccsum ^= line[i];
-
-        // Validate checksum.
-        unsigned rcsum = 0;
-        if (std::sscanf(&line[0] + eidx + 1, "%02X", &rcsum) != 1)
+        if (!m_stn.hasChecksum())
         {
           trace("No checksum found, will not parse sentence.");
           return;
         }
 
-        if (ccsum != rcsum)
+        for (size_t i = 0; i < m_args.stn_order.size(); ++i)
         {
-          trace("Checksum field does not match computed checksum, will not "
-                "parse sentence.");
-          return;
+          if (m_stn.getCode() == m_args.stn_order[i])
+          {
+            interpretSentence();
+            return;
+          }
         }
-
-        // Split sentence
-        std::vector<std::string> parts;
-        String::split(line.substr(sidx + 1, eidx - sidx - 1), ",", parts);
-
-        if (std::find(m_args.stn_order.begin(), m_args.stn_order.end(), parts[0]) != m_args.stn_order.end())
-          interpretSentence(parts);
       }
 
-      //! Interpret given sentence.
-      //! @param[in] parts vector of strings from sentence.
+      //! Interpret current sentence.
       void
-      interpretSentence(std::vector<std::string>& parts)
+      interpretSentence(void)
       {
-        if (parts[0] == m_args.stn_order.front())
+        if (m_stn.getCode() == m_args.stn_order.front())
         {
           clearMessages();
           m_fix.setTimeStamp();
@@ -461,42 +442,12 @@ namespace Sensors
           m_agvel.setTimeStamp(m_fix.getTimeStamp());
         }
 
-        if (hasNMEAMessageCode(parts[0], "ZDA"))
-        {
-          interpretZDA(parts);
-        }
-        else if (hasNMEAMessageCode(parts[0], "GGA"))
-        {
-          interpretGGA(parts);
-        }
-        else if (hasNMEAMessageCode(parts[0], "VTG"))
-        {
-          interpretVTG(parts);
-        }
-        else if (parts[0] == "PSAT")
-        {
-          if (parts[1] == "HPR")
-            interpretPSATHPR(parts);
-        }
-        else if (parts[0] == "PUBX")
-        {
-          if (parts[1] == "00")
-            interpretPUBX00(parts);
-        }
-        else if (hasNMEAMessageCode(parts[0], "HDM"))
-        {
-          interpretHDM(parts);
-        }
-        else if (hasNMEAMessageCode(parts[0], "HDT"))
-        {
-          interpretHDT(parts);
-        }
-        else if (hasNMEAMessageCode(parts[0], "ROT"))
-        {
-          interpretROT(parts);
-        }
+        // Standard sentences must come from a GNSS talker.
+        NMEATokenizer::Field talker = m_stn.getTalker();
+        if (talker.empty() || talker.data[0] == 'G')
+          m_handlers.dispatch(m_stn);
 
-        if (parts[0] == m_args.stn_order.back())
+        if (m_stn.getCode() == m_args.stn_order.back())
         {
           m_wdog.reset();
           dispatch(m_fix);
@@ -527,49 +478,43 @@ namespace Sensors
         }
       }
 
-      bool
-      hasNMEAMessageCode(const std::string& str, const std::string& code)
-      {
-        return String::startsWith(str, "G") && String::endsWith(str, code);
-      }
-
       //! Interpret ZDA sentence (UTC date and time).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] stn sentence.
       void
-      interpretZDA(const std::vector<std::string>& parts)
+      interpretZDA(const NMEATokenizer& stn)
       {
-        if (parts.size() < c_zda_fields)
+        if (stn.size() < c_zda_fields)
         {
           war(DTR("invalid ZDA sentence"));
           return;
         }
 
         // Read time.
-        if (readTime(parts[1], m_fix.utc_time))
+        if (readTime(stn[1], m_fix.utc_time))
           m_fix.validity |= IMC::GpsFix::GFV_VALID_TIME;
 
         // Read date.
-        if (readDecimal(parts[2], m_fix.utc_day)
-            && readDecimal(parts[3], m_fix.utc_month)
-            && readDecimal(parts[4], m_fix.utc_year))
+        if (stn.read(2, m_fix.utc_day)
+            && stn.read(3, m_fix.utc_month)
+            && stn.read(4, m_fix.utc_year))
         {
           m_fix.validity |= IMC::GpsFix::GFV_VALID_DATE;
         }
       }
 
       //! Interpret GGA sentence (GPS fix data).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] stn sentence.
       void
-      interpretGGA(const std::vector<std::string>& parts)
+      interpretGGA(const NMEATokenizer& stn)
       {
-        if (parts.size() < c_gga_fields)
+        if (stn.size() < c_gga_fields)
         {
           war(DTR("invalid GGA sentence"));
           return;
         }
 
         int quality = 0;
-        readDecimal(parts[6], quality);
+        stn.read(6, quality);
         if (quality == 1)
         {
           m_fix.type = IMC::GpsFix::GFT_STANDALONE;
@@ -581,14 +526,14 @@ namespace Sensors
           m_fix.validity |= IMC::GpsFix::GFV_VALID_POS;
         }
 
-        if (readLatitude(parts[2], parts[3], m_fix.lat)
-            && readLongitude(parts[4], parts[5], m_fix.lon)
-            && readNumber(parts[9], m_fix.height)
-            && readDecimal(parts[7], m_fix.satellites))
+        if (readLatitude(stn, 2, m_fix.lat)
+            && readLongitude(stn, 4, m_fix.lon)
+            && stn.read(9, m_fix.height)
+            && stn.read(7, m_fix.satellites))
         {
           // Convert altitude above sea level to altitude above ellipsoid.
           double geoid_sep = 0;
-          if (readNumber(parts[11], geoid_sep))
+          if (stn.read(11, geoid_sep))
             m_fix.height += geoid_sep;
 
           // Convert coordinates to radians.
@@ -601,36 +546,45 @@ namespace Sensors
           m_fix.validity &= ~IMC::GpsFix::GFV_VALID_POS;
         }
 
-        if (readNumber(parts[8], m_fix.hdop))
+        if (stn.read(8, m_fix.hdop))
           m_fix.validity |= IMC::GpsFix::GFV_VALID_HDOP;
       }
 
+      //! Interpret PUBX sentences.
+      //! @param[in] stn sentence.
+      void
+      interpretPUBX(const NMEATokenizer& stn)
+      {
+        if (stn.size() > 1 && stn[1] == "00")
+          interpretPUBX00(stn);
+      }
+
       //! Interpret PUBX00 sentence (navstar position).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] stn sentence.
       void
-      interpretPUBX00(const std::vector<std::string>& parts)
+      interpretPUBX00(const NMEATokenizer& stn)
       {
-        if (parts.size() < c_pubx00_fields)
+        if (stn.size() < c_pubx00_fields)
         {
           war(DTR("invalid PUBX,00 sentence"));
           return;
         }
 
-        if (parts[8] == "G3" || parts[8] == "G2")
+        if (stn[8] == "G3" || stn[8] == "G2")
         {
           m_fix.type = IMC::GpsFix::GFT_STANDALONE;
           m_fix.validity |= IMC::GpsFix::GFV_VALID_POS;
         }
-        else if (parts[8] == "D3" || parts[8] == "D2")
+        else if (stn[8] == "D3" || stn[8] == "D2")
         {
           m_fix.type = IMC::GpsFix::GFT_DIFFERENTIAL;
           m_fix.validity |= IMC::GpsFix::GFV_VALID_POS;
         }
 
-        if (readLatitude(parts[3], parts[4], m_fix.lat)
-            && readLongitude(parts[5], parts[6], m_fix.lon)
-            && readNumber(parts[7], m_fix.height)
-            && readDecimal(parts[18], m_fix.satellites))
+        if (readLatitude(stn, 3, m_fix.lat)
+            && readLongitude(stn, 5, m_fix.lon)
+            && stn.read(7, m_fix.height)
+            && stn.read(18, m_fix.satellites))
         {
           // Convert coordinates to radians.
           m_fix.lat = Angles::radians(m_fix.lat);
@@ -642,37 +596,37 @@ namespace Sensors
           m_fix.validity &= ~IMC::GpsFix::GFV_VALID_POS;
         }
 
-        if (readNumber(parts[9], m_fix.hacc))
+        if (stn.read(9, m_fix.hacc))
           m_fix.validity |= IMC::GpsFix::GFV_VALID_HACC;
 
-        if (readNumber(parts[10], m_fix.vacc))
+        if (stn.read(10, m_fix.vacc))
           m_fix.validity |= IMC::GpsFix::GFV_VALID_VACC;
 
-        if (readNumber(parts[15], m_fix.hdop))
+        if (stn.read(15, m_fix.hdop))
           m_fix.validity |= IMC::GpsFix::GFV_VALID_HDOP;
 
-        if (readNumber(parts[16], m_fix.vdop))
+        if (stn.read(16, m_fix.vdop))
           m_fix.validity |= IMC::GpsFix::GFV_VALID_VDOP;
       }
 
       //! Interpret VTG sentence (course over ground).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] stn sentence.
       void
-      interpretVTG(const std::vector<std::string>& parts)
+      interpretVTG(const NMEATokenizer& stn)
       {
-        if (parts.size() < c_vtg_fields)
+        if (stn.size() < c_vtg_fields)
         {
           war(DTR("invalid VTG sentence"));
           return;
         }
 
-        if (readNumber(parts[1], m_fix.cog))
+        if (stn.read(1, m_fix.cog))
         {
           m_fix.cog = Angles::normalizeRadian(Angles::radians(m_fix.cog));
           m_fix.validity |= IMC::GpsFix::GFV_VALID_COG;
         }
 
-        if (readNumber(parts[7], m_fix.sog))
+        if (stn.read(7, m_fix.sog))
         {
           m_fix.sog *= 1000.0f / 3600.0f;
           m_fix.validity |= IMC::GpsFix::GFV_VALID_SOG;
@@ -680,33 +634,33 @@ namespace Sensors
       }
 
       //! Interpret VTG sentence (true heading).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] stn sentence.
       void
-      interpretHDT(const std::vector<std::string>& parts)
+      interpretHDT(const NMEATokenizer& stn)
       {
-        if (parts.size() < c_hdt_fields)
+        if (stn.size() < c_hdt_fields)
         {
           war(DTR("invalid HDT sentence"));
           return;
         }
 
-        if (readNumber(parts[1], m_euler.psi))
+        if (stn.read(1, m_euler.psi))
           m_euler.psi = Angles::normalizeRadian(Angles::radians(m_euler.psi));
       }
 
       //! Interpret HDM sentence (Magnetic heading of
       //! the vessel derived from the true heading calculated).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] stn sentence.
       void
-      interpretHDM(const std::vector<std::string>& parts)
+      interpretHDM(const NMEATokenizer& stn)
       {
-        if (parts.size() < c_hdm_fields)
+        if (stn.size() < c_hdm_fields)
         {
           war(DTR("invalid HDM sentence"));
           return;
         }
 
-        if (readNumber(parts[1], m_euler.psi_magnetic))
+        if (stn.read(1, m_euler.psi_magnetic))
         {
           m_euler.psi_magnetic = Angles::normalizeRadian(Angles::radians(m_euler.psi_magnetic));
           m_has_euler = true;
@@ -714,42 +668,51 @@ namespace Sensors
       }
 
       //! Interpret ROT sentence (rate of turn).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] stn sentence.
       void
-      interpretROT(const std::vector<std::string>& parts)
+      interpretROT(const NMEATokenizer& stn)
       {
-        if (parts.size() < c_rot_fields)
+        if (stn.size() < c_rot_fields)
         {
           war(DTR("invalid ROT sentence"));
           return;
         }
 
-        if (readNumber(parts[1], m_agvel.z))
+        if (stn.read(1, m_agvel.z))
         {
           m_agvel.z = Angles::radians(m_agvel.z) / 60.0;
           m_has_agvel = true;
         }
       }
 
+      //! Interpret PSAT sentences.
+      //! @param[in] stn sentence.
+      void
+      interpretPSAT(const NMEATokenizer& stn)
+      {
+        if (stn.size() > 1 && stn[1] == "HPR")
+          interpretPSATHPR(stn);
+      }
+
       //! Interpret PSATHPR sentence (Proprietary NMEA message that
       //! provides the heading, pitch, roll, and time in a single message).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] stn sentence.
       void
-      interpretPSATHPR(const std::vector<std::string>& parts)
+      interpretPSATHPR(const NMEATokenizer& stn)
       {
-        if (parts.size() < c_psathpr_fields)
+        if (stn.size() < c_psathpr_fields)
         {
           war(DTR("invalid PSATHPR sentence"));
           return;
         }
 
-        if (readNumber(parts[4], m_euler.theta))
+        if (stn.read(4, m_euler.theta))
         {
           m_euler.theta = Angles::normalizeRadian(Angles::radians(m_euler.theta));
           m_has_euler = true;
         }
 
-        if (readNumber(parts[5], m_euler.phi))
+        if (stn.read(5, m_euler.phi))
         {
           m_euler.phi = Angles::normalizeRadian(Angles::radians(m_euler.phi));
           m_has_euler = true;
@@ -33,6 +33,7 @@
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
+#include <DUNE/Simulation/Bathymetry.hpp>
 
 // Local headers.
 #include "QuadTree.hpp"
@@ -41,6 +42,8 @@ namespace Simulators
 {
   //! This task simulates signals for the bottom and forward looking echo sounders
   //! Uses bathymetry data from APDL to generate bottom distance data.
+  //! If a bathymetry raster (created with dune-bathymetry) is found
+  //! next to the bathymetry INI file it is used instead of the INI data.
   //! Uses two configurable WGS84 points to simulate a pier or a straight-line
   //! obstacle.
   namespace Environment
@@ -51,6 +54,8 @@ namespace Simulators
 
     //! Number of points in the forward direction for bottom intersection
     static const unsigned c_forward_points = 10;
+    //! Maximum number of points in the forward direction when using a raster.
+    static const unsigned c_max_forward_points = 256;
 
     class PencilBeam
     {
@@ -197,6 +202,10 @@ namespace Simulators
       Random::Generator* m_prng;
       //! The tree.
       QuadTree* m_qtree;
+      //! Bathymetry raster.
+      Simulation::Bathymetry* m_raster;
+      //! Depths in front of the vehicle.
+      std::vector<float> m_fwd_depths;
       //! Reference latitude and longitude for data points.
       double m_ref_lat, m_ref_lon;
       //! NE offsets in regard to navigational reference.
@@ -210,6 +219,7 @@ namespace Simulators
         Tasks::Periodic(name, ctx),
         m_prng(NULL),
         m_qtree(NULL),
+        m_raster(NULL),
         m_pb(NULL)
       {
         param("Simulate - Bottom Distance", m_args.simulate_bd)
@@ -355,6 +365,7 @@ namespace Simulators
       {
         Memory::clear(m_prng);
         Memory::clear(m_qtree);
+        Memory::clear(m_raster);
         Memory::clear(m_pb);
       }
 
@@ -397,11 +408,25 @@ namespace Simulators
         debug("pier point B lat: %0.6f, lon: %0.6f", m_args.pier[2], m_args.pier[3]);
       }
 
+      //! Load bathymetry raster.
+      //! @param[in] path raster path.
       void
-      onResourceInitialization(void)
+      loadRaster(const Path& path)
+      {
+        m_raster = new Simulation::Bathymetry(path.str());
+        m_ref_lat = Angles::radians(m_raster->getLatitude());
+        m_ref_lon = Angles::radians(m_raster->getLongitude());
+
+        debug("%s | %s", m_args.location.c_str(), path.c_str());
+        debug("%s | %u x %u raster, %0.2f m resolution", m_args.location.c_str(),
+              m_raster->getRows(), m_raster->getColumns(), m_raster->getResolution());
+      }
+
+      //! Load bathymetry points to the tree.
+      //! @param[in] path bathymetry INI path.
+      void
+      loadPoints(const Path& path)
       {
-        Utils::String::toLowerCase(m_args.location);
-        Path path = m_ctx.dir_cfg / "simulation" / ("bathymetry-" + m_args.location + ".ini");
         DUNE::Parsers::Config cfg(path.c_str());
         std::vector<std::string> lines;
         cfg.get("Bathymetry", "Data", "", lines);
@@ -445,6 +470,19 @@ namespace Simulators
         ss.clear();
         ss << *m_qtree;
         trace("tree elements: %s", ss.str().c_str());
+      }
+
+      void
+      onResourceInitialization(void)
+      {
+        Utils::String::toLowerCase(m_args.location);
+        Path base = m_ctx.dir_cfg / "simulation" / ("bathymetry-" + m_args.location);
+        Path raster = base.str() + ".dbr";
+
+        if (raster.exists())
+          loadRaster(raster);
+        else
+          loadPoints(base.str() + ".ini");
 
         m_bd.beam_config.clear();
         m_bd.location.clear();
@@ -561,6 +599,18 @@ namespace Simulators
       double
       depthAt(double x, double y)
       {
+        if (m_raster != NULL)
+        {
+          double depth = 0;
+          if (!m_raster->getDepth(x, y, depth))
+          {
+            trace("out of bounds");
+            return m_args.oob_depth;
+          }
+
+          return depth + m_args.tide;
+        }
+
         Point p(x, y);
         Bounds search_area(p, m_args.interp_radius);
 
@@ -708,11 +758,19 @@ namespace Simulators
       {
         double intersect_range = m_args.max_range;
 
-        double x_step = m_args.max_range / (double)c_forward_points;
+        // Constant time raster lookups allow one point per raster sample.
+        unsigned points = c_forward_points;
+        if (m_raster != NULL)
+        {
+          double count = std::ceil(m_args.max_range / m_raster->getResolution());
+          points = (unsigned)trimValue(count, (double)c_forward_points, (double)c_max_forward_points);
+        }
+
+        double x_step = m_args.max_range / (double)points;
 
-        std::vector<float> fwd_depths(c_forward_points);
+        m_fwd_depths.resize(points);
 
-        fwd_depths[0] = depthAt(m_sstate.x + m_off_n, m_sstate.y + m_off_e);
+        m_fwd_depths[0] = depthAt(m_sstate.x + m_off_n, m_sstate.y + m_off_e);
 
         // x and z coordinates of the end of the forward beam
         double x_target, z_target;
@@ -721,18 +779,18 @@ namespace Simulators
         z_target = - m_args.max_range * sin(m_sstate.theta - m_args.forward_width / 2.0);
         z_target += m_sstate.z; // SHOULD NOT BE Z BUT DEPTH
 
-        for (unsigned i = 1; i < c_forward_points; i++)
+        for (unsigned i = 1; i < points; i++)
         {
           double xe = (double)i * x_step * cos(m_sstate.psi);
           double ye = (double)i * x_step * sin(m_sstate.psi);
 
-          fwd_depths[i] = depthAt(m_sstate.x + m_off_n + xe, m_sstate.y + m_off_e + ye);
+          m_fwd_depths[i] = depthAt(m_sstate.x + m_off_n + xe, m_sstate.y + m_off_e + ye);
 
           double bottom_x_1 = (double)(i - 1) * x_step;
-          double bottom_z_1 = fwd_depths[i - 1];
+          double bottom_z_1 = m_fwd_depths[i - 1];
 
           double bottom_x_2 = (double)i * x_step;
-          double bottom_z_2 = fwd_depths[i];
+          double bottom_z_2 = m_fwd_depths[i];
 
           double x, z;
 
@@ -38,6 +38,10 @@ namespace Simulators
   {
     namespace StreamGenerator
     {
+      //! Number of points of a cached block of velocity data along each
+      //! dimension (latitude, longitude, time).
+      static const std::array<size_t, 3> c_block = {{32, 32, 24}};
+
       Gridded2DModelDataStreamGenerator::Gridded2DModelDataStreamGenerator(
           GriddedModelDataConfig const& config,
           double wx,
@@ -45,37 +49,39 @@ namespace Simulators
           double wz)
           : StreamGenerator(wx, wy, wz),
             m_file(config.filename),
-            m_u(0),
-            m_v(0),
+            m_u(nullptr),
+            m_v(nullptr),
             m_grid(m_file.getAttribute<double>(config.grid_path, "min"),
                    m_file.getAttribute<double>(config.grid_path, "max"),
                    m_file.getAttribute<size_t>(config.grid_path, "npts"))
       {
-        auto data_u = m_file.getDataset<double>(config.u_data_path);
-        auto data_v = m_file.getDataset<double>(config.v_data_path);
+        auto dims_u = m_file.getDatasetDimensions(config.u_data_path);
+        auto dims_v = m_file.getDatasetDimensions(config.v_data_path);
 
-        if (data_u.dimensions != data_v.dimensions)
+        if (dims_u != dims_v)
           throw std::runtime_error(
               DTR("Gridded2DModelDataStreamGenerator::"
                   "Gridded2DModelDataStreamGenerator(): dimensions of velocity "
                   "components do not match."));
 
-        if (data_u.dimensions.size() != 3)
+        if (dims_u.size() != 3)
           throw std::runtime_error(
               DTR("Gridded2DModelDataStreamGenerator::"
                   "Gridded2DModelDataStreamGenerator(): data must be "
                   "three-dimensional (2D space + time)."));
 
-        if (m_grid.getDimensions(0) != data_u.dimensions[0] ||
-            m_grid.getDimensions(1) != data_u.dimensions[1] ||
-            m_grid.getDimensions(2) != data_u.dimensions[2])
+        if (m_grid.getDimensions(0) != dims_u[0] ||
+            m_grid.getDimensions(1) != dims_u[1] ||
+            m_grid.getDimensions(2) != dims_u[2])
           throw std::runtime_error(
               DTR("Gridded2DModelDataStreamGenerator::"
                   "Gridded2DModelDataStreamGenerator(): data dimensions do not "
                   "match grid dimensions."));
 
-        m_u = std::move(data_u.data);
-        m_v = std::move(data_v.data);
+        m_u = std::make_unique<Cache>(
+            m_file, config.u_data_path, c_block, config.cache_size);
+        m_v = std::make_unique<Cache>(
+            m_file, config.v_data_path, c_block, config.cache_size);
       }
 
       inline double
@@ -116,20 +122,26 @@ namespace Simulators
         // TODO Allow configurable interpolation schemes.
 
         auto gridpoint = corner_indices;
-        u_values[0] = m_u[m_grid.getOffset(gridpoint)];
-        v_values[0] = m_v[m_grid.getOffset(gridpoint)];
+        u_values[0] = m_u->get(gridpoint);
+        v_values[0] = m_v->get(gridpoint);
 
         gridpoint[0] += 1;
-        u_values[1] = m_u[m_grid.getOffset(gridpoint)];
-        v_values[1] = m_v[m_grid.getOffset(gridpoint)];
+        u_values[1] = m_u->get(gridpoint);
+        v_values[1] = m_v->get(gridpoint);
 
         gridpoint[1] += 1;
-        u_values[2] = m_u[m_grid.getOffset(gridpoint)];
-        v_values[2] = m_v[m_grid.getOffset(gridpoint)];
+        u_values[2] = m_u->get(gridpoint);
+        v_values[2] = m_v->get(gridpoint);
 
         gridpoint[0] -= 1;
-        u_values[3] = m_u[m_grid.getOffset(gridpoint)];
-        v_values[3] = m_v[m_grid.getOffset(gridpoint)];
+        u_values[3] = m_u->get(gridpoint);
+        v_values[3] = m_v->get(gridpoint);
+
+        // Read the next time window while the current one is in use.
+        auto next = corner_indices;
+        next[2] = (next[2] / c_block[2] + 1) * c_block[2];
+        m_u->prefetch(next);
+        m_v->prefetch(next);
 
         auto u_val = interpolateLinear2d(u_values, delta);
         auto v_val = interpolateLinear2d(v_values, delta);
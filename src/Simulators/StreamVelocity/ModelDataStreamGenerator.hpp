@@ -30,9 +30,11 @@
 #ifndef SIMULATORS_STREAM_VELOCITY_MODEL_DATA_STREAM_GENERATOR_HPP_INCLUDED_
 #define SIMULATORS_STREAM_VELOCITY_MODEL_DATA_STREAM_GENERATOR_HPP_INCLUDED_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "DUNE/Parsers/HDF5BlockCache.hpp"
 #include "DUNE/Parsers/HDF5Reader.hpp"
 #include "DUNE/Math/Grid.hpp"
 
@@ -64,11 +66,15 @@ namespace Simulators
       {
         //! Path to the node in the file containing the grid parameters.
         std::string grid_path;
+        //! Memory budget for the velocity data of each component (bytes).
+        size_t cache_size;
       };
 
       //! Get stream velocity values from 2D (horizontal velocities) model data
       //! on a cartesian grid.
-      //! Uses the HDF5 format to load the stream values.
+      //! Uses the HDF5 format to load the stream values. The data is read in
+      //! blocks, kept in a cache of limited size, and the next time window
+      //! of the current position is prefetched in the background.
       class Gridded2DModelDataStreamGenerator : public StreamGenerator
       {
       public:
@@ -92,11 +98,13 @@ namespace Simulators
                     double time = 0.0) const override;
 
       private:
+        using Cache = DUNE::Parsers::HDF5BlockCache<double, 3>;
+
         DUNE::Parsers::HDF5Reader m_file;
         //! Velocity in the East direction.
-        std::vector<double> m_u;
+        std::unique_ptr<Cache> m_u;
         //! Velocity in the North direction.
-        std::vector<double> m_v;
+        std::unique_ptr<Cache> m_v;
         //! Converts between grid indices and datapoint indices.
         DUNE::Math::Grid<3> m_grid;
       };
@@ -69,6 +69,7 @@ namespace Simulators
           //!   max - array with the upper grid limits.
           //!   npts - array with the number of points in each dimension.
           mdcfg.grid_path = "grid";
+          mdcfg.cache_size = (size_t)config.cache_size * 1024 * 1024;
 
           return std::make_unique<Gridded2DModelDataStreamGenerator>(
               mdcfg, config.default_wx, config.default_wy, config.default_wz);
@@ -66,6 +66,8 @@ namespace Simulators
       //! Configurations for loading stream velocity data from a file.
       //! Path to file containing the data.
       std::string filename;
+      //! Memory budget for each velocity component (MiB).
+      unsigned cache_size;
 
       //! Advance the simulation by some time, if using forecasted data.
       struct
@@ -121,6 +123,13 @@ namespace Simulators
             .defaultValue("")
             .description("Path to the file containg the stream velocity data.");
 
+        param("Cache Size", m_args.cache_size)
+            .defaultValue("64")
+            .minimumValue("1")
+            .description(
+                "Memory budget, in MiB, for the data of each velocity "
+                "component. Data is read from the file as needed.");
+
         param("Days Forward", m_args.date.days_fwd)
             .defaultValue("0")
             .description(
@@ -31,12 +31,16 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <iterator>
 #include <algorithm>
 #include <cstddef>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "Writer.hpp"
+
 namespace Transports
 {
   namespace Logging
@@ -58,6 +62,12 @@ namespace Transports
       unsigned lsf_volume_size;
       // Compression method.
       std::string lsf_compression;
+      // Write sidecar index.
+      bool lsf_index;
+      // Size of the write buffers.
+      unsigned write_buffer_size;
+      // Maximum amount of data waiting to be written.
+      unsigned write_buffer_max;
     };
 
     struct Task: public Tasks::Task
@@ -72,12 +82,12 @@ namespace Transports
       std::string m_volume_dir;
       // Compression format.
       Compression::Methods m_compression;
-      // Output file stream for LSF/LSF_GZ formats.
-      std::ostream* m_lsf;
+      // Background writer for LSF/LSF_GZ formats.
+      Writer* m_lsf;
       // Path to LSF file.
       Path m_lsf_file;
-      // Serialization buffer.
-      ByteBuffer m_buffer;
+      // Serialization arena.
+      IMC::Writer m_writer;
       // Logging control message.
       IMC::LoggingControl m_log_ctl;
       // True if logging is enabled.
@@ -101,6 +111,10 @@ namespace Transports
         .defaultValue("none")
         .description("Compression method");
 
+        param("LSF Index", m_args.lsf_index)
+        .defaultValue("true")
+        .description("Write a sidecar index allowing readers to seek by time and message type");
+
         param("LSF Volume Size", m_args.lsf_volume_size)
         .units(Units::Mebibyte)
         .defaultValue("0");
@@ -111,6 +125,19 @@ namespace Transports
         param("Transports", m_args.messages)
         .defaultValue("");
 
+        param("Write Buffer Size", m_args.write_buffer_size)
+        .visibility(Tasks::Parameter::VISIBILITY_DEVELOPER)
+        .units(Units::Kibibyte)
+        .defaultValue("256")
+        .minimumValue("4")
+        .description("Amount of data accumulated before being handed to the writer thread");
+
+        param("Write Buffer Maximum Size", m_args.write_buffer_max)
+        .visibility(Tasks::Parameter::VISIBILITY_DEVELOPER)
+        .units(Units::Kibibyte)
+        .defaultValue("16384")
+        .description("Maximum amount of data waiting to be written before logging blocks");
+
         m_log_ctl.setSource(getSystemId());
 
         bind<IMC::CacheControl>(this);
@@ -127,7 +154,7 @@ namespace Transports
       void
       onResourceInitialization(void)
       {
-        bind(this, m_args.messages);
+        bindBatch(this, m_args.messages);
 
         // Initialize entity state.
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
@@ -216,10 +243,17 @@ namespace Transports
       }
 
       void
-      consume(const IMC::Message* msg)
+      consumeBatch(const IMC::Message* const* msgs, size_t count)
       {
-        if (m_active)
-          logMessage(msg);
+        if (!m_active || m_lsf == NULL)
+          return;
+
+        // Serialize the whole batch and write it with a single call.
+        m_writer.clear();
+        for (size_t i = 0; i < count; ++i)
+          IMC::Packet::serialize(msgs[i], m_writer);
+
+        m_lsf->write(reinterpret_cast<const char*>(m_writer.getData()), m_writer.getSize());
       }
 
       bool
@@ -283,17 +317,19 @@ namespace Transports
       void
       logFile(const std::string& file)
       {
+        if (m_lsf == NULL)
+          return;
+
         std::ifstream ifs(file.c_str(), std::ios::binary);
 
         if (!ifs.is_open())
           return;
 
-        char bfr[16 * 1024];
-        while (!ifs.eof())
-        {
-          ifs.read(bfr, sizeof(bfr));
-          m_lsf->write(bfr, ifs.gcount());
-        }
+        // Write the snapshot at once so that no packet is split
+        // between log blocks.
+        std::vector<char> data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        if (!data.empty())
+          m_lsf->write(&data[0], data.size());
       }
 
       void
@@ -350,10 +386,9 @@ namespace Transports
 
         m_lsf_file = m_dir / "Data.lsf" + Compression::Factory::extension(m_compression);
 
-        if (m_compression == METHOD_UNKNOWN)
-          m_lsf = new std::ofstream(m_lsf_file.c_str(), std::ios::binary);
-        else
-          m_lsf = new Compression::FileOutput(m_lsf_file.c_str(), m_compression);
+        m_lsf = new Writer(m_lsf_file.c_str(), m_compression, m_args.lsf_index,
+                           m_args.write_buffer_size * 1024,
+                           m_args.write_buffer_max * 1024);
 
         // Log LoggingControl to facilitate posterior conversion to LLF.
         m_log_ctl.op = IMC::LoggingControl::COP_STARTED;
@@ -387,10 +422,26 @@ namespace Transports
         if (m_lsf == NULL)
           return;
 
+        std::string error;
+        if (m_lsf->failed(error))
+        {
+          err("%s", error.c_str());
+          tryStartLog(m_label);
+          return;
+        }
+
+        Writer::Statistics stats = m_lsf->getStatistics();
+        debug("writer: %u KiB queued (%u KiB max), %0.1f KiB/s, %u stalls",
+              (unsigned)(stats.queued / 1024), (unsigned)(stats.queued_max / 1024),
+              stats.bytes_per_second / 1024.0, stats.stalls);
+
+        if (stats.stalls > 0)
+          war(DTR("log writer is not keeping up with incoming data"));
+
         int64_t mib = Path(m_lsf_file).size();
         mib /= c_bytes_per_mib;
 
-        m_lsf->flush();
+        m_lsf->sync();
 
         if ((m_args.lsf_volume_size > 0) && (mib >= m_args.lsf_volume_size))
           tryStartLog(m_label);
@@ -424,8 +475,9 @@ namespace Transports
         if (m_lsf == NULL)
           return;
 
-        IMC::Packet::serialize(msg, m_buffer);
-        m_lsf->write(m_buffer.getBufferSigned(), m_buffer.getSize());
+        m_writer.clear();
+        IMC::Packet::serialize(msg, m_writer);
+        m_lsf->write(reinterpret_cast<const char*>(m_writer.getData()), m_writer.getSize());
       }
 
       void
@@ -0,0 +1,497 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef TRANSPORTS_LOGGING_WRITER_HPP_INCLUDED_
+#define TRANSPORTS_LOGGING_WRITER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+#if defined(DUNE_OS_POSIX)
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace Transports
+{
+  namespace Logging
+  {
+    using DUNE_NAMESPACES;
+
+    //! Alignment of write buffers.
+    static const size_t c_buffer_alignment = 4096;
+    //! Maximum size of an uncompressed log block.
+    static const size_t c_block_size = 128 * 1024;
+
+    //! Background writer of log files. Data written by the logging
+    //! task is appended to a front buffer while a dedicated thread
+    //! splits the back buffer into blocks of whole packets, compresses
+    //! each block independently and writes it to disk, optionally
+    //! recording the block in a sidecar index (see IMC::LogIndex). The
+    //! writer
+    //! thread swaps the buffers when the front buffer is full or
+    //! when synchronization is requested, so the logging task only
+    //! copies memory. If the disk falls behind, the front buffer
+    //! grows up to a maximum size before write() blocks.
+    class Writer: public Concurrency::Thread
+    {
+    public:
+      //! Writer statistics.
+      struct Statistics
+      {
+        //! Bytes waiting to be written.
+        size_t queued;
+        //! Maximum number of bytes waiting to be written.
+        size_t queued_max;
+        //! Bytes written since the previous call to getStatistics().
+        uint64_t written;
+        //! Write throughput since the previous call to getStatistics().
+        double bytes_per_second;
+        //! Number of times write() had to wait for the disk.
+        unsigned stalls;
+      };
+
+      //! Open a log file.
+      //! @param[in] path file path.
+      //! @param[in] method compression method.
+      //! @param[in] index true to write a sidecar index.
+      //! @param[in] buffer_size size of each buffer.
+      //! @param[in] buffer_max maximum size of the front buffer.
+      Writer(const std::string& path, Compression::Methods method, bool index,
+             size_t buffer_size, size_t buffer_max):
+        m_compressor(NULL),
+        m_position(0),
+        m_buffer_size(buffer_size),
+        m_buffer_max(std::max(buffer_max, buffer_size)),
+        m_sync(false),
+        m_queued_max(0),
+        m_written(0),
+        m_written_last(0),
+        m_stats_time(Clock::get()),
+        m_stalls(0)
+      {
+        m_front.memory = NULL;
+        m_back.memory = NULL;
+
+        // Files close themselves if construction fails.
+        try
+        {
+          m_data.open(path);
+
+          if (index)
+          {
+            m_index.open(path + IMC::LogIndex::c_extension);
+            IMC::LogIndex::encodeHeader(method, m_record);
+            m_index.write(m_record.getBufferSigned(), m_record.getSize());
+          }
+
+          if (method != METHOD_UNKNOWN)
+            m_compressor = Compression::Factory::compressor(method);
+
+          allocate(m_front, buffer_size);
+          allocate(m_back, buffer_size);
+
+          start();
+        }
+        catch (...)
+        {
+          delete m_compressor;
+          release(m_front);
+          release(m_back);
+          throw;
+        }
+      }
+
+      //! Write all pending data and close the file.
+      ~Writer(void)
+      {
+        m_cond.lock();
+        stop();
+        m_cond.broadcast();
+        m_cond.unlock();
+
+        join();
+
+        delete m_compressor;
+        m_data.close();
+        m_index.close();
+        release(m_front);
+        release(m_back);
+      }
+
+      //! Queue data for writing.
+      //! @param[in] data whole packets.
+      //! @param[in] size data size.
+      void
+      write(const char* data, size_t size)
+      {
+        Concurrency::ScopedCondition l(m_cond);
+
+        size_t needed = m_front.size + size;
+        if (needed > m_buffer_max && m_front.size > 0)
+        {
+          // The disk is not keeping up: wait for the writer thread
+          // to take the front buffer.
+          ++m_stalls;
+          m_cond.broadcast();
+          while (m_front.size > 0 && !isStopping())
+            m_cond.wait(1.0);
+        }
+
+        if (m_front.size + size > m_front.capacity)
+          grow(m_front, m_front.size + size);
+
+        std::memcpy(m_front.data + m_front.size, data, size);
+        m_front.size += size;
+
+        m_queued_max = std::max(m_queued_max, m_front.size + m_back.size);
+
+        if (m_front.size >= m_buffer_size)
+          m_cond.broadcast();
+      }
+
+      //! Request pending data to be written and synchronized to disk.
+      void
+      sync(void)
+      {
+        Concurrency::ScopedCondition l(m_cond);
+        m_sync = true;
+        m_cond.broadcast();
+      }
+
+      //! Test if the writer thread failed.
+      //! @param[out] error error message.
+      //! @return true if the writer failed, false otherwise.
+      bool
+      failed(std::string& error)
+      {
+        Concurrency::ScopedCondition l(m_cond);
+        error = m_error;
+        return !m_error.empty();
+      }
+
+      //! Retrieve and reset statistics.
+      //! @return statistics.
+      Statistics
+      getStatistics(void)
+      {
+        Concurrency::ScopedCondition l(m_cond);
+
+        double now = Clock::get();
+        Statistics stats;
+        stats.queued = m_front.size + m_back.size;
+        stats.queued_max = m_queued_max;
+        stats.written = m_written - m_written_last;
+        stats.bytes_per_second = (now > m_stats_time) ? stats.written / (now - m_stats_time) : 0;
+        stats.stalls = m_stalls;
+
+        m_queued_max = stats.queued;
+        m_written_last = m_written;
+        m_stats_time = now;
+        m_stalls = 0;
+
+        return stats;
+      }
+
+    private:
+      //! Output file.
+      class File
+      {
+      public:
+        File(void):
+          m_fd(-1)
+        { }
+
+        ~File(void)
+        {
+          close();
+        }
+
+        bool
+        isOpen(void) const
+        {
+#if defined(DUNE_OS_POSIX)
+          return m_fd >= 0;
+#else
+          return m_ofs.is_open();
+#endif
+        }
+
+        void
+        open(const std::string& path)
+        {
+#if defined(DUNE_OS_POSIX)
+          m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+          if (m_fd < 0)
+            throw std::runtime_error(String::str(DTR("failed to open '%s': %s"), path.c_str(), std::strerror(errno)));
+#else
+          m_ofs.open(path.c_str(), std::ios::binary);
+          if (!m_ofs.is_open())
+            throw std::runtime_error(String::str(DTR("failed to open '%s'"), path.c_str()));
+#endif
+        }
+
+        void
+        close(void)
+        {
+#if defined(DUNE_OS_POSIX)
+          if (m_fd >= 0)
+            ::close(m_fd);
+          m_fd = -1;
+#else
+          m_ofs.close();
+#endif
+        }
+
+        void
+        write(const char* data, size_t size)
+        {
+#if defined(DUNE_OS_POSIX)
+          while (size > 0)
+          {
+            ssize_t rv = ::write(m_fd, data, size);
+            if (rv < 0)
+            {
+              if (errno == EINTR)
+                continue;
+
+              throw std::runtime_error(String::str(DTR("failed to write log: %s"), std::strerror(errno)));
+            }
+
+            data += rv;
+            size -= rv;
+          }
+#else
+          m_ofs.write(data, size);
+          if (!m_ofs.good())
+            throw std::runtime_error(DTR("failed to write log"));
+#endif
+        }
+
+        void
+        sync(void)
+        {
+#if defined(DUNE_SYS_HAS_FDATASYNC)
+          fdatasync(m_fd);
+#elif defined(DUNE_SYS_HAS_FSYNC)
+          fsync(m_fd);
+#elif !defined(DUNE_OS_POSIX)
+          m_ofs.flush();
+#endif
+        }
+
+      private:
+        //! File descriptor.
+        int m_fd;
+#if !defined(DUNE_OS_POSIX)
+        //! File stream.
+        std::ofstream m_ofs;
+#endif
+
+        //! Non-copyable.
+        File(const File&);
+
+        //! Non-assignable.
+        File&
+        operator=(const File&);
+      };
+
+      //! Aligned memory buffer.
+      struct Buffer
+      {
+        //! Allocated memory.
+        char* memory;
+        //! Aligned data.
+        char* data;
+        //! Used bytes.
+        size_t size;
+        //! Capacity.
+        size_t capacity;
+      };
+
+      //! Front buffer, filled by write().
+      Buffer m_front;
+      //! Back buffer, written to disk.
+      Buffer m_back;
+      //! Log file.
+      File m_data;
+      //! Index file.
+      File m_index;
+      //! Compressor or NULL.
+      Compression::Compressor* m_compressor;
+      //! Compressed block.
+      ByteBuffer m_compressed;
+      //! Index record.
+      ByteBuffer m_record;
+      //! Index entries of the current block.
+      std::vector<IMC::LogIndex::Entry> m_entries;
+      //! Position of the next block in the log file.
+      uint64_t m_position;
+      //! Size of the front buffer that wakes up the writer thread.
+      size_t m_buffer_size;
+      //! Maximum size of the front buffer.
+      size_t m_buffer_max;
+      //! Protects all members shared with the writer thread.
+      Concurrency::Condition m_cond;
+      //! True if synchronization to disk was requested.
+      bool m_sync;
+      //! Error message of the writer thread.
+      std::string m_error;
+      //! Statistics.
+      size_t m_queued_max;
+      uint64_t m_written;
+      uint64_t m_written_last;
+      double m_stats_time;
+      unsigned m_stalls;
+
+      static void
+      allocate(Buffer& bfr, size_t capacity)
+      {
+        bfr.memory = static_cast<char*>(std::malloc(capacity + c_buffer_alignment));
+        if (bfr.memory == NULL)
+          throw std::bad_alloc();
+
+        uintptr_t addr = reinterpret_cast<uintptr_t>(bfr.memory);
+        bfr.data = bfr.memory + (c_buffer_alignment - addr % c_buffer_alignment) % c_buffer_alignment;
+        bfr.size = 0;
+        bfr.capacity = capacity;
+      }
+
+      static void
+      release(Buffer& bfr)
+      {
+        std::free(bfr.memory);
+        bfr.memory = NULL;
+        bfr.data = NULL;
+      }
+
+      static void
+      grow(Buffer& bfr, size_t capacity)
+      {
+        Buffer nbfr;
+        allocate(nbfr, std::max(capacity, bfr.capacity * 2));
+        std::memcpy(nbfr.data, bfr.data, bfr.size);
+        nbfr.size = bfr.size;
+        release(bfr);
+        bfr = nbfr;
+      }
+
+      //! Split the back buffer in blocks, compress and write them
+      //! and record them in the index.
+      void
+      writeBack(void)
+      {
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(m_back.data);
+        size_t offset = 0;
+
+        while (offset < m_back.size)
+        {
+          IMC::LogIndex::Block block;
+          size_t size = IMC::LogIndex::scan(data + offset, m_back.size - offset, c_block_size, block, m_entries);
+
+          char* raw = m_back.data + offset;
+          block.position = m_position;
+
+          if (m_compressor == NULL)
+          {
+            m_data.write(raw, size);
+            block.stored_size = size;
+          }
+          else
+          {
+            m_compressor->compress(m_compressed, raw, size);
+            m_data.write(m_compressed.getBufferSigned(), m_compressed.getSize());
+            block.stored_size = m_compressed.getSize();
+          }
+
+          m_position += block.stored_size;
+          offset += size;
+
+          if (m_index.isOpen())
+          {
+            IMC::LogIndex::encodeBlock(block, m_entries, m_record);
+            m_index.write(m_record.getBufferSigned(), m_record.getSize());
+          }
+        }
+      }
+
+      void
+      run(void)
+      {
+        bool done = false;
+
+        while (!done)
+        {
+          m_cond.lock();
+          while (m_front.size < m_buffer_size && !m_sync && !isStopping())
+            m_cond.wait();
+
+          done = isStopping();
+          bool sync = m_sync || done;
+          m_sync = false;
+          std::swap(m_front, m_back);
+          m_cond.broadcast();
+          m_cond.unlock();
+
+          std::string error;
+          try
+          {
+            writeBack();
+            if (sync)
+            {
+              m_data.sync();
+              if (m_index.isOpen())
+                m_index.sync();
+            }
+          }
+          catch (std::exception& e)
+          {
+            error = e.what();
+          }
+
+          m_cond.lock();
+          m_written += m_back.size;
+          m_back.size = 0;
+          if (!error.empty())
+            m_error = error;
+          m_cond.unlock();
+        }
+      }
+    };
+  }
+}
+
+#endif
@@ -56,6 +56,9 @@ namespace Transports
       // Parser handle.
       IMC::Parser m_parser;
 
+      // I/O selector.
+      Poll m_poll;
+
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::SimpleTransport(name, ctx),
         m_uart(NULL)
@@ -67,17 +70,23 @@ namespace Transports
         param("Serial Port - Baud Rate", m_args.baud_rate)
         .defaultValue("9600")
         .description("Serial port baud rate");
+
+        watchMessages(m_poll);
       }
 
       void
       onResourceAcquisition(void)
       {
         m_uart = new SerialPort(m_args.device, m_args.baud_rate);
+        m_poll.add(*m_uart);
       }
 
       void
       onResourceRelease(void)
       {
+        if (m_uart)
+          m_poll.remove(*m_uart);
+
         Memory::clear(m_uart);
 
         m_parser.reset();
@@ -97,7 +106,7 @@ namespace Transports
       void
       onDataReception(uint8_t* p, unsigned int n, double timeout)
       {
-        if (!Poll::poll(*m_uart, timeout))
+        if (!m_poll.poll(timeout) || !m_poll.wasTriggered(*m_uart))
           return;
 
         int n_r;
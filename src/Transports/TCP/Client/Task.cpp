@@ -55,6 +55,8 @@ namespace Transports
         TCPSocket* m_sock;
         // Parser handle.
         IMC::Parser m_parser;
+        // I/O selector.
+        Poll m_poll;
 
         Task(const std::string& name, Tasks::Context& ctx):
           Tasks::SimpleTransport(name, ctx),
@@ -67,6 +69,8 @@ namespace Transports
           param("Server - Port", m_args.port)
           .defaultValue("7001")
           .description("Remote server port");
+
+          watchMessages(m_poll);
         }
 
         ~Task(void)
@@ -82,6 +86,7 @@ namespace Transports
             m_sock = new TCPSocket;
             m_sock->connect(m_args.address, m_args.port);
             m_sock->setKeepAlive(true);
+            m_poll.add(*m_sock);
 
             inf(DTR("connected to %s:%u"), m_args.address.c_str(), m_args.port);
             setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
@@ -97,6 +102,7 @@ namespace Transports
         {
           if (m_sock)
           {
+            m_poll.remove(*m_sock);
             delete m_sock;
             m_sock = NULL;
           }
@@ -120,7 +126,7 @@ namespace Transports
         void
         onDataReception(uint8_t* p, unsigned int n, double timeout)
         {
-          if (!Poll::poll(*m_sock, timeout))
+          if (!m_poll.poll(timeout) || !m_poll.wasTriggered(*m_sock))
             return;
 
           int n_r;
@@ -27,6 +27,14 @@
 // Author: Eduardo Marques                                                  *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <deque>
+#include <set>
+#include <vector>
+
+// ISO C++ 11 headers.
+#include <memory>
+
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
@@ -45,8 +53,22 @@ namespace Transports
         uint16_t port;
         //! True to announce service.
         bool announce;
+        //! Output queue size per client in KiB.
+        unsigned queue_size;
+        //! Messages of which only the latest copy is queued.
+        std::vector<std::string> latest_only;
+        //! Messages that are queued even if the output queue is full.
+        std::vector<std::string> never_drop;
+        //! Output queue report period.
+        double report_period;
       };
 
+      //! Clients whose output queue grows beyond this many times the
+      //! configured size are disconnected.
+      static const unsigned c_queue_hard_factor = 4;
+      //! Maximum number of packets per vectored write.
+      static const size_t c_max_segments = 64;
+
       struct Task: public Tasks::SimpleTransport
       {
         // Arguments
@@ -58,6 +80,22 @@ namespace Transports
         // I/O selector.
         Poll m_poll;
 
+        // Serialized packet, shared by the output queues of all clients.
+        struct Packet
+        {
+          std::shared_ptr<const std::vector<uint8_t> > data; // Packet data.
+          uint16_t id; // Message identification number.
+          uint16_t src; // Source system.
+          uint8_t src_ent; // Source entity.
+
+          // Test if both packets carry the same message stream.
+          bool
+          sameStream(const Packet& other) const
+          {
+            return id == other.id && src == other.src && src_ent == other.src_ent;
+          }
+        };
+
         // Client data.
         struct Client
         {
@@ -65,15 +103,29 @@ namespace Transports
           Address address; // Client address.
           uint16_t port; // Client port.
           IMC::Parser parser; // Parser handle
+          std::deque<Packet> queue; // Output queue.
+          size_t queued; // Bytes in the output queue not yet sent.
+          size_t offset; // Bytes of the first queued packet already sent.
+          unsigned long drops; // Number of dropped packets.
+          unsigned long drops_reported; // Number of dropped packets last reported.
         };
 
         // Client list.
         typedef std::list<Client> ClientList;
         ClientList m_clients;
+        // Messages of which only the latest copy is queued.
+        std::set<uint16_t> m_latest_only;
+        // Messages that are never dropped.
+        std::set<uint16_t> m_never_drop;
+        // Total number of dropped packets.
+        unsigned long m_drops;
+        // Output queue report timer.
+        Time::Counter<double> m_report_timer;
 
         Task(const std::string& name, Tasks::Context& ctx):
           Tasks::SimpleTransport(name, ctx),
-          m_sock(0)
+          m_sock(0),
+          m_drops(0)
         {
           param("Port", m_args.port)
           .defaultValue("7001")
@@ -82,6 +134,45 @@ namespace Transports
           param("Announce Service", m_args.announce)
           .defaultValue("true")
           .description("Set to true to announce the service");
+
+          param("Output Queue Size", m_args.queue_size)
+          .defaultValue("1024")
+          .units(Units::Kibibyte)
+          .minimumValue("1")
+          .description("Maximum amount of data waiting to be sent to each"
+                       " client. When full, new messages are dropped");
+
+          param("Latest Only Messages", m_args.latest_only)
+          .defaultValue("EstimatedState")
+          .description("List of messages of which only the latest copy"
+                       " is kept in a client's output queue");
+
+          param("Never Drop Messages", m_args.never_drop)
+          .defaultValue("PlanControl")
+          .description("List of messages that are queued even if a"
+                       " client's output queue is full");
+
+          param("Queue Report Period", m_args.report_period)
+          .defaultValue("5.0")
+          .units(Units::Second)
+          .minimumValue("1.0")
+          .description("Period of the output queue statistics report");
+
+          watchMessages(m_poll);
+        }
+
+        void
+        onUpdateParameters(void)
+        {
+          m_latest_only.clear();
+          for (unsigned i = 0; i < m_args.latest_only.size(); ++i)
+            m_latest_only.insert(IMC::Factory::getIdFromAbbrev(m_args.latest_only[i]));
+
+          m_never_drop.clear();
+          for (unsigned i = 0; i < m_args.never_drop.size(); ++i)
+            m_never_drop.insert(IMC::Factory::getIdFromAbbrev(m_args.never_drop[i]));
+
+          m_report_timer.setTop(m_args.report_period);
         }
 
         ~Task(void)
@@ -151,9 +242,13 @@ namespace Transports
         {
           if (client_count > 0)
           {
+            size_t queued = 0;
+            for (ClientList::iterator itr = m_clients.begin(); itr != m_clients.end(); ++itr)
+              queued += itr->queued;
+
             setEntityState(IMC::EntityState::ESTA_NORMAL,
-                           String::str(DTR("connected to %u clients"),
-                                       client_count));
+                           String::str(DTR("connected to %u clients, %u KiB queued, %lu messages dropped"),
+                                       client_count, (unsigned)(queued / 1024), m_drops));
           }
           else
           {
@@ -166,12 +261,16 @@ namespace Transports
         closeConnection(Client& c, std::exception& e)
         {
           long unsigned int client_count = m_clients.size() - 1;
+
+          c.queue.clear();
+          c.queued = 0;
           updateEntityState(client_count);
 
           debug("closing connection to %s:%u (%s), client count is %lu",
                 c.address.c_str(), c.port, e.what(), client_count);
 
           m_poll.remove(*c.socket);
+          m_poll.removeWrite(*c.socket);
           delete c.socket;
         }
 
@@ -181,6 +280,7 @@ namespace Transports
           for (ClientList::iterator itr = m_clients.begin(); itr != m_clients.end(); ++itr)
           {
             m_poll.remove(*itr->socket);
+            m_poll.removeWrite(*itr->socket);
             delete itr->socket;
           }
 
@@ -194,8 +294,103 @@ namespace Transports
           }
         }
 
+        //! Add a packet to a client's output queue, applying the
+        //! drop policy of its message.
+        //! @param[in] c client.
+        //! @param[in] pkt packet.
+        //! @return false if the client's output queue grew beyond the
+        //! hard limit, true otherwise.
+        bool
+        enqueue(Client& c, const Packet& pkt)
+        {
+          size_t size = pkt.data->size();
+
+          // Replace the queued copy, unless it is partially sent.
+          if (m_latest_only.find(pkt.id) != m_latest_only.end())
+          {
+            for (std::deque<Packet>::reverse_iterator itr = c.queue.rbegin(); itr != c.queue.rend(); ++itr)
+            {
+              if (!itr->sameStream(pkt))
+                continue;
+
+              if (c.offset > 0 && &*itr == &c.queue.front())
+                break;
+
+              c.queued = c.queued - itr->data->size() + size;
+              *itr = pkt;
+              return true;
+            }
+          }
+
+          size_t limit = m_args.queue_size * 1024;
+
+          if (c.queued + size > limit)
+          {
+            if (m_never_drop.find(pkt.id) == m_never_drop.end())
+            {
+              ++c.drops;
+              ++m_drops;
+              return true;
+            }
+
+            if (c.queued + size > limit * c_queue_hard_factor)
+              return false;
+          }
+
+          c.queue.push_back(pkt);
+          c.queued += size;
+          return true;
+        }
+
+        //! Send as much of a client's output queue as possible
+        //! without blocking. While data remains queued the client's
+        //! socket is polled for writing.
+        //! @param[in] c client.
         void
-        onDataTransmission(const uint8_t* p, unsigned int n)
+        flush(Client& c)
+        {
+          TCPSocket::Segment segs[c_max_segments];
+
+          while (!c.queue.empty())
+          {
+            size_t count = 0;
+            for (std::deque<Packet>::iterator itr = c.queue.begin();
+                 itr != c.queue.end() && count < c_max_segments; ++itr, ++count)
+            {
+              segs[count].data = &(*itr->data)[0];
+              segs[count].size = itr->data->size();
+            }
+
+            segs[0].data += c.offset;
+            segs[0].size -= c.offset;
+
+            size_t rv = c.socket->tryWrite(segs, count);
+            if (rv == 0)
+              break;
+
+            c.queued -= rv;
+            rv += c.offset;
+            while (!c.queue.empty() && rv >= c.queue.front().data->size())
+            {
+              rv -= c.queue.front().data->size();
+              c.queue.pop_front();
+            }
+            c.offset = rv;
+
+            // Socket output buffer is full.
+            if (c.offset > 0)
+              break;
+          }
+
+          if (c.queue.empty())
+            m_poll.removeWrite(*c.socket);
+          else
+            m_poll.addWrite(*c.socket);
+        }
+
+        //! Send pending data to all clients.
+        void
+        flushClients(void)
         {
           ClientList::iterator itr = m_clients.begin();
 
@@ -203,7 +398,7 @@ namespace Transports
           {
             try
             {
-              itr->socket->write((char*)p, n);
+              flush(*itr);
             }
             catch (std::runtime_error& e)
             {
@@ -215,11 +410,72 @@ namespace Transports
           }
         }
 
+        //! Report output queue statistics.
+        void
+        reportQueues(void)
+        {
+          for (ClientList::iterator itr = m_clients.begin(); itr != m_clients.end(); ++itr)
+          {
+            if (itr->drops != itr->drops_reported)
+            {
+              war(DTR("dropped %lu messages to %s:%u, %u KiB queued"),
+                  itr->drops - itr->drops_reported, itr->address.c_str(), itr->port,
+                  (unsigned)(itr->queued / 1024));
+              itr->drops_reported = itr->drops;
+            }
+          }
+
+          updateEntityState(m_clients.size());
+        }
+
+        void
+        onDataTransmission(const uint8_t* p, unsigned int n)
+        {
+          if (m_clients.empty())
+            return;
+
+          Packet pkt;
+          IMC::Header hdr;
+          IMC::Packet::deserializeHeader(hdr, p, n);
+          pkt.id = hdr.mgid;
+          pkt.src = hdr.src;
+          pkt.src_ent = hdr.src_ent;
+          pkt.data.reset(new std::vector<uint8_t>(p, p + n));
+
+          ClientList::iterator itr = m_clients.begin();
+
+          while (itr != m_clients.end())
+          {
+            if (!enqueue(*itr, pkt))
+            {
+              std::runtime_error e(DTR("output queue overflow"));
+              closeConnection(*itr, e);
+              itr = m_clients.erase(itr);
+              continue;
+            }
+            ++itr;
+          }
+
+          flushClients();
+        }
+
         void
         onDataReception(uint8_t* buf, unsigned int cap, double timeout)
         {
-          // Poll for connections and client data
-          if (!m_poll.poll(timeout))
+          if (m_report_timer.overflow())
+          {
+            m_report_timer.reset();
+            reportQueues();
+          }
+
+          // Poll for connections, client data, outgoing messages and
+          // buffer space for queued data.
+          bool triggered = m_poll.poll(timeout);
+
+          // Send data that did not fit in the sockets' output buffers.
+          flushClients();
+
+          if (!triggered)
             return;
 
           // Check for new clients.
@@ -235,13 +491,16 @@ namespace Transports
         {
           Client c;
           c.socket = 0;
+          c.queued = 0;
+          c.offset = 0;
+          c.drops = 0;
+          c.drops_reported = 0;
           try
           {
             c.socket = m_sock->accept(&c.address, &c.port);
             c.socket->setKeepAlive(true);
             c.socket->setNoDelay(true);
             c.socket->setReceiveTimeout(5);
-            c.socket->setSendTimeout(5);
             m_poll.add(*c.socket);
             m_clients.push_back(c);
             updateEntityState(m_clients.size());
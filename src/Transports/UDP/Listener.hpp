@@ -47,7 +47,9 @@ namespace Transports
   {
     using DUNE_NAMESPACES;
 
-    class Listener: public Concurrency::Thread
+    //! Receives datagrams when the shared reactor reports the socket
+    //! as readable.
+    class Listener: public IO::Reactor::Handler
     {
     public:
       Listener(Tasks::Task& task, UDPSocket& sock, LimitedComms* lcomms,
@@ -56,7 +58,8 @@ namespace Transports
         m_sock(sock),
         m_trace(trace),
         m_contacts(contact_timeout),
-        m_lcomms(lcomms)
+        m_lcomms(lcomms),
+        m_bfr(c_batch_size * c_bfr_size)
       {  }
 
       void
@@ -80,8 +83,8 @@ namespace Transports
     private:
       // Buffer capacity.
       static const int c_bfr_size = 65535;
-      // Poll timeout in milliseconds.
-      static const int c_poll_tout = 1000;
+      // Maximum number of datagrams retrieved per read.
+      static const int c_batch_size = 8;
       // Parent task.
       Tasks::Task& m_task;
       // Reference to socket used for sending data.
@@ -94,56 +97,75 @@ namespace Transports
       RWLock m_contacts_lock;
       // LimitedComms object
       LimitedComms* m_lcomms;
+      // Receive buffers.
+      std::vector<uint8_t> m_bfr;
+      // Received datagrams.
+      UDPSocket::Datagram m_dgrams[c_batch_size];
 
       void
-      run(void)
+      process(const UDPSocket::Datagram& dgram)
       {
-        Address addr;
-        uint8_t* bfr = new uint8_t[c_bfr_size];
-        double poll_tout = c_poll_tout / 1000.0;
+        IMC::Message* msg = IMC::Packet::deserialize(dgram.data, dgram.size);
 
-        while (!isStopping())
+        if (m_lcomms->isActive())
         {
-          try
+          if (msg->getId() == DUNE_IMC_ANNOUNCE)
           {
-            if (!Poll::poll(m_sock, poll_tout))
-              continue;
+            m_lcomms->setAnnounce(static_cast<IMC::Announce*>(msg));
+          }
 
-            uint16_t rv = m_sock.read(bfr, c_bfr_size, &addr);
-            IMC::Message* msg = IMC::Packet::deserialize(bfr, rv);
+          if (!m_lcomms->isNodeWithinRange(msg->getSource(), msg->getId()))
+          {
+            IMC::Factory::recycle(msg);
+            return;
+          }
+        }
 
-            if (m_lcomms->isActive())
-            {
-              if (msg->getId() == DUNE_IMC_ANNOUNCE)
-              {
-                m_lcomms->setAnnounce(static_cast<IMC::Announce*>(msg));
-              }
+        m_contacts_lock.lockWrite();
+        m_contacts.update(msg->getSource(), dgram.addr);
+        m_contacts_lock.unlock();
 
-              if (!m_lcomms->isNodeWithinRange(msg->getSource(), msg->getId()))
-              {
-                delete msg;
-                continue;
-              }
-            }
+        m_task.dispatch(msg, DF_KEEP_TIME | DF_KEEP_SRC_EID);
 
-            m_contacts_lock.lockWrite();
-            m_contacts.update(msg->getSource(), addr);
-            m_contacts_lock.unlock();
+        if (m_trace)
+          msg->toText(std::cerr);
 
-            m_task.dispatch(msg, DF_KEEP_TIME | DF_KEEP_SRC_EID);
+        IMC::Factory::recycle(msg);
+      }
 
-            if (m_trace)
-              msg->toText(std::cerr);
+      void
+      onReadable(IO::NativeHandle handle)
+      {
+        (void)handle;
+        size_t count = 0;
 
-            delete msg;
+        // Datagrams left over are reported again when this returns.
+        try
+        {
+          for (int i = 0; i < c_batch_size; ++i)
+          {
+            m_dgrams[i].data = &m_bfr[i * c_bfr_size];
+            m_dgrams[i].size = c_bfr_size;
+          }
+
+          count = m_sock.read(m_dgrams, c_batch_size);
+        }
+        catch (std::exception& e)
+        {
+          m_task.debug("error while receiving data: %s", e.what());
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+          try
+          {
+            process(m_dgrams[i]);
           }
           catch (std::exception & e)
           {
             m_task.debug("error while unpacking message: %s",e.what());
           }
         }
-
-        delete [] bfr;
       }
     };
   }
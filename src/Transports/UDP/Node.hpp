@@ -137,22 +137,22 @@ namespace Transports
         return true;
       }
 
-      //! Send data to node.
-      //! @param[in] sock UDP destination socket.
+      //! Queue data for transmission to node.
+      //! @param[out] dgrams datagrams to be transmitted.
       //! @param[in] data data to be transmitted.
       //! @param[in] data_len length of data to be transmitted.
       void
-      send(UDPSocket& sock, const uint8_t* data, unsigned data_len)
+      queue(std::vector<UDPSocket::Datagram>& dgrams, uint8_t* data, unsigned data_len)
       {
         if (m_active == m_addrs.end())
           return;
 
-        try
-        {
-          sock.write(data, data_len, m_active->first, m_active->second);
-        }
-        catch (...)
-        { }
+        UDPSocket::Datagram dgram;
+        dgram.data = data;
+        dgram.size = data_len;
+        dgram.addr = m_active->first;
+        dgram.port = m_active->second;
+        dgrams.push_back(dgram);
       }
 
     private:
@@ -33,6 +33,7 @@
 // ISO C++ 98 headers.
 #include <string>
 #include <map>
+#include <vector>
 #include <cstdio>
 
 // DUNE headers.
@@ -96,8 +97,13 @@ namespace Transports
         return m_active_count;
       }
 
+      //! Queue data for transmission to all reachable nodes.
+      //! @param[out] dgrams datagrams to be transmitted.
+      //! @param[in] data data to be transmitted.
+      //! @param[in] data_len length of data to be transmitted.
+      //! @param[in] msgid identifier of the transmitted message.
       void
-      send(UDPSocket& sock, const uint8_t* data, unsigned data_len, unsigned msgid)
+      queue(std::vector<UDPSocket::Datagram>& dgrams, uint8_t* data, unsigned data_len, unsigned msgid)
       {
         if (m_lcomms != NULL)
         {
@@ -106,7 +112,7 @@ namespace Transports
             for (Table::iterator itr = m_table.begin(); itr != m_table.end(); ++itr)
             {
               if (m_lcomms->isNodeWithinRange(itr->first, msgid))
-                itr->second.send(sock, data, data_len);
+                itr->second.queue(dgrams, data, data_len);
             }
 
             return;
@@ -114,7 +120,7 @@ namespace Transports
         }
 
         for (Table::iterator itr = m_table.begin(); itr != m_table.end(); ++itr)
-          itr->second.send(sock, data, data_len);
+          itr->second.queue(dgrams, data, data_len);
       }
 
       void
@@ -84,17 +84,42 @@ namespace Transports
       bool only_local;
       // Optional custom service type
       std::string custom_service;
+      // Time to wait for further outgoing messages before transmitting.
+      double coalescing_window;
     };
 
     // Internal buffer size.
     static const int c_bfr_size = 65535;
+    // Capacity of the outgoing packet queue (bytes).
+    static const size_t c_out_size = 4 * c_bfr_size;
+    // Maximum number of queued outgoing packets.
+    static const size_t c_out_packets = 64;
     // Port bind retries.
     static const int c_port_retries = 5;
 
+    //! Queued outgoing packet.
+    struct Packet
+    {
+      //! Offset in the outgoing queue.
+      size_t offset;
+      //! Packet size.
+      size_t size;
+      //! Message identifier.
+      unsigned id;
+    };
+
     struct Task: public DUNE::Tasks::Task
     {
-      //! Serialization buffer.
-      uint8_t* m_bfr;
+      //! Serialized outgoing packets.
+      std::vector<uint8_t> m_out;
+      //! Used bytes of the outgoing queue.
+      size_t m_out_used;
+      //! Outgoing packets.
+      std::vector<Packet> m_packets;
+      //! Time at which the first outgoing packet was queued.
+      double m_out_time;
+      //! Datagrams of the current transmission.
+      std::vector<UDPSocket::Datagram> m_dgrams;
       //! UDP Socket.
       UDPSocket m_sock;
       //! Set of static nodes.
@@ -107,7 +132,7 @@ namespace Transports
       bool m_comm_limitations;
       //! Allow underwater communications when simulating limited comms
       bool m_underwater_comms;
-      //! Listener thread.
+      //! Handler of incoming datagrams.
       Listener* m_listener;
       //! Contact refresh counter.
       Time::Counter<float> m_contacts_refresh_counter;
@@ -118,7 +143,9 @@ namespace Transports
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Task(name, ctx),
-        m_bfr(NULL),
+        m_out(c_out_size),
+        m_out_used(0),
+        m_out_time(0),
         m_listener(NULL),
         m_lcomms(NULL)
       {
@@ -184,19 +211,19 @@ namespace Transports
         .defaultValue("")
         .description("Optional custom service type (imc+udp+<Custom Service Type>), empty entry gives default service (imc+udp)");
 
-        // Allocate space for internal buffer.
-        m_bfr = new uint8_t[c_bfr_size];
+        param("Coalescing Window", m_args.coalescing_window)
+        .defaultValue("0.0")
+        .units(Units::Second)
+        .minimumValue("0.0")
+        .maximumValue("1.0")
+        .description("Time to wait for further outgoing messages before"
+                     " transmitting them together to all nodes. If zero, messages"
+                     " are transmitted as soon as they are consumed");
 
         // Register listeners.
         bind<IMC::Announce>(this);
       }
 
-      ~Task(void)
-      {
-        if (m_bfr != NULL)
-          delete[] m_bfr;
-      }
-
       void
       onUpdateParameters(void)
       {
@@ -235,7 +262,7 @@ namespace Transports
       onResourceAcquisition(void)
       {
         // Register normal messages.
-        bind(this, m_args.messages);
+        bindBatch(this, m_args.messages);
 
         // Find a free port.
         unsigned port_limit = m_args.port + c_port_retries;
@@ -297,10 +324,10 @@ namespace Transports
         m_lcomms->setActive(m_comm_limitations);
         m_node_table.setLimitedComms(m_lcomms);
 
-        // Start listener thread.
+        // Start receiving datagrams.
         m_listener = new Listener(*this, m_sock, m_lcomms,
                                   m_args.contact_timeout, m_args.trace_in);
-        m_listener->start();
+        m_ctx.reactor.add(m_sock, m_listener);
 
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
       }
@@ -308,9 +335,11 @@ namespace Transports
       void
       onResourceRelease(void)
       {
+        flush();
+
         if (m_listener != NULL)
         {
-          m_listener->stopAndJoin();
+          m_ctx.reactor.remove(m_sock);
           delete m_listener;
           m_listener = NULL;
         }
@@ -319,7 +348,23 @@ namespace Transports
       }
 
       void
-      consume(const IMC::Message* msg)
+      consumeBatch(const IMC::Message* const* msgs, size_t count)
+      {
+        // Without destinations only the limited communications
+        // simulator needs to see the messages.
+        if (!m_lcomms->isActive() && m_node_table.getActiveCount() == 0 && m_static_dsts.size() == 0)
+          return;
+
+        for (size_t i = 0; i < count; ++i)
+          enqueue(msgs[i]);
+
+        if (m_args.coalescing_window <= 0 || Clock::get() - m_out_time >= m_args.coalescing_window)
+          flush();
+      }
+
+      //! Serialize an outgoing message into the outgoing queue.
+      void
+      enqueue(const IMC::Message* msg)
       {
         if (m_lcomms->isActive())
         {
@@ -339,25 +384,56 @@ namespace Transports
         if (m_args.trace_out)
           msg->toText(std::cerr);
 
-        uint16_t rv = IMC::Packet::serialize(msg, m_bfr, c_bfr_size);
+        if (m_out_used + c_bfr_size > m_out.size() || m_packets.size() >= c_out_packets)
+          flush();
 
-        // Send to static nodes.
-        std::set<NodeAddress>::iterator itr = m_static_dsts.begin();
-        for (; itr != m_static_dsts.end(); ++itr)
+        if (m_packets.empty())
+          m_out_time = Clock::get();
+
+        Packet packet;
+        packet.offset = m_out_used;
+        packet.size = IMC::Packet::serialize(msg, &m_out[m_out_used], c_bfr_size);
+        packet.id = msg->getId();
+        m_packets.push_back(packet);
+        m_out_used += packet.size;
+      }
+
+      //! Transmit queued packets to all nodes.
+      void
+      flush(void)
+      {
+        if (m_packets.empty())
+          return;
+
+        m_dgrams.clear();
+        for (size_t i = 0; i < m_packets.size(); ++i)
         {
-          try
+          uint8_t* data = &m_out[m_packets[i].offset];
+
+          // Send to static nodes.
+          std::set<NodeAddress>::iterator itr = m_static_dsts.begin();
+          for (; itr != m_static_dsts.end(); ++itr)
           {
-            m_sock.write(m_bfr, rv, itr->getAddress(), itr->getPort());
+            UDPSocket::Datagram dgram;
+            dgram.data = data;
+            dgram.size = m_packets[i].size;
+            dgram.addr = itr->getAddress();
+            dgram.port = itr->getPort();
+            m_dgrams.push_back(dgram);
           }
-          catch (...)
-          { }
-        }
 
-        if (m_args.dynamic_nodes)
-        {
-          // Send to dynamic nodes.
-          m_node_table.send(m_sock, m_bfr, rv, msg->getId());
+          if (m_args.dynamic_nodes)
+          {
+            // Send to dynamic nodes.
+            m_node_table.queue(m_dgrams, data, m_packets[i].size, m_packets[i].id);
+          }
         }
+
+        if (!m_dgrams.empty())
+          m_sock.write(&m_dgrams[0], m_dgrams.size());
+
+        m_packets.clear();
+        m_out_used = 0;
       }
 
       void
@@ -409,7 +485,16 @@ namespace Transports
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          if (m_packets.empty())
+          {
+            waitForMessages(1.0);
+          }
+          else
+          {
+            waitForMessages(std::max(0.0, m_out_time + m_args.coalescing_window - Clock::get()));
+            if (Clock::get() - m_out_time >= m_args.coalescing_window)
+              flush();
+          }
 
           // Check if it's time to update the contact list.
           if (m_contacts_refresh_counter.overflow())
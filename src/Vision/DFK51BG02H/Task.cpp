@@ -120,6 +120,10 @@ namespace Vision
       unsigned jpeg_quality;
       //! Number of frame buffers.
       unsigned buffer_count;
+      //! Number of compression threads.
+      unsigned threads;
+      //! Number of compression buffers.
+      unsigned jpeg_buffers;
       //! Exposure time (or maximum value if auto).
       double exposure_time;
       //! Automatic Exposure.
@@ -161,8 +165,8 @@ namespace Vision
       GVCP* m_gvcp;
       //! %GVSP.
       GVSP* m_gvsp;
-      //! RGB24 buffer.
-      uint8_t* m_rgb24_bfr;
+      //! Conversion and compression pipeline.
+      FramePipeline* m_pipeline;
       //! Keep-alive counter.
       Counter<double> m_kalive;
       //! %Destination log folder.
@@ -171,10 +175,6 @@ namespace Vision
       std::queue<Frame*> m_frames;
       //! PGM header.
       std::string m_pgm_header;
-      //! Compressor.
-      JPEGCompressor m_jpeg;
-      //! Bayer decoder.
-      BayerDecoder m_debayer;
       // White-balance filter.
       WhiteBalance m_white;
       // Exposure time.
@@ -186,9 +186,9 @@ namespace Vision
         Tasks::Task(name, ctx),
         m_gvcp(NULL),
         m_gvsp(NULL),
+        m_pipeline(NULL),
         m_kalive(0.5),
         m_log_dir(ctx.dir_log),
-        m_debayer(BayerDecoder::TILE_GBRG),
         m_white(c_width, c_height)
       {
         // Retrieve configuration values.
@@ -264,6 +264,16 @@ namespace Vision
         .defaultValue("25")
         .description("Number of buffers");
 
+        param("Compression Threads", m_args.threads)
+        .defaultValue("2")
+        .minimumValue("1")
+        .description("Number of threads converting and compressing frames concurrently");
+
+        param("Compression Buffers", m_args.jpeg_buffers)
+        .defaultValue("6")
+        .minimumValue("2")
+        .description("Number of frames waiting for or undergoing compression");
+
         param("JPEG Quality", m_args.jpeg_quality)
         .defaultValue("80")
         .units(Units::Percentage)
@@ -281,20 +291,12 @@ namespace Vision
         param("White Balance - R Factor", m_args.r_factor)
         .defaultValue("1.0");
 
-        m_rgb24_bfr = new uint8_t[c_width * c_height * 3];
-
         // Initialize PGM header.
         m_pgm_header = String::str("P5 %u %u 255\n", c_width, c_height);
 
         bind<IMC::LoggingControl>(this);
       }
 
-      //! Destructor.
-      ~Task(void)
-      {
-        delete [] m_rgb24_bfr;
-      }
-
       //! Update internal parameters.
       void
       onUpdateParameters(void)
@@ -302,19 +304,24 @@ namespace Vision
         // White-balance filter.
         m_white.setRFactor(m_args.r_factor);
         m_white.setBFactor(m_args.b_factor);
-
-        // Bayer decoder.
-        m_debayer.setMethod(BayerDecoder::METHOD_BILINEAR);
       }
 
       //! Acquire resources and buffers.
       void
       onResourceAcquisition(void)
       {
-        // Initialize JPEG compressor.
-        m_jpeg.setInputDimensions(c_width, c_height);
-        m_jpeg.setInputColorSpace(JPEGCompressor::CS_RGB);
-        m_jpeg.setOutputColorSpace(JPEGCompressor::CS_YUV);
+        // Initialize conversion and compression pipeline.
+        FramePipeline::Settings settings;
+        settings.width = c_width;
+        settings.height = c_height;
+        settings.format = FramePipeline::PF_BAYER8;
+        settings.tile = BayerDecoder::TILE_GBRG;
+        settings.method = BayerDecoder::METHOD_BILINEAR;
+        settings.output = JPEGCompressor::CS_YUV;
+        settings.quality = m_args.jpeg_quality;
+        settings.workers = m_args.threads;
+        settings.buffers = m_args.jpeg_buffers;
+        m_pipeline = new FramePipeline(settings);
 
         m_gvcp = new GVCP(m_args.raddr);
         m_gvsp = new GVSP(this, m_args.port);
@@ -341,6 +348,8 @@ namespace Vision
           m_gvsp = NULL;
         }
 
+        Memory::clear(m_pipeline);
+
         while (!m_frames.empty())
         {
           Frame* frame = m_frames.front();
@@ -438,6 +447,37 @@ namespace Vision
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_IDLE);
       }
 
+      //! Store compressed frames and update the exposure time. Frames
+      //! are retrieved in capture order.
+      void
+      storeFrames(void)
+      {
+        FramePipeline::Frame* frame = NULL;
+
+        while ((frame = m_pipeline->poll()) != NULL)
+        {
+          Path file = m_log_dir / String::str("%0.4f.jpg", frame->getTimeStamp());
+          std::ofstream jpg(file.c_str(), std::ios::binary);
+          jpg.write((const char*)frame->getJPEG(), frame->getJPEGSize());
+          jpg.close();
+
+          if (m_args.ae)
+          {
+            float correction = m_ae.exposureCorrection((uint8_t*)frame->getRGB(), c_width * c_height);
+            // Smooth out the exposure (make it slower varying), halve the deltaEV
+            correction = std::sqrt(correction);
+            m_exposure = Math::trimValue(m_exposure * correction, 0.0001, m_args.exposure_time);
+
+            if (m_exposure >= m_args.ae_min)
+              m_gvcp->setExposureTime(m_exposure);
+            else
+              m_gvcp->setExposureTime(m_args.ae_min);
+          }
+
+          m_pipeline->release(frame);
+        }
+      }
+
       void
       onMain(void)
       {
@@ -460,11 +500,13 @@ namespace Vision
           }
 
           consumeMessages();
+          storeFrames();
 
           frame = m_gvsp->dequeueDirty();
           if (frame == NULL)
           {
-            m_gvsp->waitDirty(0.5);
+            // Poll more often while frames are being compressed.
+            m_gvsp->waitDirty(m_pipeline->getPending() > 0 ? 0.01 : 0.5);
             continue;
           }
 
@@ -476,35 +518,27 @@ namespace Vision
           {
             m_white.filter(frame->getData());
             double timestamp = frame->getTimeStamp();
-            Path file = m_log_dir / String::str("%0.4f.jpg", timestamp);
 
+            // Debayering and compression run on the pipeline workers.
+            FramePipeline::Frame* pframe = m_pipeline->acquire();
+            if (pframe != NULL)
+            {
+              std::memcpy(pframe->getRaw(), frame->getData(), pframe->getRawSize());
+              pframe->setTimeStamp(timestamp);
+              m_pipeline->submit(pframe);
+            }
+            else
             {
-              m_debayer.decodeToRGB24(frame->getData(), m_rgb24_bfr, c_width, c_height);
-              m_jpeg.compress(m_rgb24_bfr, m_args.jpeg_quality);
-              std::ofstream jpg(file.c_str(), std::ios::binary);
-              jpg.write((char*)m_jpeg.imageData(), m_jpeg.imageSize());
+              war(DTR("compression overrun, frame dropped"));
             }
 
             if (m_args.store_raw)
             {
-              file = m_log_dir / String::str("%0.4f.pgm", timestamp);
+              Path file = m_log_dir / String::str("%0.4f.pgm", timestamp);
               std::ofstream pgm(file.c_str(), std::ios::binary);
               pgm.write(m_pgm_header.c_str(), m_pgm_header.size());
               pgm.write((char*)frame->getData(), c_width * c_height);
             }
-
-            if (m_args.ae)
-            {
-              float correction = m_ae.exposureCorrection(m_rgb24_bfr, c_width * c_height);
-              // Smooth out the exposure (make it slower varying), halve the deltaEV
-              correction = std::sqrt(correction);
-              m_exposure = Math::trimValue(m_exposure * correction, 0.0001, m_args.exposure_time);
-
-              if (m_exposure >= m_args.ae_min)
-                m_gvcp->setExposureTime(m_exposure);
-              else
-                m_gvcp->setExposureTime(m_args.ae_min);
-            }
           }
 
           m_gvsp->enqueueClean(frame);
@@ -36,6 +36,8 @@
 #include <fstream>
 #include <iostream>
 #include <cstddef>
+#include <deque>
+#include <algorithm>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -46,6 +48,9 @@ namespace Vision
   {
     using DUNE_NAMESPACES;
 
+    //! Number of frame buffers handed to the video driver.
+    static const unsigned c_capture_frames = 2;
+
     struct Arguments
     {
       //! Video device.
@@ -58,19 +63,37 @@ namespace Vision
       unsigned jpeg_quality;
       //! Video standard (PAL or NTSC).
       std::string standard;
+      //! Number of compression threads.
+      unsigned threads;
+      //! Number of frame buffers.
+      unsigned buffers;
+      //! Pipeline metrics report period.
+      double report_period;
     };
 
     struct Task: public DUNE::Tasks::Periodic
     {
       IMC::CompressedImage m_frame;
       Media::VideoCapture* m_video;
-      Media::JPEGCompressor m_jpeg;
+      //! Compression pipeline.
+      Media::FramePipeline* m_pipeline;
+      //! Pipeline frames being filled by the video driver, in order.
+      std::deque<Media::FramePipeline::Frame*> m_capturing;
+      //! Signalled when compressed frames are ready.
+      IO::Event m_ready;
+      //! Signalled when messages are queued.
+      IO::Event m_msg_event;
+      //! Waits for compressed frames and messages.
+      IO::Poll m_poll;
       Media::VideoCapture::Standard m_standard;
+      //! Pipeline metrics report timer.
+      Counter<double> m_report_timer;
       Arguments m_args;
 
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Periodic(name, ctx),
         m_video(NULL),
+        m_pipeline(NULL),
         m_standard(Media::VideoCapture::STANDARD_PAL)
       {
         // Retrieve configuration values.
@@ -100,6 +123,24 @@ namespace Vision
         .values("PAL, NTSC")
         .description("Video standard");
 
+        param("Compression Threads", m_args.threads)
+        .defaultValue("2")
+        .minimumValue("1")
+        .description("Number of threads compressing frames concurrently");
+
+        param("Frame Buffers", m_args.buffers)
+        .defaultValue("8")
+        .minimumValue("2")
+        .description("Number of frame buffers waiting for compression or dispatch");
+
+        param("Metrics Report Period", m_args.report_period)
+        .defaultValue("10.0")
+        .units(Units::Second)
+        .description("Period of pipeline latency reports (debug), zero to disable");
+
+        m_poll.add(m_ready);
+        m_poll.add(m_msg_event);
+
         bind<IMC::ImageTxSettings>(this);
       }
 
@@ -110,28 +151,45 @@ namespace Vision
           m_standard = Media::VideoCapture::STANDARD_NTSC;
         else
           m_standard = Media::VideoCapture::STANDARD_PAL;
+
+        if (m_pipeline != NULL)
+          m_pipeline->setQuality(m_args.jpeg_quality);
+
+        m_report_timer.setTop(m_args.report_period);
       }
 
       void
       onResourceAcquisition(void)
       {
-        m_video = new VideoCapture(m_args.vid_dev, m_args.pic_w, m_args.pic_h);
+        m_video = new VideoCapture(m_args.vid_dev, m_args.pic_w, m_args.pic_h, true);
       }
 
       void
       onResourceInitialization(void)
       {
-        m_jpeg.setInputDimensions(m_video->frameWidth(), m_video->frameHeight());
-        m_jpeg.setInputColorSpace(m_jpeg.CS_RGB);
-        m_jpeg.setOutputColorSpace(m_jpeg.CS_RGB);
+        Media::FramePipeline::Settings settings;
+        settings.width = m_video->frameWidth();
+        settings.height = m_video->frameHeight();
+        settings.format = Media::FramePipeline::PF_RGB24;
+        settings.output = Media::JPEGCompressor::CS_RGB;
+        settings.quality = m_args.jpeg_quality;
+        settings.workers = m_args.threads;
+        settings.buffers = m_args.buffers;
+        Memory::replace(m_pipeline, new Media::FramePipeline(settings));
+        m_pipeline->setEvent(&m_ready);
+
         m_video->setStandard(m_standard);
+        queueFrames();
         m_video->start();
       }
 
       void
       onResourceRelease(void)
       {
+        // Stop the driver before its buffers are freed.
         Memory::clear(m_video);
+        m_capturing.clear();
+        Memory::clear(m_pipeline);
       }
 
       void
@@ -139,18 +197,135 @@ namespace Vision
       {
         setFrequency(msg->fps);
         m_args.jpeg_quality = msg->quality;
+
+        if (m_pipeline != NULL)
+          m_pipeline->setQuality(m_args.jpeg_quality);
+      }
+
+      //! Hand free pipeline frames to the video driver, which
+      //! captures straight into them.
+      void
+      queueFrames(void)
+      {
+        while (m_capturing.size() < c_capture_frames)
+        {
+          Media::FramePipeline::Frame* frame = m_pipeline->acquire();
+          if (frame == NULL)
+            return;
+
+          m_video->queueFrame(frame->getRaw(), frame->getRawSize());
+          m_capturing.push_back(frame);
+        }
+      }
+
+      //! Take the most recent captured frame. Older frames go back
+      //! to the video driver.
+      //! @return frame or NULL if none was captured.
+      Media::FramePipeline::Frame*
+      captureFrame(void)
+      {
+        Media::FramePipeline::Frame* frame = NULL;
+
+        while (m_video->dequeueFrame(frame == NULL ? 1.0 : 0.0) != NULL)
+        {
+          if (frame != NULL)
+          {
+            m_video->queueFrame(frame->getRaw(), frame->getRawSize());
+            m_capturing.push_back(frame);
+          }
+
+          frame = m_capturing.front();
+          m_capturing.pop_front();
+        }
+
+        return frame;
+      }
+
+      //! Dispatch all frames already compressed.
+      void
+      dispatchFrames(void)
+      {
+        Media::FramePipeline::Frame* frame = NULL;
+        while ((frame = m_pipeline->poll()) != NULL)
+        {
+          const char* img = (const char*)frame->getJPEG();
+          m_frame.data.assign(img, img + frame->getJPEGSize());
+          m_frame.frameid = frame->getSequence() % 255;
+          m_pipeline->release(frame);
+          dispatch(m_frame);
+        }
+      }
+
+      //! Report pipeline latencies.
+      void
+      reportMetrics(void)
+      {
+        if (m_args.report_period <= 0 || !m_report_timer.overflow())
+          return;
+
+        m_report_timer.reset();
+
+        Media::FramePipeline::Metrics m = m_pipeline->getMetrics();
+        m_pipeline->resetMetrics();
+
+        debug("frames: %lu submitted, %lu encoded, %lu dropped, %lu failed",
+              m.submitted, m.encoded, m.dropped, m.failed);
+        debug("latency (mean/max ms): capture %0.1f/%0.1f, queue %0.1f/%0.1f,"
+              " encode %0.1f/%0.1f, delivery %0.1f/%0.1f, total %0.1f/%0.1f",
+              m.capture.mean() * 1e3, m.capture.max * 1e3,
+              m.queue.mean() * 1e3, m.queue.max * 1e3,
+              m.encode.mean() * 1e3, m.encode.max * 1e3,
+              m.delivery.mean() * 1e3, m.delivery.max * 1e3,
+              m.total.mean() * 1e3, m.total.max * 1e3);
       }
 
       void
       task(void)
       {
-        m_video->frameCapture();
-        m_jpeg.compress(m_video->frameData(), m_args.jpeg_quality);
+        Media::FramePipeline::Frame* frame = captureFrame();
+        if (frame != NULL)
+        {
+          frame->setTimeStamp(Clock::getSinceEpoch());
+          m_pipeline->submit(frame);
+        }
+
+        // Capture never waits for compression: if all buffers are
+        // busy the driver gets fewer of them and frames are skipped
+        // (and counted as dropped).
+        queueFrames();
+        reportMetrics();
+      }
+
+      //! Capture at the task frequency and dispatch frames as soon
+      //! as they are compressed.
+      void
+      onMain(void)
+      {
+        double next = Clock::get();
+        setMessageEvent(&m_msg_event);
+
+        while (!stopping())
+        {
+          consumeMessages();
+
+          double now = Clock::get();
+          if (getFrequency() <= 0)
+          {
+            next = now + 1.0;
+          }
+          else if (now >= next)
+          {
+            next = std::max(next + 1.0 / getFrequency(), now);
+            task();
+          }
+
+          // Wait for compressed frames, messages or the next capture.
+          m_poll.poll(std::max(next - Clock::get(), 0.0));
+          m_ready.clear();
+          dispatchFrames();
+        }
 
-        const char* img = (const char*)(m_jpeg.imageData());
-        m_frame.data.assign(img, img + m_jpeg.imageSize());
-        m_frame.frameid = getRunCount() % 255;
-        dispatch(m_frame);
+        setMessageEvent(NULL);
       }
     };
   }